@@ -0,0 +1,46 @@
+/// <copyright file="BenchTimer.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef BenchTimer_hpp
+#define BenchTimer_hpp
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace dxowl_bench
+{
+    /// Like measure(), but runs setup untimed before every run, e.g. to restore the input that function modifies.
+    template <typename Setup, typename Function>
+    double measureWithSetup(Setup&& setup, Function&& function, size_t repeat_cnt = 5)
+    {
+        setup();
+        function();
+
+        std::vector<double> times;
+        times.reserve(repeat_cnt);
+        for (size_t i = 0; i < repeat_cnt; ++i)
+        {
+            setup();
+            auto const start = std::chrono::steady_clock::now();
+            function();
+            auto const end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double>(end - start).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        return times.empty() ? 0.0 : times[times.size() / 2];
+    }
+
+    /// Runs function repeat_cnt times after one warm-up run, returns the median run time in seconds.
+    template <typename Function>
+    double measure(Function&& function, size_t repeat_cnt = 5)
+    {
+        return measureWithSetup([]() {}, function, repeat_cnt);
+    }
+} // namespace dxowl_bench
+
+#endif // !BenchTimer_hpp
@@ -0,0 +1,77 @@
+/// <copyright file="BlockCompressorBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdio>
+#include <vector>
+
+#include <dxowl/BlockCompressor.hpp>
+
+#include "BcDecoder.hpp"
+#include "BenchTimer.hpp"
+#include "TestImage.hpp"
+
+using namespace dxowl;
+using dxowl_test::BcDecoder;
+
+// Quality and throughput of every target format and preset on a 512x512 synthetic image. PSNR is
+// measured over the channels the format stores, BC1 and the BC7 RGB rows use the opaque variant.
+int main()
+{
+    UINT const size = 512;
+    std::vector<uint8_t> const image = dxowl_test::makeTestImage(size, size);
+    std::vector<uint8_t> const opaque = dxowl_test::makeTestImage(size, size, true);
+
+    struct Case
+    {
+        char const* name;
+        DXGI_FORMAT format;
+        std::vector<uint8_t> const& source;
+        std::vector<UINT> channels;
+    };
+
+    std::vector<Case> const cases = {
+        { "BC1", DXGI_FORMAT_BC1_UNORM, opaque, { 0, 1, 2 } },
+        { "BC3", DXGI_FORMAT_BC3_UNORM, image, { 0, 1, 2, 3 } },
+        { "BC4", DXGI_FORMAT_BC4_UNORM, image, { 0 } },
+        { "BC5", DXGI_FORMAT_BC5_UNORM, image, { 0, 1 } },
+        { "BC7 RGBA", DXGI_FORMAT_BC7_UNORM, image, { 0, 1, 2, 3 } },
+        { "BC7 RGB", DXGI_FORMAT_BC7_UNORM, opaque, { 0, 1, 2 } },
+    };
+
+    std::pair<char const*, BlockCompressor::Preset> const presets[] = {
+        { "Fast", BlockCompressor::Preset::Fast },
+        { "Normal", BlockCompressor::Preset::Normal },
+        { "High", BlockCompressor::Preset::High },
+    };
+
+    ThreadPool thread_pool;
+    std::printf("%-10s %-8s %10s %14s %14s\n", "format", "preset", "PSNR [dB]", "1 thread", "pool");
+
+    for (auto const& test_case : cases)
+    {
+        for (auto const& preset : presets)
+        {
+            std::vector<void const*> const subresources = { test_case.source.data() };
+            BlockCompressor::CompressedTexture texture;
+
+            double const serial = dxowl_bench::measure([&]() {
+                texture = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1, subresources, test_case.format, preset.second);
+            });
+            double const parallel = dxowl_bench::measure([&]() {
+                texture = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1, subresources, test_case.format, preset.second, &thread_pool);
+            });
+
+            std::vector<uint8_t> const decoded = BcDecoder::decodeSubresource(test_case.format, texture.getSubresourceData()[0], size, size);
+            double const psnr = BcDecoder::computePsnr(test_case.source, decoded, test_case.channels);
+            double const mpix = double(size) * size / 1e6;
+
+            std::printf("%-10s %-8s %10.2f %8.1f MPix/s %8.1f MPix/s\n", test_case.name, preset.first, psnr, mpix / serial, mpix / parallel);
+        }
+    }
+
+    std::printf("\npool: %zu threads\n", thread_pool.getThreadCount());
+    return 0;
+}
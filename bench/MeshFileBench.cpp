@@ -0,0 +1,128 @@
+/// <copyright file="MeshFileBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <dxowl/MeshFile.hpp>
+
+#include "BenchTimer.hpp"
+#include "RecordingDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    uint32_t const grid_size = 1023;
+
+    std::string tempPath(std::string const& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("dxowl_" + name)).string();
+    }
+
+    /// Rolling grid of (grid_size + 1)^2 vertices with position, normal and tex coord streams.
+    MeshFileWriter makeWriter(size_t& byte_size)
+    {
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> tex_coords;
+        for (uint32_t y = 0; y <= grid_size; ++y)
+        {
+            for (uint32_t x = 0; x <= grid_size; ++x)
+            {
+                float const height = std::sin(x * 0.05f) * std::cos(y * 0.07f);
+                positions.insert(positions.end(), { float(x), height, float(y) });
+                normals.insert(normals.end(), { -0.05f * std::cos(x * 0.05f), 1.0f, 0.07f * std::sin(y * 0.07f) });
+                tex_coords.insert(tex_coords.end(), { float(x) / grid_size, float(y) / grid_size });
+            }
+        }
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y < grid_size; ++y)
+        {
+            for (uint32_t x = 0; x < grid_size; ++x)
+            {
+                uint32_t const v = y * (grid_size + 1) + x;
+                indices.insert(indices.end(), { v, v + grid_size + 1, v + 1, v + 1, v + grid_size + 1, v + grid_size + 2 });
+            }
+        }
+
+        std::vector<VertexDescriptor> const layout = {
+            { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+            { 12, { { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+            { 8, { { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 2, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+        };
+        MeshFileWriter retval(layout, DXGI_FORMAT_R32_UINT);
+        retval.setVertexData(0, positions);
+        retval.setVertexData(1, normals);
+        retval.setVertexData(2, tex_coords);
+        retval.setIndexData(indices);
+
+        byte_size = (positions.size() + normals.size() + tex_coords.size() + indices.size()) * 4;
+        return retval;
+    }
+
+    std::vector<char> readFile(std::string const& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        std::vector<char> retval(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(retval.data(), static_cast<std::streamsize>(retval.size()));
+        return retval;
+    }
+} // namespace
+
+// Load throughput of a 1M vertex grid with position, normal and tex coord streams and 32 bit indices (56 MiB),
+// from the page cache. Every row opens the file with MeshFile and creates the Mesh on the recording device,
+// which copies the streams into its buffers like a driver does. Raw files hand the mapping to Mesh, LZ4 files
+// are decoded first, serially or in parallel. Reading the raw file with std::ifstream, as a loader that
+// copies into vectors has to, is given for reference. Throughput counts the uncompressed stream bytes.
+int main()
+{
+    size_t byte_size = 0;
+    MeshFileWriter const writer = makeWriter(byte_size);
+    std::string const raw_path = tempPath("bench_raw.dxmf");
+    std::string const lz4_path = tempPath("bench_lz4.dxmf");
+    writer.write(raw_path, false);
+    writer.write(lz4_path, true);
+
+    auto device = dxowl_test::createRecordingDevice();
+    ThreadPool thread_pool;
+
+    auto load = [&](std::string const& path, ThreadPool* pool) {
+        MeshFile file(path, pool);
+        file.createMesh(device.Get());
+    };
+
+    struct Row
+    {
+        char const* name;
+        std::string const& path;
+        double seconds;
+    };
+    Row const rows[] = {
+        { "ifstream read", raw_path, dxowl_bench::measure([&]() { readFile(raw_path); }) },
+        { "raw, mapped", raw_path, dxowl_bench::measure([&]() { load(raw_path, nullptr); }) },
+        { "lz4", lz4_path, dxowl_bench::measure([&]() { load(lz4_path, nullptr); }) },
+        { "lz4, thread pool", lz4_path, dxowl_bench::measure([&]() { load(lz4_path, &thread_pool); }) },
+    };
+
+    std::printf("%-18s %10s %12s %10s\n", "load", "file", "time", "GB/s");
+    for (auto const& row : rows)
+    {
+        double const file_mib = double(std::filesystem::file_size(row.path)) / (1024.0 * 1024.0);
+        std::printf("%-18s %6.1f MiB %9.2f ms %10.2f\n", row.name, file_mib, row.seconds * 1e3, byte_size / row.seconds * 1e-9);
+    }
+    std::printf("thread pool: %zu threads\n", thread_pool.getThreadCount());
+
+    std::filesystem::remove(raw_path);
+    std::filesystem::remove(lz4_path);
+    return 0;
+}
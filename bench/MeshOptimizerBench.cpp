@@ -0,0 +1,65 @@
+/// <copyright file="MeshOptimizerBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdio>
+#include <vector>
+
+#include <dxowl/MeshOptimizer.hpp>
+
+#include "BenchTimer.hpp"
+#include "TestMesh.hpp"
+
+using namespace dxowl;
+
+// Vertex cache efficiency and run time of both algorithms on a 120x120 UV sphere (28.8K triangles) whose
+// triangles are shuffled, with a 16 entry FIFO cache.
+int main()
+{
+    dxowl_test::TestMesh const original = dxowl_test::makeTestSphere(120);
+    VertexDescriptor const position_layout = { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+
+    std::pair<char const*, MeshOptimizer::Algorithm> const algorithms[] = {
+        { "Tipsify", MeshOptimizer::Algorithm::Tipsify },
+        { "Forsyth", MeshOptimizer::Algorithm::Forsyth },
+    };
+
+    std::printf("%-8s %-9s %11s %11s %11s %9s %10s\n", "algo", "overdraw", "ACMR before", "ACMR after", "ATVR after", "clusters", "time");
+
+    for (auto const& algorithm : algorithms)
+    {
+        for (float overdraw_threshold : { 0.0f, 1.05f })
+        {
+            MeshOptimizer::Settings settings;
+            settings.algorithm = algorithm.second;
+            settings.overdraw_threshold = overdraw_threshold;
+
+            MeshOptimizer::Report report;
+            double const seconds = dxowl_bench::measure([&]() {
+                dxowl_test::TestMesh mesh = original;
+                report = MeshOptimizer::optimize(
+                    { mesh.positions.data() },
+                    mesh.vertex_count,
+                    { position_layout },
+                    mesh.indices.data(),
+                    mesh.indices.size(),
+                    DXGI_FORMAT_R32_UINT,
+                    {},
+                    settings);
+            });
+
+            std::printf("%-8s %-9s %11.3f %11.3f %11.3f %9zu %7.1f ms\n",
+                algorithm.first,
+                overdraw_threshold > 0.0f ? "on" : "off",
+                report.before.acmr,
+                report.after.acmr,
+                report.after.atvr,
+                report.cluster_count,
+                seconds * 1e3);
+        }
+    }
+
+    return 0;
+}
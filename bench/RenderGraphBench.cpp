@@ -0,0 +1,62 @@
+/// <copyright file="RenderGraphBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dxowl/RenderGraph.hpp>
+
+#include "BenchTimer.hpp"
+
+using namespace dxowl;
+
+// compile() time for a chain of passes where every pass reads the output of the previous pass and of the pass
+// four steps back. The last pass has a side effect, so nothing is culled. No device is needed.
+int main()
+{
+    std::printf("%8s %8s %12s\n", "passes", "culled", "compile");
+
+    for (size_t pass_cnt : { 100, 500, 2000 })
+    {
+        RenderGraph graph;
+        RenderGraph::TextureDesc desc;
+        desc.width = 256;
+        desc.height = 256;
+
+        std::vector<RenderGraph::ResourceHandle> textures;
+        for (size_t i = 0; i < pass_cnt; ++i)
+        {
+            textures.push_back(graph.createTexture("texture" + std::to_string(i), desc));
+        }
+        for (size_t i = 0; i < pass_cnt; ++i)
+        {
+            graph.addPass(
+                "pass" + std::to_string(i),
+                [&, i](RenderGraph::PassBuilder& builder) {
+                    if (i > 0)
+                    {
+                        builder.read(textures[i - 1]);
+                    }
+                    if (i > 3)
+                    {
+                        builder.read(textures[i - 4]);
+                    }
+                    builder.write(textures[i]);
+                    if (i == pass_cnt - 1)
+                    {
+                        builder.setSideEffect();
+                    }
+                },
+                [](RenderGraph::PassContext&) {});
+        }
+
+        double const seconds = dxowl_bench::measure([&]() { graph.compile(); }, 101);
+        std::printf("%8zu %8zu %9.1f us\n", pass_cnt, graph.getStatistics().culled_pass_count, seconds * 1e6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+/// <copyright file="RenderQueueBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <dxowl/RenderQueue.hpp>
+
+#include "BenchTimer.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    size_t const draw_cnt = 100000;
+    size_t const program_cnt = 200;
+    size_t const mesh_cnt = 2000;
+    size_t const pass_cnt = 3;
+
+    // addresses that stand in for programs and meshes, sorting never dereferences them
+    alignas(16) unsigned char program_placeholders[program_cnt];
+    alignas(16) unsigned char mesh_placeholders[mesh_cnt];
+
+    size_t countProgramChanges(RenderQueue const& queue)
+    {
+        size_t retval = 0;
+        ShaderProgram const* program = nullptr;
+        for (size_t i = 0; i < queue.getDrawCount(); ++i)
+        {
+            retval += queue.getDraw(i).program != program ? 1 : 0;
+            program = queue.getDraw(i).program;
+        }
+        return retval;
+    }
+} // namespace
+
+// Sort time of 100K draws in random order, spread over 3 passes, 200 shader programs with 10 input layouts and
+// 2000 meshes, against std::stable_sort of the same keys. Program changes are counted in submission order, each
+// one costs the StateCache an input layout and shader rebind.
+int main()
+{
+    std::mt19937 rng(1);
+    std::vector<std::pair<RenderQueue::SortKey, RenderQueue::Draw>> draws;
+    for (size_t i = 0; i < draw_cnt; ++i)
+    {
+        uint32_t const program = rng() % program_cnt;
+        uint32_t const mesh = rng() % mesh_cnt;
+        uint32_t const depth_bucket = RenderQueue::computeDepthBucket(float(rng() % 1000), 0.0f, 1000.0f);
+
+        RenderQueue::Draw draw;
+        draw.program = reinterpret_cast<ShaderProgram*>(&program_placeholders[program]);
+        draw.mesh = reinterpret_cast<Mesh*>(&mesh_placeholders[mesh]);
+        draw.index_count = 3;
+        draw.user_data = uint32_t(i);
+        draws.push_back({ RenderQueue::makeKey(rng() % pass_cnt, program, program % 10, mesh, depth_bucket), draw });
+    }
+
+    RenderQueue queue;
+    auto fill = [&]() {
+        queue.beginFrame(0);
+        for (auto const& draw : draws)
+        {
+            queue.add(draw.first, draw.second);
+        }
+    };
+
+    fill();
+    size_t const unsorted_program_changes = countProgramChanges(queue);
+
+    ThreadPool thread_pool;
+    double const serial = dxowl_bench::measureWithSetup(fill, [&]() { queue.sort(); });
+    size_t const sorted_program_changes = countProgramChanges(queue);
+    size_t const radix_passes = queue.getCurrentFrameStatistics().radix_passes;
+    double const parallel = dxowl_bench::measureWithSetup(fill, [&]() { queue.sort(&thread_pool); });
+
+    std::vector<std::pair<RenderQueue::SortKey, uint32_t>> keys;
+    auto copy_keys = [&]() {
+        keys.clear();
+        for (auto const& draw : draws)
+        {
+            keys.push_back({ draw.first, draw.second.user_data });
+        }
+    };
+    double const stable_sort = dxowl_bench::measureWithSetup(copy_keys, [&]() {
+        std::stable_sort(keys.begin(), keys.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+    });
+
+    std::printf("%zu draws, %zu radix passes\n", draw_cnt, radix_passes);
+    std::printf("%-22s %8.2f ms\n", "radix sort", serial * 1e3);
+    std::printf("%-22s %8.2f ms (%zu threads)\n", "radix sort, parallel", parallel * 1e3, thread_pool.getThreadCount());
+    std::printf("%-22s %8.2f ms\n", "std::stable_sort", stable_sort * 1e3);
+    std::printf("program changes %zu unsorted, %zu sorted\n", unsorted_program_changes, sorted_program_changes);
+
+    return 0;
+}
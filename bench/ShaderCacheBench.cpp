@@ -0,0 +1,98 @@
+/// <copyright file="ShaderCacheBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dxowl/Hash.hpp>
+#include <dxowl/ShaderCache.hpp>
+
+#include "BenchTimer.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    size_t const shader_cnt = 1000;
+
+    /// Stand-in for shader bytecode: repeated instruction words with some noise, compresses like DXBC.
+    std::vector<uint8_t> makeBlob(size_t byte_size, std::mt19937& rng)
+    {
+        std::vector<uint8_t> retval(byte_size);
+        for (size_t i = 0; i < byte_size; ++i)
+        {
+            retval[i] = (i % 16 < 12) ? static_cast<uint8_t>(i % 16) : static_cast<uint8_t>(rng());
+        }
+        return retval;
+    }
+} // namespace
+
+// Time to open and read 1000 shaders of 1-16 KB, each from its own file and from a raw and an LZ4 shader
+// pack. Every blob is hashed after loading, so the mapped pages are touched. Files are in the OS cache
+// after the warm-up run, the numbers show the per-file overhead and decompression, not disk speed.
+int main()
+{
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "dxowl_shader_bench";
+    std::filesystem::create_directories(directory);
+
+    std::mt19937 rng(1);
+    ShaderCacheWriter writer;
+    std::vector<ShaderCache::Handle> handles;
+    std::vector<std::string> paths;
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < shader_cnt; ++i)
+    {
+        std::vector<uint8_t> const blob = makeBlob(1024 + rng() % (15 * 1024), rng);
+        handles.push_back(writer.add(blob));
+        paths.push_back((directory / ("shader" + std::to_string(i) + ".cso")).string());
+        std::ofstream file(paths.back(), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        total_bytes += blob.size();
+    }
+    std::string const raw_path = (directory / "raw.dxsp").string();
+    std::string const compressed_path = (directory / "compressed.dxsp").string();
+    writer.write(raw_path);
+    writer.write(compressed_path, true);
+
+    uint64_t checksum = 0;
+    double const separate = dxowl_bench::measure([&]() {
+        for (std::string const& path : paths)
+        {
+            std::ifstream file(path, std::ios::binary);
+            std::vector<uint8_t> const blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            checksum += hashBytes(blob.data(), blob.size());
+        }
+    });
+    auto loadPack = [&](std::string const& path) {
+        return dxowl_bench::measure([&]() {
+            ShaderCache cache(path);
+            for (ShaderCache::Handle handle : handles)
+            {
+                ShaderCache::Bytecode const bytecode = cache.getBytecode(handle);
+                checksum += hashBytes(bytecode.data, bytecode.byte_size);
+            }
+        });
+    };
+    double const raw = loadPack(raw_path);
+    double const compressed = loadPack(compressed_path);
+
+    std::printf("%zu shaders, %.1f MB bytecode\n", shader_cnt, total_bytes / 1e6);
+    std::printf("%-16s %9s %10s\n", "source", "MB", "load");
+    std::printf("%-16s %9.2f %7.2f ms\n", "separate files", total_bytes / 1e6, separate * 1e3);
+    std::printf("%-16s %9.2f %7.2f ms\n", "pack", std::filesystem::file_size(raw_path) / 1e6, raw * 1e3);
+    std::printf("%-16s %9.2f %7.2f ms\n", "pack, lz4", std::filesystem::file_size(compressed_path) / 1e6, compressed * 1e3);
+    std::printf("(checksum %llx)\n", static_cast<unsigned long long>(checksum));
+
+    std::filesystem::remove_all(directory);
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+/// <copyright file="StreamingRingBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdio>
+#include <vector>
+
+#include <dxowl/StreamingRing.hpp>
+
+#include "BenchTimer.hpp"
+#include "RecordingDevice.hpp"
+
+using namespace dxowl;
+
+// Upload throughput of a 4 MiB ring for a frame of 10K uploads, per upload size, on the recording device with
+// recording switched off. Map returns system memory, so this measures the ring bookkeeping and the copy, not a
+// driver. The discard column counts the wraps per frame.
+int main()
+{
+    size_t const ring_size = 4 << 20;
+    size_t const upload_cnt = 10000;
+
+    auto device = dxowl_test::createRecordingDevice();
+    dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+    ctx->record = false;
+
+    std::printf("%8s %10s %12s %10s %9s\n", "size", "frame", "per upload", "GB/s", "discards");
+
+    for (size_t upload_size : { 64, 256, 1024, 4096 })
+    {
+        StreamingRing ring(device.Get(), ring_size);
+        std::vector<uint8_t> const data(upload_size, 0x5a);
+        uint64_t frame = 0;
+
+        double const seconds = dxowl_bench::measure([&]() {
+            ring.beginFrame(++frame);
+            for (size_t i = 0; i < upload_cnt; ++i)
+            {
+                ring.upload(ctx, data);
+            }
+            ring.endFrame();
+        }, 21);
+
+        double const bytes = double(upload_size) * upload_cnt;
+        std::printf("%8zu %7.2f ms %9.1f ns %10.2f %9zu\n",
+            upload_size, seconds * 1e3, seconds * 1e9 / upload_cnt, bytes / seconds * 1e-9, ring.getLastFrameStatistics().discard_count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+/// <copyright file="TextureFileBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <dxowl/Texture2D.hpp>
+#include <dxowl/TextureFile.hpp>
+
+#include "BenchTimer.hpp"
+#include "RecordingDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    UINT const extent = 4096;
+    DXGI_FORMAT const format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    size_t const dds_header_byte_size = 4 + 124 + 20;
+
+    void put32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        uint8_t const* ptr = reinterpret_cast<uint8_t const*>(&value);
+        bytes.insert(bytes.end(), ptr, ptr + sizeof(value));
+    }
+
+    /// DDS with the DX10 header, a full mip chain and payload byte i set to i % 251.
+    std::string writeDDS()
+    {
+        std::vector<uint8_t> bytes = { 'D', 'D', 'S', ' ' };
+        put32(bytes, 124);
+        put32(bytes, 0x1007 | 0x20000);
+        put32(bytes, extent);
+        put32(bytes, extent);
+        put32(bytes, 0);
+        put32(bytes, 0);
+        put32(bytes, computeMipLevelCount(extent, extent));
+        for (int i = 0; i < 11; ++i)
+        {
+            put32(bytes, 0);
+        }
+        put32(bytes, 32);
+        put32(bytes, 0x4);
+        bytes.insert(bytes.end(), { 'D', 'X', '1', '0' });
+        for (int i = 0; i < 5; ++i)
+        {
+            put32(bytes, 0);
+        }
+        put32(bytes, 0x1000);
+        for (int i = 0; i < 4; ++i)
+        {
+            put32(bytes, 0);
+        }
+        put32(bytes, format);
+        put32(bytes, 3);
+        put32(bytes, 0);
+        put32(bytes, 1);
+        put32(bytes, 0);
+
+        size_t payload_byte_size = 0;
+        for (UINT mip = 0; mip < computeMipLevelCount(extent, extent); ++mip)
+        {
+            payload_byte_size += computeSlicePitch(format, computeMipExtent(extent, mip), computeMipExtent(extent, mip));
+        }
+        for (size_t i = 0; i < payload_byte_size; ++i)
+        {
+            bytes.push_back(uint8_t(i % 251));
+        }
+
+        std::string path = (std::filesystem::temp_directory_path() / "dxowl_bench.dds").string();
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+        return path;
+    }
+
+    /// Creates the texture from first_mip on, as a streamer does for a low resolution version.
+    void createTexture(ID3D11Device4* device, std::vector<void const*> const& subresources, UINT first_mip)
+    {
+        D3D11_TEXTURE2D_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Width = computeMipExtent(extent, first_mip);
+        desc.Height = computeMipExtent(extent, first_mip);
+        desc.MipLevels = static_cast<UINT>(subresources.size()) - first_mip;
+        desc.ArraySize = 1;
+        desc.Format = format;
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC view_desc;
+        ZeroMemory(&view_desc, sizeof(view_desc));
+        view_desc.Format = format;
+        view_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        view_desc.Texture2D.MipLevels = desc.MipLevels;
+
+        std::vector<void const*> const data(subresources.begin() + first_mip, subresources.end());
+        Texture2D texture(device, data, desc, view_desc);
+    }
+
+    /// Reads the whole file into memory and points the subresources into the copy.
+    void loadCopy(ID3D11Device4* device, std::string const& path, UINT first_mip)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+
+        TextureFile::Info const info = TextureFile::readInfo(bytes.data(), bytes.size(), bytes.size());
+        std::vector<void const*> subresources;
+        size_t offset = dds_header_byte_size;
+        for (UINT mip = 0; mip < info.mip_levels; ++mip)
+        {
+            subresources.push_back(bytes.data() + offset);
+            offset += computeSlicePitch(format, computeMipExtent(extent, mip), computeMipExtent(extent, mip));
+        }
+        createTexture(device, subresources, first_mip);
+    }
+
+    void loadMapped(ID3D11Device4* device, std::string const& path, UINT first_mip)
+    {
+        TextureFile file(path);
+        createTexture(device, file.getSubresourceData(), first_mip);
+    }
+
+    /// Peak resident set of a child process running load, minus that of a child doing nothing.
+    double peakResidentMiB(std::function<void()> const& load)
+    {
+        auto child_peak = [](std::function<void()> const& function) {
+            pid_t const pid = fork();
+            if (pid == 0)
+            {
+                function();
+                _exit(0);
+            }
+            int status = 0;
+            rusage usage = {};
+            wait4(pid, &status, 0, &usage);
+            return double(usage.ru_maxrss) / 1024.0; // KiB on Linux
+        };
+        return child_peak(load) - child_peak([]() {});
+    }
+} // namespace
+
+// Loads a 4096x4096 RGBA8 DDS with a full mip chain (85 MiB) from the page cache and creates the texture on
+// the recording device, which copies the texels like a driver does. "copy" reads the file into a vector
+// first, "mapped" uses TextureFile. The lower rows create only mips 1 and up, which a streamer uploads
+// first. Peak RSS is measured in a forked child per row and includes the device copy. Mapped pages count as
+// resident once the device has read them, so a full load peaks like the copy and saves the read; loads of
+// the smaller mips never touch the pages of mip 0. The last row validates the header without loading.
+int main()
+{
+    std::string const path = writeDDS();
+
+    auto device = dxowl_test::createRecordingDevice();
+    ID3D11Device4* d3d11_device = device.Get();
+
+    struct Row
+    {
+        char const* name;
+        std::function<void()> load;
+    };
+    std::vector<Row> const rows = {
+        { "copy", [&]() { loadCopy(d3d11_device, path, 0); } },
+        { "mapped", [&]() { loadMapped(d3d11_device, path, 0); } },
+        { "copy, from mip 1", [&]() { loadCopy(d3d11_device, path, 1); } },
+        { "mapped, from mip 1", [&]() { loadMapped(d3d11_device, path, 1); } },
+        { "probe", [&]() { TextureFile::Info info; TextureFile::probe(path, info); } },
+    };
+
+    std::printf("%-20s %12s %14s\n", "load", "time", "peak RSS");
+    for (auto const& row : rows)
+    {
+        double const seconds = dxowl_bench::measure(row.load);
+        double const resident = peakResidentMiB(row.load);
+        std::printf("%-20s %9.3f ms %10.1f MiB\n", row.name, seconds * 1e3, resident);
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/// <copyright file="VertexQuantizerBench.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <dxowl/VertexQuantizer.hpp>
+
+#include "BenchTimer.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    struct Vertex
+    {
+        float position[3];
+        float normal[3];
+        float tangent[4];
+        float tex_coord[2];
+        float color[4];
+    };
+
+    /// UV sphere of the given radius with (segments + 1)^2 vertices.
+    std::vector<Vertex> makeSphere(uint32_t segments, float radius)
+    {
+        std::vector<Vertex> retval;
+        for (uint32_t y = 0; y <= segments; ++y)
+        {
+            for (uint32_t x = 0; x <= segments; ++x)
+            {
+                float const u = x * 6.2831853f / segments;
+                float const v = y * 3.1415927f / segments;
+                float const n[3] = { std::cos(u) * std::sin(v), std::cos(v), std::sin(u) * std::sin(v) };
+
+                Vertex vertex;
+                for (int c = 0; c < 3; ++c)
+                {
+                    vertex.position[c] = n[c] * radius;
+                    vertex.normal[c] = n[c];
+                }
+                vertex.tangent[0] = -std::sin(u);
+                vertex.tangent[1] = 0.0f;
+                vertex.tangent[2] = std::cos(u);
+                vertex.tangent[3] = x % 2 == 0 ? 1.0f : -1.0f;
+                vertex.tex_coord[0] = float(x) / segments;
+                vertex.tex_coord[1] = float(y) / segments;
+                vertex.color[0] = 0.5f + 0.5f * n[0];
+                vertex.color[1] = 0.5f + 0.5f * n[1];
+                vertex.color[2] = 0.5f + 0.5f * n[2];
+                vertex.color[3] = 1.0f;
+                retval.push_back(vertex);
+            }
+        }
+        return retval;
+    }
+} // namespace
+
+// Quantizes a 1M vertex sphere with position, normal, tangent with handedness, tex coord and color, all 32 bit
+// float, for three radii. Prints the vertex size of the float and the quantized layout and the largest errors
+// the quantizer measured by decoding every vertex. The position error is relative to the bounding box, so it
+// grows with the radius. Also times quantize() without and with a thread pool.
+int main()
+{
+    VertexDescriptor const layout = { sizeof(Vertex),
+        {
+            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        } };
+
+    ThreadPool thread_pool;
+
+    std::printf("%8s %12s %12s %12s %12s %12s %12s %12s %12s\n",
+        "radius", "float B/vtx", "quant B/vtx", "position", "normal deg", "texcoord", "color", "quantize", "pool");
+    for (float radius : { 1.0f, 100.0f, 10000.0f })
+    {
+        std::vector<Vertex> const vertices = makeSphere(1023, radius);
+        std::vector<void const*> const data = { vertices.data() };
+
+        VertexQuantizer::QuantizedMesh mesh = VertexQuantizer::quantize({ layout }, data, vertices.size());
+        double const serial = dxowl_bench::measure([&]() { mesh = VertexQuantizer::quantize({ layout }, data, vertices.size()); });
+        double const parallel = dxowl_bench::measure([&]() { mesh = VertexQuantizer::quantize({ layout }, data, vertices.size(), &thread_pool); });
+
+        VertexQuantizer::Report const& report = mesh.getReport();
+        std::printf("%8.0f %12zu %12zu %12.2e %12.4f %12.2e %12.2e %9.2f ms %9.2f ms\n",
+            radius,
+            report.bytes_per_vertex_before,
+            report.bytes_per_vertex_after,
+            report.max_position_error,
+            report.max_normal_error_degrees,
+            report.max_texcoord_error,
+            report.max_color_error,
+            serial * 1e3,
+            parallel * 1e3);
+    }
+    std::printf("%zu vertices, pool: %zu threads\n", size_t(1024) * 1024, thread_pool.getThreadCount());
+
+    return 0;
+}
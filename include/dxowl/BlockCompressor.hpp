@@ -0,0 +1,1221 @@
+/// <copyright file="BlockCompressor.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef BlockCompressor_hpp
+#define BlockCompressor_hpp
+
+#include <dxgiformat.h>
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define DXOWL_BC_SSE
+#include <immintrin.h>
+#endif
+
+#include "FormatTraits.hpp"
+#include "MipGenerator.hpp" // UINT and the D3D11 descriptor types of CompressedTexture
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    namespace detail
+    {
+        // BC7 two subset partitions, bit i is the subset of texel i
+        static constexpr std::array<uint16_t, 64> bc7_partitions2 = { {
+            0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+            0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+            0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+            0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+            0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+            0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+            0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+            0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22 } };
+
+        // anchor texel of the second subset, the first subset is always anchored at texel 0
+        static constexpr std::array<uint8_t, 64> bc7_anchors2 = { {
+            15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+            15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+            15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+            6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15 } };
+
+        static constexpr std::array<uint8_t, 8> bc7_weights3 = { { 0, 9, 18, 27, 37, 46, 55, 64 } };
+        static constexpr std::array<uint8_t, 16> bc7_weights4 = { { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 } };
+
+        static constexpr bool validateBc7Partitions()
+        {
+            for (size_t p = 0; p < bc7_partitions2.size(); ++p)
+            {
+                if ((bc7_partitions2[p] & 1) != 0 || ((bc7_partitions2[p] >> bc7_anchors2[p]) & 1) != 1)
+                    return false;
+            }
+            return true;
+        }
+
+        static_assert(validateBc7Partitions(), "BC7 partition and anchor tables are inconsistent");
+    } // namespace detail
+
+    /// CPU encoder for BC1, BC3, BC4, BC5 and BC7 textures. Sources are 8 bit UNORM (R, RG, RGBA or BGRA)
+    /// subresources laid out like the input of Texture2D; the output can be passed to the same constructor
+    /// together with getTextureDesc(). Blocks are encoded in parallel if a thread pool is given.
+    /// Values are compressed as stored, pair _SRGB sources with _SRGB targets.
+    class BlockCompressor
+    {
+    public:
+        enum class Preset
+        {
+            Fast,   // principal axis endpoints, BC7 mode 6 only
+            Normal, // plus least squares endpoint refinement and BC4 six value mode
+            High    // plus exhaustive p-bit and BC4 endpoint search, BC7 mode 1 for opaque blocks
+        };
+
+        class CompressedTexture
+        {
+        public:
+            DXGI_FORMAT getFormat() const { return m_format; }
+            UINT getWidth() const { return m_width; }
+            UINT getHeight() const { return m_height; }
+            UINT getMipLevels() const { return m_mip_levels; }
+            UINT getArraySize() const { return m_array_size; }
+
+            /// Pointers to all subresources, subresource i holds mip level (i % mip_levels) of array slice (i / mip_levels).
+            std::vector<void const*> getSubresourceData() const;
+
+            /// Immutable shader resource texture matching the compressed data.
+            D3D11_TEXTURE2D_DESC getTextureDesc() const;
+            D3D11_SHADER_RESOURCE_VIEW_DESC getShaderResourceViewDesc() const;
+
+        private:
+            friend class BlockCompressor;
+
+            DXGI_FORMAT m_format = DXGI_FORMAT_UNKNOWN;
+            UINT m_width = 0;
+            UINT m_height = 0;
+            UINT m_mip_levels = 0;
+            UINT m_array_size = 0;
+            std::vector<std::vector<uint8_t>> m_subresources;
+        };
+
+        static bool isSupportedSource(DXGI_FORMAT format);
+        static bool isSupportedTarget(DXGI_FORMAT format);
+
+        /// Level 0 width and height must be multiples of 4, smaller mip levels are padded to full blocks.
+        static CompressedTexture compress(
+            DXGI_FORMAT src_format,
+            UINT width,
+            UINT height,
+            UINT mip_levels,
+            UINT array_size,
+            std::vector<void const*> const& subresources,
+            DXGI_FORMAT dst_format,
+            Preset preset = Preset::Normal,
+            ThreadPool* thread_pool = nullptr);
+
+        static CompressedTexture compress(
+            MipGenerator::MipChain const& mip_chain,
+            DXGI_FORMAT dst_format,
+            Preset preset = Preset::Normal,
+            ThreadPool* thread_pool = nullptr);
+
+    private:
+        // 4x4 texels as planar RGBA floats in [0,255]
+        struct Block
+        {
+            alignas(16) float channels[4][16];
+        };
+
+        struct BitWriter
+        {
+            uint8_t* data;
+            UINT position;
+
+            void write(uint32_t value, UINT bit_cnt);
+        };
+
+        static void loadBlock(
+            DXGI_FORMAT src_format,
+            uint8_t const* src,
+            size_t row_pitch,
+            UINT width,
+            UINT height,
+            UINT block_x,
+            UINT block_y,
+            Block& block);
+
+        static void encodeBlock(DXGI_FORMAT dst_format, Block const& block, Preset preset, uint8_t* dst);
+
+        /// BC1 supports 1 bit alpha via three color mode, the color block of BC3 always decodes as four color mode.
+        static void encodeBc1(Block const& block, bool bc1, Preset preset, uint8_t* dst);
+        static void encodeBc4(Block const& block, UINT channel, Preset preset, uint8_t* dst);
+        static void encodeBc7(Block const& block, Preset preset, uint8_t* dst);
+        static float encodeBc7Mode6(Block const& block, Preset preset, uint8_t* dst);
+        static float encodeBc7Mode1(Block const& block, Preset preset, uint8_t* dst);
+
+        /// Picks the closest palette entry for every texel, returns the summed squared error of the texels in mask.
+        /// Palette channel 0 corresponds to block channel first_channel.
+        static float fitIndices(
+            Block const& block,
+            UINT first_channel,
+            UINT channel_cnt,
+            float const (*palette)[4],
+            UINT palette_size,
+            uint16_t mask,
+            uint8_t* indices);
+
+        static void computeEndpoints(
+            Block const& block,
+            UINT channel_cnt,
+            uint16_t mask,
+            float (&endpoints)[2][4]);
+
+        /// Least squares endpoints for fixed indices, weights[i] is the fraction of endpoint 1 of palette entry i.
+        static bool refineEndpoints(
+            Block const& block,
+            UINT channel_cnt,
+            uint16_t mask,
+            uint8_t const* indices,
+            float const* weights,
+            float (&endpoints)[2][4]);
+
+        static uint16_t quantizeRgb565(float const* color);
+        static void expandRgb565(uint16_t value, float* color);
+    };
+
+    inline std::vector<void const*> BlockCompressor::CompressedTexture::getSubresourceData() const
+    {
+        std::vector<void const*> retval;
+        retval.reserve(m_subresources.size());
+        for (auto const& subresource : m_subresources)
+        {
+            retval.push_back(subresource.data());
+        }
+        return retval;
+    }
+
+    inline D3D11_TEXTURE2D_DESC BlockCompressor::CompressedTexture::getTextureDesc() const
+    {
+        D3D11_TEXTURE2D_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Width = m_width;
+        desc.Height = m_height;
+        desc.MipLevels = m_mip_levels;
+        desc.ArraySize = m_array_size;
+        desc.Format = m_format;
+        desc.SampleDesc.Count = 1;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        return desc;
+    }
+
+    inline D3D11_SHADER_RESOURCE_VIEW_DESC BlockCompressor::CompressedTexture::getShaderResourceViewDesc() const
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Format = m_format;
+        if (m_array_size > 1)
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MostDetailedMip = 0;
+            desc.Texture2DArray.MipLevels = m_mip_levels;
+            desc.Texture2DArray.FirstArraySlice = 0;
+            desc.Texture2DArray.ArraySize = m_array_size;
+        }
+        else
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MostDetailedMip = 0;
+            desc.Texture2D.MipLevels = m_mip_levels;
+        }
+        return desc;
+    }
+
+    inline bool BlockCompressor::isSupportedSource(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline bool BlockCompressor::isSupportedTarget(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+        case DXGI_FORMAT_BC4_UNORM:
+        case DXGI_FORMAT_BC5_UNORM:
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline BlockCompressor::CompressedTexture BlockCompressor::compress(
+        DXGI_FORMAT src_format,
+        UINT width,
+        UINT height,
+        UINT mip_levels,
+        UINT array_size,
+        std::vector<void const*> const& subresources,
+        DXGI_FORMAT dst_format,
+        Preset preset,
+        ThreadPool* thread_pool)
+    {
+        if (!isSupportedSource(src_format) || !isSupportedTarget(dst_format))
+        {
+            throw std::invalid_argument("BlockCompressor: unsupported format");
+        }
+        if (width == 0 || height == 0 || width % 4 != 0 || height % 4 != 0)
+        {
+            throw std::invalid_argument("BlockCompressor: level 0 size must be a multiple of 4");
+        }
+        if (mip_levels == 0 || array_size == 0 || subresources.size() != size_t(mip_levels) * array_size)
+        {
+            throw std::invalid_argument("BlockCompressor: subresource count does not match mip levels and array size");
+        }
+
+        CompressedTexture retval;
+        retval.m_format = dst_format;
+        retval.m_width = width;
+        retval.m_height = height;
+        retval.m_mip_levels = mip_levels;
+        retval.m_array_size = array_size;
+        retval.m_subresources.resize(subresources.size());
+
+        // one job per row of blocks, over all subresources
+        std::vector<std::pair<size_t, UINT>> jobs;
+
+        for (size_t i = 0; i < subresources.size(); ++i)
+        {
+            UINT const mip_level = static_cast<UINT>(i % mip_levels);
+            UINT const mip_width = computeMipExtent(width, mip_level);
+            UINT const mip_height = computeMipExtent(height, mip_level);
+
+            retval.m_subresources[i].resize(computeSubresourceByteSize(dst_format, mip_width, mip_height));
+
+            for (UINT block_row = 0; block_row < (mip_height + 3) / 4; ++block_row)
+            {
+                jobs.emplace_back(i, block_row);
+            }
+        }
+
+        auto encodeRow = [&](size_t job_idx) {
+            size_t const subresource = jobs[job_idx].first;
+            UINT const block_row = jobs[job_idx].second;
+            UINT const mip_level = static_cast<UINT>(subresource % mip_levels);
+            UINT const mip_width = computeMipExtent(width, mip_level);
+            UINT const mip_height = computeMipExtent(height, mip_level);
+
+            size_t const src_row_pitch = computeRowPitch(src_format, mip_width);
+            size_t const dst_row_pitch = computeRowPitch(dst_format, mip_width);
+            size_t const block_size = getFormatTraits(dst_format).bytes_per_block;
+
+            auto src = static_cast<uint8_t const*>(subresources[subresource]);
+            uint8_t* dst = retval.m_subresources[subresource].data() + dst_row_pitch * block_row;
+
+            Block block;
+            for (UINT block_x = 0; block_x < (mip_width + 3) / 4; ++block_x)
+            {
+                loadBlock(src_format, src, src_row_pitch, mip_width, mip_height, block_x, block_row, block);
+                encodeBlock(dst_format, block, preset, dst + block_size * block_x);
+            }
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, jobs.size(), encodeRow);
+        }
+        else
+        {
+            for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx)
+            {
+                encodeRow(job_idx);
+            }
+        }
+
+        return retval;
+    }
+
+    inline BlockCompressor::CompressedTexture BlockCompressor::compress(
+        MipGenerator::MipChain const& mip_chain,
+        DXGI_FORMAT dst_format,
+        Preset preset,
+        ThreadPool* thread_pool)
+    {
+        return compress(
+            mip_chain.getFormat(),
+            mip_chain.getWidth(),
+            mip_chain.getHeight(),
+            mip_chain.getMipLevels(),
+            mip_chain.getArraySize(),
+            mip_chain.getSubresourceData(),
+            dst_format,
+            preset,
+            thread_pool);
+    }
+
+    inline void BlockCompressor::BitWriter::write(uint32_t value, UINT bit_cnt)
+    {
+        for (UINT i = 0; i < bit_cnt; ++i, ++position)
+        {
+            data[position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (position & 7));
+        }
+    }
+
+    inline void BlockCompressor::loadBlock(
+        DXGI_FORMAT src_format,
+        uint8_t const* src,
+        size_t row_pitch,
+        UINT width,
+        UINT height,
+        UINT block_x,
+        UINT block_y,
+        Block& block)
+    {
+        UINT const channel_cnt = getFormatTraits(src_format).channel_count;
+        bool const bgra = src_format == DXGI_FORMAT_B8G8R8A8_UNORM || src_format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+
+        for (UINT i = 0; i < 16; ++i)
+        {
+            // replicate edge texels into the padding of partial blocks
+            UINT const x = (std::min)(block_x * 4 + (i & 3), width - 1);
+            UINT const y = (std::min)(block_y * 4 + (i >> 2), height - 1);
+            uint8_t const* texel = src + row_pitch * y + size_t(x) * channel_cnt;
+
+            block.channels[0][i] = texel[bgra ? 2 : 0];
+            block.channels[1][i] = channel_cnt > 1 ? texel[1] : 0.0f;
+            block.channels[2][i] = channel_cnt > 2 ? texel[bgra ? 0 : 2] : 0.0f;
+            block.channels[3][i] = channel_cnt > 3 ? texel[3] : 255.0f;
+        }
+    }
+
+    inline void BlockCompressor::encodeBlock(DXGI_FORMAT dst_format, Block const& block, Preset preset, uint8_t* dst)
+    {
+        switch (dst_format)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+            encodeBc1(block, true, preset, dst);
+            break;
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            encodeBc4(block, 3, preset, dst);
+            encodeBc1(block, false, preset, dst + 8);
+            break;
+        case DXGI_FORMAT_BC4_UNORM:
+            encodeBc4(block, 0, preset, dst);
+            break;
+        case DXGI_FORMAT_BC5_UNORM:
+            encodeBc4(block, 0, preset, dst);
+            encodeBc4(block, 1, preset, dst + 8);
+            break;
+        default:
+            encodeBc7(block, preset, dst);
+            break;
+        }
+    }
+
+    inline void BlockCompressor::encodeBc1(Block const& block, bool bc1, Preset preset, uint8_t* dst)
+    {
+        uint16_t opaque = 0xffff;
+        if (bc1)
+        {
+            for (UINT i = 0; i < 16; ++i)
+            {
+                if (block.channels[3][i] < 128.0f)
+                    opaque &= static_cast<uint16_t>(~(1u << i));
+            }
+        }
+
+        uint16_t color[2] = { 0, 0 };
+        uint8_t indices[16] = {};
+        bool three_color = opaque != 0xffff;
+
+        if (opaque != 0)
+        {
+            float endpoints[2][4];
+            computeEndpoints(block, 3, opaque, endpoints);
+
+            int const iterations = preset == Preset::Fast ? 0 : (preset == Preset::Normal ? 2 : 4);
+            float best_error = FLT_MAX;
+
+            // four color mode needs c0 > c1 and cannot represent transparency, three color mode needs c0 <= c1
+            for (int mode = three_color ? 3 : 4; mode >= 3; --mode)
+            {
+                float const weights4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+                float const weights3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+                float const* weights = mode == 4 ? weights4 : weights3;
+
+                float mode_endpoints[2][4];
+                std::memcpy(mode_endpoints, endpoints, sizeof(endpoints));
+
+                for (int iteration = 0; iteration <= iterations; ++iteration)
+                {
+                    uint16_t c[2] = { quantizeRgb565(mode_endpoints[0]), quantizeRgb565(mode_endpoints[1]) };
+                    if ((mode == 4 && c[0] < c[1]) || (mode == 3 && c[0] > c[1]))
+                    {
+                        std::swap(c[0], c[1]);
+                    }
+
+                    float palette[4][4];
+                    expandRgb565(c[0], palette[0]);
+                    expandRgb565(c[1], palette[1]);
+                    for (UINT ch = 0; ch < 3; ++ch)
+                    {
+                        palette[2][ch] = palette[0][ch] + (palette[1][ch] - palette[0][ch]) * weights[2];
+                        palette[3][ch] = palette[0][ch] + (palette[1][ch] - palette[0][ch]) * weights[3];
+                    }
+
+                    uint8_t candidate[16];
+                    // in three color mode, index 3 is transparent black and only used for transparent texels
+                    float error = fitIndices(block, 0, 3, palette, mode == 4 ? 4 : 3, opaque, candidate);
+
+                    if (mode == 4 && c[0] == c[1])
+                    {
+                        // equal endpoints decode as three color mode, where index 3 is black
+                        std::fill(candidate, candidate + 16, uint8_t(0));
+                    }
+
+                    if (error < best_error)
+                    {
+                        best_error = error;
+                        color[0] = c[0];
+                        color[1] = c[1];
+                        std::memcpy(indices, candidate, 16);
+                        three_color = mode == 3;
+                    }
+
+                    if (iteration == iterations || !refineEndpoints(block, 3, opaque, candidate, weights, mode_endpoints))
+                    {
+                        break;
+                    }
+                }
+
+                // without transparent texels, three color mode is only worth a try at the highest preset
+                if (!bc1 || preset != Preset::High)
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            three_color = true;
+        }
+
+        uint32_t index_bits = 0;
+        for (UINT i = 0; i < 16; ++i)
+        {
+            uint32_t index = (opaque >> i) & 1 ? indices[i] : 3;
+            index_bits |= index << (2 * i);
+        }
+
+        if (!three_color && color[0] == color[1])
+        {
+            index_bits = 0;
+        }
+
+        std::memcpy(dst, &color[0], 2);
+        std::memcpy(dst + 2, &color[1], 2);
+        std::memcpy(dst + 4, &index_bits, 4);
+    }
+
+    inline void BlockCompressor::encodeBc4(Block const& block, UINT channel, Preset preset, uint8_t* dst)
+    {
+        float const* values = block.channels[channel];
+
+        float min_value = 255.0f;
+        float max_value = 0.0f;
+        float min_inner = 255.0f; // extremes excluding 0 and 255, which six value mode encodes explicitly
+        float max_inner = 0.0f;
+        for (UINT i = 0; i < 16; ++i)
+        {
+            min_value = (std::min)(min_value, values[i]);
+            max_value = (std::max)(max_value, values[i]);
+            if (values[i] > 0.0f && values[i] < 255.0f)
+            {
+                min_inner = (std::min)(min_inner, values[i]);
+                max_inner = (std::max)(max_inner, values[i]);
+            }
+        }
+
+        auto evaluate = [&](int a0, int a1, uint8_t* indices) -> float {
+            float palette[8][4] = {};
+            palette[0][0] = static_cast<float>(a0);
+            palette[1][0] = static_cast<float>(a1);
+            if (a0 > a1)
+            {
+                for (int i = 1; i < 7; ++i)
+                    palette[i + 1][0] = static_cast<float>((7 - i) * a0 + i * a1) / 7.0f;
+            }
+            else
+            {
+                for (int i = 1; i < 5; ++i)
+                    palette[i + 1][0] = static_cast<float>((5 - i) * a0 + i * a1) / 5.0f;
+                palette[6][0] = 0.0f;
+                palette[7][0] = 255.0f;
+            }
+            return fitIndices(block, channel, 1, palette, 8, 0xffff, indices);
+        };
+
+        int best_a0 = static_cast<int>(max_value + 0.5f);
+        int best_a1 = static_cast<int>(min_value + 0.5f);
+        uint8_t best_indices[16] = {};
+        float best_error = FLT_MAX;
+
+        if (best_a0 == best_a1)
+        {
+            best_error = 0.0f;
+        }
+        else
+        {
+            best_error = evaluate(best_a0, best_a1, best_indices);
+
+            if (preset != Preset::Fast && min_inner <= max_inner)
+            {
+                int const a0 = static_cast<int>(min_inner + 0.5f);
+                int const a1 = static_cast<int>(max_inner + 0.5f);
+                uint8_t indices[16];
+                float error = evaluate(a0, a1, indices);
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_a0 = a0;
+                    best_a1 = a1;
+                    std::memcpy(best_indices, indices, 16);
+                }
+            }
+
+            if (preset == Preset::High)
+            {
+                // local search around the best endpoints, keeping the mode
+                int const center0 = best_a0;
+                int const center1 = best_a1;
+                bool const eight_values = center0 > center1;
+
+                for (int d0 = -2; d0 <= 2; ++d0)
+                {
+                    for (int d1 = -2; d1 <= 2; ++d1)
+                    {
+                        int const a0 = (std::min)((std::max)(center0 + d0, 0), 255);
+                        int const a1 = (std::min)((std::max)(center1 + d1, 0), 255);
+                        if ((a0 > a1) != eight_values)
+                            continue;
+
+                        uint8_t indices[16];
+                        float error = evaluate(a0, a1, indices);
+                        if (error < best_error)
+                        {
+                            best_error = error;
+                            best_a0 = a0;
+                            best_a1 = a1;
+                            std::memcpy(best_indices, indices, 16);
+                        }
+                    }
+                }
+            }
+        }
+
+        uint64_t index_bits = 0;
+        for (UINT i = 0; i < 16; ++i)
+        {
+            index_bits |= static_cast<uint64_t>(best_indices[i]) << (3 * i);
+        }
+
+        dst[0] = static_cast<uint8_t>(best_a0);
+        dst[1] = static_cast<uint8_t>(best_a1);
+        for (UINT i = 0; i < 6; ++i)
+        {
+            dst[2 + i] = static_cast<uint8_t>(index_bits >> (8 * i));
+        }
+    }
+
+    inline void BlockCompressor::encodeBc7(Block const& block, Preset preset, uint8_t* dst)
+    {
+        float const error = encodeBc7Mode6(block, preset, dst);
+
+        if (preset != Preset::High || error == 0.0f)
+        {
+            return;
+        }
+
+        // mode 1 has no alpha channel, but two subsets with 3 bit indices
+        for (UINT i = 0; i < 16; ++i)
+        {
+            if (block.channels[3][i] != 255.0f)
+                return;
+        }
+
+        uint8_t candidate[16];
+        if (encodeBc7Mode1(block, preset, candidate) < error)
+        {
+            std::memcpy(dst, candidate, 16);
+        }
+    }
+
+    inline float BlockCompressor::encodeBc7Mode6(Block const& block, Preset preset, uint8_t* dst)
+    {
+        float weights[16];
+        for (UINT i = 0; i < 16; ++i)
+        {
+            weights[i] = static_cast<float>(detail::bc7_weights4[i]) / 64.0f;
+        }
+
+        float endpoints[2][4];
+        computeEndpoints(block, 4, 0xffff, endpoints);
+
+        int const iterations = preset == Preset::Fast ? 0 : (preset == Preset::Normal ? 2 : 4);
+
+        float best_error = FLT_MAX;
+        uint8_t best_quantized[2][4] = {};
+        uint8_t best_pbits[2] = {};
+        uint8_t best_indices[16] = {};
+
+        for (int iteration = 0; iteration <= iterations; ++iteration)
+        {
+            // 7 bit endpoints with a p-bit each, either chosen per endpoint or searched exhaustively
+            int const pbit_combinations = preset == Preset::High ? 4 : 1;
+
+            for (int combination = 0; combination < pbit_combinations; ++combination)
+            {
+                uint8_t quantized[2][4];
+                uint8_t pbits[2];
+                float palette[16][4];
+
+                for (UINT e = 0; e < 2; ++e)
+                {
+                    float best_pbit_error = FLT_MAX;
+                    for (int p = 0; p < 2; ++p)
+                    {
+                        if (pbit_combinations > 1 && p != ((combination >> e) & 1))
+                            continue;
+
+                        float pbit_error = 0.0f;
+                        uint8_t q[4];
+                        for (UINT ch = 0; ch < 4; ++ch)
+                        {
+                            float const value = (std::min)((std::max)(endpoints[e][ch], 0.0f), 255.0f);
+                            int c = static_cast<int>(std::floor((value - p) * 0.5f + 0.5f));
+                            c = (std::min)((std::max)(c, 0), 127);
+                            q[ch] = static_cast<uint8_t>(c);
+                            float const diff = static_cast<float>((c << 1) | p) - value;
+                            pbit_error += diff * diff;
+                        }
+                        if (pbit_error < best_pbit_error)
+                        {
+                            best_pbit_error = pbit_error;
+                            std::memcpy(quantized[e], q, 4);
+                            pbits[e] = static_cast<uint8_t>(p);
+                        }
+                    }
+                }
+
+                for (UINT i = 0; i < 16; ++i)
+                {
+                    for (UINT ch = 0; ch < 4; ++ch)
+                    {
+                        int const e0 = (quantized[0][ch] << 1) | pbits[0];
+                        int const e1 = (quantized[1][ch] << 1) | pbits[1];
+                        palette[i][ch] = static_cast<float>(((64 - detail::bc7_weights4[i]) * e0 + detail::bc7_weights4[i] * e1 + 32) >> 6);
+                    }
+                }
+
+                uint8_t indices[16];
+                float error = fitIndices(block, 0, 4, palette, 16, 0xffff, indices);
+
+                if (error < best_error)
+                {
+                    best_error = error;
+                    std::memcpy(best_quantized, quantized, sizeof(quantized));
+                    std::memcpy(best_pbits, pbits, sizeof(pbits));
+                    std::memcpy(best_indices, indices, 16);
+                }
+            }
+
+            if (iteration == iterations || !refineEndpoints(block, 4, 0xffff, best_indices, weights, endpoints))
+            {
+                break;
+            }
+        }
+
+        // the anchor index is stored without its most significant bit
+        if (best_indices[0] >= 8)
+        {
+            std::swap(best_quantized[0], best_quantized[1]);
+            std::swap(best_pbits[0], best_pbits[1]);
+            for (UINT i = 0; i < 16; ++i)
+            {
+                best_indices[i] = static_cast<uint8_t>(15 - best_indices[i]);
+            }
+        }
+
+        std::memset(dst, 0, 16);
+        BitWriter writer = { dst, 0 };
+        writer.write(1u << 6, 7);
+        for (UINT ch = 0; ch < 4; ++ch)
+        {
+            writer.write(best_quantized[0][ch], 7);
+            writer.write(best_quantized[1][ch], 7);
+        }
+        writer.write(best_pbits[0], 1);
+        writer.write(best_pbits[1], 1);
+        for (UINT i = 0; i < 16; ++i)
+        {
+            writer.write(best_indices[i], i == 0 ? 3 : 4);
+        }
+
+        return best_error;
+    }
+
+    inline float BlockCompressor::encodeBc7Mode1(Block const& block, Preset preset, uint8_t* dst)
+    {
+        // rank partitions by the residual of a line fit per subset, then fully encode the best candidates
+        constexpr UINT candidate_cnt = 4;
+        std::array<std::pair<float, UINT>, 64> ranking;
+
+        for (UINT partition = 0; partition < 64; ++partition)
+        {
+            float residual = 0.0f;
+
+            for (UINT subset = 0; subset < 2; ++subset)
+            {
+                uint16_t const mask = static_cast<uint16_t>(subset == 0 ? ~detail::bc7_partitions2[partition] : detail::bc7_partitions2[partition]);
+
+                float endpoints[2][4];
+                computeEndpoints(block, 3, mask, endpoints);
+
+                float axis[3];
+                float length_sq = 0.0f;
+                for (UINT ch = 0; ch < 3; ++ch)
+                {
+                    axis[ch] = endpoints[1][ch] - endpoints[0][ch];
+                    length_sq += axis[ch] * axis[ch];
+                }
+
+                for (UINT i = 0; i < 16; ++i)
+                {
+                    if (((mask >> i) & 1) == 0)
+                        continue;
+
+                    float offset[3];
+                    float dot = 0.0f;
+                    float dist_sq = 0.0f;
+                    for (UINT ch = 0; ch < 3; ++ch)
+                    {
+                        offset[ch] = block.channels[ch][i] - endpoints[0][ch];
+                        dot += offset[ch] * axis[ch];
+                        dist_sq += offset[ch] * offset[ch];
+                    }
+                    residual += length_sq > 0.0f ? dist_sq - dot * dot / length_sq : dist_sq;
+                }
+            }
+
+            ranking[partition] = { residual, partition };
+        }
+
+        std::partial_sort(ranking.begin(), ranking.begin() + candidate_cnt, ranking.end());
+
+        float weights[8];
+        for (UINT i = 0; i < 8; ++i)
+        {
+            weights[i] = static_cast<float>(detail::bc7_weights3[i]) / 64.0f;
+        }
+
+        float best_error = FLT_MAX;
+        UINT best_partition = 0;
+        uint8_t best_quantized[2][2][3] = {}; // subset, endpoint, channel
+        uint8_t best_pbits[2] = {};
+        uint8_t best_indices[16] = {};
+
+        for (UINT candidate = 0; candidate < candidate_cnt; ++candidate)
+        {
+            UINT const partition = ranking[candidate].second;
+            float error = 0.0f;
+            uint8_t quantized[2][2][3];
+            uint8_t pbits[2];
+            uint8_t indices[16] = {};
+
+            for (UINT subset = 0; subset < 2; ++subset)
+            {
+                uint16_t const mask = static_cast<uint16_t>(subset == 0 ? ~detail::bc7_partitions2[partition] : detail::bc7_partitions2[partition]);
+
+                float endpoints[2][4];
+                computeEndpoints(block, 3, mask, endpoints);
+
+                float subset_error = FLT_MAX;
+                int const iterations = preset == Preset::High ? 2 : 0;
+
+                for (int iteration = 0; iteration <= iterations; ++iteration)
+                {
+                    // the p-bit is shared by both endpoints of a subset
+                    for (int p = 0; p < 2; ++p)
+                    {
+                        uint8_t q[2][3];
+                        int expanded[2][3];
+                        for (UINT e = 0; e < 2; ++e)
+                        {
+                            for (UINT ch = 0; ch < 3; ++ch)
+                            {
+                                float const value = (std::min)((std::max)(endpoints[e][ch], 0.0f), 255.0f);
+                                int best_c = 0;
+                                int best_diff = INT32_MAX;
+                                int const guess = static_cast<int>(value * 127.0f / 255.0f - p) / 2;
+                                for (int c = (std::max)(guess - 1, 0); c <= (std::min)(guess + 2, 63); ++c)
+                                {
+                                    int const v7 = (c << 1) | p;
+                                    int const v8 = (v7 << 1) | (v7 >> 6);
+                                    int const diff = std::abs(v8 - static_cast<int>(value + 0.5f));
+                                    if (diff < best_diff)
+                                    {
+                                        best_diff = diff;
+                                        best_c = c;
+                                    }
+                                }
+                                q[e][ch] = static_cast<uint8_t>(best_c);
+                                int const v7 = (best_c << 1) | p;
+                                expanded[e][ch] = (v7 << 1) | (v7 >> 6);
+                            }
+                        }
+
+                        float palette[8][4] = {};
+                        for (UINT i = 0; i < 8; ++i)
+                        {
+                            for (UINT ch = 0; ch < 3; ++ch)
+                            {
+                                palette[i][ch] = static_cast<float>(((64 - detail::bc7_weights3[i]) * expanded[0][ch] + detail::bc7_weights3[i] * expanded[1][ch] + 32) >> 6);
+                            }
+                        }
+
+                        uint8_t subset_indices[16];
+                        float candidate_error = fitIndices(block, 0, 3, palette, 8, mask, subset_indices);
+
+                        if (candidate_error < subset_error)
+                        {
+                            subset_error = candidate_error;
+                            std::memcpy(quantized[subset], q, sizeof(q));
+                            pbits[subset] = static_cast<uint8_t>(p);
+                            for (UINT i = 0; i < 16; ++i)
+                            {
+                                if ((mask >> i) & 1)
+                                    indices[i] = subset_indices[i];
+                            }
+                        }
+                    }
+
+                    if (iteration == iterations || !refineEndpoints(block, 3, mask, indices, weights, endpoints))
+                    {
+                        break;
+                    }
+                }
+
+                error += subset_error;
+            }
+
+            if (error < best_error)
+            {
+                best_error = error;
+                best_partition = partition;
+                std::memcpy(best_quantized, quantized, sizeof(quantized));
+                std::memcpy(best_pbits, pbits, sizeof(pbits));
+                std::memcpy(best_indices, indices, 16);
+            }
+        }
+
+        // anchor indices are stored without their most significant bit
+        UINT const anchors[2] = { 0, detail::bc7_anchors2[best_partition] };
+        for (UINT subset = 0; subset < 2; ++subset)
+        {
+            if (best_indices[anchors[subset]] < 4)
+                continue;
+
+            std::swap(best_quantized[subset][0], best_quantized[subset][1]);
+            for (UINT i = 0; i < 16; ++i)
+            {
+                if (((detail::bc7_partitions2[best_partition] >> i) & 1) == subset)
+                    best_indices[i] = static_cast<uint8_t>(7 - best_indices[i]);
+            }
+        }
+
+        std::memset(dst, 0, 16);
+        BitWriter writer = { dst, 0 };
+        writer.write(1u << 1, 2);
+        writer.write(best_partition, 6);
+        for (UINT ch = 0; ch < 3; ++ch)
+        {
+            for (UINT subset = 0; subset < 2; ++subset)
+            {
+                writer.write(best_quantized[subset][0][ch], 6);
+                writer.write(best_quantized[subset][1][ch], 6);
+            }
+        }
+        writer.write(best_pbits[0], 1);
+        writer.write(best_pbits[1], 1);
+        for (UINT i = 0; i < 16; ++i)
+        {
+            writer.write(best_indices[i], (i == anchors[0] || i == anchors[1]) ? 2 : 3);
+        }
+
+        return best_error;
+    }
+
+    inline float BlockCompressor::fitIndices(
+        Block const& block,
+        UINT first_channel,
+        UINT channel_cnt,
+        float const (*palette)[4],
+        UINT palette_size,
+        uint16_t mask,
+        uint8_t* indices)
+    {
+        float error = 0.0f;
+
+#ifdef DXOWL_BC_SSE
+        // four texels per iteration, distances to every palette entry
+        for (UINT i = 0; i < 16; i += 4)
+        {
+            __m128 best_distance = _mm_set1_ps(FLT_MAX);
+            __m128 best_index = _mm_setzero_ps();
+
+            for (UINT p = 0; p < palette_size; ++p)
+            {
+                __m128 distance = _mm_setzero_ps();
+                for (UINT ch = 0; ch < channel_cnt; ++ch)
+                {
+                    __m128 diff = _mm_sub_ps(_mm_load_ps(block.channels[first_channel + ch] + i), _mm_set1_ps(palette[p][ch]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(diff, diff));
+                }
+
+                __m128 closer = _mm_cmplt_ps(distance, best_distance);
+                best_distance = _mm_min_ps(distance, best_distance);
+                best_index = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(p))), _mm_andnot_ps(closer, best_index));
+            }
+
+            alignas(16) float distances[4];
+            alignas(16) float texel_indices[4];
+            _mm_store_ps(distances, best_distance);
+            _mm_store_ps(texel_indices, best_index);
+
+            for (UINT j = 0; j < 4; ++j)
+            {
+                indices[i + j] = static_cast<uint8_t>(texel_indices[j]);
+                if ((mask >> (i + j)) & 1)
+                    error += distances[j];
+            }
+        }
+#else
+        for (UINT i = 0; i < 16; ++i)
+        {
+            float best_distance = FLT_MAX;
+            uint8_t best_index = 0;
+
+            for (UINT p = 0; p < palette_size; ++p)
+            {
+                float distance = 0.0f;
+                for (UINT ch = 0; ch < channel_cnt; ++ch)
+                {
+                    float const diff = block.channels[first_channel + ch][i] - palette[p][ch];
+                    distance += diff * diff;
+                }
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best_index = static_cast<uint8_t>(p);
+                }
+            }
+
+            indices[i] = best_index;
+            if ((mask >> i) & 1)
+                error += best_distance;
+        }
+#endif
+
+        return error;
+    }
+
+    inline void BlockCompressor::computeEndpoints(
+        Block const& block,
+        UINT channel_cnt,
+        uint16_t mask,
+        float (&endpoints)[2][4])
+    {
+        float mean[4] = {};
+        float texel_cnt = 0.0f;
+        for (UINT i = 0; i < 16; ++i)
+        {
+            if (((mask >> i) & 1) == 0)
+                continue;
+            for (UINT ch = 0; ch < channel_cnt; ++ch)
+                mean[ch] += block.channels[ch][i];
+            texel_cnt += 1.0f;
+        }
+
+        if (texel_cnt == 0.0f)
+        {
+            std::memset(endpoints, 0, sizeof(endpoints));
+            return;
+        }
+
+        for (UINT ch = 0; ch < channel_cnt; ++ch)
+            mean[ch] /= texel_cnt;
+
+        float covariance[4][4] = {};
+        for (UINT i = 0; i < 16; ++i)
+        {
+            if (((mask >> i) & 1) == 0)
+                continue;
+            for (UINT a = 0; a < channel_cnt; ++a)
+            {
+                for (UINT b = a; b < channel_cnt; ++b)
+                {
+                    covariance[a][b] += (block.channels[a][i] - mean[a]) * (block.channels[b][i] - mean[b]);
+                }
+            }
+        }
+
+        // principal axis by power iteration, starting from the channel with the largest variance
+        float axis[4] = {};
+        UINT largest = 0;
+        for (UINT ch = 1; ch < channel_cnt; ++ch)
+        {
+            if (covariance[ch][ch] > covariance[largest][largest])
+                largest = ch;
+        }
+        axis[largest] = 1.0f;
+
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[4] = {};
+            float length = 0.0f;
+            for (UINT a = 0; a < channel_cnt; ++a)
+            {
+                for (UINT b = 0; b < channel_cnt; ++b)
+                {
+                    next[a] += (a <= b ? covariance[a][b] : covariance[b][a]) * axis[b];
+                }
+                length = (std::max)(length, std::abs(next[a]));
+            }
+            if (length == 0.0f)
+                break;
+            for (UINT ch = 0; ch < channel_cnt; ++ch)
+                axis[ch] = next[ch] / length;
+        }
+
+        float axis_length_sq = 0.0f;
+        for (UINT ch = 0; ch < channel_cnt; ++ch)
+            axis_length_sq += axis[ch] * axis[ch];
+
+        float t_min = 0.0f;
+        float t_max = 0.0f;
+        for (UINT i = 0; i < 16; ++i)
+        {
+            if (((mask >> i) & 1) == 0)
+                continue;
+            float t = 0.0f;
+            for (UINT ch = 0; ch < channel_cnt; ++ch)
+                t += (block.channels[ch][i] - mean[ch]) * axis[ch];
+            t /= axis_length_sq;
+            t_min = (std::min)(t_min, t);
+            t_max = (std::max)(t_max, t);
+        }
+
+        for (UINT ch = 0; ch < 4; ++ch)
+        {
+            endpoints[0][ch] = ch < channel_cnt ? mean[ch] + axis[ch] * t_min : 255.0f;
+            endpoints[1][ch] = ch < channel_cnt ? mean[ch] + axis[ch] * t_max : 255.0f;
+        }
+    }
+
+    inline bool BlockCompressor::refineEndpoints(
+        Block const& block,
+        UINT channel_cnt,
+        uint16_t mask,
+        uint8_t const* indices,
+        float const* weights,
+        float (&endpoints)[2][4])
+    {
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        float x0[4] = {};
+        float x1[4] = {};
+
+        for (UINT i = 0; i < 16; ++i)
+        {
+            if (((mask >> i) & 1) == 0)
+                continue;
+
+            float const w = weights[indices[i]];
+            a += (1.0f - w) * (1.0f - w);
+            b += (1.0f - w) * w;
+            c += w * w;
+            for (UINT ch = 0; ch < channel_cnt; ++ch)
+            {
+                x0[ch] += (1.0f - w) * block.channels[ch][i];
+                x1[ch] += w * block.channels[ch][i];
+            }
+        }
+
+        float const determinant = a * c - b * b;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+
+        for (UINT ch = 0; ch < channel_cnt; ++ch)
+        {
+            endpoints[0][ch] = (std::min)((std::max)((c * x0[ch] - b * x1[ch]) / determinant, 0.0f), 255.0f);
+            endpoints[1][ch] = (std::min)((std::max)((a * x1[ch] - b * x0[ch]) / determinant, 0.0f), 255.0f);
+        }
+
+        return true;
+    }
+
+    inline uint16_t BlockCompressor::quantizeRgb565(float const* color)
+    {
+        auto quantize = [](float value, int max) {
+            int q = static_cast<int>((std::min)((std::max)(value, 0.0f), 255.0f) * max / 255.0f + 0.5f);
+            return static_cast<uint16_t>((std::min)(q, max));
+        };
+
+        return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+    }
+
+    inline void BlockCompressor::expandRgb565(uint16_t value, float* color)
+    {
+        int const r = (value >> 11) & 31;
+        int const g = (value >> 5) & 63;
+        int const b = value & 31;
+
+        color[0] = static_cast<float>((r << 3) | (r >> 2));
+        color[1] = static_cast<float>((g << 2) | (g >> 4));
+        color[2] = static_cast<float>((b << 3) | (b >> 2));
+        color[3] = 255.0f;
+    }
+
+} // namespace dxowl
+
+#endif // !BlockCompressor_hpp
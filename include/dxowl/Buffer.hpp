@@ -12,6 +12,8 @@
 #include <wrl.h>
 #include <winrt/base.h> // winrt::check_hresult
 
+#include "MemoryTracker.hpp"
+
 namespace dxowl
 {
     class Buffer
@@ -26,42 +28,151 @@ namespace dxowl
             D3D11_BUFFER_DESC const& buffer_desc,
             D3D11_SHADER_RESOURCE_VIEW_DESC const& shdr_rsrc_view,
             Container const& datastorage)
-            : m_buffer(nullptr), m_descriptor(buffer_desc), m_shdr_rsrc_view_desc(shdr_rsrc_view)
+            : m_buffer(nullptr), m_descriptor(buffer_desc), m_shdr_rsrc_view_desc(shdr_rsrc_view), m_unordered_access_view_desc()
         {
-            size_t byte_size = datastorage.size() * sizeof(Container::value_type);
+            size_t byte_size = datastorage.size() * sizeof(typename Container::value_type);
 
             if (byte_size > 0)
             {
-                D3D11_SUBRESOURCE_DATA init_data;
-                init_data.pSysMem = datastorage.data();
-                winrt::check_hresult(d3d11_device->CreateBuffer(&m_descriptor, &init_data, &m_buffer));
+                create(d3d11_device, datastorage.data());
             }
             else
             {
                 m_descriptor.ByteWidth = 16;
                 m_descriptor.StructureByteStride = 16;
                 m_shdr_rsrc_view_desc.Buffer.NumElements = 1;
-                winrt::check_hresult(d3d11_device->CreateBuffer(&m_descriptor, nullptr, &m_buffer));
+                create(d3d11_device, nullptr);
             }
+        }
 
-            winrt::check_hresult(d3d11_device->CreateShaderResourceView(
-                m_buffer.Get(),
-                &m_shdr_rsrc_view_desc,
-                m_shdr_rsrc_view.GetAddressOf()));
+        /// Creates a buffer for compute passes. Views are created for the shader resource and unordered access
+        /// bind flags set in buffer_desc, the other view description is ignored. Without initial data the
+        /// content is undefined.
+        Buffer(
+            ID3D11Device4* d3d11_device,
+            D3D11_BUFFER_DESC const& buffer_desc,
+            D3D11_SHADER_RESOURCE_VIEW_DESC const& shdr_rsrc_view,
+            D3D11_UNORDERED_ACCESS_VIEW_DESC const& unordered_access_view,
+            void const* initial_data = nullptr)
+            : m_buffer(nullptr), m_descriptor(buffer_desc), m_shdr_rsrc_view_desc(shdr_rsrc_view), m_unordered_access_view_desc(unordered_access_view)
+        {
+            create(d3d11_device, initial_data);
+        }
+
+        /// Creates a buffer without views, e.g. a staging buffer (see getStagingDescriptor).
+        Buffer(
+            ID3D11Device4* d3d11_device,
+            D3D11_BUFFER_DESC const& buffer_desc,
+            void const* initial_data = nullptr)
+            : m_buffer(nullptr), m_descriptor(buffer_desc), m_shdr_rsrc_view_desc(), m_unordered_access_view_desc()
+        {
+            m_descriptor.BindFlags &= ~(D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS);
+            create(d3d11_device, initial_data);
         }
 
         ~Buffer() = default;
 
+        Buffer(const Buffer& cpy) = delete;
+        Buffer(Buffer&& other) = default;
+        Buffer& operator=(Buffer&& rhs) = default;
+        Buffer& operator=(const Buffer& rhs) = delete;
+
+        /// Description of a CPU readable buffer that the content of a buffer described by buffer_desc can be copied to.
+        static inline D3D11_BUFFER_DESC getStagingDescriptor(D3D11_BUFFER_DESC const& buffer_desc) {
+            D3D11_BUFFER_DESC retval = buffer_desc;
+            retval.Usage = D3D11_USAGE_STAGING;
+            retval.BindFlags = 0;
+            retval.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+            return retval;
+        }
+
+        /// Description of a buffer holding DrawIndexedInstancedIndirect argument records (20 bytes each). CPU written
+        /// buffers are dynamic, otherwise the buffer is GPU written through a raw unordered access view.
+        static inline D3D11_BUFFER_DESC getIndirectArgsDescriptor(UINT record_count, bool cpu_write = true) {
+            D3D11_BUFFER_DESC retval = {};
+            retval.ByteWidth = record_count * 5 * sizeof(UINT);
+            retval.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+            if (cpu_write)
+            {
+                retval.Usage = D3D11_USAGE_DYNAMIC;
+                retval.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            }
+            else
+            {
+                retval.Usage = D3D11_USAGE_DEFAULT;
+                retval.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+                retval.MiscFlags |= D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+            }
+            return retval;
+        }
+
+        inline Microsoft::WRL::ComPtr<ID3D11Buffer> getBuffer() {
+            return m_buffer;
+        }
+
+        inline D3D11_BUFFER_DESC const& getDescriptor() const {
+            return m_descriptor;
+        }
+
         inline Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> getShaderResourceView() {
             return m_shdr_rsrc_view;
         }
 
+        inline Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> getUnorderedAccessView() {
+            return m_unordered_access_view;
+        }
+
+        inline void setMemoryTag(std::string const& tag) {
+            m_memory_allocation.setTag(tag);
+        }
+
+        inline size_t getMemoryByteSize() const {
+            return m_memory_allocation.getByteSize();
+        }
+
     private:
+        inline void create(ID3D11Device4* d3d11_device, void const* initial_data) {
+            if (initial_data != nullptr)
+            {
+                D3D11_SUBRESOURCE_DATA init_data = {};
+                init_data.pSysMem = initial_data;
+                winrt::check_hresult(d3d11_device->CreateBuffer(&m_descriptor, &init_data, &m_buffer));
+            }
+            else
+            {
+                winrt::check_hresult(d3d11_device->CreateBuffer(&m_descriptor, nullptr, &m_buffer));
+            }
+
+            if (m_descriptor.BindFlags & D3D11_BIND_SHADER_RESOURCE)
+            {
+                winrt::check_hresult(d3d11_device->CreateShaderResourceView(
+                    m_buffer.Get(),
+                    &m_shdr_rsrc_view_desc,
+                    m_shdr_rsrc_view.GetAddressOf()));
+            }
+
+            if (m_descriptor.BindFlags & D3D11_BIND_UNORDERED_ACCESS)
+            {
+                winrt::check_hresult(d3d11_device->CreateUnorderedAccessView(
+                    m_buffer.Get(),
+                    &m_unordered_access_view_desc,
+                    m_unordered_access_view.GetAddressOf()));
+            }
+
+            m_memory_allocation.setByteSize(computeResourceByteSize(m_descriptor));
+            m_memory_allocation.setCategory(MemoryTracker::Category::Buffer);
+        }
+
         Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
         D3D11_BUFFER_DESC m_descriptor;
 
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_shdr_rsrc_view;
         D3D11_SHADER_RESOURCE_VIEW_DESC m_shdr_rsrc_view_desc;
+
+        Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_unordered_access_view;
+        D3D11_UNORDERED_ACCESS_VIEW_DESC m_unordered_access_view_desc;
+
+        MemoryTracker::Allocation m_memory_allocation;
     };
 } // namespace dxowl
 
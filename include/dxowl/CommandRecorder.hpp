@@ -0,0 +1,289 @@
+/// <copyright file="CommandRecorder.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef CommandRecorder_hpp
+#define CommandRecorder_hpp
+
+#include <d3d11_4.h>
+#include <wrl/client.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "StateCache.hpp"
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// Records draw submission on several threads and replays it in a fixed order on the immediate context.
+    /// Each recording slot owns a deferred context and a StateCache; record() splits its batches into
+    /// contiguous ranges, one per slot, so the replay order only depends on the batch indices and never on
+    /// thread scheduling. In immediate mode, batches are recorded sequentially on the immediate context.
+    /// Deferred contexts start every command list with cleared state, so render targets, viewports and other
+    /// state that is not part of the batch must be set in the setup callback of record().
+    /// execute() clears the immediate context state, invalidate any StateCache of the immediate context afterwards.
+    class CommandRecorder
+    {
+    public:
+        enum class Mode
+        {
+            Auto,     // deferred contexts if the driver supports command lists natively, immediate otherwise
+            Deferred,
+            Immediate
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t batches_recorded = 0;
+            size_t command_lists_executed = 0;
+            size_t calls_issued = 0;
+            size_t calls_skipped = 0;
+        };
+
+        typedef std::function<void(size_t batch_idx, StateCache& state_cache)> RecordFunc;
+        typedef std::function<void(ID3D11DeviceContext4* d3d11_ctx)> SetupFunc;
+
+        CommandRecorder(
+            ID3D11Device4* d3d11_device,
+            ID3D11DeviceContext4* d3d11_immediate_ctx,
+            ThreadPool& thread_pool,
+            Mode mode = Mode::Auto);
+        ~CommandRecorder() = default;
+
+        CommandRecorder(const CommandRecorder& cpy) = delete;
+        CommandRecorder(CommandRecorder&& other) = delete;
+        CommandRecorder& operator=(CommandRecorder&& rhs) = delete;
+        CommandRecorder& operator=(const CommandRecorder& rhs) = delete;
+
+        /// Returns the mode in use, Auto is resolved to Deferred or Immediate on construction.
+        Mode getMode() const;
+        size_t getSlotCount() const;
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        /// Calls record_func(i, state_cache) for all batches i in [0, batch_cnt). Setup_func, if set, is called
+        /// on each used context before its first batch. Command lists are queued for the next execute().
+        void record(size_t batch_cnt, RecordFunc const& record_func, SetupFunc const& setup_func = nullptr);
+
+        /// Executes all queued command lists in recording order.
+        void execute();
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct RecordingSlot
+        {
+            Microsoft::WRL::ComPtr<ID3D11DeviceContext4> context;
+            std::unique_ptr<StateCache> state_cache;
+            Microsoft::WRL::ComPtr<ID3D11CommandList> command_list;
+        };
+
+        bool createDeferredContexts(ID3D11Device4* d3d11_device, size_t slot_cnt);
+        void recordSlot(RecordingSlot& slot, size_t batch_begin, size_t batch_end, RecordFunc const& record_func, SetupFunc const& setup_func);
+        void accumulateStatistics(StateCache& state_cache);
+
+        ID3D11DeviceContext4* m_immediate_ctx;
+        ThreadPool& m_thread_pool;
+        Mode m_mode;
+
+        std::vector<RecordingSlot> m_slots;
+        std::unique_ptr<StateCache> m_immediate_state_cache;
+        std::vector<Microsoft::WRL::ComPtr<ID3D11CommandList>> m_command_lists;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline CommandRecorder::CommandRecorder(
+        ID3D11Device4* d3d11_device,
+        ID3D11DeviceContext4* d3d11_immediate_ctx,
+        ThreadPool& thread_pool,
+        Mode mode)
+        : m_immediate_ctx(d3d11_immediate_ctx), m_thread_pool(thread_pool), m_mode(mode)
+    {
+        size_t const slot_cnt = thread_pool.getThreadCount() > 0 ? thread_pool.getThreadCount() : 1;
+
+        if (m_mode == Mode::Auto)
+        {
+            // the runtime emulates command lists if the driver does not support them, which is usually slower
+            // than submitting directly
+            D3D11_FEATURE_DATA_THREADING threading = {};
+            HRESULT hr = d3d11_device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading));
+            bool const native_command_lists = SUCCEEDED(hr) && threading.DriverCommandLists;
+
+            m_mode = native_command_lists && createDeferredContexts(d3d11_device, slot_cnt) ? Mode::Deferred : Mode::Immediate;
+        }
+        else if (m_mode == Mode::Deferred)
+        {
+            if (!createDeferredContexts(d3d11_device, slot_cnt))
+            {
+                // e.g. devices created with D3D11_CREATE_DEVICE_SINGLETHREADED
+                winrt::check_hresult(DXGI_ERROR_INVALID_CALL);
+            }
+        }
+
+        m_immediate_state_cache = std::make_unique<StateCache>(m_immediate_ctx);
+    }
+
+    inline CommandRecorder::Mode CommandRecorder::getMode() const
+    {
+        return m_mode;
+    }
+
+    inline size_t CommandRecorder::getSlotCount() const
+    {
+        return m_mode == Mode::Deferred ? m_slots.size() : 1;
+    }
+
+    inline void CommandRecorder::beginFrame(uint64_t frame)
+    {
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void CommandRecorder::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline void CommandRecorder::record(size_t batch_cnt, RecordFunc const& record_func, SetupFunc const& setup_func)
+    {
+        if (batch_cnt == 0)
+        {
+            return;
+        }
+
+        m_current_stats.batches_recorded += batch_cnt;
+
+        if (m_mode == Mode::Immediate)
+        {
+            // the application may have changed the immediate context since the last record()
+            m_immediate_state_cache->invalidate();
+            m_immediate_state_cache->beginFrame(m_current_stats.frame);
+
+            if (setup_func)
+            {
+                setup_func(m_immediate_ctx);
+            }
+            for (size_t batch_idx = 0; batch_idx < batch_cnt; ++batch_idx)
+            {
+                record_func(batch_idx, *m_immediate_state_cache);
+            }
+            m_immediate_state_cache->flush();
+
+            accumulateStatistics(*m_immediate_state_cache);
+            return;
+        }
+
+        size_t const slot_cnt = (std::min)(m_slots.size(), batch_cnt);
+        size_t const batches_per_slot = batch_cnt / slot_cnt;
+        size_t const remainder = batch_cnt % slot_cnt;
+
+        // slot i records a contiguous range of batches, the first 'remainder' slots take one extra batch
+        m_thread_pool.parallelFor(0, slot_cnt, [&](size_t slot_idx) {
+            size_t batch_begin = slot_idx * batches_per_slot + (std::min)(slot_idx, remainder);
+            size_t batch_end = batch_begin + batches_per_slot + (slot_idx < remainder ? 1 : 0);
+            recordSlot(m_slots[slot_idx], batch_begin, batch_end, record_func, setup_func);
+        });
+
+        for (size_t slot_idx = 0; slot_idx < slot_cnt; ++slot_idx)
+        {
+            m_command_lists.push_back(std::move(m_slots[slot_idx].command_list));
+            accumulateStatistics(*m_slots[slot_idx].state_cache);
+        }
+    }
+
+    inline void CommandRecorder::execute()
+    {
+        for (auto& command_list : m_command_lists)
+        {
+            m_immediate_ctx->ExecuteCommandList(command_list.Get(), FALSE);
+        }
+
+        m_current_stats.command_lists_executed += m_command_lists.size();
+        m_command_lists.clear();
+    }
+
+    inline CommandRecorder::FrameStatistics CommandRecorder::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline CommandRecorder::FrameStatistics CommandRecorder::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline bool CommandRecorder::createDeferredContexts(ID3D11Device4* d3d11_device, size_t slot_cnt)
+    {
+        std::vector<RecordingSlot> slots(slot_cnt);
+
+        for (auto& slot : slots)
+        {
+            Microsoft::WRL::ComPtr<ID3D11DeviceContext3> deferred_ctx;
+            if (FAILED(d3d11_device->CreateDeferredContext3(0, deferred_ctx.GetAddressOf()))
+                || FAILED(deferred_ctx.As(&slot.context)))
+            {
+                return false;
+            }
+            slot.state_cache = std::make_unique<StateCache>(slot.context.Get());
+        }
+
+        m_slots = std::move(slots);
+        return true;
+    }
+
+    inline void CommandRecorder::recordSlot(
+        RecordingSlot& slot,
+        size_t batch_begin,
+        size_t batch_end,
+        RecordFunc const& record_func,
+        SetupFunc const& setup_func)
+    {
+        // every command list starts from default state
+        slot.state_cache->invalidate();
+        slot.state_cache->beginFrame(m_current_stats.frame);
+
+        try
+        {
+            if (setup_func)
+            {
+                setup_func(slot.context.Get());
+            }
+            for (size_t batch_idx = batch_begin; batch_idx < batch_end; ++batch_idx)
+            {
+                record_func(batch_idx, *slot.state_cache);
+            }
+            slot.state_cache->flush();
+        }
+        catch (...)
+        {
+            // drop the partial recording so the next record() starts with an empty context
+            slot.context->FinishCommandList(FALSE, slot.command_list.ReleaseAndGetAddressOf());
+            slot.command_list.Reset();
+            throw;
+        }
+
+        winrt::check_hresult(slot.context->FinishCommandList(FALSE, slot.command_list.ReleaseAndGetAddressOf()));
+    }
+
+    inline void CommandRecorder::accumulateStatistics(StateCache& state_cache)
+    {
+        state_cache.endFrame();
+        StateCache::FrameStatistics stats = state_cache.getLastFrameStatistics();
+        m_current_stats.calls_issued += stats.calls_issued;
+        m_current_stats.calls_skipped += stats.calls_skipped;
+    }
+
+} // namespace dxowl
+
+#endif // !CommandRecorder_hpp
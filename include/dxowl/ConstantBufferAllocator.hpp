@@ -0,0 +1,343 @@
+/// <copyright file="ConstantBufferAllocator.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ConstantBufferAllocator_hpp
+#define ConstantBufferAllocator_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "MemoryTracker.hpp"
+
+namespace dxowl
+{
+    /// Sub-allocates per-frame shader constants from a few large dynamic constant buffers instead of one small
+    /// buffer per object. Slices are 256 byte aligned and bound with the first-constant offsets of
+    /// VSSetConstantBuffers1/PSSetConstantBuffers1. Each buffer is mapped with D3D11_MAP_WRITE_DISCARD on its
+    /// first use in a frame and with D3D11_MAP_WRITE_NO_OVERWRITE afterwards, so slices handed out earlier in the
+    /// frame stay valid. Another buffer is created when all buffers are full. Requires a driver that supports
+    /// constant buffer offsetting and no-overwrite maps of dynamic constant buffers (Direct3D 11.1, Windows 8).
+    class ConstantBufferAllocator
+    {
+    public:
+        static constexpr size_t alignment = 256;
+
+        /// A slice in shader constants, i.e. 16 byte units as expected by the *SetConstantBuffers1 functions.
+        struct Allocation
+        {
+            ID3D11Buffer* buffer;
+            UINT first_constant;
+            UINT constant_count;
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t map_count = 0;
+            size_t discard_count = 0;
+            size_t allocation_count = 0;
+            size_t bytes_written = 0;
+            size_t bytes_allocated = 0;     // including the padding to 256 bytes
+            size_t buffer_count = 0;        // buffers used in the frame
+        };
+
+        ConstantBufferAllocator(ID3D11Device4* d3d11_device, size_t buffer_byte_size = 1u << 20);
+        ~ConstantBufferAllocator() = default;
+
+        ConstantBufferAllocator(const ConstantBufferAllocator& cpy) = delete;
+        ConstantBufferAllocator(ConstantBufferAllocator&& other) = delete;
+        ConstantBufferAllocator& operator=(ConstantBufferAllocator&& rhs) = delete;
+        ConstantBufferAllocator& operator=(const ConstantBufferAllocator& rhs) = delete;
+
+        /// Slices of the previous frame become invalid.
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        Allocation upload(ID3D11DeviceContext4* d3d11_ctx, void const* data, size_t byte_size);
+
+        template <typename Constants>
+        Allocation upload(ID3D11DeviceContext4* d3d11_ctx, Constants const& constants);
+
+        /// Maps a slice and lets write_func fill it in place (signature: void(void* dst)).
+        template <typename WriteFunc>
+        Allocation allocate(ID3D11DeviceContext4* d3d11_ctx, size_t byte_size, WriteFunc&& write_func);
+
+        /// Allocates count slices of byte_size each and fills them with a single map per buffer touched,
+        /// usually one (write_func signature: void(size_t index, void* dst)). Resizes allocations to count.
+        template <typename WriteFunc>
+        void allocateBatch(
+            ID3D11DeviceContext4* d3d11_ctx,
+            size_t count,
+            size_t byte_size,
+            std::vector<Allocation>& allocations,
+            WriteFunc&& write_func);
+
+        /// Uploads one slice per element of constants, e.g. the per-object constants of a draw list.
+        template <typename Container>
+        void uploadBatch(
+            ID3D11DeviceContext4* d3d11_ctx,
+            Container const& constants,
+            std::vector<Allocation>& allocations);
+
+        static void bindVS(ID3D11DeviceContext4* d3d11_ctx, UINT slot, Allocation const& allocation);
+        static void bindPS(ID3D11DeviceContext4* d3d11_ctx, UINT slot, Allocation const& allocation);
+
+        size_t getBufferCount() const;
+        size_t getBufferByteSize() const;
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct Page
+        {
+            Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+            MemoryTracker::Allocation memory_allocation;
+            uint64_t discard_epoch = 0;
+        };
+
+        static size_t alignedSize(size_t byte_size);
+
+        template <typename WriteFunc>
+        void write(
+            ID3D11DeviceContext4* d3d11_ctx,
+            size_t count,
+            size_t byte_size,
+            Allocation* allocations,
+            WriteFunc&& write_func);
+
+        /// Moves to a buffer with room for at least one slice of aligned_size, creating one if necessary.
+        void reserve(size_t aligned_size);
+
+        /// Maps the current buffer, discarding it on its first use in the frame.
+        std::byte* map(ID3D11DeviceContext4* d3d11_ctx);
+
+        ID3D11Device4* m_d3d11_device;
+        size_t m_buffer_byte_size;
+
+        std::vector<std::unique_ptr<Page>> m_pages;
+        size_t m_current_page;
+        size_t m_head;
+
+        uint64_t m_epoch; // counts beginFrame calls, independent of the frame numbers passed in
+        uint64_t m_frame;
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline ConstantBufferAllocator::ConstantBufferAllocator(ID3D11Device4* d3d11_device, size_t buffer_byte_size)
+        : m_d3d11_device(d3d11_device),
+        m_buffer_byte_size(alignedSize(buffer_byte_size)),
+        m_current_page(0),
+        m_head(0),
+        m_epoch(1),
+        m_frame(0)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        HRESULT hr = d3d11_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+        if (FAILED(hr) || !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            throw std::runtime_error("ConstantBufferAllocator: constant buffer offsetting is not supported");
+        }
+    }
+
+    inline void ConstantBufferAllocator::beginFrame(uint64_t frame)
+    {
+        m_frame = frame;
+        ++m_epoch;
+        m_current_page = 0;
+        m_head = 0;
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void ConstantBufferAllocator::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline ConstantBufferAllocator::Allocation ConstantBufferAllocator::upload(
+        ID3D11DeviceContext4* d3d11_ctx,
+        void const* data,
+        size_t byte_size)
+    {
+        return allocate(d3d11_ctx, byte_size,
+            [data, byte_size](void* dst) { std::memcpy(dst, data, byte_size); });
+    }
+
+    template <typename Constants>
+    inline ConstantBufferAllocator::Allocation ConstantBufferAllocator::upload(
+        ID3D11DeviceContext4* d3d11_ctx,
+        Constants const& constants)
+    {
+        return upload(d3d11_ctx, &constants, sizeof(Constants));
+    }
+
+    template <typename WriteFunc>
+    inline ConstantBufferAllocator::Allocation ConstantBufferAllocator::allocate(
+        ID3D11DeviceContext4* d3d11_ctx,
+        size_t byte_size,
+        WriteFunc&& write_func)
+    {
+        Allocation retval;
+        write(d3d11_ctx, 1, byte_size, &retval,
+            [&write_func](size_t, void* dst) { write_func(dst); });
+        return retval;
+    }
+
+    template <typename WriteFunc>
+    inline void ConstantBufferAllocator::allocateBatch(
+        ID3D11DeviceContext4* d3d11_ctx,
+        size_t count,
+        size_t byte_size,
+        std::vector<Allocation>& allocations,
+        WriteFunc&& write_func)
+    {
+        allocations.resize(count);
+        write(d3d11_ctx, count, byte_size, allocations.data(), write_func);
+    }
+
+    template <typename WriteFunc>
+    inline void ConstantBufferAllocator::write(
+        ID3D11DeviceContext4* d3d11_ctx,
+        size_t count,
+        size_t byte_size,
+        Allocation* allocations,
+        WriteFunc&& write_func)
+    {
+        if (byte_size == 0 || byte_size > D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16)
+        {
+            throw std::length_error("ConstantBufferAllocator: constants must be between 1 byte and 64 KiB");
+        }
+
+        size_t const aligned_size = alignedSize(byte_size);
+        UINT const constant_count = static_cast<UINT>(aligned_size / 16);
+
+        size_t i = 0;
+        while (i < count)
+        {
+            reserve(aligned_size);
+
+            Page& page = *m_pages[m_current_page];
+            size_t const fit_count = (std::min)(count - i, (m_buffer_byte_size - m_head) / aligned_size);
+
+            std::byte* data = map(d3d11_ctx);
+            for (size_t end = i + fit_count; i < end; ++i)
+            {
+                write_func(i, data + m_head);
+                allocations[i] = { page.buffer.Get(), static_cast<UINT>(m_head / 16), constant_count };
+                m_head += aligned_size;
+            }
+            d3d11_ctx->Unmap(page.buffer.Get(), 0);
+        }
+
+        m_current_stats.allocation_count += count;
+        m_current_stats.bytes_written += count * byte_size;
+        m_current_stats.bytes_allocated += count * aligned_size;
+    }
+
+    template <typename Container>
+    inline void ConstantBufferAllocator::uploadBatch(
+        ID3D11DeviceContext4* d3d11_ctx,
+        Container const& constants,
+        std::vector<Allocation>& allocations)
+    {
+        typedef typename Container::value_type Constants;
+        Constants const* src = constants.data();
+        allocateBatch(d3d11_ctx, constants.size(), sizeof(Constants), allocations,
+            [src](size_t index, void* dst) { std::memcpy(dst, src + index, sizeof(Constants)); });
+    }
+
+    inline void ConstantBufferAllocator::bindVS(ID3D11DeviceContext4* d3d11_ctx, UINT slot, Allocation const& allocation)
+    {
+        d3d11_ctx->VSSetConstantBuffers1(slot, 1, &allocation.buffer, &allocation.first_constant, &allocation.constant_count);
+    }
+
+    inline void ConstantBufferAllocator::bindPS(ID3D11DeviceContext4* d3d11_ctx, UINT slot, Allocation const& allocation)
+    {
+        d3d11_ctx->PSSetConstantBuffers1(slot, 1, &allocation.buffer, &allocation.first_constant, &allocation.constant_count);
+    }
+
+    inline size_t ConstantBufferAllocator::getBufferCount() const
+    {
+        return m_pages.size();
+    }
+
+    inline size_t ConstantBufferAllocator::getBufferByteSize() const
+    {
+        return m_buffer_byte_size;
+    }
+
+    inline ConstantBufferAllocator::FrameStatistics ConstantBufferAllocator::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline ConstantBufferAllocator::FrameStatistics ConstantBufferAllocator::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline size_t ConstantBufferAllocator::alignedSize(size_t byte_size)
+    {
+        return ((byte_size + alignment - 1) / alignment) * alignment;
+    }
+
+    inline void ConstantBufferAllocator::reserve(size_t aligned_size)
+    {
+        if (m_current_page < m_pages.size() && m_head + aligned_size <= m_buffer_byte_size)
+        {
+            return;
+        }
+
+        if (m_current_page < m_pages.size())
+        {
+            ++m_current_page;
+            m_head = 0;
+        }
+
+        if (m_current_page == m_pages.size())
+        {
+            auto page = std::make_unique<Page>();
+            const CD3D11_BUFFER_DESC desc(static_cast<UINT>(m_buffer_byte_size), D3D11_BIND_CONSTANT_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
+            winrt::check_hresult(m_d3d11_device->CreateBuffer(&desc, nullptr, page->buffer.GetAddressOf()));
+            page->memory_allocation.setByteSize(computeResourceByteSize(desc));
+            page->memory_allocation.setCategory(MemoryTracker::Category::Buffer);
+            m_pages.push_back(std::move(page));
+        }
+    }
+
+    inline std::byte* ConstantBufferAllocator::map(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        Page& page = *m_pages[m_current_page];
+
+        D3D11_MAP map_type = D3D11_MAP_WRITE_NO_OVERWRITE;
+        if (page.discard_epoch != m_epoch)
+        {
+            map_type = D3D11_MAP_WRITE_DISCARD;
+            page.discard_epoch = m_epoch;
+            ++m_current_stats.discard_count;
+            ++m_current_stats.buffer_count;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE map;
+        winrt::check_hresult(d3d11_ctx->Map(page.buffer.Get(), 0, map_type, 0, &map));
+        ++m_current_stats.map_count;
+
+        return static_cast<std::byte*>(map.pData);
+    }
+
+} // namespace dxowl
+
+#endif // !ConstantBufferAllocator_hpp
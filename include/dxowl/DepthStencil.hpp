@@ -21,6 +21,11 @@ namespace dxowl
             D3D11_DEPTH_STENCIL_VIEW_DESC const& depth_stencil_view_desc);
         ~DepthStencil();
 
+        DepthStencil(const DepthStencil& cpy) = delete;
+        DepthStencil(DepthStencil&& other) = default;
+        DepthStencil& operator=(DepthStencil&& rhs) = default;
+        DepthStencil& operator=(const DepthStencil& rhs) = delete;
+
         void resize(ID3D11Device4* d3d11_device, UINT width, UINT height);
 
         Microsoft::WRL::ComPtr<ID3D11DepthStencilView> getDepthStencilView() const;
@@ -39,10 +44,13 @@ namespace dxowl
         D3D11_DEPTH_STENCIL_VIEW_DESC const& depth_stencil_view_desc)
         : Texture2D(d3d11_device, std::vector<void*>(), desc, shdr_rsrc_view_desc), m_depth_stencil_view_desc(depth_stencil_view_desc)
     {
-        HRESULT hr = d3d11_device->CreateDepthStencilView(
-            m_texture.Get(),
-            &m_depth_stencil_view_desc,
-            &m_depth_stencil_view);
+        winrt::check_hresult(
+            d3d11_device->CreateDepthStencilView(
+                m_texture.Get(),
+                &m_depth_stencil_view_desc,
+                &m_depth_stencil_view));
+
+        m_memory_allocation.setCategory(MemoryTracker::Category::DepthStencil);
     }
 
     inline DepthStencil::~DepthStencil()
@@ -51,6 +59,12 @@ namespace dxowl
 
     inline void DepthStencil::resize(ID3D11Device4* d3d11_device, UINT width, UINT height)
     {
+        // Keep the texture and its views if the size does not change
+        if (m_texture != nullptr && m_desc.Width == width && m_desc.Height == height)
+        {
+            return;
+        }
+
         m_depth_stencil_view = nullptr;
         m_shdr_rsrc_view = nullptr;
         m_texture = nullptr;
@@ -62,22 +76,25 @@ namespace dxowl
         m_desc.Width = width;
         m_desc.Height = height;
 
-        HRESULT hr = d3d11_device->CreateTexture2D(
-            &m_desc,
-            nullptr,
-            m_texture.GetAddressOf()
-        );
-
-        hr = d3d11_device->CreateShaderResourceView(
-            m_texture.Get(),
-            &m_shdr_rsrc_view_desc,
-            m_shdr_rsrc_view.GetAddressOf()
-        );
-
-        hr = d3d11_device->CreateDepthStencilView(
-            m_texture.Get(),
-            &m_depth_stencil_view_desc,
-            &m_depth_stencil_view);
+        winrt::check_hresult(
+            d3d11_device->CreateTexture2D(
+                &m_desc,
+                nullptr,
+                m_texture.GetAddressOf()));
+
+        winrt::check_hresult(
+            d3d11_device->CreateShaderResourceView(
+                m_texture.Get(),
+                &m_shdr_rsrc_view_desc,
+                m_shdr_rsrc_view.GetAddressOf()));
+
+        winrt::check_hresult(
+            d3d11_device->CreateDepthStencilView(
+                m_texture.Get(),
+                &m_depth_stencil_view_desc,
+                &m_depth_stencil_view));
+
+        m_memory_allocation.setByteSize(computeResourceByteSize(m_desc));
     }
 
     inline Microsoft::WRL::ComPtr<ID3D11DepthStencilView> DepthStencil::getDepthStencilView() const
@@ -0,0 +1,377 @@
+/// <copyright file="FormatTraits.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef FormatTraits_hpp
+#define FormatTraits_hpp
+
+#include <dxgiformat.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace dxowl
+{
+    enum class FormatChannelType : uint8_t
+    {
+        Unknown,
+        Typeless,
+        Float,
+        Unorm,
+        Snorm,
+        Uint,
+        Sint,
+        SharedExp,
+        DepthStencil, // mixed depth and stencil components
+        Video
+    };
+
+    struct FormatTraits
+    {
+        DXGI_FORMAT format;
+        uint8_t bytes_per_block;   // bytes per texel for uncompressed formats
+        uint8_t block_width;       // texels per block in x, 1 for uncompressed formats
+        uint8_t block_height;      // texels per block in y, 1 for uncompressed formats
+        uint8_t channel_count;
+        FormatChannelType channel_type;
+        bool is_srgb;
+        bool has_depth;
+        bool has_stencil;
+        bool is_block_compressed;
+        uint8_t plane_rows_x2;     // planar video formats: rows of all planes per luma row, times two. 0 otherwise
+    };
+
+    // Indexed by the numerical value of DXGI_FORMAT. Unused values map to an empty DXGI_FORMAT_UNKNOWN entry.
+    inline constexpr std::array<FormatTraits, 133> format_traits_table = { {
+        //  format, bytes per block, block width, block height, channels, channel type, srgb, depth, stencil, block compressed, plane rows x2
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32A32_TYPELESS, 16, 1, 1, 4, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32A32_FLOAT, 16, 1, 1, 4, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32A32_UINT, 16, 1, 1, 4, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32A32_SINT, 16, 1, 1, 4, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32_TYPELESS, 12, 1, 1, 3, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32_FLOAT, 12, 1, 1, 3, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32_UINT, 12, 1, 1, 3, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32B32_SINT, 12, 1, 1, 3, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_TYPELESS, 8, 1, 1, 4, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_FLOAT, 8, 1, 1, 4, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_UNORM, 8, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_UINT, 8, 1, 1, 4, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_SNORM, 8, 1, 1, 4, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16B16A16_SINT, 8, 1, 1, 4, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32_TYPELESS, 8, 1, 1, 2, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32_FLOAT, 8, 1, 1, 2, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32_UINT, 8, 1, 1, 2, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G32_SINT, 8, 1, 1, 2, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32G8X24_TYPELESS, 8, 1, 1, 2, FormatChannelType::Typeless, false, true, true, false, 0 },
+            { DXGI_FORMAT_D32_FLOAT_S8X24_UINT, 8, 1, 1, 2, FormatChannelType::DepthStencil, false, true, true, false, 0 },
+            { DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS, 8, 1, 1, 1, FormatChannelType::Float, false, true, false, false, 0 },
+            { DXGI_FORMAT_X32_TYPELESS_G8X24_UINT, 8, 1, 1, 1, FormatChannelType::Uint, false, false, true, false, 0 },
+            { DXGI_FORMAT_R10G10B10A2_TYPELESS, 4, 1, 1, 4, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R10G10B10A2_UNORM, 4, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R10G10B10A2_UINT, 4, 1, 1, 4, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R11G11B10_FLOAT, 4, 1, 1, 3, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_TYPELESS, 4, 1, 1, 4, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_UNORM, 4, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 4, 1, 1, 4, FormatChannelType::Unorm, true, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_UINT, 4, 1, 1, 4, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_SNORM, 4, 1, 1, 4, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8B8A8_SINT, 4, 1, 1, 4, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_TYPELESS, 4, 1, 1, 2, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_FLOAT, 4, 1, 1, 2, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_UNORM, 4, 1, 1, 2, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_UINT, 4, 1, 1, 2, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_SNORM, 4, 1, 1, 2, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16G16_SINT, 4, 1, 1, 2, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32_TYPELESS, 4, 1, 1, 1, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_D32_FLOAT, 4, 1, 1, 1, FormatChannelType::Float, false, true, false, false, 0 },
+            { DXGI_FORMAT_R32_FLOAT, 4, 1, 1, 1, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32_UINT, 4, 1, 1, 1, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R32_SINT, 4, 1, 1, 1, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R24G8_TYPELESS, 4, 1, 1, 2, FormatChannelType::Typeless, false, true, true, false, 0 },
+            { DXGI_FORMAT_D24_UNORM_S8_UINT, 4, 1, 1, 2, FormatChannelType::DepthStencil, false, true, true, false, 0 },
+            { DXGI_FORMAT_R24_UNORM_X8_TYPELESS, 4, 1, 1, 1, FormatChannelType::Unorm, false, true, false, false, 0 },
+            { DXGI_FORMAT_X24_TYPELESS_G8_UINT, 4, 1, 1, 1, FormatChannelType::Uint, false, false, true, false, 0 },
+            { DXGI_FORMAT_R8G8_TYPELESS, 2, 1, 1, 2, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8_UNORM, 2, 1, 1, 2, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8_UINT, 2, 1, 1, 2, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8_SNORM, 2, 1, 1, 2, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8_SINT, 2, 1, 1, 2, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16_TYPELESS, 2, 1, 1, 1, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16_FLOAT, 2, 1, 1, 1, FormatChannelType::Float, false, false, false, false, 0 },
+            { DXGI_FORMAT_D16_UNORM, 2, 1, 1, 1, FormatChannelType::Unorm, false, true, false, false, 0 },
+            { DXGI_FORMAT_R16_UNORM, 2, 1, 1, 1, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16_UINT, 2, 1, 1, 1, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16_SNORM, 2, 1, 1, 1, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R16_SINT, 2, 1, 1, 1, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8_TYPELESS, 1, 1, 1, 1, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8_UNORM, 1, 1, 1, 1, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8_UINT, 1, 1, 1, 1, FormatChannelType::Uint, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8_SNORM, 1, 1, 1, 1, FormatChannelType::Snorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8_SINT, 1, 1, 1, 1, FormatChannelType::Sint, false, false, false, false, 0 },
+            { DXGI_FORMAT_A8_UNORM, 1, 1, 1, 1, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R1_UNORM, 1, 8, 1, 1, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R9G9B9E5_SHAREDEXP, 4, 1, 1, 3, FormatChannelType::SharedExp, false, false, false, false, 0 },
+            { DXGI_FORMAT_R8G8_B8G8_UNORM, 4, 2, 1, 3, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_G8R8_G8B8_UNORM, 4, 2, 1, 3, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_BC1_TYPELESS, 8, 4, 4, 4, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC1_UNORM, 8, 4, 4, 4, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC1_UNORM_SRGB, 8, 4, 4, 4, FormatChannelType::Unorm, true, false, false, true, 0 },
+            { DXGI_FORMAT_BC2_TYPELESS, 16, 4, 4, 4, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC2_UNORM, 16, 4, 4, 4, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC2_UNORM_SRGB, 16, 4, 4, 4, FormatChannelType::Unorm, true, false, false, true, 0 },
+            { DXGI_FORMAT_BC3_TYPELESS, 16, 4, 4, 4, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC3_UNORM, 16, 4, 4, 4, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC3_UNORM_SRGB, 16, 4, 4, 4, FormatChannelType::Unorm, true, false, false, true, 0 },
+            { DXGI_FORMAT_BC4_TYPELESS, 8, 4, 4, 1, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC4_UNORM, 8, 4, 4, 1, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC4_SNORM, 8, 4, 4, 1, FormatChannelType::Snorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC5_TYPELESS, 16, 4, 4, 2, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC5_UNORM, 16, 4, 4, 2, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC5_SNORM, 16, 4, 4, 2, FormatChannelType::Snorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_B5G6R5_UNORM, 2, 1, 1, 3, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_B5G5R5A1_UNORM, 2, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8A8_UNORM, 4, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8X8_UNORM, 4, 1, 1, 3, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM, 4, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8A8_TYPELESS, 4, 1, 1, 4, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, 4, 1, 1, 4, FormatChannelType::Unorm, true, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8X8_TYPELESS, 4, 1, 1, 3, FormatChannelType::Typeless, false, false, false, false, 0 },
+            { DXGI_FORMAT_B8G8R8X8_UNORM_SRGB, 4, 1, 1, 3, FormatChannelType::Unorm, true, false, false, false, 0 },
+            { DXGI_FORMAT_BC6H_TYPELESS, 16, 4, 4, 3, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC6H_UF16, 16, 4, 4, 3, FormatChannelType::Float, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC6H_SF16, 16, 4, 4, 3, FormatChannelType::Float, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC7_TYPELESS, 16, 4, 4, 4, FormatChannelType::Typeless, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC7_UNORM, 16, 4, 4, 4, FormatChannelType::Unorm, false, false, false, true, 0 },
+            { DXGI_FORMAT_BC7_UNORM_SRGB, 16, 4, 4, 4, FormatChannelType::Unorm, true, false, false, true, 0 },
+            { DXGI_FORMAT_AYUV, 4, 1, 1, 4, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_Y410, 4, 1, 1, 4, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_Y416, 8, 1, 1, 4, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_NV12, 2, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 3 },
+            { DXGI_FORMAT_P010, 4, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 3 },
+            { DXGI_FORMAT_P016, 4, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 3 },
+            { DXGI_FORMAT_420_OPAQUE, 2, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 3 },
+            { DXGI_FORMAT_YUY2, 4, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_Y210, 8, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_Y216, 8, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_NV11, 4, 4, 1, 3, FormatChannelType::Video, false, false, false, false, 4 },
+            { DXGI_FORMAT_AI44, 1, 1, 1, 2, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_IA44, 1, 1, 1, 2, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_P8, 1, 1, 1, 1, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_A8P8, 2, 1, 1, 2, FormatChannelType::Video, false, false, false, false, 0 },
+            { DXGI_FORMAT_B4G4R4A4_UNORM, 2, 1, 1, 4, FormatChannelType::Unorm, false, false, false, false, 0 },
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 116 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 117 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 118 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 119 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 120 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 121 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 122 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 123 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 124 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 125 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 126 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 127 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 128 (unused)
+            { DXGI_FORMAT_UNKNOWN, 0, 1, 1, 0, FormatChannelType::Unknown, false, false, false, false, 0 }, // 129 (unused)
+            { DXGI_FORMAT_P208, 2, 2, 1, 3, FormatChannelType::Video, false, false, false, false, 4 },
+            { DXGI_FORMAT_V208, 1, 1, 1, 3, FormatChannelType::Video, false, false, false, false, 4 },
+            { DXGI_FORMAT_V408, 1, 1, 1, 3, FormatChannelType::Video, false, false, false, false, 6 }
+    } };
+
+    static constexpr FormatTraits const& getFormatTraits(DXGI_FORMAT format)
+    {
+        return static_cast<size_t>(format) < format_traits_table.size()
+            ? format_traits_table[static_cast<size_t>(format)]
+            : format_traits_table[0];
+    }
+
+    static constexpr bool isBlockCompressed(DXGI_FORMAT format)
+    {
+        return getFormatTraits(format).is_block_compressed;
+    }
+
+    static constexpr bool isSRGB(DXGI_FORMAT format)
+    {
+        return getFormatTraits(format).is_srgb;
+    }
+
+    static constexpr bool isDepthStencil(DXGI_FORMAT format)
+    {
+        return getFormatTraits(format).has_depth || getFormatTraits(format).has_stencil;
+    }
+
+    static constexpr bool isPlanar(DXGI_FORMAT format)
+    {
+        return getFormatTraits(format).plane_rows_x2 != 0;
+    }
+
+    /// Byte size of a single element (texel, vertex attribute or index). Returns 0 for formats that
+    /// do not store elements individually, i.e. block compressed, packed multi-texel and planar formats.
+    static constexpr size_t computeBytesPerElement(DXGI_FORMAT format)
+    {
+        FormatTraits const& traits = getFormatTraits(format);
+        return (traits.block_width == 1 && traits.block_height == 1 && traits.plane_rows_x2 == 0) ? traits.bytes_per_block : 0;
+    }
+
+    static constexpr uint32_t computeMipExtent(uint32_t extent, uint32_t mip_level)
+    {
+        return (extent >> mip_level) > 0 ? (extent >> mip_level) : 1;
+    }
+
+    static constexpr uint32_t computeMipLevelCount(uint32_t width, uint32_t height, uint32_t depth = 1)
+    {
+        uint32_t max_extent = width > height ? width : height;
+        max_extent = max_extent > depth ? max_extent : depth;
+
+        uint32_t retval = 1;
+        while (max_extent > 1)
+        {
+            max_extent >>= 1;
+            ++retval;
+        }
+
+        return retval;
+    }
+
+    static constexpr size_t computeRowPitch(DXGI_FORMAT format, size_t width)
+    {
+        FormatTraits const& traits = getFormatTraits(format);
+        size_t blocks = (width + traits.block_width - 1) / traits.block_width;
+        return (blocks > 0 ? blocks : 1) * traits.bytes_per_block;
+    }
+
+    /// Number of rows of blocks (or texels) in a 2D slice, including additional planes of planar formats.
+    static constexpr size_t computeRowCount(DXGI_FORMAT format, size_t height)
+    {
+        FormatTraits const& traits = getFormatTraits(format);
+        size_t rows = (height + traits.block_height - 1) / traits.block_height;
+        rows = rows > 0 ? rows : 1;
+        return traits.plane_rows_x2 != 0 ? (rows * traits.plane_rows_x2 + 1) / 2 : rows;
+    }
+
+    static constexpr size_t computeSlicePitch(DXGI_FORMAT format, size_t width, size_t height)
+    {
+        return computeRowPitch(format, width) * computeRowCount(format, height);
+    }
+
+    static constexpr size_t computeSubresourceByteSize(DXGI_FORMAT format, size_t width, size_t height, size_t depth = 1)
+    {
+        return computeSlicePitch(format, width, height) * (depth > 0 ? depth : 1);
+    }
+
+    /// IEEE 754 binary16 conversion as used by the _FLOAT 16 bit formats, rounds to nearest even.
+    inline float halfToFloat(uint16_t value)
+    {
+        uint32_t const sign = static_cast<uint32_t>(value & 0x8000) << 16;
+        uint32_t exponent = (value >> 10) & 0x1f;
+        uint32_t mantissa = value & 0x3ff;
+        uint32_t bits;
+
+        if (exponent == 0x1f)
+        {
+            bits = sign | 0x7f800000 | (mantissa << 13); // inf, nan
+        }
+        else if (exponent != 0)
+        {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        else if (mantissa != 0)
+        {
+            // denormal, normalize
+            exponent = 113;
+            while ((mantissa & 0x400) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+        else
+        {
+            bits = sign;
+        }
+
+        float retval;
+        std::memcpy(&retval, &bits, 4);
+        return retval;
+    }
+
+    inline uint16_t floatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, 4);
+
+        uint16_t const sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        int32_t const exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+        uint32_t const mantissa = bits & 0x7fffff;
+
+        if (((bits >> 23) & 0xff) == 0xff)
+        {
+            // inf, quiet nan with the upper payload bits as F16C keeps them
+            return static_cast<uint16_t>(sign | 0x7c00 | (mantissa != 0 ? 0x200 | (mantissa >> 13) : 0));
+        }
+        if (exponent >= 0x1f)
+        {
+            return static_cast<uint16_t>(sign | 0x7c00); // overflow to inf
+        }
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return sign; // underflow to zero
+            }
+            // denormal, round to nearest even
+            uint32_t const full_mantissa = mantissa | 0x800000;
+            uint32_t const shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half_mantissa = full_mantissa >> shift;
+            uint32_t const remainder = full_mantissa & ((1u << shift) - 1);
+            uint32_t const halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half_mantissa & 1)))
+                ++half_mantissa;
+            return static_cast<uint16_t>(sign | half_mantissa);
+        }
+
+        // round to nearest even, a mantissa carry correctly increments the exponent
+        uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        uint32_t const remainder = mantissa & 0x1fff;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+            ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    namespace detail
+    {
+        static constexpr bool validateFormatTraitsTable()
+        {
+            for (size_t i = 0; i < format_traits_table.size(); ++i)
+            {
+                FormatTraits const& traits = format_traits_table[i];
+                bool const is_unused = traits.format == DXGI_FORMAT_UNKNOWN && traits.bytes_per_block == 0;
+                if (!is_unused && static_cast<size_t>(traits.format) != i)
+                    return false;
+                if (traits.block_width == 0 || traits.block_height == 0)
+                    return false;
+            }
+            return true;
+        }
+    } // namespace detail
+
+    static_assert(detail::validateFormatTraitsTable(), "format_traits_table is not indexed by DXGI_FORMAT");
+    static_assert(computeBytesPerElement(DXGI_FORMAT_R32G32B32_FLOAT) == 12, "");
+    static_assert(computeBytesPerElement(DXGI_FORMAT_R16_UINT) == 2 && computeBytesPerElement(DXGI_FORMAT_R32_UINT) == 4, "");
+    static_assert(computeBytesPerElement(DXGI_FORMAT_D24_UNORM_S8_UINT) == 4, "");
+    static_assert(computeBytesPerElement(DXGI_FORMAT_BC1_UNORM) == 0, "");
+    static_assert(computeRowPitch(DXGI_FORMAT_B8G8R8A8_UNORM, 256) == 1024, "");
+    static_assert(computeRowPitch(DXGI_FORMAT_BC1_UNORM, 256) == 512, "");
+    static_assert(computeRowPitch(DXGI_FORMAT_BC7_UNORM, 2) == 16, "");
+    static_assert(computeSlicePitch(DXGI_FORMAT_BC3_UNORM, 30, 30) == 8 * 8 * 16, "");
+    static_assert(computeRowPitch(DXGI_FORMAT_R1_UNORM, 10) == 2, "");
+    static_assert(computeSlicePitch(DXGI_FORMAT_NV12, 4, 3) == 4 * 5, "");
+    static_assert(computeMipLevelCount(256, 64) == 9 && computeMipExtent(5, 2) == 1, "");
+
+} // namespace dxowl
+
+#endif // !FormatTraits_hpp
@@ -0,0 +1,186 @@
+/// <copyright file="FreeListAllocator.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef FreeListAllocator_hpp
+#define FreeListAllocator_hpp
+
+#include <cstddef>
+#include <map>
+
+namespace dxowl
+{
+    /// Best-fit offset allocator over an abstract range [0, capacity). Freed ranges are coalesced
+    /// with adjacent free ranges. Offsets and sizes are in arbitrary units (bytes, vertices, indices).
+    class FreeListAllocator
+    {
+    public:
+        static constexpr size_t InvalidOffset = ~static_cast<size_t>(0);
+
+        explicit FreeListAllocator(size_t capacity = 0);
+        ~FreeListAllocator() = default;
+
+        size_t allocate(size_t size, size_t alignment = 1);
+        void free(size_t offset, size_t size);
+        void reset(size_t capacity);
+
+        size_t getCapacity() const;
+        size_t getUsed() const;
+        size_t getFree() const;
+        size_t getLargestFreeBlock() const;
+        size_t getFreeBlockCount() const;
+
+    private:
+        typedef std::map<size_t, size_t> OffsetMap;        // offset -> size
+        typedef std::multimap<size_t, size_t> SizeMap;     // size -> offset
+
+        void insertFreeBlock(size_t offset, size_t size);
+        void eraseFreeBlock(OffsetMap::iterator it);
+
+        size_t m_capacity;
+        size_t m_used;
+        OffsetMap m_free_by_offset;
+        SizeMap m_free_by_size;
+    };
+
+    inline FreeListAllocator::FreeListAllocator(size_t capacity)
+        : m_capacity(0), m_used(0)
+    {
+        reset(capacity);
+    }
+
+    inline size_t FreeListAllocator::allocate(size_t size, size_t alignment)
+    {
+        if (size == 0)
+        {
+            return InvalidOffset;
+        }
+
+        alignment = alignment > 0 ? alignment : 1;
+
+        for (auto it = m_free_by_size.lower_bound(size); it != m_free_by_size.end(); ++it)
+        {
+            size_t block_offset = it->second;
+            size_t block_size = it->first;
+            size_t aligned_offset = ((block_offset + alignment - 1) / alignment) * alignment;
+            size_t padding = aligned_offset - block_offset;
+
+            if (padding + size > block_size)
+            {
+                continue;
+            }
+
+            eraseFreeBlock(m_free_by_offset.find(block_offset));
+
+            if (padding > 0)
+            {
+                insertFreeBlock(block_offset, padding);
+            }
+            if (block_size > padding + size)
+            {
+                insertFreeBlock(aligned_offset + size, block_size - padding - size);
+            }
+
+            m_used += size;
+            return aligned_offset;
+        }
+
+        return InvalidOffset;
+    }
+
+    inline void FreeListAllocator::free(size_t offset, size_t size)
+    {
+        if (size == 0 || offset == InvalidOffset)
+        {
+            return;
+        }
+
+        m_used -= size;
+
+        // coalesce with the following free block
+        auto next = m_free_by_offset.lower_bound(offset);
+        if (next != m_free_by_offset.end() && next->first == offset + size)
+        {
+            size += next->second;
+            eraseFreeBlock(next);
+        }
+
+        // coalesce with the preceding free block
+        auto prev = m_free_by_offset.lower_bound(offset);
+        if (prev != m_free_by_offset.begin())
+        {
+            --prev;
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                size += prev->second;
+                eraseFreeBlock(prev);
+            }
+        }
+
+        insertFreeBlock(offset, size);
+    }
+
+    inline void FreeListAllocator::reset(size_t capacity)
+    {
+        m_capacity = capacity;
+        m_used = 0;
+        m_free_by_offset.clear();
+        m_free_by_size.clear();
+
+        if (capacity > 0)
+        {
+            insertFreeBlock(0, capacity);
+        }
+    }
+
+    inline size_t FreeListAllocator::getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    inline size_t FreeListAllocator::getUsed() const
+    {
+        return m_used;
+    }
+
+    inline size_t FreeListAllocator::getFree() const
+    {
+        return m_capacity - m_used;
+    }
+
+    inline size_t FreeListAllocator::getLargestFreeBlock() const
+    {
+        return m_free_by_size.empty() ? 0 : m_free_by_size.rbegin()->first;
+    }
+
+    inline size_t FreeListAllocator::getFreeBlockCount() const
+    {
+        return m_free_by_offset.size();
+    }
+
+    inline void FreeListAllocator::insertFreeBlock(size_t offset, size_t size)
+    {
+        m_free_by_offset.emplace(offset, size);
+        m_free_by_size.emplace(size, offset);
+    }
+
+    inline void FreeListAllocator::eraseFreeBlock(OffsetMap::iterator it)
+    {
+        auto range = m_free_by_size.equal_range(it->second);
+        for (auto size_it = range.first; size_it != range.second; ++size_it)
+        {
+            if (size_it->second == it->first)
+            {
+                m_free_by_size.erase(size_it);
+                break;
+            }
+        }
+        m_free_by_offset.erase(it);
+    }
+
+} // namespace dxowl
+
+#endif // !FreeListAllocator_hpp
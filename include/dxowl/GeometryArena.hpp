@@ -0,0 +1,422 @@
+/// <copyright file="GeometryArena.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef GeometryArena_hpp
+#define GeometryArena_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "FormatTraits.hpp"
+#include "FreeListAllocator.hpp"
+#include "MemoryTracker.hpp"
+#include "StateCache.hpp"
+#include "VertexDescriptor.hpp"
+
+namespace dxowl
+{
+    /// Packs many meshes that share one vertex layout and index format into shared vertex and index
+    /// buffers. Meshes are addressed through handles that resolve to (base vertex, first index, count)
+    /// views, so a whole batch binds its buffers once and draws with DrawIndexed.
+    class GeometryArena
+    {
+    public:
+        typedef uint32_t MeshHandle;
+        static constexpr MeshHandle InvalidHandle = ~static_cast<MeshHandle>(0);
+
+        struct MeshView
+        {
+            UINT base_vertex;
+            UINT vertex_count;
+            UINT first_index;
+            UINT index_count;
+        };
+
+        struct Statistics
+        {
+            size_t mesh_count;
+            size_t vertex_capacity;
+            size_t vertices_used;
+            size_t largest_free_vertex_range;
+            size_t free_vertex_ranges;
+            size_t index_capacity;
+            size_t indices_used;
+            size_t largest_free_index_range;
+            size_t free_index_ranges;
+            size_t compaction_count;
+        };
+
+        GeometryArena(
+            ID3D11Device4* d3d11_device,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            DXGI_FORMAT const index_type,
+            size_t const vertex_capacity,
+            size_t const index_capacity,
+            D3D_PRIMITIVE_TOPOLOGY const primitive_type = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ~GeometryArena() = default;
+
+        GeometryArena(const GeometryArena& cpy) = delete;
+        GeometryArena(GeometryArena&& other) = delete;
+        GeometryArena& operator=(GeometryArena&& rhs) = delete;
+        GeometryArena& operator=(const GeometryArena& rhs) = delete;
+
+        /// Uploads a mesh into the shared buffers. Indices are local to the mesh, i.e. relative to its
+        /// base vertex. Returns InvalidHandle if there is no free range large enough; calling compact()
+        /// and retrying may succeed if the arena is fragmented.
+        template <typename VertexPtr, typename IndexPtr>
+        MeshHandle addMesh(
+            ID3D11DeviceContext4* d3d11_ctx,
+            std::vector<VertexPtr> const& vertex_data,
+            size_t const vertex_count,
+            IndexPtr const index_data,
+            size_t const index_count);
+
+        void removeMesh(MeshHandle const handle);
+
+        MeshView getMeshView(MeshHandle const handle) const;
+
+        /// Moves all live meshes to the front of freshly created buffers, removing fragmentation.
+        /// Mesh views change, handles stay valid.
+        void compact(ID3D11Device4* d3d11_device, ID3D11DeviceContext4* d3d11_ctx);
+
+        void setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx);
+        void setIndexBuffer(ID3D11DeviceContext4* d3d11_ctx);
+
+        // Bind through a StateCache, skipping bindings that are already set
+        void setVertexBuffers(StateCache& state_cache);
+        void setIndexBuffer(StateCache& state_cache);
+        void draw(ID3D11DeviceContext4* d3d11_ctx, MeshHandle const handle);
+
+        bool isCompatible(std::vector<VertexDescriptor> const& vertex_layout, DXGI_FORMAT const index_type) const;
+        std::vector<VertexDescriptor> getVertexLayout() const;
+        DXGI_FORMAT getIndexFormat() const;
+        D3D_PRIMITIVE_TOPOLOGY getPrimitiveTopology() const;
+        Statistics getStatistics() const;
+
+    private:
+        typedef Microsoft::WRL::ComPtr<ID3D11Buffer> BufferPtr;
+
+        struct MeshSlot
+        {
+            MeshView view;
+            bool alive;
+        };
+
+        void createBuffers(ID3D11Device4* d3d11_device, std::vector<BufferPtr>& vertex_buffers, BufferPtr& index_buffer) const;
+
+        static void updateBufferRange(
+            ID3D11DeviceContext4* d3d11_ctx,
+            ID3D11Buffer* buffer,
+            size_t byte_offset,
+            size_t byte_size,
+            void const* data);
+
+        std::vector<BufferPtr> m_vertex_buffers;
+        BufferPtr m_index_buffer;
+
+        std::vector<VertexDescriptor> m_vertex_layout;
+        DXGI_FORMAT m_index_format;
+        size_t m_index_byte_size;
+        D3D_PRIMITIVE_TOPOLOGY m_primitive_topology;
+
+        FreeListAllocator m_vertex_allocator;
+        FreeListAllocator m_index_allocator;
+
+        std::vector<MeshSlot> m_meshes;
+        std::vector<MeshHandle> m_free_handles;
+        size_t m_mesh_count;
+        size_t m_compaction_count;
+
+        MemoryTracker::Allocation m_memory_allocation;
+    };
+
+    inline GeometryArena::GeometryArena(
+        ID3D11Device4* d3d11_device,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        DXGI_FORMAT const index_type,
+        size_t const vertex_capacity,
+        size_t const index_capacity,
+        D3D_PRIMITIVE_TOPOLOGY const primitive_type)
+        : m_vertex_layout(vertex_layout),
+        m_index_format(index_type),
+        m_index_byte_size(computeBytesPerElement(index_type)),
+        m_primitive_topology(primitive_type),
+        m_vertex_allocator(vertex_capacity),
+        m_index_allocator(index_capacity),
+        m_mesh_count(0),
+        m_compaction_count(0)
+    {
+        createBuffers(d3d11_device, m_vertex_buffers, m_index_buffer);
+
+        size_t byte_size = m_index_allocator.getCapacity() * m_index_byte_size;
+        for (auto const& vertex_descriptor : m_vertex_layout)
+        {
+            byte_size += m_vertex_allocator.getCapacity() * vertex_descriptor.stride;
+        }
+        m_memory_allocation.setByteSize(byte_size);
+        m_memory_allocation.setCategory(MemoryTracker::Category::Mesh);
+    }
+
+    template <typename VertexPtr, typename IndexPtr>
+    inline GeometryArena::MeshHandle GeometryArena::addMesh(
+        ID3D11DeviceContext4* d3d11_ctx,
+        std::vector<VertexPtr> const& vertex_data,
+        size_t const vertex_count,
+        IndexPtr const index_data,
+        size_t const index_count)
+    {
+        size_t base_vertex = m_vertex_allocator.allocate(vertex_count);
+        if (base_vertex == FreeListAllocator::InvalidOffset)
+        {
+            return InvalidHandle;
+        }
+
+        size_t first_index = m_index_allocator.allocate(index_count);
+        if (first_index == FreeListAllocator::InvalidOffset)
+        {
+            m_vertex_allocator.free(base_vertex, vertex_count);
+            return InvalidHandle;
+        }
+
+        for (size_t i = 0; i < m_vertex_buffers.size() && i < vertex_data.size(); ++i)
+        {
+            size_t stride = m_vertex_layout[i].stride;
+            updateBufferRange(d3d11_ctx, m_vertex_buffers[i].Get(), base_vertex * stride, vertex_count * stride, vertex_data[i]);
+        }
+        updateBufferRange(d3d11_ctx, m_index_buffer.Get(), first_index * m_index_byte_size, index_count * m_index_byte_size, index_data);
+
+        MeshSlot slot = { { static_cast<UINT>(base_vertex), static_cast<UINT>(vertex_count), static_cast<UINT>(first_index), static_cast<UINT>(index_count) }, true };
+
+        MeshHandle handle;
+        if (!m_free_handles.empty())
+        {
+            handle = m_free_handles.back();
+            m_free_handles.pop_back();
+            m_meshes[handle] = slot;
+        }
+        else
+        {
+            handle = static_cast<MeshHandle>(m_meshes.size());
+            m_meshes.push_back(slot);
+        }
+        ++m_mesh_count;
+
+        return handle;
+    }
+
+    inline void GeometryArena::removeMesh(MeshHandle const handle)
+    {
+        if (handle >= m_meshes.size() || !m_meshes[handle].alive)
+        {
+            return;
+        }
+
+        MeshView const& view = m_meshes[handle].view;
+        m_vertex_allocator.free(view.base_vertex, view.vertex_count);
+        m_index_allocator.free(view.first_index, view.index_count);
+
+        m_meshes[handle].alive = false;
+        m_free_handles.push_back(handle);
+        --m_mesh_count;
+    }
+
+    inline GeometryArena::MeshView GeometryArena::getMeshView(MeshHandle const handle) const
+    {
+        if (handle < m_meshes.size() && m_meshes[handle].alive)
+            return m_meshes[handle].view;
+        else
+            return { 0, 0, 0, 0 };
+    }
+
+    inline void GeometryArena::compact(ID3D11Device4* d3d11_device, ID3D11DeviceContext4* d3d11_ctx)
+    {
+        std::vector<BufferPtr> vertex_buffers;
+        BufferPtr index_buffer;
+        createBuffers(d3d11_device, vertex_buffers, index_buffer);
+
+        // keep the relative order of meshes to preserve locality
+        std::vector<MeshHandle> live_meshes;
+        live_meshes.reserve(m_mesh_count);
+        for (MeshHandle handle = 0; handle < m_meshes.size(); ++handle)
+        {
+            if (m_meshes[handle].alive)
+                live_meshes.push_back(handle);
+        }
+        std::sort(live_meshes.begin(), live_meshes.end(), [this](MeshHandle lhs, MeshHandle rhs) {
+            return m_meshes[lhs].view.base_vertex < m_meshes[rhs].view.base_vertex;
+        });
+
+        m_vertex_allocator.reset(m_vertex_allocator.getCapacity());
+        m_index_allocator.reset(m_index_allocator.getCapacity());
+
+        for (MeshHandle handle : live_meshes)
+        {
+            MeshView& view = m_meshes[handle].view;
+
+            size_t base_vertex = m_vertex_allocator.allocate(view.vertex_count);
+            size_t first_index = m_index_allocator.allocate(view.index_count);
+
+            for (size_t i = 0; i < m_vertex_buffers.size(); ++i)
+            {
+                UINT stride = static_cast<UINT>(m_vertex_layout[i].stride);
+                D3D11_BOX src_box = { view.base_vertex * stride, 0, 0, (view.base_vertex + view.vertex_count) * stride, 1, 1 };
+                d3d11_ctx->CopySubresourceRegion(
+                    vertex_buffers[i].Get(), 0, static_cast<UINT>(base_vertex) * stride, 0, 0,
+                    m_vertex_buffers[i].Get(), 0, &src_box);
+            }
+
+            UINT index_size = static_cast<UINT>(m_index_byte_size);
+            D3D11_BOX src_box = { view.first_index * index_size, 0, 0, (view.first_index + view.index_count) * index_size, 1, 1 };
+            d3d11_ctx->CopySubresourceRegion(
+                index_buffer.Get(), 0, static_cast<UINT>(first_index) * index_size, 0, 0,
+                m_index_buffer.Get(), 0, &src_box);
+
+            view.base_vertex = static_cast<UINT>(base_vertex);
+            view.first_index = static_cast<UINT>(first_index);
+        }
+
+        m_vertex_buffers = std::move(vertex_buffers);
+        m_index_buffer = std::move(index_buffer);
+        ++m_compaction_count;
+    }
+
+    inline void GeometryArena::setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+
+        UINT vb_cnt = static_cast<UINT>(std::min<size_t>(m_vertex_buffers.size(), D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+        for (UINT i = 0; i < vb_cnt; ++i)
+        {
+            vbs[i] = m_vertex_buffers[i].Get();
+            strides[i] = static_cast<UINT>(m_vertex_layout[i].stride);
+            offsets[i] = 0;
+        }
+
+        d3d11_ctx->IASetVertexBuffers(0, vb_cnt, vbs, strides, offsets);
+    }
+
+    inline void GeometryArena::setIndexBuffer(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        d3d11_ctx->IASetIndexBuffer(m_index_buffer.Get(), m_index_format, 0);
+    }
+
+    inline void GeometryArena::setVertexBuffers(StateCache& state_cache)
+    {
+        ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+
+        UINT vb_cnt = static_cast<UINT>(std::min<size_t>(m_vertex_buffers.size(), D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+        for (UINT i = 0; i < vb_cnt; ++i)
+        {
+            vbs[i] = m_vertex_buffers[i].Get();
+            strides[i] = static_cast<UINT>(m_vertex_layout[i].stride);
+            offsets[i] = 0;
+        }
+
+        state_cache.setVertexBuffers(0, vb_cnt, vbs, strides, offsets);
+    }
+
+    inline void GeometryArena::setIndexBuffer(StateCache& state_cache)
+    {
+        state_cache.setIndexBuffer(m_index_buffer.Get(), m_index_format, 0);
+    }
+
+    inline void GeometryArena::draw(ID3D11DeviceContext4* d3d11_ctx, MeshHandle const handle)
+    {
+        MeshView view = getMeshView(handle);
+        d3d11_ctx->DrawIndexed(view.index_count, view.first_index, static_cast<INT>(view.base_vertex));
+    }
+
+    inline bool GeometryArena::isCompatible(std::vector<VertexDescriptor> const& vertex_layout, DXGI_FORMAT const index_type) const
+    {
+        return index_type == m_index_format && vertex_layout == m_vertex_layout;
+    }
+
+    inline std::vector<VertexDescriptor> GeometryArena::getVertexLayout() const
+    {
+        return m_vertex_layout;
+    }
+
+    inline DXGI_FORMAT GeometryArena::getIndexFormat() const
+    {
+        return m_index_format;
+    }
+
+    inline D3D_PRIMITIVE_TOPOLOGY GeometryArena::getPrimitiveTopology() const
+    {
+        return m_primitive_topology;
+    }
+
+    inline GeometryArena::Statistics GeometryArena::getStatistics() const
+    {
+        Statistics retval;
+        retval.mesh_count = m_mesh_count;
+        retval.vertex_capacity = m_vertex_allocator.getCapacity();
+        retval.vertices_used = m_vertex_allocator.getUsed();
+        retval.largest_free_vertex_range = m_vertex_allocator.getLargestFreeBlock();
+        retval.free_vertex_ranges = m_vertex_allocator.getFreeBlockCount();
+        retval.index_capacity = m_index_allocator.getCapacity();
+        retval.indices_used = m_index_allocator.getUsed();
+        retval.largest_free_index_range = m_index_allocator.getLargestFreeBlock();
+        retval.free_index_ranges = m_index_allocator.getFreeBlockCount();
+        retval.compaction_count = m_compaction_count;
+        return retval;
+    }
+
+    inline void GeometryArena::createBuffers(
+        ID3D11Device4* d3d11_device,
+        std::vector<BufferPtr>& vertex_buffers,
+        BufferPtr& index_buffer) const
+    {
+        vertex_buffers.resize(m_vertex_layout.size(), nullptr);
+
+        for (size_t i = 0; i < m_vertex_layout.size(); ++i)
+        {
+            const CD3D11_BUFFER_DESC vertexBufferDesc(
+                static_cast<UINT>(m_vertex_allocator.getCapacity() * m_vertex_layout[i].stride),
+                D3D11_BIND_VERTEX_BUFFER);
+            winrt::check_hresult(d3d11_device->CreateBuffer(&vertexBufferDesc, nullptr, &(vertex_buffers[i])));
+        }
+
+        const CD3D11_BUFFER_DESC indexBufferDesc(
+            static_cast<UINT>(m_index_allocator.getCapacity() * m_index_byte_size),
+            D3D11_BIND_INDEX_BUFFER);
+        winrt::check_hresult(d3d11_device->CreateBuffer(&indexBufferDesc, nullptr, &index_buffer));
+    }
+
+    inline void GeometryArena::updateBufferRange(
+        ID3D11DeviceContext4* d3d11_ctx,
+        ID3D11Buffer* buffer,
+        size_t byte_offset,
+        size_t byte_size,
+        void const* data)
+    {
+        if (data == nullptr || byte_size == 0)
+        {
+            return;
+        }
+
+        const D3D11_BOX dst_box = {
+            static_cast<UINT>(byte_offset),
+            0U,
+            0U,
+            static_cast<UINT>(byte_offset + byte_size),
+            1U,
+            1U };
+
+        d3d11_ctx->UpdateSubresource(buffer, 0, &dst_box, data, 0, 0);
+    }
+
+} // namespace dxowl
+
+#endif // !GeometryArena_hpp
@@ -0,0 +1,59 @@
+/// <copyright file="Hash.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef Hash_hpp
+#define Hash_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dxowl
+{
+    static constexpr uint64_t hash_seed = 0x9e3779b97f4a7c15ull;
+
+    static inline uint64_t hashMix(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    static inline uint64_t hashCombine(uint64_t seed, uint64_t value)
+    {
+        return hashMix(seed ^ (value + hash_seed + (seed << 6) + (seed >> 2)));
+    }
+
+    /// Non-cryptographic 64-bit content hash. Consumes 8 bytes per step.
+    static inline uint64_t hashBytes(void const* data, size_t byte_size, uint64_t seed = hash_seed)
+    {
+        auto bytes = static_cast<unsigned char const*>(data);
+        uint64_t retval = seed ^ (byte_size * 0x87c37b91114253d5ull);
+
+        size_t i = 0;
+        for (; i + 8 <= byte_size; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, 8);
+            retval = (retval ^ hashMix(word)) * 0x9fb21c651e98df25ull;
+            retval ^= retval >> 29;
+        }
+
+        uint64_t tail = 0;
+        for (size_t shift = 0; i < byte_size; ++i, shift += 8)
+        {
+            tail |= static_cast<uint64_t>(bytes[i]) << shift;
+        }
+
+        return hashMix(retval ^ hashMix(tail));
+    }
+
+} // namespace dxowl
+
+#endif // !Hash_hpp
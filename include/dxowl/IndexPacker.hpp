@@ -0,0 +1,476 @@
+/// <copyright file="IndexPacker.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef IndexPacker_hpp
+#define IndexPacker_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "FormatTraits.hpp"
+#include "MeshOptimizer.hpp"
+#include "VertexDescriptor.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define DXOWL_INDEX_SSE
+#include <immintrin.h>
+#endif
+
+namespace dxowl
+{
+    /// Shrinks index data: narrowing of R32_UINT indices to R16_UINT, splitting of large meshes into parts that each
+    /// address at most 65535 vertices, and conversion of triangle lists to strips with restart indices.
+    /// Restart indices are 0xFFFF for R16_UINT and 0xFFFFFFFF for R32_UINT, as fixed by D3D11 for strip topologies.
+    class IndexPacker
+    {
+    public:
+        static constexpr uint32_t max_index_16 = 0xFFFE;
+        static constexpr uint32_t restart_index = 0xFFFFFFFF;
+
+        struct Report
+        {
+            DXGI_FORMAT index_format_before = DXGI_FORMAT_UNKNOWN;
+            DXGI_FORMAT index_format_after = DXGI_FORMAT_UNKNOWN;
+            size_t index_bytes_before = 0;
+            size_t index_bytes_after = 0;
+            size_t vertex_bytes_before = 0;
+            size_t vertex_bytes_after = 0; // grows if split() duplicates vertices shared by parts
+
+            ptrdiff_t getBytesSaved() const;
+        };
+
+        /// A range of the split index data, draw with DrawIndexed(index_count, first_index, base_vertex).
+        struct Part
+        {
+            UINT submesh;
+            UINT first_index;
+            UINT index_count;
+            INT base_vertex;
+            UINT vertex_count;
+        };
+
+        class SplitMesh
+        {
+        public:
+            std::vector<void const*> getVertexData() const;
+            std::vector<size_t> getVertexDataByteSizes() const;
+            size_t getVertexCount() const;
+            std::vector<uint16_t> const& getIndexData() const;
+            size_t getIndexDataByteSize() const;
+            std::vector<Part> const& getParts() const;
+            Report const& getReport() const;
+
+        private:
+            friend class IndexPacker;
+
+            std::vector<std::vector<uint8_t>> m_vertex_data;
+            size_t m_vertex_count = 0;
+            std::vector<uint16_t> m_index_data;
+            std::vector<Part> m_parts;
+            Report m_report;
+        };
+
+        /// Largest index value, restart indices are skipped. Returns 0 for empty index data.
+        static uint32_t findMaxIndex(void const* index_data, size_t index_count, DXGI_FORMAT index_type);
+
+        /// True if the indices are R32_UINT and every index except restart indices fits into R16_UINT.
+        static bool canNarrow(void const* index_data, size_t index_count, DXGI_FORMAT index_type);
+
+        /// Converts R32_UINT indices to R16_UINT, restart indices are preserved. Throws if an index does not fit.
+        static std::vector<uint16_t> narrow(void const* index_data, size_t index_count);
+
+        /// Splits triangle list submeshes into parts that reference at most 65535 vertices each. Vertices are remapped
+        /// to a contiguous range per part in order of first use, vertices shared by several parts are duplicated.
+        /// Per-instance streams are copied unchanged. An empty submesh list covers all indices.
+        static SplitMesh split(
+            std::vector<void const*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            void const* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<MeshOptimizer::Submesh> const& submeshes = {});
+
+        /// Converts a triangle list into a triangle strip with restart indices, keeping the winding of every triangle.
+        /// Triangles are chained in their list order where possible, so run MeshOptimizer first.
+        /// Returns false and leaves strip_indices empty if the strip would not have fewer indices than the list.
+        static bool convertToStrip(
+            void const* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<uint32_t>& strip_indices);
+    };
+
+    inline ptrdiff_t IndexPacker::Report::getBytesSaved() const
+    {
+        return static_cast<ptrdiff_t>(index_bytes_before + vertex_bytes_before)
+            - static_cast<ptrdiff_t>(index_bytes_after + vertex_bytes_after);
+    }
+
+    inline std::vector<void const*> IndexPacker::SplitMesh::getVertexData() const
+    {
+        std::vector<void const*> retval;
+        retval.reserve(m_vertex_data.size());
+        for (auto const& stream : m_vertex_data)
+        {
+            retval.push_back(stream.data());
+        }
+        return retval;
+    }
+
+    inline std::vector<size_t> IndexPacker::SplitMesh::getVertexDataByteSizes() const
+    {
+        std::vector<size_t> retval;
+        retval.reserve(m_vertex_data.size());
+        for (auto const& stream : m_vertex_data)
+        {
+            retval.push_back(stream.size());
+        }
+        return retval;
+    }
+
+    inline size_t IndexPacker::SplitMesh::getVertexCount() const
+    {
+        return m_vertex_count;
+    }
+
+    inline std::vector<uint16_t> const& IndexPacker::SplitMesh::getIndexData() const
+    {
+        return m_index_data;
+    }
+
+    inline size_t IndexPacker::SplitMesh::getIndexDataByteSize() const
+    {
+        return m_index_data.size() * sizeof(uint16_t);
+    }
+
+    inline std::vector<IndexPacker::Part> const& IndexPacker::SplitMesh::getParts() const
+    {
+        return m_parts;
+    }
+
+    inline IndexPacker::Report const& IndexPacker::SplitMesh::getReport() const
+    {
+        return m_report;
+    }
+
+    inline uint32_t IndexPacker::findMaxIndex(void const* index_data, size_t index_count, DXGI_FORMAT index_type)
+    {
+        size_t i = 0;
+        uint32_t retval = 0;
+
+        if (index_type == DXGI_FORMAT_R32_UINT)
+        {
+            auto src = static_cast<uint32_t const*>(index_data);
+#ifdef DXOWL_INDEX_SSE
+            // SSE2 has no unsigned 32 bit max, compare with flipped sign bits instead
+            __m128i const sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+            __m128i const restart = _mm_set1_epi32(-1);
+            __m128i max = sign;
+            for (; i + 4 <= index_count; i += 4)
+            {
+                __m128i value = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+                value = _mm_andnot_si128(_mm_cmpeq_epi32(value, restart), value);
+                value = _mm_xor_si128(value, sign);
+                __m128i greater = _mm_cmpgt_epi32(value, max);
+                max = _mm_or_si128(_mm_and_si128(greater, value), _mm_andnot_si128(greater, max));
+            }
+            alignas(16) uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(max, sign));
+            retval = (std::max)((std::max)(lanes[0], lanes[1]), (std::max)(lanes[2], lanes[3]));
+#endif
+            for (; i < index_count; ++i)
+            {
+                retval = src[i] != restart_index ? (std::max)(retval, src[i]) : retval;
+            }
+        }
+        else if (index_type == DXGI_FORMAT_R16_UINT)
+        {
+            auto src = static_cast<uint16_t const*>(index_data);
+#ifdef DXOWL_INDEX_SSE
+            // signed 16 bit max on values with flipped sign bits
+            __m128i const sign = _mm_set1_epi16(static_cast<short>(0x8000));
+            __m128i const restart = _mm_set1_epi16(-1);
+            __m128i max = sign;
+            for (; i + 8 <= index_count; i += 8)
+            {
+                __m128i value = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+                value = _mm_andnot_si128(_mm_cmpeq_epi16(value, restart), value);
+                max = _mm_max_epi16(max, _mm_xor_si128(value, sign));
+            }
+            alignas(16) uint16_t lanes[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(max, sign));
+            retval = *std::max_element(lanes, lanes + 8);
+#endif
+            for (; i < index_count; ++i)
+            {
+                retval = src[i] != 0xFFFF ? std::max<uint32_t>(retval, src[i]) : retval;
+            }
+        }
+        else
+        {
+            throw std::invalid_argument("IndexPacker: index type must be R16_UINT or R32_UINT");
+        }
+
+        return retval;
+    }
+
+    inline bool IndexPacker::canNarrow(void const* index_data, size_t index_count, DXGI_FORMAT index_type)
+    {
+        return index_type == DXGI_FORMAT_R32_UINT && index_data != nullptr
+            && findMaxIndex(index_data, index_count, index_type) <= max_index_16;
+    }
+
+    inline std::vector<uint16_t> IndexPacker::narrow(void const* index_data, size_t index_count)
+    {
+        auto src = static_cast<uint32_t const*>(index_data);
+        std::vector<uint16_t> retval(index_count);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            if (src[i] > max_index_16 && src[i] != restart_index)
+            {
+                throw std::out_of_range("IndexPacker: index does not fit into R16_UINT");
+            }
+            retval[i] = static_cast<uint16_t>(src[i]);
+        }
+        return retval;
+    }
+
+    inline IndexPacker::SplitMesh IndexPacker::split(
+        std::vector<void const*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        void const* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<MeshOptimizer::Submesh> const& submeshes)
+    {
+        if (vertex_data.size() != vertex_layout.size())
+        {
+            throw std::invalid_argument("IndexPacker: one vertex stream per vertex descriptor required");
+        }
+
+        std::vector<uint32_t> indices = MeshOptimizer::readIndices(index_data, index_count, index_type);
+
+        std::vector<MeshOptimizer::Submesh> resolved_submeshes = submeshes;
+        if (resolved_submeshes.empty())
+        {
+            resolved_submeshes.push_back({ 0, static_cast<UINT>(index_count) });
+        }
+
+        SplitMesh retval;
+        retval.m_index_data.reserve(index_count);
+        retval.m_report.index_format_before = index_type;
+        retval.m_report.index_format_after = DXGI_FORMAT_R16_UINT;
+        retval.m_report.index_bytes_before = index_count * computeBytesPerElement(index_type);
+
+        // gather the vertices of every part in order of first use, local_ids[v] is valid if part_stamp[v] matches
+        std::vector<uint32_t> part_stamp(vertex_count, ~0u);
+        std::vector<uint16_t> local_ids(vertex_count, 0);
+        std::vector<uint32_t> remap;
+        uint32_t part_id = 0;
+
+        for (size_t submesh_idx = 0; submesh_idx < resolved_submeshes.size(); ++submesh_idx)
+        {
+            MeshOptimizer::Submesh const& submesh = resolved_submeshes[submesh_idx];
+            if (static_cast<size_t>(submesh.first_index) + submesh.index_count > index_count || submesh.index_count % 3 != 0)
+            {
+                throw std::invalid_argument("IndexPacker: submesh is not a triangle list inside the index data");
+            }
+
+            size_t t = submesh.first_index;
+            size_t const end = static_cast<size_t>(submesh.first_index) + submesh.index_count;
+            while (t < end)
+            {
+                Part part = {};
+                part.submesh = static_cast<UINT>(submesh_idx);
+                part.first_index = static_cast<UINT>(retval.m_index_data.size());
+                part.base_vertex = static_cast<INT>(remap.size());
+
+                size_t const part_first_vertex = remap.size();
+                for (; t < end; t += 3)
+                {
+                    UINT new_vertices = 0;
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        uint32_t v = indices[t + c];
+                        if (v >= vertex_count)
+                        {
+                            throw std::invalid_argument("IndexPacker: index out of range");
+                        }
+                        bool duplicate = (c > 0 && indices[t] == v) || (c > 1 && indices[t + 1] == v);
+                        new_vertices += (part_stamp[v] != part_id && !duplicate) ? 1 : 0;
+                    }
+                    if (remap.size() - part_first_vertex + new_vertices > max_index_16 + 1)
+                    {
+                        break;
+                    }
+
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        uint32_t v = indices[t + c];
+                        if (part_stamp[v] != part_id)
+                        {
+                            part_stamp[v] = part_id;
+                            local_ids[v] = static_cast<uint16_t>(remap.size() - part_first_vertex);
+                            remap.push_back(v);
+                        }
+                        retval.m_index_data.push_back(local_ids[v]);
+                    }
+                }
+
+                part.index_count = static_cast<UINT>(retval.m_index_data.size() - part.first_index);
+                part.vertex_count = static_cast<UINT>(remap.size() - part_first_vertex);
+                retval.m_parts.push_back(part);
+                ++part_id;
+            }
+        }
+
+        retval.m_vertex_count = remap.size();
+        retval.m_vertex_data.resize(vertex_layout.size());
+        for (size_t s = 0; s < vertex_layout.size(); ++s)
+        {
+            size_t const stride = vertex_layout[s].stride;
+            auto src = static_cast<uint8_t const*>(vertex_data[s]);
+            std::vector<uint8_t>& dst = retval.m_vertex_data[s];
+
+            if (isPerInstance(vertex_layout[s]))
+            {
+                dst.assign(src, src + vertex_count * stride);
+                continue;
+            }
+
+            retval.m_report.vertex_bytes_before += vertex_count * stride;
+            dst.resize(remap.size() * stride);
+            for (size_t i = 0; i < remap.size(); ++i)
+            {
+                std::memcpy(dst.data() + i * stride, src + remap[i] * stride, stride);
+            }
+            retval.m_report.vertex_bytes_after += dst.size();
+        }
+        retval.m_report.index_bytes_after = retval.getIndexDataByteSize();
+
+        return retval;
+    }
+
+    inline bool IndexPacker::convertToStrip(
+        void const* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<uint32_t>& strip_indices)
+    {
+        strip_indices.clear();
+        if (index_count % 3 != 0)
+        {
+            throw std::invalid_argument("IndexPacker: index data is not a triangle list");
+        }
+
+        std::vector<uint32_t> const indices = MeshOptimizer::readIndices(index_data, index_count, index_type);
+        size_t const triangle_cnt = index_count / 3;
+
+        // directed edges of all triangles, sorted for lookup of the triangle continuing a strip
+        std::vector<std::pair<uint64_t, uint32_t>> edges;
+        edges.reserve(index_count);
+        auto edgeKey = [](uint32_t from, uint32_t to) {
+            return (static_cast<uint64_t>(from) << 32) | to;
+        };
+        for (size_t t = 0; t < triangle_cnt; ++t)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                edges.push_back({ edgeKey(indices[t * 3 + c], indices[t * 3 + (c + 1) % 3]), static_cast<uint32_t>(t) });
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<bool> emitted(triangle_cnt, false);
+
+        // finds an unused triangle with the directed edge from -> to and its remaining vertex
+        auto findTriangle = [&](uint32_t from, uint32_t to, uint32_t& third) {
+            uint64_t key = edgeKey(from, to);
+            auto it = std::lower_bound(edges.begin(), edges.end(), std::make_pair(key, 0u));
+            for (; it != edges.end() && it->first == key; ++it)
+            {
+                uint32_t t = it->second;
+                if (emitted[t])
+                {
+                    continue;
+                }
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    if (indices[t * 3 + c] == from && indices[t * 3 + (c + 1) % 3] == to)
+                    {
+                        third = indices[t * 3 + (c + 2) % 3];
+                        return t;
+                    }
+                }
+            }
+            return ~0u;
+        };
+
+        strip_indices.reserve(index_count);
+        for (size_t start = 0; start < triangle_cnt; ++start)
+        {
+            if (emitted[start])
+            {
+                continue;
+            }
+
+            // start with the rotation that can be continued, triangle 1 of a strip has the reversed edge v2 -> v1
+            uint32_t const* tri = &indices[start * 3];
+            emitted[start] = true;
+            size_t rotation = 0;
+            for (size_t c = 0; c < 3; ++c)
+            {
+                uint32_t third;
+                if (findTriangle(tri[(c + 2) % 3], tri[(c + 1) % 3], third) != ~0u)
+                {
+                    rotation = c;
+                    break;
+                }
+            }
+
+            if (!strip_indices.empty())
+            {
+                strip_indices.push_back(restart_index);
+            }
+            strip_indices.push_back(tri[rotation]);
+            strip_indices.push_back(tri[(rotation + 1) % 3]);
+            strip_indices.push_back(tri[(rotation + 2) % 3]);
+
+            // even triangles are (v0, v1, v2), odd ones (v1, v0, v2) relative to their first strip vertex
+            for (size_t k = 1;; ++k)
+            {
+                size_t const n = strip_indices.size();
+                uint32_t const p = strip_indices[n - 2];
+                uint32_t const q = strip_indices[n - 1];
+                uint32_t third;
+                uint32_t t = (k % 2 == 0) ? findTriangle(p, q, third) : findTriangle(q, p, third);
+                if (t == ~0u)
+                {
+                    break;
+                }
+                emitted[t] = true;
+                strip_indices.push_back(third);
+            }
+        }
+
+        if (strip_indices.size() >= index_count)
+        {
+            strip_indices.clear();
+            return false;
+        }
+        return true;
+    }
+
+} // namespace dxowl
+
+#endif // !IndexPacker_hpp
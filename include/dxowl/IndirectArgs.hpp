@@ -0,0 +1,104 @@
+/// <copyright file="IndirectArgs.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef IndirectArgs_hpp
+#define IndirectArgs_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dxowl
+{
+    /// Argument record of DrawIndexedInstancedIndirect, laid out as the GPU reads it from a buffer created with
+    /// D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS. Independent of D3D11, so encoding can be used and checked anywhere.
+    struct DrawIndexedInstancedArgs
+    {
+        uint32_t index_count_per_instance;
+        uint32_t instance_count;
+        uint32_t start_index_location;
+        int32_t base_vertex_location;
+        uint32_t start_instance_location;
+    };
+
+    static_assert(sizeof(DrawIndexedInstancedArgs) == 5 * sizeof(uint32_t), "DrawIndexedInstancedArgs must be tightly packed");
+
+    inline DrawIndexedInstancedArgs encodeDrawIndexedInstancedArgs(
+        uint32_t index_count,
+        uint32_t instance_count,
+        uint32_t first_index,
+        int32_t base_vertex,
+        uint32_t base_instance)
+    {
+        return { index_count, instance_count, first_index, base_vertex, base_instance };
+    }
+
+    /// Writes records in the buffer layout, dst must hold count * sizeof(DrawIndexedInstancedArgs) bytes.
+    inline void writeDrawIndexedInstancedArgs(DrawIndexedInstancedArgs const* args, size_t count, void* dst)
+    {
+        std::memcpy(dst, args, count * sizeof(DrawIndexedInstancedArgs));
+    }
+
+    /// Number of indices per primitive of a list topology, 0 for strips and undefined topologies.
+    /// topology is a D3D11_PRIMITIVE_TOPOLOGY value; taken as an integer to keep this header independent of D3D11.
+    inline uint32_t computeListPrimitiveIndexCount(uint32_t topology)
+    {
+        switch (topology)
+        {
+        case 1: return 1;   // POINTLIST
+        case 2: return 2;   // LINELIST
+        case 4: return 3;   // TRIANGLELIST
+        case 10: return 4;  // LINELIST_ADJ
+        case 12: return 6;  // TRIANGLELIST_ADJ
+        default:
+            // 1 to 32 control point patch lists
+            return topology >= 33 && topology <= 64 ? topology - 32 : 0;
+        }
+    }
+
+    /// Removes records that draw nothing. For list topologies, each record is also merged into its predecessor
+    /// if it continues the predecessor's index range with the same base vertex and instances and the predecessor
+    /// ends on a whole primitive. Strips are never merged, since that would connect them.
+    /// Order is preserved. Returns the number of removed records.
+    inline size_t compactDrawIndexedInstancedArgs(std::vector<DrawIndexedInstancedArgs>& args, uint32_t topology)
+    {
+        uint32_t const primitive_index_count = computeListPrimitiveIndexCount(topology);
+
+        size_t dst = 0;
+        for (size_t src = 0; src < args.size(); ++src)
+        {
+            DrawIndexedInstancedArgs const& record = args[src];
+            if (record.index_count_per_instance == 0 || record.instance_count == 0)
+            {
+                continue;
+            }
+
+            if (dst > 0 && primitive_index_count > 0)
+            {
+                DrawIndexedInstancedArgs& prev = args[dst - 1];
+                if (prev.base_vertex_location == record.base_vertex_location
+                    && prev.instance_count == record.instance_count
+                    && prev.start_instance_location == record.start_instance_location
+                    && prev.start_index_location + prev.index_count_per_instance == record.start_index_location
+                    && prev.index_count_per_instance % primitive_index_count == 0)
+                {
+                    prev.index_count_per_instance += record.index_count_per_instance;
+                    continue;
+                }
+            }
+
+            args[dst++] = record;
+        }
+
+        size_t const removed = args.size() - dst;
+        args.resize(dst);
+        return removed;
+    }
+
+} // namespace dxowl
+
+#endif // !IndirectArgs_hpp
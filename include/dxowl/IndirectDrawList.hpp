@@ -0,0 +1,240 @@
+/// <copyright file="IndirectDrawList.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef IndirectDrawList_hpp
+#define IndirectDrawList_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "Buffer.hpp"
+#include "GeometryArena.hpp"
+#include "IndirectArgs.hpp"
+#include "StateCache.hpp"
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// CPU built list of DrawIndexedInstancedIndirect argument records for index ranges of one Mesh or
+    /// GeometryArena. Records are encoded on worker threads, uploaded with a single map into a dynamic indirect
+    /// arguments buffer and drawn with one indirect draw each, with the geometry bound by the caller.
+    /// The buffer layout matches what a GPU culling pass would write later.
+    class IndirectDrawList
+    {
+    public:
+        static constexpr UINT record_byte_size = sizeof(DrawIndexedInstancedArgs);
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t record_count = 0;
+            size_t compacted_count = 0;     // records removed or merged by compact()
+            size_t map_count = 0;
+            size_t bytes_uploaded = 0;
+            size_t indirect_draw_count = 0;
+            size_t buffer_resize_count = 0;
+        };
+
+        IndirectDrawList(ID3D11Device4* d3d11_device, size_t initial_record_capacity = 1024);
+        ~IndirectDrawList() = default;
+
+        IndirectDrawList(const IndirectDrawList& cpy) = delete;
+        IndirectDrawList(IndirectDrawList&& other) = delete;
+        IndirectDrawList& operator=(IndirectDrawList&& rhs) = delete;
+        IndirectDrawList& operator=(const IndirectDrawList& rhs) = delete;
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        void clear();
+
+        void add(UINT index_count, UINT first_index, INT base_vertex, UINT instance_count = 1, UINT base_instance = 0);
+        void add(GeometryArena const& arena, GeometryArena::MeshHandle handle, UINT instance_count = 1, UINT base_instance = 0);
+
+        /// Replaces the records with count records filled by encode (signature: void(size_t idx, DrawIndexedInstancedArgs&)).
+        /// With a thread pool, encode is called concurrently for different records.
+        template <typename EncodeFunc>
+        void build(size_t count, EncodeFunc&& encode, ThreadPool* thread_pool = nullptr);
+
+        /// See compactDrawIndexedInstancedArgs. Returns the number of removed records.
+        size_t compact(D3D11_PRIMITIVE_TOPOLOGY topology);
+
+        /// Writes all records into the indirect arguments buffer with one D3D11_MAP_WRITE_DISCARD map.
+        /// The buffer grows to 1.5 times the record count if it is too small.
+        void upload(ID3D11DeviceContext4* d3d11_ctx);
+
+        /// Issues one DrawIndexedInstancedIndirect per uploaded record.
+        void draw(ID3D11DeviceContext4* d3d11_ctx);
+        void draw(ID3D11DeviceContext4* d3d11_ctx, size_t first_record, size_t record_count);
+
+        /// Flushes pending vertex buffer changes of the cache before drawing.
+        void draw(StateCache& state_cache);
+
+        std::vector<DrawIndexedInstancedArgs> const& getRecords() const;
+        ID3D11Buffer* getBuffer() const;
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        void createBuffer(size_t record_capacity);
+
+        ID3D11Device4* m_d3d11_device;
+
+        std::vector<DrawIndexedInstancedArgs> m_records;
+        std::unique_ptr<Buffer> m_args_buffer;
+        size_t m_record_capacity;
+        size_t m_uploaded_count;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline IndirectDrawList::IndirectDrawList(ID3D11Device4* d3d11_device, size_t initial_record_capacity)
+        : m_d3d11_device(d3d11_device), m_record_capacity(0), m_uploaded_count(0)
+    {
+        createBuffer(std::max<size_t>(initial_record_capacity, 1));
+    }
+
+    inline void IndirectDrawList::beginFrame(uint64_t frame)
+    {
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void IndirectDrawList::endFrame()
+    {
+        m_current_stats.record_count = m_records.size();
+        m_last_stats = m_current_stats;
+    }
+
+    inline void IndirectDrawList::clear()
+    {
+        m_records.clear();
+    }
+
+    inline void IndirectDrawList::add(UINT index_count, UINT first_index, INT base_vertex, UINT instance_count, UINT base_instance)
+    {
+        m_records.push_back(encodeDrawIndexedInstancedArgs(index_count, instance_count, first_index, base_vertex, base_instance));
+    }
+
+    inline void IndirectDrawList::add(GeometryArena const& arena, GeometryArena::MeshHandle handle, UINT instance_count, UINT base_instance)
+    {
+        GeometryArena::MeshView view = arena.getMeshView(handle);
+        add(view.index_count, view.first_index, static_cast<INT>(view.base_vertex), instance_count, base_instance);
+    }
+
+    template <typename EncodeFunc>
+    inline void IndirectDrawList::build(size_t count, EncodeFunc&& encode, ThreadPool* thread_pool)
+    {
+        m_records.resize(count);
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, count, [this, &encode](size_t i) { encode(i, m_records[i]); }, 1024);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                encode(i, m_records[i]);
+            }
+        }
+    }
+
+    inline size_t IndirectDrawList::compact(D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        size_t removed = compactDrawIndexedInstancedArgs(m_records, static_cast<uint32_t>(topology));
+        m_current_stats.compacted_count += removed;
+        return removed;
+    }
+
+    inline void IndirectDrawList::upload(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        m_uploaded_count = m_records.size();
+        if (m_records.empty())
+        {
+            return;
+        }
+
+        if (m_records.size() > m_record_capacity)
+        {
+            createBuffer(m_records.size() + m_records.size() / 2);
+            ++m_current_stats.buffer_resize_count;
+        }
+
+        ID3D11Buffer* buffer = m_args_buffer->getBuffer().Get();
+
+        D3D11_MAPPED_SUBRESOURCE map;
+        winrt::check_hresult(d3d11_ctx->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &map));
+        writeDrawIndexedInstancedArgs(m_records.data(), m_records.size(), map.pData);
+        d3d11_ctx->Unmap(buffer, 0);
+
+        ++m_current_stats.map_count;
+        m_current_stats.bytes_uploaded += m_records.size() * record_byte_size;
+    }
+
+    inline void IndirectDrawList::draw(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        draw(d3d11_ctx, 0, m_uploaded_count);
+    }
+
+    inline void IndirectDrawList::draw(ID3D11DeviceContext4* d3d11_ctx, size_t first_record, size_t record_count)
+    {
+        if (first_record > m_uploaded_count || record_count > m_uploaded_count - first_record)
+        {
+            throw std::out_of_range("IndirectDrawList: records have not been uploaded");
+        }
+
+        ID3D11Buffer* buffer = m_args_buffer->getBuffer().Get();
+        for (size_t i = first_record; i < first_record + record_count; ++i)
+        {
+            d3d11_ctx->DrawIndexedInstancedIndirect(buffer, static_cast<UINT>(i * record_byte_size));
+        }
+        m_current_stats.indirect_draw_count += record_count;
+    }
+
+    inline void IndirectDrawList::draw(StateCache& state_cache)
+    {
+        state_cache.flush();
+        draw(state_cache.getContext());
+    }
+
+    inline std::vector<DrawIndexedInstancedArgs> const& IndirectDrawList::getRecords() const
+    {
+        return m_records;
+    }
+
+    inline ID3D11Buffer* IndirectDrawList::getBuffer() const
+    {
+        return m_args_buffer->getBuffer().Get();
+    }
+
+    inline IndirectDrawList::FrameStatistics IndirectDrawList::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline IndirectDrawList::FrameStatistics IndirectDrawList::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline void IndirectDrawList::createBuffer(size_t record_capacity)
+    {
+        D3D11_BUFFER_DESC desc = Buffer::getIndirectArgsDescriptor(static_cast<UINT>(record_capacity));
+        m_args_buffer = std::make_unique<Buffer>(m_d3d11_device, desc);
+        m_record_capacity = record_capacity;
+    }
+
+} // namespace dxowl
+
+#endif // !IndirectDrawList_hpp
@@ -0,0 +1,216 @@
+/// <copyright file="InputLayoutCache.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef InputLayoutCache_hpp
+#define InputLayoutCache_hpp
+
+#include <d3d11_4.h>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "Hash.hpp"
+#include "VertexDescriptor.hpp"
+
+namespace dxowl
+{
+    /// Shares ID3D11InputLayout objects between shader programs. Layouts are looked up by the content
+    /// hash of the vertex layout combined with the hash of the vertex shader's input signature, so
+    /// programs with different vertex shaders but identical inputs share one layout object.
+    /// Thread-safe.
+    class InputLayoutCache
+    {
+    public:
+        typedef Microsoft::WRL::ComPtr<ID3D11InputLayout> InputLayoutPtr;
+
+        struct Statistics
+        {
+            size_t hits;
+            size_t misses;
+            size_t layout_count;
+            size_t semantic_name_count;
+        };
+
+        InputLayoutCache() : m_hits(0), m_misses(0) {}
+        ~InputLayoutCache() = default;
+
+        InputLayoutCache(const InputLayoutCache& cpy) = delete;
+        InputLayoutCache(InputLayoutCache&& other) = delete;
+        InputLayoutCache& operator=(InputLayoutCache&& rhs) = delete;
+        InputLayoutCache& operator=(const InputLayoutCache& rhs) = delete;
+
+        InputLayoutPtr getInputLayout(
+            ID3D11Device4* d3d11_device,
+            std::vector<VertexDescriptor> const& vertex_desc,
+            void const* vertex_shader,
+            size_t vertex_shader_byteSize);
+
+        /// Returns a pointer to a cache-owned copy of the given semantic name that stays valid for the
+        /// lifetime of the cache. Equal names always return the same pointer.
+        LPCSTR internSemanticName(LPCSTR semantic_name);
+
+        void clear();
+
+        Statistics getStatistics() const;
+
+    private:
+        struct Entry
+        {
+            std::vector<VertexDescriptor> vertex_layout;
+            std::vector<uint8_t> input_signature;
+            InputLayoutPtr input_layout;
+        };
+
+        /// Locates the input signature chunk (ISGN/ISG1) of a DXBC container. Falls back to the whole
+        /// bytecode if the container cannot be parsed.
+        static void getInputSignature(
+            void const* vertex_shader,
+            size_t vertex_shader_byteSize,
+            uint8_t const*& signature,
+            size_t& signature_byteSize);
+
+        mutable std::mutex m_mutex;
+        std::unordered_set<std::string> m_semantic_names;
+        std::unordered_multimap<uint64_t, Entry> m_entries;
+        size_t m_hits;
+        size_t m_misses;
+    };
+
+    inline InputLayoutCache::InputLayoutPtr InputLayoutCache::getInputLayout(
+        ID3D11Device4* d3d11_device,
+        std::vector<VertexDescriptor> const& vertex_desc,
+        void const* vertex_shader,
+        size_t vertex_shader_byteSize)
+    {
+        uint8_t const* signature = nullptr;
+        size_t signature_byteSize = 0;
+        getInputSignature(vertex_shader, vertex_shader_byteSize, signature, signature_byteSize);
+
+        uint64_t key = hashCombine(computeHash(vertex_desc), hashBytes(signature, signature_byteSize));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto range = m_entries.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            Entry const& entry = it->second;
+            if (entry.input_signature.size() == signature_byteSize
+                && std::memcmp(entry.input_signature.data(), signature, signature_byteSize) == 0
+                && entry.vertex_layout == vertex_desc)
+            {
+                ++m_hits;
+                return entry.input_layout;
+            }
+        }
+
+        ++m_misses;
+
+        Entry entry;
+        entry.vertex_layout = vertex_desc;
+        entry.input_signature.assign(signature, signature + signature_byteSize);
+
+        std::vector<D3D11_INPUT_ELEMENT_DESC> attributes;
+        for (auto& vl : entry.vertex_layout)
+        {
+            for (auto& attrib : vl.attributes)
+            {
+                auto name = m_semantic_names.insert(std::string(attrib.SemanticName != nullptr ? attrib.SemanticName : ""));
+                attrib.SemanticName = name.first->c_str();
+            }
+            attributes.insert(std::end(attributes), std::begin(vl.attributes), std::end(vl.attributes));
+        }
+
+        winrt::check_hresult(
+            d3d11_device->CreateInputLayout(
+                attributes.data(),
+                static_cast<UINT>(attributes.size()),
+                vertex_shader,
+                vertex_shader_byteSize,
+                entry.input_layout.GetAddressOf()));
+
+        InputLayoutPtr retval = entry.input_layout;
+        m_entries.emplace(key, std::move(entry));
+
+        return retval;
+    }
+
+    inline LPCSTR InputLayoutCache::internSemanticName(LPCSTR semantic_name)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_semantic_names.insert(std::string(semantic_name != nullptr ? semantic_name : "")).first->c_str();
+    }
+
+    inline void InputLayoutCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // semantic names are kept, pointers handed out by internSemanticName stay valid
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    inline InputLayoutCache::Statistics InputLayoutCache::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return { m_hits, m_misses, m_entries.size(), m_semantic_names.size() };
+    }
+
+    inline void InputLayoutCache::getInputSignature(
+        void const* vertex_shader,
+        size_t vertex_shader_byteSize,
+        uint8_t const*& signature,
+        size_t& signature_byteSize)
+    {
+        auto bytes = static_cast<uint8_t const*>(vertex_shader);
+
+        signature = bytes;
+        signature_byteSize = vertex_shader_byteSize;
+
+        // DXBC header: fourcc, 16 byte digest, version, total size, chunk count, chunk offsets
+        size_t const header_byteSize = 32;
+        if (vertex_shader_byteSize < header_byteSize || std::memcmp(bytes, "DXBC", 4) != 0)
+        {
+            return;
+        }
+
+        uint32_t chunk_cnt;
+        std::memcpy(&chunk_cnt, bytes + 28, 4);
+
+        for (uint32_t i = 0; i < chunk_cnt && header_byteSize + (i + 1) * 4 <= vertex_shader_byteSize; ++i)
+        {
+            uint32_t chunk_offset;
+            std::memcpy(&chunk_offset, bytes + header_byteSize + i * 4, 4);
+
+            if (static_cast<size_t>(chunk_offset) + 8 > vertex_shader_byteSize)
+            {
+                continue;
+            }
+
+            uint32_t chunk_byteSize;
+            std::memcpy(&chunk_byteSize, bytes + chunk_offset + 4, 4);
+
+            bool const is_input_signature =
+                std::memcmp(bytes + chunk_offset, "ISGN", 4) == 0 || std::memcmp(bytes + chunk_offset, "ISG1", 4) == 0;
+
+            if (is_input_signature && static_cast<size_t>(chunk_offset) + 8 + chunk_byteSize <= vertex_shader_byteSize)
+            {
+                // include the fourcc so ISGN and ISG1 signatures never compare equal
+                signature = bytes + chunk_offset;
+                signature_byteSize = 8 + static_cast<size_t>(chunk_byteSize);
+                return;
+            }
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !InputLayoutCache_hpp
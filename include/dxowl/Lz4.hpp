@@ -0,0 +1,196 @@
+/// <copyright file="Lz4.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef Lz4_hpp
+#define Lz4_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dxowl
+{
+    /// Minimal encoder and decoder for the LZ4 block format (no frame header). The encoder is a
+    /// single-pass greedy matcher, the decoder validates all lengths and offsets against its inputs.
+    namespace lz4
+    {
+        namespace detail
+        {
+            static inline uint32_t read32(uint8_t const* ptr)
+            {
+                uint32_t retval;
+                std::memcpy(&retval, ptr, 4);
+                return retval;
+            }
+
+            static inline void writeLength(std::vector<uint8_t>& out, size_t length)
+            {
+                for (; length >= 255; length -= 255)
+                {
+                    out.push_back(255);
+                }
+                out.push_back(static_cast<uint8_t>(length));
+            }
+
+            static inline void writeSequence(
+                std::vector<uint8_t>& out,
+                uint8_t const* literals,
+                size_t literal_length,
+                size_t offset,
+                size_t match_length)
+            {
+                size_t const match_code = match_length >= 4 ? match_length - 4 : 0;
+                uint8_t token = static_cast<uint8_t>((literal_length < 15 ? literal_length : 15) << 4);
+                if (match_length > 0)
+                {
+                    token |= static_cast<uint8_t>(match_code < 15 ? match_code : 15);
+                }
+                out.push_back(token);
+
+                if (literal_length >= 15)
+                {
+                    writeLength(out, literal_length - 15);
+                }
+                out.insert(out.end(), literals, literals + literal_length);
+
+                if (match_length > 0)
+                {
+                    out.push_back(static_cast<uint8_t>(offset & 0xff));
+                    out.push_back(static_cast<uint8_t>(offset >> 8));
+                    if (match_code >= 15)
+                    {
+                        writeLength(out, match_code - 15);
+                    }
+                }
+            }
+        } // namespace detail
+
+        static inline std::vector<uint8_t> compress(void const* src, size_t src_size)
+        {
+            auto in = static_cast<uint8_t const*>(src);
+
+            std::vector<uint8_t> retval;
+            retval.reserve(src_size + src_size / 255 + 16);
+
+            // the format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+            size_t const last_literals = 5;
+            size_t const match_start_limit = src_size >= 12 ? src_size - 12 : 0;
+
+            constexpr size_t hash_bits = 12;
+            std::vector<uint32_t> table(size_t(1) << hash_bits, UINT32_MAX);
+
+            size_t ip = 0;
+            size_t anchor = 0;
+
+            while (src_size >= 13 && ip <= match_start_limit)
+            {
+                uint32_t sequence = detail::read32(in + ip);
+                uint32_t hash = (sequence * 2654435761u) >> (32 - hash_bits);
+                uint32_t ref = table[hash];
+                table[hash] = static_cast<uint32_t>(ip);
+
+                if (ref != UINT32_MAX && ip - ref <= 65535 && detail::read32(in + ref) == sequence)
+                {
+                    size_t match_length = 4;
+                    while (ip + match_length < src_size - last_literals && in[ref + match_length] == in[ip + match_length])
+                    {
+                        ++match_length;
+                    }
+
+                    detail::writeSequence(retval, in + anchor, ip - anchor, ip - ref, match_length);
+
+                    ip += match_length;
+                    anchor = ip;
+                }
+                else
+                {
+                    ++ip;
+                }
+            }
+
+            detail::writeSequence(retval, in + anchor, src_size - anchor, 0, 0);
+
+            return retval;
+        }
+
+        /// Returns false if the input is malformed or does not decode to exactly dst_size bytes.
+        static inline bool decompress(void const* src, size_t src_size, void* dst, size_t dst_size)
+        {
+            auto in = static_cast<uint8_t const*>(src);
+            auto out = static_cast<uint8_t*>(dst);
+
+            size_t ip = 0;
+            size_t op = 0;
+
+            auto readLength = [&](size_t& length) -> bool {
+                uint8_t value;
+                do
+                {
+                    if (ip >= src_size)
+                        return false;
+                    value = in[ip++];
+                    length += value;
+                } while (value == 255);
+                return true;
+            };
+
+            while (ip < src_size)
+            {
+                uint8_t token = in[ip++];
+
+                size_t literal_length = token >> 4;
+                if (literal_length == 15 && !readLength(literal_length))
+                    return false;
+                if (ip + literal_length > src_size || op + literal_length > dst_size)
+                    return false;
+
+                // dst may be null for an empty output, memcpy must not see it
+                if (literal_length > 0)
+                {
+                    std::memcpy(out + op, in + ip, literal_length);
+                }
+                ip += literal_length;
+                op += literal_length;
+
+                if (ip == src_size)
+                    break; // last sequence has no match
+
+                if (ip + 2 > src_size)
+                    return false;
+                size_t offset = static_cast<size_t>(in[ip]) | (static_cast<size_t>(in[ip + 1]) << 8);
+                ip += 2;
+                if (offset == 0 || offset > op)
+                    return false;
+
+                size_t match_length = token & 15;
+                if (match_length == 15 && !readLength(match_length))
+                    return false;
+                match_length += 4;
+                if (op + match_length > dst_size)
+                    return false;
+
+                // matches may overlap their own output
+                uint8_t const* match = out + op - offset;
+                if (offset >= match_length)
+                {
+                    std::memcpy(out + op, match, match_length);
+                }
+                else
+                {
+                    for (size_t i = 0; i < match_length; ++i)
+                        out[op + i] = match[i];
+                }
+                op += match_length;
+            }
+
+            return op == dst_size;
+        }
+    } // namespace lz4
+
+} // namespace dxowl
+
+#endif // !Lz4_hpp
@@ -0,0 +1,136 @@
+/// <copyright file="MappedFile.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MappedFile_hpp
+#define MappedFile_hpp
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dxowl
+{
+    /// Read-only memory mapping of a whole file. Pages are loaded lazily by the OS on first access.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(std::string const& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile& cpy) = delete;
+        MappedFile(MappedFile&& other) = delete;
+        MappedFile& operator=(MappedFile&& rhs) = delete;
+        MappedFile& operator=(const MappedFile& rhs) = delete;
+
+        void const* data() const;
+        size_t size() const;
+
+    private:
+        void const* m_data;
+        size_t m_size;
+
+#ifdef _WIN32
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        int m_file;
+#endif
+    };
+
+#ifdef _WIN32
+    inline MappedFile::MappedFile(std::string const& path)
+        : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+    {
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        }
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(m_file, &file_size);
+        m_size = static_cast<size_t>(file_size.QuadPart);
+
+        if (m_size > 0)
+        {
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            m_data = m_mapping != nullptr ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (m_data == nullptr)
+            {
+                if (m_mapping != nullptr)
+                    CloseHandle(m_mapping);
+                CloseHandle(m_file);
+                throw std::runtime_error("MappedFile: cannot map " + path);
+            }
+        }
+    }
+
+    inline MappedFile::~MappedFile()
+    {
+        if (m_data != nullptr)
+            UnmapViewOfFile(m_data);
+        if (m_mapping != nullptr)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+    }
+#else
+    inline MappedFile::MappedFile(std::string const& path)
+        : m_data(nullptr), m_size(0), m_file(-1)
+    {
+        m_file = open(path.c_str(), O_RDONLY);
+        if (m_file < 0)
+        {
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        }
+
+        struct stat file_stat;
+        fstat(m_file, &file_stat);
+        m_size = static_cast<size_t>(file_stat.st_size);
+
+        if (m_size > 0)
+        {
+            void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+            if (mapping == MAP_FAILED)
+            {
+                close(m_file);
+                throw std::runtime_error("MappedFile: cannot map " + path);
+            }
+            m_data = mapping;
+        }
+    }
+
+    inline MappedFile::~MappedFile()
+    {
+        if (m_data != nullptr)
+            munmap(const_cast<void*>(m_data), m_size);
+        if (m_file >= 0)
+            close(m_file);
+    }
+#endif
+
+    inline void const* MappedFile::data() const
+    {
+        return m_data;
+    }
+
+    inline size_t MappedFile::size() const
+    {
+        return m_size;
+    }
+
+} // namespace dxowl
+
+#endif // !MappedFile_hpp
@@ -0,0 +1,292 @@
+/// <copyright file="MemoryTracker.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MemoryTracker_hpp
+#define MemoryTracker_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "FormatTraits.hpp"
+
+namespace dxowl
+{
+    /// Process-wide accounting of the video memory held by dxowl resources. Every resource owns an Allocation that
+    /// registers its computed byte size on creation, updates it on resize and removes it on destruction.
+    /// Sizes are computed from the resource descriptions and ignore driver padding and alignment. Thread-safe.
+    class MemoryTracker
+    {
+    public:
+        enum class Category : uint8_t
+        {
+            Buffer,
+            Mesh,
+            Texture,
+            RenderTarget,
+            DepthStencil
+        };
+
+        static constexpr size_t category_count = 5;
+
+        struct Statistics
+        {
+            size_t total_bytes = 0;
+            size_t high_water_bytes = 0;
+            std::array<size_t, category_count> category_bytes = {};
+            std::array<size_t, category_count> category_high_water_bytes = {};
+            std::array<size_t, category_count> category_resource_count = {};
+        };
+
+        /// Registration of one resource. Default constructed allocations are not tracked until a category is set.
+        /// Moving transfers the registration and leaves the source untracked. Copies are not allowed, since a copied
+        /// resource shares its D3D11 objects and would be counted twice.
+        class Allocation
+        {
+        public:
+            Allocation();
+            Allocation(Category category, size_t byte_size);
+            ~Allocation();
+
+            Allocation(const Allocation& cpy) = delete;
+            Allocation(Allocation&& other) noexcept;
+            Allocation& operator=(Allocation&& rhs) noexcept;
+            Allocation& operator=(const Allocation& rhs) = delete;
+
+            void setCategory(Category category);
+            void setByteSize(size_t byte_size);
+
+            /// Tags group allocations across categories, e.g. by asset or render pass. Untagged allocations have an empty tag.
+            void setTag(std::string const& tag);
+
+            Category getCategory() const;
+            size_t getByteSize() const;
+            std::string const& getTag() const;
+
+        private:
+            bool m_tracked;
+            Category m_category;
+            size_t m_byte_size;
+            std::string m_tag;
+        };
+
+        static MemoryTracker& get();
+
+        MemoryTracker(const MemoryTracker& cpy) = delete;
+        MemoryTracker(MemoryTracker&& other) = delete;
+        MemoryTracker& operator=(MemoryTracker&& rhs) = delete;
+        MemoryTracker& operator=(const MemoryTracker& rhs) = delete;
+
+        Statistics getStatistics() const;
+
+        /// Live bytes per tag, tags without live bytes are omitted.
+        std::map<std::string, size_t> getTagBytes() const;
+
+        /// Restarts the high-water marks at the current totals, e.g. at the start of a level.
+        void resetHighWaterMarks();
+
+    private:
+        MemoryTracker() = default;
+
+        void add(Category category, std::string const& tag, size_t byte_size);
+        void remove(Category category, std::string const& tag, size_t byte_size);
+
+        mutable std::mutex m_mutex;
+        Statistics m_stats;
+        std::map<std::string, size_t> m_tag_bytes;
+    };
+
+    inline size_t computeResourceByteSize(D3D11_BUFFER_DESC const& desc)
+    {
+        return desc.ByteWidth;
+    }
+
+    inline size_t computeResourceByteSize(D3D11_TEXTURE2D_DESC const& desc)
+    {
+        UINT const mip_levels = desc.MipLevels > 0 ? desc.MipLevels : computeMipLevelCount(desc.Width, desc.Height);
+
+        size_t retval = 0;
+        for (UINT mip_level = 0; mip_level < mip_levels; ++mip_level)
+        {
+            retval += computeSubresourceByteSize(desc.Format, computeMipExtent(desc.Width, mip_level), computeMipExtent(desc.Height, mip_level));
+        }
+        return retval * desc.ArraySize * (std::max)(desc.SampleDesc.Count, 1u);
+    }
+
+    inline size_t computeResourceByteSize(D3D11_TEXTURE3D_DESC const& desc)
+    {
+        UINT const mip_levels = desc.MipLevels > 0 ? desc.MipLevels : computeMipLevelCount(desc.Width, desc.Height, desc.Depth);
+
+        size_t retval = 0;
+        for (UINT mip_level = 0; mip_level < mip_levels; ++mip_level)
+        {
+            retval += computeSubresourceByteSize(desc.Format,
+                computeMipExtent(desc.Width, mip_level),
+                computeMipExtent(desc.Height, mip_level),
+                computeMipExtent(desc.Depth, mip_level));
+        }
+        return retval;
+    }
+
+    inline MemoryTracker::Allocation::Allocation()
+        : m_tracked(false), m_category(Category::Buffer), m_byte_size(0)
+    {
+    }
+
+    inline MemoryTracker::Allocation::Allocation(Category category, size_t byte_size)
+        : m_tracked(true), m_category(category), m_byte_size(byte_size)
+    {
+        MemoryTracker::get().add(m_category, m_tag, m_byte_size);
+    }
+
+    inline MemoryTracker::Allocation::~Allocation()
+    {
+        if (m_tracked)
+        {
+            MemoryTracker::get().remove(m_category, m_tag, m_byte_size);
+        }
+    }
+
+    inline MemoryTracker::Allocation::Allocation(Allocation&& other) noexcept
+        : m_tracked(other.m_tracked), m_category(other.m_category), m_byte_size(other.m_byte_size), m_tag(std::move(other.m_tag))
+    {
+        other.m_tracked = false;
+        other.m_byte_size = 0;
+        other.m_tag.clear();
+    }
+
+    inline MemoryTracker::Allocation& MemoryTracker::Allocation::operator=(Allocation&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (m_tracked)
+            {
+                MemoryTracker::get().remove(m_category, m_tag, m_byte_size);
+            }
+
+            m_tracked = rhs.m_tracked;
+            m_category = rhs.m_category;
+            m_byte_size = rhs.m_byte_size;
+            m_tag = std::move(rhs.m_tag);
+
+            rhs.m_tracked = false;
+            rhs.m_byte_size = 0;
+            rhs.m_tag.clear();
+        }
+        return *this;
+    }
+
+    inline void MemoryTracker::Allocation::setCategory(Category category)
+    {
+        if (m_tracked)
+        {
+            MemoryTracker::get().remove(m_category, m_tag, m_byte_size);
+        }
+        m_tracked = true;
+        m_category = category;
+        MemoryTracker::get().add(m_category, m_tag, m_byte_size);
+    }
+
+    inline void MemoryTracker::Allocation::setByteSize(size_t byte_size)
+    {
+        if (m_tracked)
+        {
+            MemoryTracker::get().remove(m_category, m_tag, m_byte_size);
+            MemoryTracker::get().add(m_category, m_tag, byte_size);
+        }
+        m_byte_size = byte_size;
+    }
+
+    inline void MemoryTracker::Allocation::setTag(std::string const& tag)
+    {
+        if (m_tracked)
+        {
+            MemoryTracker::get().remove(m_category, m_tag, m_byte_size);
+            MemoryTracker::get().add(m_category, tag, m_byte_size);
+        }
+        m_tag = tag;
+    }
+
+    inline MemoryTracker::Category MemoryTracker::Allocation::getCategory() const
+    {
+        return m_category;
+    }
+
+    inline size_t MemoryTracker::Allocation::getByteSize() const
+    {
+        return m_byte_size;
+    }
+
+    inline std::string const& MemoryTracker::Allocation::getTag() const
+    {
+        return m_tag;
+    }
+
+    inline MemoryTracker& MemoryTracker::get()
+    {
+        static MemoryTracker tracker;
+        return tracker;
+    }
+
+    inline MemoryTracker::Statistics MemoryTracker::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    inline std::map<std::string, size_t> MemoryTracker::getTagBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tag_bytes;
+    }
+
+    inline void MemoryTracker::resetHighWaterMarks()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.high_water_bytes = m_stats.total_bytes;
+        m_stats.category_high_water_bytes = m_stats.category_bytes;
+    }
+
+    inline void MemoryTracker::add(Category category, std::string const& tag, size_t byte_size)
+    {
+        size_t const c = static_cast<size_t>(category);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.total_bytes += byte_size;
+        m_stats.high_water_bytes = (std::max)(m_stats.high_water_bytes, m_stats.total_bytes);
+        m_stats.category_bytes[c] += byte_size;
+        m_stats.category_high_water_bytes[c] = (std::max)(m_stats.category_high_water_bytes[c], m_stats.category_bytes[c]);
+        ++m_stats.category_resource_count[c];
+        if (byte_size > 0)
+        {
+            m_tag_bytes[tag] += byte_size;
+        }
+    }
+
+    inline void MemoryTracker::remove(Category category, std::string const& tag, size_t byte_size)
+    {
+        size_t const c = static_cast<size_t>(category);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.total_bytes -= byte_size;
+        m_stats.category_bytes[c] -= byte_size;
+        --m_stats.category_resource_count[c];
+
+        auto it = m_tag_bytes.find(tag);
+        if (it != m_tag_bytes.end() && (it->second -= byte_size) == 0)
+        {
+            m_tag_bytes.erase(it);
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !MemoryTracker_hpp
@@ -8,18 +8,31 @@
 #define Mesh_hpp
 
 #include <d3d11_4.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 #include <wrl.h>
 #include <winrt/base.h> // winrt::check_hresult
 
+#include "FormatTraits.hpp"
+#include "MemoryTracker.hpp"
+#include "StateCache.hpp"
+#include "StreamingRing.hpp"
 #include "VertexDescriptor.hpp"
 
 namespace dxowl
 {
+    /// Vertex buffers whose VertexDescriptor attributes use D3D11_INPUT_PER_INSTANCE_DATA hold instance data.
+    /// Their binding offsets advance with base_instance divided by the slot's InstanceDataStepRate instead of
+    /// base_vertex, and setInstanceData() refills them each frame. Create them with nullptr data and an initial
+    /// capacity in bytes.
     class Mesh
     {
     public:
+        /// Index data is stored in the given format. To store R32_UINT data whose indices fit into 16 bit as
+        /// R16_UINT, convert it with IndexPacker::canNarrow() and IndexPacker::narrow() first.
         template <typename VertexPtr, typename IndexPtr>
         Mesh(
             ID3D11Device4* d3d11_device,
@@ -60,15 +73,57 @@ namespace dxowl
             size_t byte_offset,
             IndexContainer const& indices);
 
-        void setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx, UINT const base_vertex);
+        /// Replaces the content of a per-instance vertex buffer with D3D11_MAP_WRITE_DISCARD. The buffer is
+        /// recreated with 1.5 times the required size if the instances do not fit.
+        template <typename InstanceContainer>
+        void setInstanceData(
+            ID3D11Device4* d3d11_device,
+            ID3D11DeviceContext4* d3d11_ctx,
+            size_t vertex_buffer_idx,
+            InstanceContainer const& instances);
+
+        /// Instance count of the last setInstanceData() call.
+        UINT getInstanceCount() const;
+
+        /// Binds the mesh and draws instance_count instances, e.g. getInstanceCount(), with a single DrawIndexedInstanced.
+        void drawInstanced(
+            ID3D11DeviceContext4* d3d11_ctx,
+            UINT const index_count,
+            UINT const instance_count,
+            UINT const first_index = 0,
+            UINT const base_vertex = 0,
+            UINT const base_instance = 0);
+
+        void setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx, UINT const base_vertex, UINT const base_instance = 0);
         void setIndexBuffer(ID3D11DeviceContext4* d3d11_ctx, UINT const first_index);
 
+        // Bind per-frame data streamed through a StreamingRing using this mesh's layout and index format.
+        // Throws std::logic_error if an allocation was invalidated by a discard of the ring.
+        void setVertexBuffers(
+            ID3D11DeviceContext4* d3d11_ctx,
+            StreamingRing const& ring,
+            std::vector<StreamingRing::Allocation> const& vertex_streams,
+            UINT const base_vertex,
+            UINT const base_instance = 0);
+        void setIndexBuffer(
+            ID3D11DeviceContext4* d3d11_ctx,
+            StreamingRing const& ring,
+            StreamingRing::Allocation const& index_data,
+            UINT const first_index);
+
+        // Bind through a StateCache, skipping bindings that are already set
+        void setVertexBuffers(StateCache& state_cache, UINT const base_vertex, UINT const base_instance = 0);
+        void setIndexBuffer(StateCache& state_cache, UINT const first_index);
+
         size_t getVertexBufferByteSize(size_t const idx) const;
         size_t getIndexBufferByteSize() const;
         std::vector<VertexDescriptor> getVertexLayout() const;
         DXGI_FORMAT getIndexFormat() const;
         D3D_PRIMITIVE_TOPOLOGY getPrimitiveTopology() const;
 
+        void setMemoryTag(std::string const& tag);
+        size_t getMemoryByteSize() const;
+
     private:
         typedef Microsoft::WRL::ComPtr<ID3D11Buffer> BufferPtr;
 
@@ -81,17 +136,22 @@ namespace dxowl
         DXGI_FORMAT m_index_format;
         D3D_PRIMITIVE_TOPOLOGY m_primitive_topology;
 
-        template <class T>
-        static inline std::vector<T*> unpack(
-            std::vector<Microsoft::WRL::ComPtr<T>>& ptrs)
-        {
-            std::vector<T*> retval;
-            retval.reserve(ptrs.size());
-            std::transform(ptrs.begin(), ptrs.end(), std::back_inserter(retval),
-                [](Microsoft::WRL::ComPtr<T>& p) { return p.Get(); });
+        UINT m_instance_count = 0;
 
-            return retval;
-        }
+        MemoryTracker::Allocation m_memory_allocation;
+
+        // Fills the per-slot binding arrays, which must hold D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT entries.
+        // Returns the number of used slots.
+        UINT getVertexBufferBindings(
+            UINT const base_vertex,
+            UINT const base_instance,
+            ID3D11Buffer** buffers,
+            UINT* strides,
+            UINT* offsets) const;
+
+        // First element of a vertex buffer slot for the given base vertex and instance. Per-instance slots advance
+        // once per InstanceDataStepRate instances, so base_instance must be a multiple of it; throws otherwise.
+        static UINT computeFirstElement(VertexDescriptor const& vertex_descriptor, UINT const base_vertex, UINT const base_instance);
     };
 
     template <typename VertexPtr, typename IndexPtr>
@@ -144,6 +204,14 @@ namespace dxowl
 
         //Store primitive topology
         m_primitive_topology = primitive_type;
+
+        size_t byte_size = computeResourceByteSize(m_ib_descriptor);
+        for (auto const& vb_desc : m_vb_descriptors)
+        {
+            byte_size += computeResourceByteSize(vb_desc);
+        }
+        m_memory_allocation.setByteSize(byte_size);
+        m_memory_allocation.setCategory(MemoryTracker::Category::Mesh);
     }
 
     template <typename VertexContainer, typename IndexContainer>
@@ -172,7 +240,9 @@ namespace dxowl
                     &vertexBufferDesc,
                     &vertexBufferData,
                     &(m_vertex_buffers.back())));
+            m_memory_allocation.setByteSize(m_memory_allocation.getByteSize() + computeResourceByteSize(vertexBufferDesc));
         }
+        m_memory_allocation.setCategory(MemoryTracker::Category::Mesh);
 
         //TODO index buffer?
     }
@@ -218,7 +288,7 @@ namespace dxowl
         //    byte_offset,
         //    0U,
         //    0U,
-        //    byte_offset + (indices.size() * sizeof(IndexContainer::value_type)),
+        //    byte_offset + (indices.size() * sizeof(typename IndexContainer::value_type)),
         //    1U,
         //    1U };
         //
@@ -234,35 +304,92 @@ namespace dxowl
 
         d3d11_ctx->Map(m_index_buffer.Get(), 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &map);
         auto cb = static_cast<std::byte*>(map.pData) + byte_offset;
-        std::memcpy(cb, indices.data(), indices.size() * sizeof(IndexContainer::value_type));
+        std::memcpy(cb, indices.data(), indices.size() * sizeof(typename IndexContainer::value_type));
         d3d11_ctx->Unmap(m_index_buffer.Get(), 0);
     }
 
-    inline void Mesh::setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx, UINT const base_vertex)
+    template <typename InstanceContainer>
+    inline void Mesh::setInstanceData(
+        ID3D11Device4* d3d11_device,
+        ID3D11DeviceContext4* d3d11_ctx,
+        size_t vertex_buffer_idx,
+        InstanceContainer const& instances)
+    {
+        if (vertex_buffer_idx >= m_vertex_buffers.size() || vertex_buffer_idx >= m_vertex_layout.size()
+            || !isPerInstance(m_vertex_layout[vertex_buffer_idx]))
+        {
+            throw std::invalid_argument("Mesh: vertex buffer does not hold per-instance data");
+        }
+
+        size_t byte_size = instances.size() * sizeof(typename InstanceContainer::value_type);
+        D3D11_BUFFER_DESC& vb_desc = m_vb_descriptors[vertex_buffer_idx];
+
+        if (byte_size > vb_desc.ByteWidth)
+        {
+            size_t old_byte_size = computeResourceByteSize(vb_desc);
+
+            const CD3D11_BUFFER_DESC vertexBufferDesc(static_cast<UINT>(byte_size + byte_size / 2), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
+            m_vertex_buffers[vertex_buffer_idx] = nullptr;
+            winrt::check_hresult(d3d11_device->CreateBuffer(&vertexBufferDesc, nullptr, &(m_vertex_buffers[vertex_buffer_idx])));
+            vb_desc = vertexBufferDesc;
+
+            m_memory_allocation.setByteSize(m_memory_allocation.getByteSize() - old_byte_size + computeResourceByteSize(vb_desc));
+        }
+
+        if (byte_size > 0)
+        {
+            D3D11_MAPPED_SUBRESOURCE map;
+            winrt::check_hresult(d3d11_ctx->Map(m_vertex_buffers[vertex_buffer_idx].Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &map));
+            std::memcpy(map.pData, instances.data(), byte_size);
+            d3d11_ctx->Unmap(m_vertex_buffers[vertex_buffer_idx].Get(), 0);
+        }
+
+        m_instance_count = static_cast<UINT>(instances.size());
+    }
+
+    inline UINT Mesh::getInstanceCount() const
     {
-        auto vbs = unpack(m_vertex_buffers);
+        return m_instance_count;
+    }
 
-        std::vector<UINT> strides;
-        std::vector<UINT> offsets;
-        strides.reserve(static_cast<UINT>(vbs.size()));
-        offsets.reserve(static_cast<UINT>(vbs.size()));
-        for (auto& vl : m_vertex_layout)
+    inline void Mesh::drawInstanced(
+        ID3D11DeviceContext4* d3d11_ctx,
+        UINT const index_count,
+        UINT const instance_count,
+        UINT const first_index,
+        UINT const base_vertex,
+        UINT const base_instance)
+    {
+        if (instance_count == 0)
         {
-            strides.push_back(static_cast<UINT>(vl.stride));
-            offsets.push_back(base_vertex * static_cast<UINT>(vl.stride));
+            return;
         }
 
+        // offsets are applied through the bindings, like for non-instanced draws
+        setVertexBuffers(d3d11_ctx, base_vertex, base_instance);
+        setIndexBuffer(d3d11_ctx, first_index);
+        d3d11_ctx->IASetPrimitiveTopology(m_primitive_topology);
+        d3d11_ctx->DrawIndexedInstanced(index_count, instance_count, 0, 0, 0);
+    }
+
+    inline void Mesh::setVertexBuffers(ID3D11DeviceContext4* d3d11_ctx, UINT const base_vertex, UINT const base_instance)
+    {
+        ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT vb_cnt = getVertexBufferBindings(base_vertex, base_instance, vbs, strides, offsets);
+
         d3d11_ctx->IASetVertexBuffers(
             0,
-            static_cast<UINT>(vbs.size()),
-            vbs.data(),
-            strides.data(),
-            offsets.data());
+            vb_cnt,
+            vbs,
+            strides,
+            offsets);
     }
 
     inline void Mesh::setIndexBuffer(ID3D11DeviceContext4* d3d11_ctx, UINT first_index)
     {
-        UINT offset = static_cast<UINT>(computeByteSize(m_index_format)) * first_index;
+        UINT offset = static_cast<UINT>(computeBytesPerElement(m_index_format)) * first_index;
 
         d3d11_ctx->IASetIndexBuffer(
             m_index_buffer.Get(),
@@ -270,6 +397,122 @@ namespace dxowl
             offset);
     }
 
+    inline void Mesh::setVertexBuffers(
+        ID3D11DeviceContext4* d3d11_ctx,
+        StreamingRing const& ring,
+        std::vector<StreamingRing::Allocation> const& vertex_streams,
+        UINT const base_vertex,
+        UINT const base_instance)
+    {
+        if (vertex_streams.size() > m_vertex_layout.size())
+        {
+            throw std::out_of_range("Mesh: more vertex streams than vertex buffers in the layout");
+        }
+
+        ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+
+        UINT vb_cnt = static_cast<UINT>(std::min<size_t>(vertex_streams.size(), D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+        for (UINT i = 0; i < vb_cnt; ++i)
+        {
+            if (!ring.isCurrent(vertex_streams[i]))
+            {
+                throw std::logic_error("Mesh: vertex stream was invalidated by a StreamingRing discard");
+            }
+
+            UINT stride = static_cast<UINT>(m_vertex_layout[i].stride);
+            vbs[i] = vertex_streams[i].buffer;
+            strides[i] = stride;
+            offsets[i] = vertex_streams[i].byte_offset + computeFirstElement(m_vertex_layout[i], base_vertex, base_instance) * stride;
+        }
+
+        d3d11_ctx->IASetVertexBuffers(
+            0,
+            vb_cnt,
+            vbs,
+            strides,
+            offsets);
+    }
+
+    inline void Mesh::setIndexBuffer(
+        ID3D11DeviceContext4* d3d11_ctx,
+        StreamingRing const& ring,
+        StreamingRing::Allocation const& index_data,
+        UINT const first_index)
+    {
+        if (!ring.isCurrent(index_data))
+        {
+            throw std::logic_error("Mesh: index data was invalidated by a StreamingRing discard");
+        }
+
+        UINT offset = index_data.byte_offset + static_cast<UINT>(computeBytesPerElement(m_index_format)) * first_index;
+
+        d3d11_ctx->IASetIndexBuffer(
+            index_data.buffer,
+            m_index_format,
+            offset);
+    }
+
+    inline void Mesh::setVertexBuffers(StateCache& state_cache, UINT const base_vertex, UINT const base_instance)
+    {
+        ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        UINT vb_cnt = getVertexBufferBindings(base_vertex, base_instance, vbs, strides, offsets);
+
+        state_cache.setVertexBuffers(0, vb_cnt, vbs, strides, offsets);
+    }
+
+    inline void Mesh::setIndexBuffer(StateCache& state_cache, UINT const first_index)
+    {
+        UINT offset = static_cast<UINT>(computeBytesPerElement(m_index_format)) * first_index;
+
+        state_cache.setIndexBuffer(m_index_buffer.Get(), m_index_format, offset);
+    }
+
+    inline UINT Mesh::getVertexBufferBindings(
+        UINT const base_vertex,
+        UINT const base_instance,
+        ID3D11Buffer** buffers,
+        UINT* strides,
+        UINT* offsets) const
+    {
+        UINT vb_cnt = static_cast<UINT>(std::min<size_t>(
+            (std::min)(m_vertex_buffers.size(), m_vertex_layout.size()),
+            D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+
+        for (UINT i = 0; i < vb_cnt; ++i)
+        {
+            UINT stride = static_cast<UINT>(m_vertex_layout[i].stride);
+            buffers[i] = m_vertex_buffers[i].Get();
+            strides[i] = stride;
+            offsets[i] = computeFirstElement(m_vertex_layout[i], base_vertex, base_instance) * stride;
+        }
+
+        return vb_cnt;
+    }
+
+    inline UINT Mesh::computeFirstElement(VertexDescriptor const& vertex_descriptor, UINT const base_vertex, UINT const base_instance)
+    {
+        if (!isPerInstance(vertex_descriptor))
+        {
+            return base_vertex;
+        }
+
+        // a step rate of 0 repeats the first element for all instances
+        UINT const step_rate = getInstanceDataStepRate(vertex_descriptor);
+        if (step_rate == 0)
+        {
+            return 0;
+        }
+        if (base_instance % step_rate != 0)
+        {
+            throw std::invalid_argument("Mesh: base_instance must be a multiple of the instance data step rate");
+        }
+        return base_instance / step_rate;
+    }
+
     inline size_t Mesh::getVertexBufferByteSize(size_t idx) const
     {
         if (idx < m_vb_descriptors.size())
@@ -299,6 +542,16 @@ namespace dxowl
         return m_primitive_topology;
     }
 
+    inline void Mesh::setMemoryTag(std::string const& tag)
+    {
+        m_memory_allocation.setTag(tag);
+    }
+
+    inline size_t Mesh::getMemoryByteSize() const
+    {
+        return m_memory_allocation.getByteSize();
+    }
+
 } // namespace dxowl
 
 #endif
\ No newline at end of file
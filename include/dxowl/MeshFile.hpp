@@ -0,0 +1,554 @@
+/// <copyright file="MeshFile.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MeshFile_hpp
+#define MeshFile_hpp
+
+#include <d3d11_4.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Lz4.hpp"
+#include "MappedFile.hpp"
+#include "Mesh.hpp"
+#include "ThreadPool.hpp"
+#include "VertexDescriptor.hpp"
+
+namespace dxowl
+{
+    namespace detail
+    {
+        // Mesh file layout: header, stream table (vertex streams followed by the index stream), attribute table,
+        // semantic name string table, 64 byte aligned stream data.
+        struct MeshFileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t vertex_stream_count;
+            uint32_t attribute_count;
+            uint32_t index_format;
+            uint32_t primitive_topology;
+            uint32_t string_table_byte_size;
+            uint32_t reserved;
+        };
+
+        struct MeshFileStream
+        {
+            uint64_t offset;
+            uint64_t stored_byte_size;
+            uint64_t byte_size;
+            uint32_t stride; // element byte size, the index size for the index stream
+            uint32_t flags;
+        };
+
+        struct MeshFileAttribute
+        {
+            uint32_t vertex_stream;
+            uint32_t semantic_name_offset; // into the string table
+            uint32_t semantic_index;
+            uint32_t format;
+            uint32_t input_slot;
+            uint32_t aligned_byte_offset;
+            uint32_t input_slot_class;
+            uint32_t instance_data_step_rate;
+        };
+
+        static constexpr char mesh_file_magic[4] = { 'D', 'X', 'M', 'F' };
+        static constexpr uint32_t mesh_file_version = 1;
+        static constexpr uint32_t mesh_file_stream_lz4 = 1u << 0;
+        static constexpr uint32_t mesh_file_stream_shuffled = 1u << 1; // bytes grouped by position within an element
+        static constexpr size_t mesh_file_alignment = 64;
+
+        static_assert(sizeof(MeshFileHeader) == 32, "MeshFileHeader layout");
+        static_assert(sizeof(MeshFileStream) == 32, "MeshFileStream layout");
+        static_assert(sizeof(MeshFileAttribute) == 32, "MeshFileAttribute layout");
+
+        /// Transposes elements of the given stride so that byte b of all elements is stored contiguously.
+        /// Neighbouring vertices mostly differ in their low bytes, which leaves long runs for LZ4 in the others.
+        inline void shuffleBytes(uint8_t const* src, uint8_t* dst, size_t byte_size, size_t stride)
+        {
+            size_t const element_cnt = byte_size / stride;
+            for (size_t b = 0; b < stride; ++b)
+            {
+                for (size_t i = 0; i < element_cnt; ++i)
+                {
+                    dst[b * element_cnt + i] = src[i * stride + b];
+                }
+            }
+        }
+
+        inline void unshuffleBytes(uint8_t const* src, uint8_t* dst, size_t byte_size, size_t stride)
+        {
+            size_t const element_cnt = byte_size / stride;
+            for (size_t b = 0; b < stride; ++b)
+            {
+                for (size_t i = 0; i < element_cnt; ++i)
+                {
+                    dst[i * stride + b] = src[b * element_cnt + i];
+                }
+            }
+        }
+    } // namespace detail
+
+    /// Read-only view of a mesh file. The file is memory-mapped once and uncompressed streams are handed to
+    /// Mesh as pointers into the mapping, so vertex and index data is only read by the driver on buffer creation.
+    /// Compressed streams are decoded on construction, in parallel if a thread pool is given.
+    /// Semantic names in getVertexLayout() point into the mapping, intern them (e.g. with
+    /// InputLayoutCache::internSemanticName) if the layout has to outlive the MeshFile.
+    class MeshFile
+    {
+    public:
+        explicit MeshFile(std::string const& path, ThreadPool* thread_pool = nullptr);
+        ~MeshFile() = default;
+
+        MeshFile(const MeshFile& cpy) = delete;
+        MeshFile(MeshFile&& other) = delete;
+        MeshFile& operator=(MeshFile&& rhs) = delete;
+        MeshFile& operator=(const MeshFile& rhs) = delete;
+
+        std::unique_ptr<Mesh> createMesh(ID3D11Device4* d3d11_device) const;
+
+        std::vector<void const*> const& getVertexData() const;
+        std::vector<size_t> const& getVertexDataByteSizes() const;
+        void const* getIndexData() const;
+        size_t getIndexDataByteSize() const;
+
+        std::vector<VertexDescriptor> const& getVertexLayout() const;
+        DXGI_FORMAT getIndexFormat() const;
+        D3D_PRIMITIVE_TOPOLOGY getPrimitiveTopology() const;
+
+        /// True if no stream had to be decompressed.
+        bool isZeroCopy() const;
+
+    private:
+        MappedFile m_file;
+
+        std::vector<void const*> m_vertex_data;
+        std::vector<size_t> m_vertex_data_byte_sizes;
+        void const* m_index_data;
+        size_t m_index_data_byte_size;
+
+        std::vector<VertexDescriptor> m_vertex_layout;
+        DXGI_FORMAT m_index_format;
+        D3D_PRIMITIVE_TOPOLOGY m_primitive_topology;
+
+        std::vector<std::vector<uint8_t>> m_decompressed; // one entry per stream, empty if stored uncompressed
+    };
+
+    /// Collects the streams and layout of a single indexed mesh and writes a file that can be opened with MeshFile.
+    /// The semantic names of the layout are copied when the file is written.
+    class MeshFileWriter
+    {
+    public:
+        MeshFileWriter(
+            std::vector<VertexDescriptor> const& vertex_layout,
+            DXGI_FORMAT const index_type,
+            D3D_PRIMITIVE_TOPOLOGY const primitive_type = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ~MeshFileWriter() = default;
+
+        /// Sets the data of the vertex buffer that vertex_layout[vertex_buffer_idx] describes.
+        void setVertexData(size_t vertex_buffer_idx, void const* data, size_t byte_size);
+
+        template <typename VertexContainer>
+        void setVertexData(size_t vertex_buffer_idx, VertexContainer const& vertices);
+
+        void setIndexData(void const* data, size_t byte_size);
+
+        template <typename IndexContainer>
+        void setIndexData(IndexContainer const& indices);
+
+        /// With compress set, streams are byte shuffled and LZ4 compressed if that saves space.
+        void write(std::string const& path, bool compress = false) const;
+
+    private:
+        std::vector<VertexDescriptor> m_vertex_layout;
+        DXGI_FORMAT m_index_format;
+        D3D_PRIMITIVE_TOPOLOGY m_primitive_topology;
+
+        std::vector<std::vector<uint8_t>> m_vertex_data;
+        std::vector<uint8_t> m_index_data;
+    };
+
+    inline MeshFile::MeshFile(std::string const& path, ThreadPool* thread_pool)
+        : m_file(path), m_index_data(nullptr), m_index_data_byte_size(0)
+    {
+        auto bytes = static_cast<uint8_t const*>(m_file.data());
+        uint64_t const file_size = m_file.size();
+
+        if (file_size < sizeof(detail::MeshFileHeader))
+        {
+            throw std::runtime_error("MeshFile: file too small " + path);
+        }
+
+        auto header = reinterpret_cast<detail::MeshFileHeader const*>(bytes);
+
+        uint64_t const stream_table_offset = sizeof(detail::MeshFileHeader);
+        uint64_t const stream_cnt = static_cast<uint64_t>(header->vertex_stream_count) + 1;
+        uint64_t const attribute_table_offset = stream_table_offset + stream_cnt * sizeof(detail::MeshFileStream);
+        uint64_t const string_table_offset = attribute_table_offset + static_cast<uint64_t>(header->attribute_count) * sizeof(detail::MeshFileAttribute);
+
+        bool const valid_header =
+            std::memcmp(header->magic, detail::mesh_file_magic, 4) == 0
+            && header->version == detail::mesh_file_version
+            && header->vertex_stream_count <= D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+            && (header->index_format == DXGI_FORMAT_R16_UINT || header->index_format == DXGI_FORMAT_R32_UINT)
+            && string_table_offset + header->string_table_byte_size <= file_size;
+
+        if (!valid_header)
+        {
+            throw std::runtime_error("MeshFile: invalid header " + path);
+        }
+
+        auto streams = reinterpret_cast<detail::MeshFileStream const*>(bytes + stream_table_offset);
+        auto attributes = reinterpret_cast<detail::MeshFileAttribute const*>(bytes + attribute_table_offset);
+        auto string_table = reinterpret_cast<char const*>(bytes + string_table_offset);
+
+        for (uint64_t i = 0; i < stream_cnt; ++i)
+        {
+            detail::MeshFileStream const& stream = streams[i];
+            bool const compressed = (stream.flags & detail::mesh_file_stream_lz4) != 0;
+
+            bool const valid_stream =
+                stream.offset <= file_size
+                && stream.stored_byte_size <= file_size - stream.offset
+                && stream.stride > 0
+                && stream.byte_size % stream.stride == 0
+                && stream.byte_size <= UINT32_MAX // D3D11 buffer size limit
+                && (compressed || stream.stored_byte_size == stream.byte_size);
+
+            if (!valid_stream)
+            {
+                throw std::runtime_error("MeshFile: invalid stream table " + path);
+            }
+        }
+
+        if (header->vertex_stream_count == 0 || streams[header->vertex_stream_count].byte_size == 0)
+        {
+            throw std::runtime_error("MeshFile: mesh without vertices or indices " + path);
+        }
+
+        // the string table is terminated, so every offset inside it addresses a terminated name
+        if (header->string_table_byte_size == 0 || string_table[header->string_table_byte_size - 1] != '\0')
+        {
+            throw std::runtime_error("MeshFile: invalid string table " + path);
+        }
+
+        m_vertex_layout.resize(header->vertex_stream_count);
+        for (uint32_t i = 0; i < header->vertex_stream_count; ++i)
+        {
+            m_vertex_layout[i].stride = streams[i].stride;
+        }
+
+        for (uint32_t i = 0; i < header->attribute_count; ++i)
+        {
+            detail::MeshFileAttribute const& attribute = attributes[i];
+            if (attribute.vertex_stream >= header->vertex_stream_count
+                || attribute.semantic_name_offset >= header->string_table_byte_size)
+            {
+                throw std::runtime_error("MeshFile: invalid attribute table " + path);
+            }
+
+            D3D11_INPUT_ELEMENT_DESC desc;
+            desc.SemanticName = string_table + attribute.semantic_name_offset;
+            desc.SemanticIndex = attribute.semantic_index;
+            desc.Format = static_cast<DXGI_FORMAT>(attribute.format);
+            desc.InputSlot = attribute.input_slot;
+            desc.AlignedByteOffset = attribute.aligned_byte_offset;
+            desc.InputSlotClass = static_cast<D3D11_INPUT_CLASSIFICATION>(attribute.input_slot_class);
+            desc.InstanceDataStepRate = attribute.instance_data_step_rate;
+            m_vertex_layout[attribute.vertex_stream].attributes.push_back(desc);
+        }
+
+        m_index_format = static_cast<DXGI_FORMAT>(header->index_format);
+        m_primitive_topology = static_cast<D3D_PRIMITIVE_TOPOLOGY>(header->primitive_topology);
+
+        // decode compressed streams, the others are used in place
+        m_decompressed.resize(static_cast<size_t>(stream_cnt));
+        auto decodeStream = [&](size_t stream_idx) {
+            detail::MeshFileStream const& stream = streams[stream_idx];
+            if ((stream.flags & detail::mesh_file_stream_lz4) == 0)
+            {
+                return;
+            }
+
+            std::vector<uint8_t> decoded(static_cast<size_t>(stream.byte_size));
+            if (!lz4::decompress(bytes + stream.offset, static_cast<size_t>(stream.stored_byte_size), decoded.data(), decoded.size()))
+            {
+                throw std::runtime_error("MeshFile: corrupt stream " + path);
+            }
+
+            if ((stream.flags & detail::mesh_file_stream_shuffled) != 0)
+            {
+                m_decompressed[stream_idx].resize(decoded.size());
+                detail::unshuffleBytes(decoded.data(), m_decompressed[stream_idx].data(), decoded.size(), stream.stride);
+            }
+            else
+            {
+                m_decompressed[stream_idx] = std::move(decoded);
+            }
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, static_cast<size_t>(stream_cnt), decodeStream);
+        }
+        else
+        {
+            for (size_t stream_idx = 0; stream_idx < stream_cnt; ++stream_idx)
+            {
+                decodeStream(stream_idx);
+            }
+        }
+
+        auto streamData = [&](size_t stream_idx) -> void const* {
+            return (streams[stream_idx].flags & detail::mesh_file_stream_lz4) != 0
+                ? static_cast<void const*>(m_decompressed[stream_idx].data())
+                : static_cast<void const*>(bytes + streams[stream_idx].offset);
+        };
+
+        for (uint32_t i = 0; i < header->vertex_stream_count; ++i)
+        {
+            m_vertex_data.push_back(streamData(i));
+            m_vertex_data_byte_sizes.push_back(static_cast<size_t>(streams[i].byte_size));
+        }
+        m_index_data = streamData(header->vertex_stream_count);
+        m_index_data_byte_size = static_cast<size_t>(streams[header->vertex_stream_count].byte_size);
+    }
+
+    inline std::unique_ptr<Mesh> MeshFile::createMesh(ID3D11Device4* d3d11_device) const
+    {
+        return std::make_unique<Mesh>(
+            d3d11_device,
+            m_vertex_data,
+            m_vertex_data_byte_sizes,
+            m_index_data,
+            m_index_data_byte_size,
+            m_vertex_layout,
+            m_index_format,
+            m_primitive_topology);
+    }
+
+    inline std::vector<void const*> const& MeshFile::getVertexData() const
+    {
+        return m_vertex_data;
+    }
+
+    inline std::vector<size_t> const& MeshFile::getVertexDataByteSizes() const
+    {
+        return m_vertex_data_byte_sizes;
+    }
+
+    inline void const* MeshFile::getIndexData() const
+    {
+        return m_index_data;
+    }
+
+    inline size_t MeshFile::getIndexDataByteSize() const
+    {
+        return m_index_data_byte_size;
+    }
+
+    inline std::vector<VertexDescriptor> const& MeshFile::getVertexLayout() const
+    {
+        return m_vertex_layout;
+    }
+
+    inline DXGI_FORMAT MeshFile::getIndexFormat() const
+    {
+        return m_index_format;
+    }
+
+    inline D3D_PRIMITIVE_TOPOLOGY MeshFile::getPrimitiveTopology() const
+    {
+        return m_primitive_topology;
+    }
+
+    inline bool MeshFile::isZeroCopy() const
+    {
+        for (auto const& stream : m_decompressed)
+        {
+            if (!stream.empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline MeshFileWriter::MeshFileWriter(
+        std::vector<VertexDescriptor> const& vertex_layout,
+        DXGI_FORMAT const index_type,
+        D3D_PRIMITIVE_TOPOLOGY const primitive_type)
+        : m_vertex_layout(vertex_layout), m_index_format(index_type), m_primitive_topology(primitive_type),
+          m_vertex_data(vertex_layout.size())
+    {
+        if (index_type != DXGI_FORMAT_R16_UINT && index_type != DXGI_FORMAT_R32_UINT)
+        {
+            throw std::invalid_argument("MeshFileWriter: index type must be R16_UINT or R32_UINT");
+        }
+        for (auto const& vertex_descriptor : vertex_layout)
+        {
+            if (vertex_descriptor.stride == 0)
+            {
+                throw std::invalid_argument("MeshFileWriter: vertex stride must not be 0");
+            }
+        }
+    }
+
+    inline void MeshFileWriter::setVertexData(size_t vertex_buffer_idx, void const* data, size_t byte_size)
+    {
+        if (vertex_buffer_idx >= m_vertex_data.size() || byte_size % m_vertex_layout[vertex_buffer_idx].stride != 0)
+        {
+            throw std::invalid_argument("MeshFileWriter: vertex data does not match the vertex layout");
+        }
+        auto bytes = static_cast<uint8_t const*>(data);
+        m_vertex_data[vertex_buffer_idx].assign(bytes, bytes + byte_size);
+    }
+
+    template <typename VertexContainer>
+    inline void MeshFileWriter::setVertexData(size_t vertex_buffer_idx, VertexContainer const& vertices)
+    {
+        setVertexData(vertex_buffer_idx, vertices.data(), vertices.size() * sizeof(typename VertexContainer::value_type));
+    }
+
+    inline void MeshFileWriter::setIndexData(void const* data, size_t byte_size)
+    {
+        if (byte_size % computeBytesPerElement(m_index_format) != 0)
+        {
+            throw std::invalid_argument("MeshFileWriter: index data does not match the index type");
+        }
+        auto bytes = static_cast<uint8_t const*>(data);
+        m_index_data.assign(bytes, bytes + byte_size);
+    }
+
+    template <typename IndexContainer>
+    inline void MeshFileWriter::setIndexData(IndexContainer const& indices)
+    {
+        setIndexData(indices.data(), indices.size() * sizeof(typename IndexContainer::value_type));
+    }
+
+    inline void MeshFileWriter::write(std::string const& path, bool compress) const
+    {
+        std::vector<detail::MeshFileAttribute> attributes;
+        std::string string_table;
+
+        for (size_t i = 0; i < m_vertex_layout.size(); ++i)
+        {
+            for (auto const& attrib : m_vertex_layout[i].attributes)
+            {
+                detail::MeshFileAttribute attribute = {};
+                attribute.vertex_stream = static_cast<uint32_t>(i);
+                attribute.semantic_name_offset = static_cast<uint32_t>(string_table.size());
+                attribute.semantic_index = attrib.SemanticIndex;
+                attribute.format = static_cast<uint32_t>(attrib.Format);
+                attribute.input_slot = attrib.InputSlot;
+                attribute.aligned_byte_offset = attrib.AlignedByteOffset;
+                attribute.input_slot_class = static_cast<uint32_t>(attrib.InputSlotClass);
+                attribute.instance_data_step_rate = attrib.InstanceDataStepRate;
+                attributes.push_back(attribute);
+
+                string_table.append(attrib.SemanticName != nullptr ? attrib.SemanticName : "");
+                string_table.push_back('\0');
+            }
+        }
+        if (string_table.empty())
+        {
+            string_table.push_back('\0');
+        }
+
+        size_t const stream_cnt = m_vertex_data.size() + 1;
+        std::vector<detail::MeshFileStream> streams(stream_cnt);
+
+        size_t const tables_byte_size = sizeof(detail::MeshFileHeader)
+            + stream_cnt * sizeof(detail::MeshFileStream)
+            + attributes.size() * sizeof(detail::MeshFileAttribute)
+            + string_table.size();
+        std::vector<uint8_t> data(tables_byte_size, 0);
+
+        for (size_t i = 0; i < stream_cnt; ++i)
+        {
+            bool const is_index_stream = i == m_vertex_data.size();
+            std::vector<uint8_t> const& stream_data = is_index_stream ? m_index_data : m_vertex_data[i];
+
+            data.resize(((data.size() + detail::mesh_file_alignment - 1) / detail::mesh_file_alignment) * detail::mesh_file_alignment, 0);
+
+            detail::MeshFileStream& stream = streams[i];
+            stream.offset = data.size();
+            stream.byte_size = stream_data.size();
+            stream.stride = static_cast<uint32_t>(is_index_stream ? computeBytesPerElement(m_index_format) : m_vertex_layout[i].stride);
+
+            std::vector<uint8_t> compressed;
+            uint32_t compressed_flags = detail::mesh_file_stream_lz4;
+            if (compress && !stream_data.empty())
+            {
+                if (stream.stride > 1)
+                {
+                    std::vector<uint8_t> shuffled(stream_data.size());
+                    detail::shuffleBytes(stream_data.data(), shuffled.data(), stream_data.size(), stream.stride);
+                    compressed = lz4::compress(shuffled.data(), shuffled.size());
+                    compressed_flags |= detail::mesh_file_stream_shuffled;
+                }
+                else
+                {
+                    compressed = lz4::compress(stream_data.data(), stream_data.size());
+                }
+            }
+
+            // only keep the compressed variant if it actually saves space
+            if (compress && !stream_data.empty() && compressed.size() < stream_data.size())
+            {
+                stream.flags = compressed_flags;
+                stream.stored_byte_size = compressed.size();
+                data.insert(data.end(), compressed.begin(), compressed.end());
+            }
+            else
+            {
+                stream.stored_byte_size = stream.byte_size;
+                data.insert(data.end(), stream_data.begin(), stream_data.end());
+            }
+        }
+
+        detail::MeshFileHeader header = {};
+        std::memcpy(header.magic, detail::mesh_file_magic, 4);
+        header.version = detail::mesh_file_version;
+        header.vertex_stream_count = static_cast<uint32_t>(m_vertex_data.size());
+        header.attribute_count = static_cast<uint32_t>(attributes.size());
+        header.index_format = static_cast<uint32_t>(m_index_format);
+        header.primitive_topology = static_cast<uint32_t>(m_primitive_topology);
+        header.string_table_byte_size = static_cast<uint32_t>(string_table.size());
+
+        uint8_t* tables = data.data();
+        std::memcpy(tables, &header, sizeof(header));
+        tables += sizeof(header);
+        std::memcpy(tables, streams.data(), streams.size() * sizeof(detail::MeshFileStream));
+        tables += streams.size() * sizeof(detail::MeshFileStream);
+        if (!attributes.empty())
+        {
+            std::memcpy(tables, attributes.data(), attributes.size() * sizeof(detail::MeshFileAttribute));
+            tables += attributes.size() * sizeof(detail::MeshFileAttribute);
+        }
+        std::memcpy(tables, string_table.data(), string_table.size());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("MeshFileWriter: cannot open " + path);
+        }
+        file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            throw std::runtime_error("MeshFileWriter: cannot write " + path);
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !MeshFile_hpp
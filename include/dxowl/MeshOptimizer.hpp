@@ -0,0 +1,888 @@
+/// <copyright file="MeshOptimizer.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MeshOptimizer_hpp
+#define MeshOptimizer_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "FormatTraits.hpp"
+#include "ThreadPool.hpp"
+#include "VertexDescriptor.hpp"
+
+namespace dxowl
+{
+    /// Reorders indexed triangle list data before it is handed to Mesh. Triangles of each submesh are reordered
+    /// for the post-transform vertex cache, then grouped into clusters that are sorted to draw outward facing
+    /// geometry first, which reduces overdraw. Finally, all per-vertex streams are reordered to the order of
+    /// first use so vertex fetch reads memory linearly. Index values are absolute, i.e. submeshes are drawn with
+    /// a base vertex of 0, and they may share vertices.
+    class MeshOptimizer
+    {
+    public:
+        enum class Algorithm
+        {
+            Tipsify, // Sander et al. 2007, linear time, tuned to the given cache size
+            Forsyth  // Forsyth 2006, LRU score based, less sensitive to the actual cache size
+        };
+
+        struct Settings
+        {
+            Algorithm algorithm = Algorithm::Tipsify;
+            UINT cache_size = 16;                // FIFO entries, used by Tipsify and for the statistics
+            float overdraw_threshold = 1.05f;    // tolerated relative ACMR increase for overdraw sorting, 0 disables it
+            bool optimize_vertex_fetch = true;
+        };
+
+        struct Submesh
+        {
+            UINT first_index;
+            UINT index_count;
+        };
+
+        struct CacheStatistics
+        {
+            size_t triangles = 0;
+            size_t vertices_transformed = 0;
+            size_t vertices_referenced = 0;
+            float acmr = 0.0f; // average cache miss ratio, transformed vertices per triangle
+            float atvr = 0.0f; // average transformed to referenced vertex ratio, 1 is optimal
+        };
+
+        struct Report
+        {
+            CacheStatistics before;
+            CacheStatistics after;
+            size_t cluster_count = 0;
+            bool overdraw_sorted = false; // false if disabled or the layout has no float POSITION attribute
+        };
+
+        /// Simulates a FIFO post-transform cache of the given size, emptied at the start of every submesh.
+        /// An empty submesh list covers all indices.
+        static CacheStatistics analyzeVertexCache(
+            void const* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            size_t vertex_count,
+            std::vector<Submesh> const& submeshes,
+            UINT cache_size = 16);
+
+        /// Optimizes index and vertex data in place. vertex_data holds one stream of vertex_count elements per
+        /// vertex descriptor, streams with per-instance attributes are left untouched. Submeshes must not overlap.
+        static Report optimize(
+            std::vector<void*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            void* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<Submesh> const& submeshes,
+            Settings const& settings,
+            ThreadPool* thread_pool = nullptr);
+
+        static Report optimize(
+            std::vector<void*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            void* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<Submesh> const& submeshes = {},
+            ThreadPool* thread_pool = nullptr);
+
+        /// Widens R16_UINT or R32_UINT index data to 32 bit and back. Throws for other index types.
+        static std::vector<uint32_t> readIndices(void const* index_data, size_t index_count, DXGI_FORMAT index_type);
+        static void writeIndices(std::vector<uint32_t> const& indices, void* index_data, DXGI_FORMAT index_type);
+
+    private:
+        static constexpr uint32_t invalid_index = ~0u;
+        static constexpr UINT forsyth_cache_size = 32;
+
+        /// Triangles of one submesh with vertices renumbered to a compact local range.
+        struct LocalMesh
+        {
+            std::vector<uint32_t> indices;        // local vertex ids
+            std::vector<uint32_t> global_ids;     // local to global vertex id
+            std::vector<uint32_t> adjacency_offsets;
+            std::vector<uint32_t> adjacency;      // triangles per local vertex
+        };
+
+        struct PositionAccessor
+        {
+            uint8_t const* data = nullptr;
+            size_t stride = 0;
+            size_t offset = 0;
+
+            bool isValid() const;
+            void load(uint32_t vertex, float (&position)[3]) const;
+        };
+
+        static std::vector<Submesh> resolveSubmeshes(std::vector<Submesh> const& submeshes, size_t index_count);
+
+        static LocalMesh buildLocalMesh(uint32_t const* indices, size_t index_count);
+
+        /// Both return the triangle order and the positions in that order where the cache had to be restarted.
+        static void orderTipsify(LocalMesh const& mesh, UINT cache_size, std::vector<uint32_t>& order, std::vector<uint32_t>& hard_boundaries);
+        static void orderForsyth(LocalMesh const& mesh, std::vector<uint32_t>& order, std::vector<uint32_t>& hard_boundaries);
+
+        /// Splits hard clusters wherever the ACMR so far is within threshold of the cluster's ACMR.
+        static std::vector<uint32_t> computeSoftBoundaries(
+            LocalMesh const& mesh,
+            std::vector<uint32_t> const& order,
+            std::vector<uint32_t> const& hard_boundaries,
+            UINT cache_size,
+            float threshold);
+
+        static void sortClusters(
+            LocalMesh const& mesh,
+            PositionAccessor const& positions,
+            std::vector<uint32_t>& order,
+            std::vector<uint32_t> const& boundaries);
+
+        static size_t optimizeSubmesh(
+            uint32_t* indices,
+            size_t index_count,
+            PositionAccessor const& positions,
+            Settings const& settings);
+
+        static void remapVertexFetch(
+            std::vector<void*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            std::vector<uint32_t>& indices,
+            ThreadPool* thread_pool);
+
+        static PositionAccessor findPositions(std::vector<void*> const& vertex_data, std::vector<VertexDescriptor> const& vertex_layout);
+    };
+
+    inline MeshOptimizer::CacheStatistics MeshOptimizer::analyzeVertexCache(
+        void const* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        size_t vertex_count,
+        std::vector<Submesh> const& submeshes,
+        UINT cache_size)
+    {
+        std::vector<uint32_t> indices = readIndices(index_data, index_count, index_type);
+
+        CacheStatistics retval;
+        std::vector<uint64_t> cache_time(vertex_count, 0);
+        std::vector<bool> referenced(vertex_count, false);
+        uint64_t time = static_cast<uint64_t>(cache_size) + 1;
+
+        for (Submesh const& submesh : resolveSubmeshes(submeshes, index_count))
+        {
+            // vertices cached before the submesh appear to be older than the cache size
+            time += cache_size + 1;
+
+            for (size_t i = submesh.first_index; i < submesh.first_index + submesh.index_count; ++i)
+            {
+                uint32_t v = indices[i];
+                if (v >= vertex_count)
+                {
+                    throw std::invalid_argument("MeshOptimizer: index out of range");
+                }
+                if (time - cache_time[v] > cache_size)
+                {
+                    cache_time[v] = time++;
+                    ++retval.vertices_transformed;
+                }
+                if (!referenced[v])
+                {
+                    referenced[v] = true;
+                    ++retval.vertices_referenced;
+                }
+            }
+            retval.triangles += submesh.index_count / 3;
+        }
+
+        retval.acmr = retval.triangles > 0 ? static_cast<float>(retval.vertices_transformed) / retval.triangles : 0.0f;
+        retval.atvr = retval.vertices_referenced > 0 ? static_cast<float>(retval.vertices_transformed) / retval.vertices_referenced : 0.0f;
+        return retval;
+    }
+
+    inline MeshOptimizer::Report MeshOptimizer::optimize(
+        std::vector<void*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        void* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<Submesh> const& submeshes,
+        Settings const& settings,
+        ThreadPool* thread_pool)
+    {
+        if (vertex_data.size() != vertex_layout.size())
+        {
+            throw std::invalid_argument("MeshOptimizer: one vertex stream per vertex descriptor required");
+        }
+        if (settings.cache_size == 0)
+        {
+            throw std::invalid_argument("MeshOptimizer: cache size must not be 0");
+        }
+
+        std::vector<Submesh> const resolved_submeshes = resolveSubmeshes(submeshes, index_count);
+
+        Report report;
+        report.before = analyzeVertexCache(index_data, index_count, index_type, vertex_count, resolved_submeshes, settings.cache_size);
+
+        std::vector<uint32_t> indices = readIndices(index_data, index_count, index_type);
+        PositionAccessor const positions = settings.overdraw_threshold > 0.0f ? findPositions(vertex_data, vertex_layout) : PositionAccessor();
+        report.overdraw_sorted = positions.isValid();
+
+        std::vector<size_t> cluster_counts(resolved_submeshes.size(), 0);
+        auto optimizeRange = [&](size_t submesh_idx) {
+            Submesh const& submesh = resolved_submeshes[submesh_idx];
+            cluster_counts[submesh_idx] = optimizeSubmesh(indices.data() + submesh.first_index, submesh.index_count, positions, settings);
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, resolved_submeshes.size(), optimizeRange);
+        }
+        else
+        {
+            for (size_t submesh_idx = 0; submesh_idx < resolved_submeshes.size(); ++submesh_idx)
+            {
+                optimizeRange(submesh_idx);
+            }
+        }
+        report.cluster_count = std::accumulate(cluster_counts.begin(), cluster_counts.end(), size_t(0));
+
+        if (settings.optimize_vertex_fetch)
+        {
+            remapVertexFetch(vertex_data, vertex_count, vertex_layout, indices, thread_pool);
+        }
+
+        writeIndices(indices, index_data, index_type);
+
+        report.after = analyzeVertexCache(index_data, index_count, index_type, vertex_count, resolved_submeshes, settings.cache_size);
+        return report;
+    }
+
+    inline MeshOptimizer::Report MeshOptimizer::optimize(
+        std::vector<void*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        void* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<Submesh> const& submeshes,
+        ThreadPool* thread_pool)
+    {
+        return optimize(vertex_data, vertex_count, vertex_layout, index_data, index_count, index_type, submeshes, Settings(), thread_pool);
+    }
+
+    inline bool MeshOptimizer::PositionAccessor::isValid() const
+    {
+        return data != nullptr;
+    }
+
+    inline void MeshOptimizer::PositionAccessor::load(uint32_t vertex, float (&position)[3]) const
+    {
+        std::memcpy(position, data + vertex * stride + offset, sizeof(position));
+    }
+
+    inline std::vector<uint32_t> MeshOptimizer::readIndices(void const* index_data, size_t index_count, DXGI_FORMAT index_type)
+    {
+        std::vector<uint32_t> retval(index_count);
+        if (index_type == DXGI_FORMAT_R16_UINT)
+        {
+            auto src = static_cast<uint16_t const*>(index_data);
+            std::copy(src, src + index_count, retval.begin());
+        }
+        else if (index_type == DXGI_FORMAT_R32_UINT)
+        {
+            std::memcpy(retval.data(), index_data, index_count * sizeof(uint32_t));
+        }
+        else
+        {
+            throw std::invalid_argument("MeshOptimizer: index type must be R16_UINT or R32_UINT");
+        }
+        return retval;
+    }
+
+    inline void MeshOptimizer::writeIndices(std::vector<uint32_t> const& indices, void* index_data, DXGI_FORMAT index_type)
+    {
+        if (index_type == DXGI_FORMAT_R16_UINT)
+        {
+            auto dst = static_cast<uint16_t*>(index_data);
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                dst[i] = static_cast<uint16_t>(indices[i]);
+            }
+        }
+        else
+        {
+            std::memcpy(index_data, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+    }
+
+    inline std::vector<MeshOptimizer::Submesh> MeshOptimizer::resolveSubmeshes(std::vector<Submesh> const& submeshes, size_t index_count)
+    {
+        if (submeshes.empty())
+        {
+            return { { 0, static_cast<UINT>(index_count) } };
+        }
+
+        for (Submesh const& submesh : submeshes)
+        {
+            if (static_cast<size_t>(submesh.first_index) + submesh.index_count > index_count || submesh.index_count % 3 != 0)
+            {
+                throw std::invalid_argument("MeshOptimizer: submesh is not a triangle list inside the index data");
+            }
+        }
+        return submeshes;
+    }
+
+    inline MeshOptimizer::LocalMesh MeshOptimizer::buildLocalMesh(uint32_t const* indices, size_t index_count)
+    {
+        LocalMesh mesh;
+
+        mesh.global_ids.assign(indices, indices + index_count);
+        std::sort(mesh.global_ids.begin(), mesh.global_ids.end());
+        mesh.global_ids.erase(std::unique(mesh.global_ids.begin(), mesh.global_ids.end()), mesh.global_ids.end());
+
+        mesh.indices.resize(index_count);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            mesh.indices[i] = static_cast<uint32_t>(std::lower_bound(mesh.global_ids.begin(), mesh.global_ids.end(), indices[i]) - mesh.global_ids.begin());
+        }
+
+        // compressed sparse rows of the triangles adjacent to each vertex
+        mesh.adjacency_offsets.assign(mesh.global_ids.size() + 1, 0);
+        for (uint32_t v : mesh.indices)
+        {
+            ++mesh.adjacency_offsets[v + 1];
+        }
+        std::partial_sum(mesh.adjacency_offsets.begin(), mesh.adjacency_offsets.end(), mesh.adjacency_offsets.begin());
+
+        mesh.adjacency.resize(index_count);
+        std::vector<uint32_t> fill(mesh.adjacency_offsets.begin(), mesh.adjacency_offsets.end() - 1);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            mesh.adjacency[fill[mesh.indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        return mesh;
+    }
+
+    inline void MeshOptimizer::orderTipsify(
+        LocalMesh const& mesh,
+        UINT cache_size,
+        std::vector<uint32_t>& order,
+        std::vector<uint32_t>& hard_boundaries)
+    {
+        size_t const vertex_cnt = mesh.global_ids.size();
+        size_t const triangle_cnt = mesh.indices.size() / 3;
+
+        std::vector<uint32_t> live(vertex_cnt);
+        for (size_t v = 0; v < vertex_cnt; ++v)
+        {
+            live[v] = mesh.adjacency_offsets[v + 1] - mesh.adjacency_offsets[v];
+        }
+
+        std::vector<uint64_t> cache_time(vertex_cnt, 0);
+        std::vector<bool> emitted(triangle_cnt, false);
+        std::vector<uint32_t> dead_end;
+        std::vector<uint32_t> candidates;
+
+        uint64_t time = static_cast<uint64_t>(cache_size) + 1;
+        uint32_t cursor = 0;
+        uint32_t fanning = 0;
+
+        order.clear();
+        order.reserve(triangle_cnt);
+        hard_boundaries.assign(1, 0);
+
+        while (fanning != invalid_index)
+        {
+            candidates.clear();
+
+            for (uint32_t a = mesh.adjacency_offsets[fanning]; a < mesh.adjacency_offsets[fanning + 1]; ++a)
+            {
+                uint32_t t = mesh.adjacency[a];
+                if (emitted[t])
+                {
+                    continue;
+                }
+
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    uint32_t v = mesh.indices[t * 3 + c];
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - cache_time[v] > cache_size)
+                    {
+                        cache_time[v] = time++;
+                    }
+                }
+                emitted[t] = true;
+                order.push_back(t);
+            }
+
+            // prefer the candidate that stays longest in the cache while its remaining triangles are emitted
+            uint32_t next = invalid_index;
+            int64_t best_priority = -1;
+            for (uint32_t v : candidates)
+            {
+                if (live[v] == 0)
+                {
+                    continue;
+                }
+                int64_t priority = 0;
+                if (time - cache_time[v] + 2 * live[v] <= cache_size)
+                {
+                    priority = static_cast<int64_t>(time - cache_time[v]);
+                }
+                if (priority > best_priority)
+                {
+                    best_priority = priority;
+                    next = v;
+                }
+            }
+
+            if (next == invalid_index)
+            {
+                // dead end, continue with a recently used vertex or the next one in input order
+                while (!dead_end.empty() && next == invalid_index)
+                {
+                    uint32_t v = dead_end.back();
+                    dead_end.pop_back();
+                    next = live[v] > 0 ? v : invalid_index;
+                }
+                while (next == invalid_index && cursor < vertex_cnt)
+                {
+                    next = live[cursor] > 0 ? cursor : invalid_index;
+                    ++cursor;
+                }
+                if (next != invalid_index && time - cache_time[next] > cache_size)
+                {
+                    hard_boundaries.push_back(static_cast<uint32_t>(order.size()));
+                }
+            }
+
+            fanning = next;
+        }
+    }
+
+    inline void MeshOptimizer::orderForsyth(
+        LocalMesh const& mesh,
+        std::vector<uint32_t>& order,
+        std::vector<uint32_t>& hard_boundaries)
+    {
+        size_t const vertex_cnt = mesh.global_ids.size();
+        size_t const triangle_cnt = mesh.indices.size() / 3;
+
+        auto vertexScore = [](int cache_position, uint32_t remaining) -> float {
+            if (remaining == 0)
+            {
+                return -1.0f;
+            }
+            float score = 0.0f;
+            if (cache_position >= 0)
+            {
+                // the last triangle's vertices get a fixed score so the next triangle does not reuse them directly
+                score = cache_position < 3
+                    ? 0.75f
+                    : std::pow(1.0f - static_cast<float>(cache_position - 3) / (forsyth_cache_size - 3), 1.5f);
+            }
+            return score + 2.0f / std::sqrt(static_cast<float>(remaining));
+        };
+
+        // remaining triangles per vertex, the unemitted ones are kept at the front of each adjacency row
+        std::vector<uint32_t> remaining(vertex_cnt);
+        std::vector<uint32_t> adjacency(mesh.adjacency);
+        std::vector<int> cache_position(vertex_cnt, -1);
+        std::vector<float> vertex_score(vertex_cnt);
+        for (size_t v = 0; v < vertex_cnt; ++v)
+        {
+            remaining[v] = mesh.adjacency_offsets[v + 1] - mesh.adjacency_offsets[v];
+            vertex_score[v] = vertexScore(-1, remaining[v]);
+        }
+
+        auto triangleScore = [&](uint32_t t) {
+            return vertex_score[mesh.indices[t * 3]] + vertex_score[mesh.indices[t * 3 + 1]] + vertex_score[mesh.indices[t * 3 + 2]];
+        };
+
+        // start with the triangle of the lowest valence vertices
+        std::vector<bool> emitted(triangle_cnt, false);
+        uint32_t best = invalid_index;
+        float best_score = -1.0f;
+        for (uint32_t t = 0; t < triangle_cnt; ++t)
+        {
+            if (triangleScore(t) > best_score)
+            {
+                best_score = triangleScore(t);
+                best = t;
+            }
+        }
+
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> new_cache;
+        cache.reserve(forsyth_cache_size + 3);
+        new_cache.reserve(forsyth_cache_size + 3);
+
+        order.clear();
+        order.reserve(triangle_cnt);
+        hard_boundaries.assign(1, 0);
+
+        uint32_t cursor = 0;
+
+        while (best != invalid_index)
+        {
+            emitted[best] = true;
+            order.push_back(best);
+
+            new_cache.clear();
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                uint32_t v = mesh.indices[best * 3 + c];
+                new_cache.push_back(v);
+
+                uint32_t* row = adjacency.data() + mesh.adjacency_offsets[v];
+                std::swap(*std::find(row, row + remaining[v], best), row[remaining[v] - 1]);
+                --remaining[v];
+            }
+            for (uint32_t v : cache)
+            {
+                if (std::find(new_cache.begin(), new_cache.begin() + 3, v) == new_cache.begin() + 3)
+                {
+                    new_cache.push_back(v);
+                }
+            }
+
+            // vertices pushed out of the cache lose their position score
+            for (size_t i = forsyth_cache_size; i < new_cache.size(); ++i)
+            {
+                cache_position[new_cache[i]] = -1;
+                vertex_score[new_cache[i]] = vertexScore(-1, remaining[new_cache[i]]);
+            }
+            new_cache.resize(std::min<size_t>(new_cache.size(), forsyth_cache_size));
+            std::swap(cache, new_cache);
+
+            for (size_t i = 0; i < cache.size(); ++i)
+            {
+                cache_position[cache[i]] = static_cast<int>(i);
+                vertex_score[cache[i]] = vertexScore(static_cast<int>(i), remaining[cache[i]]);
+            }
+
+            // only triangles touching the cache change their score
+            best = invalid_index;
+            best_score = -1.0f;
+            for (uint32_t v : cache)
+            {
+                uint32_t const* row = adjacency.data() + mesh.adjacency_offsets[v];
+                for (uint32_t a = 0; a < remaining[v]; ++a)
+                {
+                    uint32_t t = row[a];
+                    float score = triangleScore(t);
+                    if (score > best_score)
+                    {
+                        best_score = score;
+                        best = t;
+                    }
+                }
+            }
+
+            if (best == invalid_index)
+            {
+                while (cursor < triangle_cnt && emitted[cursor])
+                {
+                    ++cursor;
+                }
+                if (cursor < triangle_cnt)
+                {
+                    best = cursor;
+                    hard_boundaries.push_back(static_cast<uint32_t>(order.size()));
+                }
+            }
+        }
+    }
+
+    inline std::vector<uint32_t> MeshOptimizer::computeSoftBoundaries(
+        LocalMesh const& mesh,
+        std::vector<uint32_t> const& order,
+        std::vector<uint32_t> const& hard_boundaries,
+        UINT cache_size,
+        float threshold)
+    {
+        std::vector<uint64_t> cache_time(mesh.global_ids.size(), 0);
+        uint64_t time = static_cast<uint64_t>(cache_size) + 1;
+
+        auto countMisses = [&](uint32_t t) {
+            size_t misses = 0;
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                uint32_t v = mesh.indices[t * 3 + c];
+                if (time - cache_time[v] > cache_size)
+                {
+                    cache_time[v] = time++;
+                    ++misses;
+                }
+            }
+            return misses;
+        };
+
+        std::vector<uint32_t> boundaries;
+        for (size_t c = 0; c < hard_boundaries.size(); ++c)
+        {
+            size_t const begin = hard_boundaries[c];
+            size_t const end = c + 1 < hard_boundaries.size() ? hard_boundaries[c + 1] : order.size();
+
+            time += cache_size + 1;
+            size_t cluster_misses = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                cluster_misses += countMisses(order[i]);
+            }
+            float const target_acmr = threshold * static_cast<float>(cluster_misses) / static_cast<float>(end - begin);
+
+            boundaries.push_back(static_cast<uint32_t>(begin));
+
+            time += cache_size + 1;
+            size_t running_misses = 0;
+            size_t running_triangles = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                running_misses += countMisses(order[i]);
+                ++running_triangles;
+
+                if (static_cast<float>(running_misses) <= static_cast<float>(running_triangles) * target_acmr)
+                {
+                    boundaries.push_back(static_cast<uint32_t>(i + 1));
+                    time += cache_size + 1;
+                    running_misses = 0;
+                    running_triangles = 0;
+                }
+            }
+
+            // the last piece of a cluster rarely reaches the target, merge it with the previous one. This also
+            // removes a boundary at end if the last piece did reach it.
+            if (boundaries.back() != begin)
+            {
+                boundaries.pop_back();
+            }
+        }
+
+        return boundaries;
+    }
+
+    inline void MeshOptimizer::sortClusters(
+        LocalMesh const& mesh,
+        PositionAccessor const& positions,
+        std::vector<uint32_t>& order,
+        std::vector<uint32_t> const& boundaries)
+    {
+        float mesh_center[3] = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t global_id : mesh.global_ids)
+        {
+            float p[3];
+            positions.load(global_id, p);
+            for (int k = 0; k < 3; ++k)
+            {
+                mesh_center[k] += p[k];
+            }
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            mesh_center[k] /= static_cast<float>(mesh.global_ids.size());
+        }
+
+        // clusters facing away from the mesh center are likely to occlude the rest of the mesh, draw them first
+        std::vector<std::pair<float, uint32_t>> sort_keys(boundaries.size());
+        for (size_t c = 0; c < boundaries.size(); ++c)
+        {
+            size_t const begin = boundaries[c];
+            size_t const end = c + 1 < boundaries.size() ? boundaries[c + 1] : order.size();
+
+            float center[3] = { 0.0f, 0.0f, 0.0f };
+            float normal[3] = { 0.0f, 0.0f, 0.0f };
+            float area_sum = 0.0f;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                float p0[3], p1[3], p2[3];
+                positions.load(mesh.global_ids[mesh.indices[order[i] * 3]], p0);
+                positions.load(mesh.global_ids[mesh.indices[order[i] * 3 + 1]], p1);
+                positions.load(mesh.global_ids[mesh.indices[order[i] * 3 + 2]], p2);
+
+                float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    center[k] += (p0[k] + p1[k] + p2[k]) * (area / 3.0f);
+                    normal[k] += n[k];
+                }
+                area_sum += area;
+            }
+
+            float normal_length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            float key = 0.0f;
+            if (area_sum > 0.0f && normal_length > 0.0f)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    key += (center[k] / area_sum - mesh_center[k]) * (normal[k] / normal_length);
+                }
+            }
+            sort_keys[c] = { key, static_cast<uint32_t>(c) };
+        }
+
+        std::stable_sort(sort_keys.begin(), sort_keys.end(),
+            [](std::pair<float, uint32_t> const& lhs, std::pair<float, uint32_t> const& rhs) { return lhs.first > rhs.first; });
+
+        std::vector<uint32_t> sorted_order;
+        sorted_order.reserve(order.size());
+        for (auto const& sort_key : sort_keys)
+        {
+            uint32_t c = sort_key.second;
+            size_t const begin = boundaries[c];
+            size_t const end = c + 1 < boundaries.size() ? boundaries[c + 1] : order.size();
+            sorted_order.insert(sorted_order.end(), order.begin() + begin, order.begin() + end);
+        }
+        order = std::move(sorted_order);
+    }
+
+    inline size_t MeshOptimizer::optimizeSubmesh(
+        uint32_t* indices,
+        size_t index_count,
+        PositionAccessor const& positions,
+        Settings const& settings)
+    {
+        if (index_count == 0)
+        {
+            return 0;
+        }
+
+        LocalMesh mesh = buildLocalMesh(indices, index_count);
+
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> boundaries;
+        if (settings.algorithm == Algorithm::Forsyth)
+        {
+            orderForsyth(mesh, order, boundaries);
+        }
+        else
+        {
+            orderTipsify(mesh, settings.cache_size, order, boundaries);
+        }
+
+        if (positions.isValid())
+        {
+            boundaries = computeSoftBoundaries(mesh, order, boundaries, settings.cache_size, settings.overdraw_threshold);
+            sortClusters(mesh, positions, order, boundaries);
+        }
+
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                indices[i * 3 + c] = mesh.global_ids[mesh.indices[order[i] * 3 + c]];
+            }
+        }
+
+        return boundaries.size();
+    }
+
+    inline void MeshOptimizer::remapVertexFetch(
+        std::vector<void*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        std::vector<uint32_t>& indices,
+        ThreadPool* thread_pool)
+    {
+        // indices outside of the submeshes were never checked by the cache analysis
+        for (uint32_t index : indices)
+        {
+            if (index >= vertex_count)
+            {
+                throw std::out_of_range("MeshOptimizer: index out of range");
+            }
+        }
+
+        // new vertex ids in order of first use, unreferenced vertices keep their relative order at the end
+        std::vector<uint32_t> remap(vertex_count, invalid_index);
+        uint32_t next_id = 0;
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == invalid_index)
+            {
+                remap[index] = next_id++;
+            }
+            index = remap[index];
+        }
+        for (uint32_t& id : remap)
+        {
+            if (id == invalid_index)
+            {
+                id = next_id++;
+            }
+        }
+
+        auto remapStream = [&](size_t stream_idx) {
+            VertexDescriptor const& vertex_descriptor = vertex_layout[stream_idx];
+            if (isPerInstance(vertex_descriptor) || vertex_data[stream_idx] == nullptr)
+            {
+                return;
+            }
+
+            size_t const stride = vertex_descriptor.stride;
+            auto data = static_cast<uint8_t*>(vertex_data[stream_idx]);
+            std::vector<uint8_t> copy(data, data + vertex_count * stride);
+            for (size_t v = 0; v < vertex_count; ++v)
+            {
+                std::memcpy(data + remap[v] * stride, copy.data() + v * stride, stride);
+            }
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, vertex_data.size(), remapStream);
+        }
+        else
+        {
+            for (size_t stream_idx = 0; stream_idx < vertex_data.size(); ++stream_idx)
+            {
+                remapStream(stream_idx);
+            }
+        }
+    }
+
+    inline MeshOptimizer::PositionAccessor MeshOptimizer::findPositions(
+        std::vector<void*> const& vertex_data,
+        std::vector<VertexDescriptor> const& vertex_layout)
+    {
+        PositionAccessor retval;
+
+        size_t vertex_buffer_idx;
+        D3D11_INPUT_ELEMENT_DESC attrib;
+        size_t byte_offset;
+        if (findVertexAttribute(vertex_layout, "POSITION", 0, vertex_buffer_idx, attrib, byte_offset)
+            && (attrib.Format == DXGI_FORMAT_R32G32B32_FLOAT || attrib.Format == DXGI_FORMAT_R32G32B32A32_FLOAT)
+            && vertex_data[vertex_buffer_idx] != nullptr)
+        {
+            retval.data = static_cast<uint8_t const*>(vertex_data[vertex_buffer_idx]);
+            retval.stride = vertex_layout[vertex_buffer_idx].stride;
+            retval.offset = byte_offset;
+        }
+        return retval;
+    }
+
+} // namespace dxowl
+
+#endif // !MeshOptimizer_hpp
@@ -0,0 +1,472 @@
+/// <copyright file="MeshletBuilder.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MeshletBuilder_hpp
+#define MeshletBuilder_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "MeshOptimizer.hpp"
+#include "ThreadPool.hpp"
+#include "VertexDescriptor.hpp"
+
+namespace dxowl
+{
+    /// Splits the triangle lists of a mesh into small clusters (meshlets) of connected triangles and reorders the
+    /// index data so that every meshlet is a contiguous index range inside its submesh. Each meshlet gets a bounding
+    /// sphere and a normal cone for culling with MeshletCuller. Run MeshOptimizer first, meshlets are grown in index
+    /// order and inherit its vertex locality.
+    /// Normals follow the D3D11 default of clockwise front faces in a left-handed space, set front_counter_clockwise
+    /// for the opposite convention.
+    class MeshletBuilder
+    {
+    public:
+        struct Settings
+        {
+            UINT max_vertices = 64;
+            UINT max_triangles = 124;
+            bool front_counter_clockwise = false;
+        };
+
+        struct Meshlet
+        {
+            UINT submesh;
+            UINT first_index;
+            UINT index_count;
+            UINT vertex_count;
+            float center[3];
+            float radius;
+            float cone_apex[3];
+            float cone_axis[3];
+            float cone_cutoff; // back-facing if dot(normalize(cone_apex - eye), cone_axis) >= cone_cutoff, > 1 never culls
+        };
+
+        /// Index values are absolute like in MeshOptimizer. An empty submesh list covers all indices.
+        static std::vector<Meshlet> build(
+            std::vector<void const*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            void* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<MeshOptimizer::Submesh> const& submeshes,
+            Settings const& settings,
+            ThreadPool* thread_pool = nullptr);
+
+        static std::vector<Meshlet> build(
+            std::vector<void const*> const& vertex_data,
+            size_t vertex_count,
+            std::vector<VertexDescriptor> const& vertex_layout,
+            void* index_data,
+            size_t index_count,
+            DXGI_FORMAT index_type,
+            std::vector<MeshOptimizer::Submesh> const& submeshes = {},
+            ThreadPool* thread_pool = nullptr);
+
+    private:
+        static constexpr uint32_t invalid_index = ~0u;
+
+        struct Positions
+        {
+            uint8_t const* data;
+            size_t stride;
+            size_t offset;
+
+            void load(uint32_t vertex, float (&position)[3]) const;
+        };
+
+        static void buildSubmesh(
+            uint32_t* indices,
+            size_t index_count,
+            UINT submesh_idx,
+            UINT first_index,
+            Settings const& settings,
+            std::vector<Meshlet>& meshlets);
+
+        static void computeBounds(uint32_t const* indices, Positions const& positions, bool front_counter_clockwise, Meshlet& meshlet);
+    };
+
+    inline std::vector<MeshletBuilder::Meshlet> MeshletBuilder::build(
+        std::vector<void const*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        void* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<MeshOptimizer::Submesh> const& submeshes,
+        Settings const& settings,
+        ThreadPool* thread_pool)
+    {
+        if (settings.max_vertices < 3 || settings.max_triangles < 1)
+        {
+            throw std::invalid_argument("MeshletBuilder: meshlets need room for at least one triangle");
+        }
+
+        size_t vertex_buffer_idx;
+        D3D11_INPUT_ELEMENT_DESC position_attrib;
+        size_t position_offset;
+        if (!findVertexAttribute(vertex_layout, "POSITION", 0, vertex_buffer_idx, position_attrib, position_offset)
+            || (position_attrib.Format != DXGI_FORMAT_R32G32B32_FLOAT && position_attrib.Format != DXGI_FORMAT_R32G32B32A32_FLOAT)
+            || vertex_buffer_idx >= vertex_data.size())
+        {
+            throw std::invalid_argument("MeshletBuilder: vertex layout has no float POSITION attribute");
+        }
+        Positions const positions = {
+            static_cast<uint8_t const*>(vertex_data[vertex_buffer_idx]), vertex_layout[vertex_buffer_idx].stride, position_offset };
+
+        std::vector<uint32_t> indices = MeshOptimizer::readIndices(index_data, index_count, index_type);
+        for (uint32_t index : indices)
+        {
+            if (index >= vertex_count)
+            {
+                throw std::invalid_argument("MeshletBuilder: index out of range");
+            }
+        }
+
+        std::vector<MeshOptimizer::Submesh> resolved_submeshes = submeshes;
+        if (resolved_submeshes.empty())
+        {
+            resolved_submeshes.push_back({ 0, static_cast<UINT>(index_count) });
+        }
+        for (auto const& submesh : resolved_submeshes)
+        {
+            if (static_cast<size_t>(submesh.first_index) + submesh.index_count > index_count || submesh.index_count % 3 != 0)
+            {
+                throw std::invalid_argument("MeshletBuilder: submesh is not a triangle list inside the index data");
+            }
+        }
+
+        std::vector<std::vector<Meshlet>> submesh_meshlets(resolved_submeshes.size());
+        auto buildRange = [&](size_t submesh_idx) {
+            MeshOptimizer::Submesh const& submesh = resolved_submeshes[submesh_idx];
+            buildSubmesh(indices.data() + submesh.first_index, submesh.index_count, static_cast<UINT>(submesh_idx),
+                submesh.first_index, settings, submesh_meshlets[submesh_idx]);
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, resolved_submeshes.size(), buildRange);
+        }
+        else
+        {
+            for (size_t submesh_idx = 0; submesh_idx < resolved_submeshes.size(); ++submesh_idx)
+            {
+                buildRange(submesh_idx);
+            }
+        }
+
+        std::vector<Meshlet> retval;
+        for (auto& meshlets : submesh_meshlets)
+        {
+            retval.insert(retval.end(), meshlets.begin(), meshlets.end());
+        }
+
+        auto boundMeshlet = [&](size_t meshlet_idx) {
+            computeBounds(indices.data(), positions, settings.front_counter_clockwise, retval[meshlet_idx]);
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, retval.size(), boundMeshlet, 64);
+        }
+        else
+        {
+            for (size_t meshlet_idx = 0; meshlet_idx < retval.size(); ++meshlet_idx)
+            {
+                boundMeshlet(meshlet_idx);
+            }
+        }
+
+        MeshOptimizer::writeIndices(indices, index_data, index_type);
+        return retval;
+    }
+
+    inline std::vector<MeshletBuilder::Meshlet> MeshletBuilder::build(
+        std::vector<void const*> const& vertex_data,
+        size_t vertex_count,
+        std::vector<VertexDescriptor> const& vertex_layout,
+        void* index_data,
+        size_t index_count,
+        DXGI_FORMAT index_type,
+        std::vector<MeshOptimizer::Submesh> const& submeshes,
+        ThreadPool* thread_pool)
+    {
+        return build(vertex_data, vertex_count, vertex_layout, index_data, index_count, index_type, submeshes, Settings(), thread_pool);
+    }
+
+    inline void MeshletBuilder::Positions::load(uint32_t vertex, float (&position)[3]) const
+    {
+        std::memcpy(position, data + vertex * stride + offset, sizeof(position));
+    }
+
+    inline void MeshletBuilder::buildSubmesh(
+        uint32_t* indices,
+        size_t index_count,
+        UINT submesh_idx,
+        UINT first_index,
+        Settings const& settings,
+        std::vector<Meshlet>& meshlets)
+    {
+        size_t const triangle_cnt = index_count / 3;
+        if (triangle_cnt == 0)
+        {
+            return;
+        }
+
+        // compact local vertex ids, so the per-vertex state only scales with the submesh
+        std::vector<uint32_t> global_ids(indices, indices + index_count);
+        std::sort(global_ids.begin(), global_ids.end());
+        global_ids.erase(std::unique(global_ids.begin(), global_ids.end()), global_ids.end());
+
+        std::vector<uint32_t> local(index_count);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            local[i] = static_cast<uint32_t>(std::lower_bound(global_ids.begin(), global_ids.end(), indices[i]) - global_ids.begin());
+        }
+
+        std::vector<uint32_t> adjacency_offsets(global_ids.size() + 1, 0);
+        for (uint32_t v : local)
+        {
+            ++adjacency_offsets[v + 1];
+        }
+        std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+        std::vector<uint32_t> adjacency(index_count);
+        std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            adjacency[fill[local[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::vector<bool> emitted(triangle_cnt, false);
+        std::vector<uint32_t> meshlet_stamp(global_ids.size(), invalid_index);
+        std::vector<uint32_t> meshlet_vertices;
+        std::vector<uint32_t> order;
+        order.reserve(triangle_cnt);
+
+        size_t cursor = 0;
+        uint32_t meshlet_id = 0;
+
+        auto newVertexCount = [&](uint32_t t) {
+            UINT retval = 0;
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                uint32_t v = local[t * 3 + c];
+                // degenerate triangles reference a vertex twice, count it once
+                bool duplicate = (c > 0 && local[t * 3] == v) || (c > 1 && local[t * 3 + 1] == v);
+                retval += (meshlet_stamp[v] != meshlet_id && !duplicate) ? 1 : 0;
+            }
+            return retval;
+        };
+
+        while (order.size() < triangle_cnt)
+        {
+            UINT const meshlet_first_triangle = static_cast<UINT>(order.size());
+            meshlet_vertices.clear();
+
+            while (order.size() - meshlet_first_triangle < settings.max_triangles)
+            {
+                // prefer connected triangles that add the fewest vertices
+                uint32_t best = invalid_index;
+                UINT best_new = 4;
+                for (size_t i = 0; i < meshlet_vertices.size() && best_new > 0; ++i)
+                {
+                    uint32_t v = meshlet_vertices[i];
+                    for (uint32_t a = adjacency_offsets[v]; a < adjacency_offsets[v + 1] && best_new > 0; ++a)
+                    {
+                        uint32_t t = adjacency[a];
+                        if (emitted[t])
+                        {
+                            continue;
+                        }
+                        UINT new_vertices = newVertexCount(t);
+                        if (new_vertices < best_new && meshlet_vertices.size() + new_vertices <= settings.max_vertices)
+                        {
+                            best = t;
+                            best_new = new_vertices;
+                        }
+                    }
+                }
+
+                // no connected triangle left, fill mostly empty meshlets with the next triangle in index order
+                if (best == invalid_index && (order.size() - meshlet_first_triangle) * 2 < settings.max_triangles)
+                {
+                    while (cursor < triangle_cnt && emitted[cursor])
+                    {
+                        ++cursor;
+                    }
+                    if (cursor < triangle_cnt && meshlet_vertices.size() + newVertexCount(static_cast<uint32_t>(cursor)) <= settings.max_vertices)
+                    {
+                        best = static_cast<uint32_t>(cursor);
+                    }
+                }
+
+                if (best == invalid_index)
+                {
+                    break;
+                }
+
+                emitted[best] = true;
+                order.push_back(best);
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    uint32_t v = local[best * 3 + c];
+                    if (meshlet_stamp[v] != meshlet_id)
+                    {
+                        meshlet_stamp[v] = meshlet_id;
+                        meshlet_vertices.push_back(v);
+                    }
+                }
+            }
+
+            Meshlet meshlet = {};
+            meshlet.submesh = submesh_idx;
+            meshlet.first_index = first_index + meshlet_first_triangle * 3;
+            meshlet.index_count = static_cast<UINT>(order.size() - meshlet_first_triangle) * 3;
+            meshlet.vertex_count = static_cast<UINT>(meshlet_vertices.size());
+            meshlets.push_back(meshlet);
+
+            ++meshlet_id;
+        }
+
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                indices[i * 3 + c] = global_ids[local[order[i] * 3 + c]];
+            }
+        }
+    }
+
+    inline void MeshletBuilder::computeBounds(
+        uint32_t const* indices,
+        Positions const& positions,
+        bool front_counter_clockwise,
+        Meshlet& meshlet)
+    {
+        size_t const triangle_cnt = meshlet.index_count / 3;
+        uint32_t const* meshlet_indices = indices + meshlet.first_index;
+
+        // sphere around the box center
+        float bounds_min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float bounds_max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (size_t i = 0; i < meshlet.index_count; ++i)
+        {
+            float p[3];
+            positions.load(meshlet_indices[i], p);
+            for (int k = 0; k < 3; ++k)
+            {
+                bounds_min[k] = (std::min)(bounds_min[k], p[k]);
+                bounds_max[k] = (std::max)(bounds_max[k], p[k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            meshlet.center[k] = 0.5f * (bounds_min[k] + bounds_max[k]);
+        }
+        float radius_sq = 0.0f;
+        for (size_t i = 0; i < meshlet.index_count; ++i)
+        {
+            float p[3];
+            positions.load(meshlet_indices[i], p);
+            float d[3] = { p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2] };
+            radius_sq = (std::max)(radius_sq, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        }
+        meshlet.radius = std::sqrt(radius_sq);
+
+        // normal cone from the unit normals of all non-degenerate triangles
+        std::vector<float> normals;
+        std::vector<float> origins;
+        normals.reserve(triangle_cnt * 3);
+        origins.reserve(triangle_cnt * 3);
+        float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+        for (size_t t = 0; t < triangle_cnt; ++t)
+        {
+            float p0[3], p1[3], p2[3];
+            positions.load(meshlet_indices[t * 3], p0);
+            positions.load(meshlet_indices[t * 3 + 1], p1);
+            positions.load(meshlet_indices[t * 3 + 2], p2);
+
+            float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0f)
+            {
+                continue;
+            }
+
+            // for clockwise front faces in a left-handed space the cross product points towards the viewer
+            float const sign = front_counter_clockwise ? -1.0f : 1.0f;
+            for (int k = 0; k < 3; ++k)
+            {
+                normals.push_back(sign * n[k] / length);
+                origins.push_back(p0[k]);
+                axis[k] += sign * n[k] / length;
+            }
+        }
+
+        meshlet.cone_cutoff = 2.0f;
+        std::memcpy(meshlet.cone_apex, meshlet.center, sizeof(meshlet.cone_apex));
+        std::memset(meshlet.cone_axis, 0, sizeof(meshlet.cone_axis));
+
+        float axis_length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (normals.empty() || axis_length == 0.0f)
+        {
+            return;
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            axis[k] /= axis_length;
+        }
+
+        float min_dot = 1.0f;
+        for (size_t t = 0; t < normals.size(); t += 3)
+        {
+            min_dot = (std::min)(min_dot, axis[0] * normals[t] + axis[1] * normals[t + 1] + axis[2] * normals[t + 2]);
+        }
+
+        // cones wider than a hemisphere cannot be back-facing as a whole
+        if (min_dot <= 0.1f)
+        {
+            return;
+        }
+
+        // move the apex back along the axis until it lies behind all triangle planes
+        float max_t = 0.0f;
+        for (size_t t = 0; t < normals.size(); t += 3)
+        {
+            float dc = 0.0f;
+            float dn = 0.0f;
+            for (int k = 0; k < 3; ++k)
+            {
+                dc += (meshlet.center[k] - origins[t + k]) * normals[t + k];
+                dn += axis[k] * normals[t + k];
+            }
+            max_t = (std::max)(max_t, dc / dn);
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            meshlet.cone_apex[k] = meshlet.center[k] - axis[k] * max_t;
+            meshlet.cone_axis[k] = axis[k];
+        }
+        // the view direction must lie outside the normal cone widened by 90 degrees, i.e. cos(angle + 90)
+        meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    }
+
+} // namespace dxowl
+
+#endif // !MeshletBuilder_hpp
@@ -0,0 +1,345 @@
+/// <copyright file="MeshletCuller.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MeshletCuller_hpp
+#define MeshletCuller_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "MeshletBuilder.hpp"
+#include "ThreadPool.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define DXOWL_CULL_SSE
+#include <immintrin.h>
+#endif
+
+namespace dxowl
+{
+    /// Per-frame CPU culling of the meshlets produced by MeshletBuilder against a view frustum and with normal cones.
+    /// Meshlet bounds are kept as structure of arrays and tested four at a time, the visible meshlets are compacted
+    /// into as few DrawIndexed ranges as possible by merging neighbours of the same submesh.
+    /// Views are given in the object space of the mesh. Not thread-safe, call from the render thread.
+    class MeshletCuller
+    {
+    public:
+        struct View
+        {
+            float frustum_planes[6][4]; // inside if dot(plane.xyz, p) + plane.w >= 0
+            float camera_position[3];
+        };
+
+        struct DrawRange
+        {
+            UINT submesh;
+            UINT first_index;
+            UINT index_count;
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t meshlets_tested = 0;
+            size_t meshlets_frustum_culled = 0;
+            size_t meshlets_backface_culled = 0;
+            size_t triangles_visible = 0;
+            size_t draw_ranges = 0;
+        };
+
+        MeshletCuller(std::vector<MeshletBuilder::Meshlet> const& meshlets);
+        ~MeshletCuller() = default;
+
+        MeshletCuller(const MeshletCuller& cpy) = delete;
+        MeshletCuller(MeshletCuller&& other) = delete;
+        MeshletCuller& operator=(MeshletCuller&& rhs) = delete;
+        MeshletCuller& operator=(const MeshletCuller& rhs) = delete;
+
+        /// Extracts normalized frustum planes from a row-major view projection matrix that transforms row vectors
+        /// (DirectXMath convention) with a [0,1] depth range. Planes point inwards in the order left, right, bottom, top, near, far.
+        static void extractFrustumPlanes(float const (&view_projection)[16], float (&planes)[6][4]);
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        /// Culls all meshlets and rebuilds the draw ranges. Returns the compacted ranges, valid until the next call.
+        std::vector<DrawRange> const& cull(View const& view, ThreadPool* thread_pool = nullptr);
+
+        std::vector<DrawRange> const& getDrawRanges() const;
+
+        /// Issues one DrawIndexed per range of the last cull(). Input layout, buffers and shaders must be bound.
+        void draw(ID3D11DeviceContext4* d3d11_ctx, INT base_vertex_location = 0) const;
+
+        size_t getMeshletCount() const;
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        enum Visibility : uint8_t
+        {
+            Visible = 0,
+            FrustumCulled = 1,
+            BackfaceCulled = 2
+        };
+
+        static constexpr size_t block_size = 256;
+
+        void cullRange(View const& view, size_t begin, size_t end);
+
+        size_t m_meshlet_cnt;
+
+        // padded to a multiple of 4, the padding results are ignored by the compaction
+        std::vector<float> m_center_x;
+        std::vector<float> m_center_y;
+        std::vector<float> m_center_z;
+        std::vector<float> m_radius;
+        std::vector<float> m_apex_x;
+        std::vector<float> m_apex_y;
+        std::vector<float> m_apex_z;
+        std::vector<float> m_axis_x;
+        std::vector<float> m_axis_y;
+        std::vector<float> m_axis_z;
+        std::vector<float> m_cutoff;
+
+        std::vector<DrawRange> m_ranges;
+        std::vector<uint8_t> m_visibility;
+        std::vector<DrawRange> m_draw_ranges;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline MeshletCuller::MeshletCuller(std::vector<MeshletBuilder::Meshlet> const& meshlets)
+        : m_meshlet_cnt(meshlets.size())
+    {
+        size_t const padded_cnt = (m_meshlet_cnt + 3) & ~size_t(3);
+
+        m_center_x.assign(padded_cnt, 0.0f);
+        m_center_y.assign(padded_cnt, 0.0f);
+        m_center_z.assign(padded_cnt, 0.0f);
+        m_radius.assign(padded_cnt, 0.0f);
+        m_apex_x.assign(padded_cnt, 0.0f);
+        m_apex_y.assign(padded_cnt, 0.0f);
+        m_apex_z.assign(padded_cnt, 0.0f);
+        m_axis_x.assign(padded_cnt, 0.0f);
+        m_axis_y.assign(padded_cnt, 0.0f);
+        m_axis_z.assign(padded_cnt, 0.0f);
+        m_cutoff.assign(padded_cnt, 2.0f);
+
+        m_ranges.reserve(m_meshlet_cnt);
+        for (size_t i = 0; i < m_meshlet_cnt; ++i)
+        {
+            MeshletBuilder::Meshlet const& meshlet = meshlets[i];
+            m_center_x[i] = meshlet.center[0];
+            m_center_y[i] = meshlet.center[1];
+            m_center_z[i] = meshlet.center[2];
+            m_radius[i] = meshlet.radius;
+            m_apex_x[i] = meshlet.cone_apex[0];
+            m_apex_y[i] = meshlet.cone_apex[1];
+            m_apex_z[i] = meshlet.cone_apex[2];
+            m_axis_x[i] = meshlet.cone_axis[0];
+            m_axis_y[i] = meshlet.cone_axis[1];
+            m_axis_z[i] = meshlet.cone_axis[2];
+            m_cutoff[i] = meshlet.cone_cutoff;
+            m_ranges.push_back({ meshlet.submesh, meshlet.first_index, meshlet.index_count });
+        }
+
+        m_visibility.resize(padded_cnt, FrustumCulled);
+    }
+
+    inline void MeshletCuller::extractFrustumPlanes(float const (&view_projection)[16], float (&planes)[6][4])
+    {
+        auto column = [&](int c, int k) {
+            return view_projection[k * 4 + c];
+        };
+
+        for (int k = 0; k < 4; ++k)
+        {
+            planes[0][k] = column(3, k) + column(0, k);
+            planes[1][k] = column(3, k) - column(0, k);
+            planes[2][k] = column(3, k) + column(1, k);
+            planes[3][k] = column(3, k) - column(1, k);
+            planes[4][k] = column(2, k);
+            planes[5][k] = column(3, k) - column(2, k);
+        }
+
+        for (auto& plane : planes)
+        {
+            float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f)
+            {
+                for (float& value : plane)
+                {
+                    value /= length;
+                }
+            }
+        }
+    }
+
+    inline void MeshletCuller::beginFrame(uint64_t frame)
+    {
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void MeshletCuller::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline std::vector<MeshletCuller::DrawRange> const& MeshletCuller::cull(View const& view, ThreadPool* thread_pool)
+    {
+        size_t const block_cnt = (m_visibility.size() + block_size - 1) / block_size;
+
+        auto cullBlock = [&](size_t block_idx) {
+            size_t begin = block_idx * block_size;
+            cullRange(view, begin, (std::min)(begin + block_size, m_visibility.size()));
+        };
+
+        if (thread_pool != nullptr && block_cnt > 1)
+        {
+            thread_pool->parallelFor(0, block_cnt, cullBlock);
+        }
+        else
+        {
+            for (size_t block_idx = 0; block_idx < block_cnt; ++block_idx)
+            {
+                cullBlock(block_idx);
+            }
+        }
+
+        m_draw_ranges.clear();
+        for (size_t i = 0; i < m_meshlet_cnt; ++i)
+        {
+            if (m_visibility[i] != Visible)
+            {
+                m_current_stats.meshlets_frustum_culled += m_visibility[i] == FrustumCulled ? 1 : 0;
+                m_current_stats.meshlets_backface_culled += m_visibility[i] == BackfaceCulled ? 1 : 0;
+                continue;
+            }
+
+            DrawRange const& range = m_ranges[i];
+            m_current_stats.triangles_visible += range.index_count / 3;
+
+            if (!m_draw_ranges.empty() && m_draw_ranges.back().submesh == range.submesh
+                && m_draw_ranges.back().first_index + m_draw_ranges.back().index_count == range.first_index)
+            {
+                m_draw_ranges.back().index_count += range.index_count;
+            }
+            else
+            {
+                m_draw_ranges.push_back(range);
+            }
+        }
+
+        m_current_stats.meshlets_tested += m_meshlet_cnt;
+        m_current_stats.draw_ranges += m_draw_ranges.size();
+
+        return m_draw_ranges;
+    }
+
+    inline std::vector<MeshletCuller::DrawRange> const& MeshletCuller::getDrawRanges() const
+    {
+        return m_draw_ranges;
+    }
+
+    inline void MeshletCuller::draw(ID3D11DeviceContext4* d3d11_ctx, INT base_vertex_location) const
+    {
+        for (auto const& range : m_draw_ranges)
+        {
+            d3d11_ctx->DrawIndexed(range.index_count, range.first_index, base_vertex_location);
+        }
+    }
+
+    inline size_t MeshletCuller::getMeshletCount() const
+    {
+        return m_meshlet_cnt;
+    }
+
+    inline MeshletCuller::FrameStatistics MeshletCuller::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline MeshletCuller::FrameStatistics MeshletCuller::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline void MeshletCuller::cullRange(View const& view, size_t begin, size_t end)
+    {
+        // begin and end are multiples of 4, the arrays are padded accordingly
+#ifdef DXOWL_CULL_SSE
+        __m128 const cam_x = _mm_set1_ps(view.camera_position[0]);
+        __m128 const cam_y = _mm_set1_ps(view.camera_position[1]);
+        __m128 const cam_z = _mm_set1_ps(view.camera_position[2]);
+
+        for (size_t i = begin; i < end; i += 4)
+        {
+            __m128 const center_x = _mm_loadu_ps(&m_center_x[i]);
+            __m128 const center_y = _mm_loadu_ps(&m_center_y[i]);
+            __m128 const center_z = _mm_loadu_ps(&m_center_z[i]);
+            __m128 const neg_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&m_radius[i]));
+
+            // sphere is outside if it lies completely behind any plane
+            __m128 outside = _mm_setzero_ps();
+            for (auto const& plane : view.frustum_planes)
+            {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(center_x, _mm_set1_ps(plane[0])), _mm_mul_ps(center_y, _mm_set1_ps(plane[1]))),
+                    _mm_add_ps(_mm_mul_ps(center_z, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, neg_radius));
+            }
+
+            // back-facing if dot(apex - camera, axis) >= cutoff * |apex - camera|
+            __m128 dir_x = _mm_sub_ps(_mm_loadu_ps(&m_apex_x[i]), cam_x);
+            __m128 dir_y = _mm_sub_ps(_mm_loadu_ps(&m_apex_y[i]), cam_y);
+            __m128 dir_z = _mm_sub_ps(_mm_loadu_ps(&m_apex_z[i]), cam_z);
+            __m128 dot = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(dir_x, _mm_loadu_ps(&m_axis_x[i])), _mm_mul_ps(dir_y, _mm_loadu_ps(&m_axis_y[i]))),
+                _mm_mul_ps(dir_z, _mm_loadu_ps(&m_axis_z[i])));
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(dir_x, dir_x), _mm_mul_ps(dir_y, dir_y)), _mm_mul_ps(dir_z, dir_z)));
+            __m128 backface = _mm_cmpge_ps(dot, _mm_mul_ps(_mm_loadu_ps(&m_cutoff[i]), length));
+
+            int outside_mask = _mm_movemask_ps(outside);
+            int backface_mask = _mm_movemask_ps(backface);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                m_visibility[i + lane] = ((outside_mask >> lane) & 1) ? FrustumCulled
+                    : ((backface_mask >> lane) & 1)                   ? BackfaceCulled
+                                                                      : Visible;
+            }
+        }
+#else
+        for (size_t i = begin; i < end; ++i)
+        {
+            bool outside = false;
+            for (auto const& plane : view.frustum_planes)
+            {
+                float distance = m_center_x[i] * plane[0] + m_center_y[i] * plane[1] + m_center_z[i] * plane[2] + plane[3];
+                outside = outside || distance < -m_radius[i];
+            }
+
+            float dir_x = m_apex_x[i] - view.camera_position[0];
+            float dir_y = m_apex_y[i] - view.camera_position[1];
+            float dir_z = m_apex_z[i] - view.camera_position[2];
+            float dot = dir_x * m_axis_x[i] + dir_y * m_axis_y[i] + dir_z * m_axis_z[i];
+            float length = std::sqrt(dir_x * dir_x + dir_y * dir_y + dir_z * dir_z);
+            bool backface = dot >= m_cutoff[i] * length;
+
+            m_visibility[i] = outside ? FrustumCulled : (backface ? BackfaceCulled : Visible);
+        }
+#endif
+    }
+
+} // namespace dxowl
+
+#endif // !MeshletCuller_hpp
@@ -0,0 +1,616 @@
+/// <copyright file="MipGenerator.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef MipGenerator_hpp
+#define MipGenerator_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define DXOWL_MIPGEN_SSE
+#include <immintrin.h>
+#endif
+
+#include "FormatTraits.hpp"
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// Generates mip chains on the CPU. Texels are filtered in linear float RGBA, _SRGB formats are
+    /// converted to linear space before filtering. The result is laid out like the subresource data expected
+    /// by the std::vector<TexelDataPtr> constructor of Texture2D, so textures can be created IMMUTABLE
+    /// and without D3D11_BIND_RENDER_TARGET. Supported are 8 and 16 bit UNORM, 16 bit FLOAT and 32 bit FLOAT
+    /// formats with 1, 2 or 4 channels (and R32G32B32_FLOAT).
+    class MipGenerator
+    {
+    public:
+        enum class Filter
+        {
+            Box,
+            Triangle,
+            Kaiser
+        };
+
+        struct Settings
+        {
+            Filter filter = Filter::Box;
+            UINT mip_levels = 0;                     // 0 generates the full chain
+            float alpha_coverage_reference = -1.0f;  // alpha test value to preserve coverage for, negative disables
+            float kaiser_width = 3.0f;               // filter radius in destination texels
+            float kaiser_alpha = 4.0f;
+        };
+
+        class MipChain
+        {
+        public:
+            DXGI_FORMAT getFormat() const { return m_format; }
+            UINT getWidth() const { return m_width; }
+            UINT getHeight() const { return m_height; }
+            UINT getMipLevels() const { return m_mip_levels; }
+            UINT getArraySize() const { return m_array_size; }
+
+            /// Pointers to all subresources, subresource i holds mip level (i % mip_levels) of array slice (i / mip_levels).
+            std::vector<void const*> getSubresourceData() const;
+
+        private:
+            friend class MipGenerator;
+
+            DXGI_FORMAT m_format = DXGI_FORMAT_UNKNOWN;
+            UINT m_width = 0;
+            UINT m_height = 0;
+            UINT m_mip_levels = 0;
+            UINT m_array_size = 0;
+            std::vector<std::vector<uint8_t>> m_subresources;
+        };
+
+        static bool isSupported(DXGI_FORMAT format);
+
+        /// Builds the mip chain for every array slice. Slices point to tightly packed level 0 texels.
+        /// Levels and slices are processed in parallel if a thread pool is given.
+        static MipChain generate(
+            DXGI_FORMAT format,
+            UINT width,
+            UINT height,
+            std::vector<void const*> const& slices,
+            Settings const& settings,
+            ThreadPool* thread_pool = nullptr);
+
+        static MipChain generate(
+            DXGI_FORMAT format,
+            UINT width,
+            UINT height,
+            std::vector<void const*> const& slices,
+            ThreadPool* thread_pool = nullptr);
+
+    private:
+        // Resampling weights for one axis, every destination texel uses tap_count taps
+        struct Kernel
+        {
+            UINT tap_count = 0;
+            std::vector<UINT> indices;
+            std::vector<float> weights;
+        };
+
+        static Kernel computeKernel(UINT src_extent, UINT dst_extent, Settings const& settings);
+        static float evaluateFilter(Filter filter, float t, Settings const& settings);
+        static float besselI0(float x);
+
+        static void decodeRow(DXGI_FORMAT format, uint8_t const* src, float* dst, UINT width);
+        static void encodeRow(DXGI_FORMAT format, float const* src, uint8_t* dst, UINT width, float alpha_scale);
+
+        static void filterRow(float const* src, float* dst, UINT dst_width, Kernel const& kernel);
+        static void filterColumns(float const* src, float* dst, UINT src_width, UINT row, Kernel const& kernel);
+
+        static float computeAlphaCoverage(std::vector<float> const& texels, float reference, float alpha_scale);
+        static float findAlphaScale(std::vector<float> const& texels, float reference, float coverage);
+
+        static float srgbToLinear(float value);
+        static float linearToSrgb(float value);
+
+        template <typename Func>
+        static void forEach(ThreadPool* thread_pool, size_t count, Func&& func);
+    };
+
+    inline std::vector<void const*> MipGenerator::MipChain::getSubresourceData() const
+    {
+        std::vector<void const*> retval;
+        retval.reserve(m_subresources.size());
+        for (auto const& subresource : m_subresources)
+        {
+            retval.push_back(subresource.data());
+        }
+        return retval;
+    }
+
+    inline bool MipGenerator::isSupported(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_R16_UNORM:
+        case DXGI_FORMAT_R16G16_UNORM:
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_R16G16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R32_FLOAT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+        case DXGI_FORMAT_R32G32B32_FLOAT:
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline MipGenerator::MipChain MipGenerator::generate(
+        DXGI_FORMAT format,
+        UINT width,
+        UINT height,
+        std::vector<void const*> const& slices,
+        Settings const& settings,
+        ThreadPool* thread_pool)
+    {
+        if (!isSupported(format))
+        {
+            throw std::invalid_argument("MipGenerator: unsupported format");
+        }
+        if (width == 0 || height == 0 || slices.empty())
+        {
+            throw std::invalid_argument("MipGenerator: empty input");
+        }
+
+        UINT const max_levels = computeMipLevelCount(width, height);
+        UINT const mip_levels = settings.mip_levels > 0 ? (std::min)(settings.mip_levels, max_levels) : max_levels;
+        UINT const array_size = static_cast<UINT>(slices.size());
+        bool const alpha_coverage = settings.alpha_coverage_reference >= 0.0f && getFormatTraits(format).channel_count == 4;
+
+        MipChain retval;
+        retval.m_format = format;
+        retval.m_width = width;
+        retval.m_height = height;
+        retval.m_mip_levels = mip_levels;
+        retval.m_array_size = array_size;
+        retval.m_subresources.resize(static_cast<size_t>(mip_levels) * array_size);
+
+        // float RGBA working copies of the previous level and the horizontally filtered intermediate
+        std::vector<std::vector<float>> levels(array_size, std::vector<float>(size_t(4) * width * height));
+        std::vector<std::vector<float>> intermediates(array_size);
+        std::vector<float> coverage(array_size, 0.0f);
+
+        size_t const row_pitch = computeRowPitch(format, width);
+
+        forEach(thread_pool, size_t(array_size) * height, [&](size_t idx) {
+            size_t slice = idx / height;
+            size_t row = idx % height;
+            auto src = static_cast<uint8_t const*>(slices[slice]) + row * row_pitch;
+            decodeRow(format, src, levels[slice].data() + size_t(4) * width * row, width);
+        });
+
+        for (UINT slice = 0; slice < array_size; ++slice)
+        {
+            auto src = static_cast<uint8_t const*>(slices[slice]);
+            retval.m_subresources[size_t(slice) * mip_levels].assign(src, src + computeSlicePitch(format, width, height));
+
+            if (alpha_coverage)
+            {
+                coverage[slice] = computeAlphaCoverage(levels[slice], settings.alpha_coverage_reference, 1.0f);
+            }
+        }
+
+        for (UINT level = 1; level < mip_levels; ++level)
+        {
+            UINT const src_width = computeMipExtent(width, level - 1);
+            UINT const src_height = computeMipExtent(height, level - 1);
+            UINT const dst_width = computeMipExtent(width, level);
+            UINT const dst_height = computeMipExtent(height, level);
+
+            Kernel const kernel_x = computeKernel(src_width, dst_width, settings);
+            Kernel const kernel_y = computeKernel(src_height, dst_height, settings);
+
+            for (auto& intermediate : intermediates)
+            {
+                intermediate.resize(size_t(4) * dst_width * src_height);
+            }
+
+            forEach(thread_pool, size_t(array_size) * src_height, [&](size_t idx) {
+                size_t slice = idx / src_height;
+                size_t row = idx % src_height;
+                filterRow(
+                    levels[slice].data() + size_t(4) * src_width * row,
+                    intermediates[slice].data() + size_t(4) * dst_width * row,
+                    dst_width,
+                    kernel_x);
+            });
+
+            for (auto& level_data : levels)
+            {
+                level_data.resize(size_t(4) * dst_width * dst_height);
+            }
+
+            forEach(thread_pool, size_t(array_size) * dst_height, [&](size_t idx) {
+                size_t slice = idx / dst_height;
+                size_t row = idx % dst_height;
+                filterColumns(
+                    intermediates[slice].data(),
+                    levels[slice].data() + size_t(4) * dst_width * row,
+                    dst_width,
+                    static_cast<UINT>(row),
+                    kernel_y);
+            });
+
+            std::vector<float> alpha_scales(array_size, 1.0f);
+            forEach(thread_pool, alpha_coverage ? array_size : 0, [&](size_t slice) {
+                alpha_scales[slice] = findAlphaScale(levels[slice], settings.alpha_coverage_reference, coverage[slice]);
+            });
+
+            size_t const dst_row_pitch = computeRowPitch(format, dst_width);
+            for (UINT slice = 0; slice < array_size; ++slice)
+            {
+                retval.m_subresources[size_t(slice) * mip_levels + level].resize(dst_row_pitch * dst_height);
+            }
+
+            forEach(thread_pool, size_t(array_size) * dst_height, [&](size_t idx) {
+                size_t slice = idx / dst_height;
+                size_t row = idx % dst_height;
+                encodeRow(
+                    format,
+                    levels[slice].data() + size_t(4) * dst_width * row,
+                    retval.m_subresources[slice * mip_levels + level].data() + dst_row_pitch * row,
+                    dst_width,
+                    alpha_scales[slice]);
+            });
+        }
+
+        return retval;
+    }
+
+    inline MipGenerator::MipChain MipGenerator::generate(
+        DXGI_FORMAT format,
+        UINT width,
+        UINT height,
+        std::vector<void const*> const& slices,
+        ThreadPool* thread_pool)
+    {
+        return generate(format, width, height, slices, Settings(), thread_pool);
+    }
+
+    inline MipGenerator::Kernel MipGenerator::computeKernel(UINT src_extent, UINT dst_extent, Settings const& settings)
+    {
+        float const scale = static_cast<float>(src_extent) / static_cast<float>(dst_extent);
+
+        float radius = 0.5f;
+        if (settings.filter == Filter::Triangle)
+            radius = 1.0f;
+        else if (settings.filter == Filter::Kaiser)
+            radius = settings.kaiser_width;
+        float const support = radius * scale;
+
+        Kernel retval;
+        retval.tap_count = static_cast<UINT>(std::ceil(support * 2.0f)) + 2;
+        retval.indices.assign(size_t(dst_extent) * retval.tap_count, 0);
+        retval.weights.assign(size_t(dst_extent) * retval.tap_count, 0.0f);
+
+        for (UINT dst = 0; dst < dst_extent; ++dst)
+        {
+            float const center = (static_cast<float>(dst) + 0.5f) * scale;
+            int const first = static_cast<int>(std::floor(center - support));
+
+            UINT* indices = retval.indices.data() + size_t(dst) * retval.tap_count;
+            float* weights = retval.weights.data() + size_t(dst) * retval.tap_count;
+            float weight_sum = 0.0f;
+
+            for (UINT tap = 0; tap < retval.tap_count; ++tap)
+            {
+                int const src = first + static_cast<int>(tap);
+                float weight = 0.0f;
+
+                if (settings.filter == Filter::Box)
+                {
+                    // exact overlap of the source texel with the destination footprint
+                    float const lo = (std::max)(static_cast<float>(src), center - support);
+                    float const hi = (std::min)(static_cast<float>(src) + 1.0f, center + support);
+                    weight = (std::max)(0.0f, hi - lo);
+                }
+                else
+                {
+                    weight = evaluateFilter(settings.filter, (static_cast<float>(src) + 0.5f - center) / scale, settings);
+                }
+
+                // clamp addressing
+                indices[tap] = static_cast<UINT>((std::min)((std::max)(src, 0), static_cast<int>(src_extent) - 1));
+                weights[tap] = weight;
+                weight_sum += weight;
+            }
+
+            for (UINT tap = 0; tap < retval.tap_count; ++tap)
+            {
+                weights[tap] /= weight_sum;
+            }
+        }
+
+        return retval;
+    }
+
+    inline float MipGenerator::evaluateFilter(Filter filter, float t, Settings const& settings)
+    {
+        float const abs_t = std::abs(t);
+
+        if (filter == Filter::Triangle)
+        {
+            return (std::max)(0.0f, 1.0f - abs_t);
+        }
+
+        // Kaiser windowed sinc
+        if (abs_t >= settings.kaiser_width)
+        {
+            return 0.0f;
+        }
+
+        float const pi_t = 3.14159265358979f * t;
+        float const sinc = abs_t < 1e-6f ? 1.0f : std::sin(pi_t) / pi_t;
+        float const ratio = t / settings.kaiser_width;
+        float const window = besselI0(settings.kaiser_alpha * std::sqrt(1.0f - ratio * ratio)) / besselI0(settings.kaiser_alpha);
+
+        return sinc * window;
+    }
+
+    inline float MipGenerator::besselI0(float x)
+    {
+        // power series, converges quickly for the alpha values used by Kaiser windows
+        float sum = 1.0f;
+        float term = 1.0f;
+        float const half_x_sq = 0.25f * x * x;
+
+        for (int k = 1; k < 32 && term > sum * 1e-8f; ++k)
+        {
+            term *= half_x_sq / static_cast<float>(k * k);
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    inline void MipGenerator::decodeRow(DXGI_FORMAT format, uint8_t const* src, float* dst, UINT width)
+    {
+        FormatTraits const& traits = getFormatTraits(format);
+        UINT const channel_cnt = traits.channel_count;
+        UINT const channel_size = traits.bytes_per_block / channel_cnt;
+        bool const srgb = traits.is_srgb;
+
+        for (UINT x = 0; x < width; ++x)
+        {
+            float texel[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+            for (UINT c = 0; c < channel_cnt; ++c)
+            {
+                uint8_t const* channel = src + (size_t(x) * channel_cnt + c) * channel_size;
+
+                if (traits.channel_type == FormatChannelType::Unorm && channel_size == 1)
+                {
+                    texel[c] = static_cast<float>(*channel) / 255.0f;
+                    if (srgb && c < 3)
+                        texel[c] = srgbToLinear(texel[c]);
+                }
+                else if (traits.channel_type == FormatChannelType::Unorm)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, channel, 2);
+                    texel[c] = static_cast<float>(value) / 65535.0f;
+                }
+                else if (channel_size == 2)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, channel, 2);
+                    texel[c] = halfToFloat(value);
+                }
+                else
+                {
+                    std::memcpy(&texel[c], channel, 4);
+                }
+            }
+
+            std::memcpy(dst + size_t(4) * x, texel, sizeof(texel));
+        }
+    }
+
+    inline void MipGenerator::encodeRow(DXGI_FORMAT format, float const* src, uint8_t* dst, UINT width, float alpha_scale)
+    {
+        FormatTraits const& traits = getFormatTraits(format);
+        UINT const channel_cnt = traits.channel_count;
+        UINT const channel_size = traits.bytes_per_block / channel_cnt;
+        bool const srgb = traits.is_srgb;
+
+        for (UINT x = 0; x < width; ++x)
+        {
+            float texel[4];
+            std::memcpy(texel, src + size_t(4) * x, sizeof(texel));
+            texel[3] *= alpha_scale;
+
+            for (UINT c = 0; c < channel_cnt; ++c)
+            {
+                uint8_t* channel = dst + (size_t(x) * channel_cnt + c) * channel_size;
+
+                if (traits.channel_type == FormatChannelType::Unorm)
+                {
+                    // negative filter lobes can leave the representable range
+                    float value = (std::min)((std::max)(texel[c], 0.0f), 1.0f);
+                    if (channel_size == 1)
+                    {
+                        *channel = static_cast<uint8_t>((srgb && c < 3 ? linearToSrgb(value) : value) * 255.0f + 0.5f);
+                    }
+                    else
+                    {
+                        uint16_t encoded = static_cast<uint16_t>(value * 65535.0f + 0.5f);
+                        std::memcpy(channel, &encoded, 2);
+                    }
+                }
+                else if (channel_size == 2)
+                {
+                    uint16_t encoded = floatToHalf(texel[c]);
+                    std::memcpy(channel, &encoded, 2);
+                }
+                else
+                {
+                    std::memcpy(channel, &texel[c], 4);
+                }
+            }
+        }
+    }
+
+    inline void MipGenerator::filterRow(float const* src, float* dst, UINT dst_width, Kernel const& kernel)
+    {
+        for (UINT x = 0; x < dst_width; ++x)
+        {
+            UINT const* indices = kernel.indices.data() + size_t(x) * kernel.tap_count;
+            float const* weights = kernel.weights.data() + size_t(x) * kernel.tap_count;
+
+#ifdef DXOWL_MIPGEN_SSE
+            __m128 sum = _mm_setzero_ps();
+            for (UINT tap = 0; tap < kernel.tap_count; ++tap)
+            {
+                __m128 texel = _mm_loadu_ps(src + size_t(4) * indices[tap]);
+                sum = _mm_add_ps(sum, _mm_mul_ps(texel, _mm_set1_ps(weights[tap])));
+            }
+            _mm_storeu_ps(dst + size_t(4) * x, sum);
+#else
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (UINT tap = 0; tap < kernel.tap_count; ++tap)
+            {
+                float const* texel = src + size_t(4) * indices[tap];
+                for (int c = 0; c < 4; ++c)
+                    sum[c] += texel[c] * weights[tap];
+            }
+            std::memcpy(dst + size_t(4) * x, sum, sizeof(sum));
+#endif
+        }
+    }
+
+    inline void MipGenerator::filterColumns(float const* src, float* dst, UINT src_width, UINT row, Kernel const& kernel)
+    {
+        UINT const* indices = kernel.indices.data() + size_t(row) * kernel.tap_count;
+        float const* weights = kernel.weights.data() + size_t(row) * kernel.tap_count;
+        size_t const float_cnt = size_t(4) * src_width;
+
+        std::fill(dst, dst + float_cnt, 0.0f);
+
+        for (UINT tap = 0; tap < kernel.tap_count; ++tap)
+        {
+            if (weights[tap] == 0.0f)
+                continue;
+
+            float const* src_row = src + float_cnt * indices[tap];
+            float const weight = weights[tap];
+            size_t i = 0;
+
+#if defined(__AVX2__)
+            __m256 const weight8 = _mm256_set1_ps(weight);
+            for (; i + 8 <= float_cnt; i += 8)
+            {
+                __m256 sum = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src_row + i), weight8));
+                _mm256_storeu_ps(dst + i, sum);
+            }
+#endif
+#ifdef DXOWL_MIPGEN_SSE
+            __m128 const weight4 = _mm_set1_ps(weight);
+            for (; i + 4 <= float_cnt; i += 4)
+            {
+                __m128 sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src_row + i), weight4));
+                _mm_storeu_ps(dst + i, sum);
+            }
+#endif
+            for (; i < float_cnt; ++i)
+            {
+                dst[i] += src_row[i] * weight;
+            }
+        }
+    }
+
+    inline float MipGenerator::computeAlphaCoverage(std::vector<float> const& texels, float reference, float alpha_scale)
+    {
+        size_t const texel_cnt = texels.size() / 4;
+        size_t covered = 0;
+
+        for (size_t i = 0; i < texel_cnt; ++i)
+        {
+            if (texels[i * 4 + 3] * alpha_scale > reference)
+                ++covered;
+        }
+
+        return static_cast<float>(covered) / static_cast<float>(texel_cnt);
+    }
+
+    inline float MipGenerator::findAlphaScale(std::vector<float> const& texels, float reference, float coverage)
+    {
+        // coverage grows monotonically with the scale, bisect for the scale that matches level 0 best.
+        // Coverage is a step function, so keep the closest candidate rather than the last one
+        float lo = 0.0f;
+        float hi = 4.0f;
+        float retval = 1.0f;
+        float best_error = std::abs(computeAlphaCoverage(texels, reference, 1.0f) - coverage);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            float const mid = 0.5f * (lo + hi);
+            float const current = computeAlphaCoverage(texels, reference, mid);
+            float const error = std::abs(current - coverage);
+
+            if (error < best_error)
+            {
+                best_error = error;
+                retval = mid;
+            }
+
+            if (current < coverage)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        return retval;
+    }
+
+    inline float MipGenerator::srgbToLinear(float value)
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    inline float MipGenerator::linearToSrgb(float value)
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    template <typename Func>
+    inline void MipGenerator::forEach(ThreadPool* thread_pool, size_t count, Func&& func)
+    {
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, count, func, 16);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !MipGenerator_hpp
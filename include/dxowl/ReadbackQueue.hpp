@@ -0,0 +1,332 @@
+/// <copyright file="ReadbackQueue.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ReadbackQueue_hpp
+#define ReadbackQueue_hpp
+
+#include <d3d11_4.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "Buffer.hpp"
+
+namespace dxowl
+{
+    /// Reads buffers back to the CPU without stalling the render thread. Each request copies the source into a
+    /// pooled staging buffer, which is polled with D3D11_MAP_FLAG_DO_NOT_WAIT once it is latency_frames old.
+    /// Completed data is delivered to a callback or a future from poll(). Requests complete in submission order,
+    /// since the GPU finishes copies in order. Use the immediate context, deferred contexts cannot map for reading.
+    /// Not thread-safe, futures may be waited on from any thread.
+    class ReadbackQueue
+    {
+    public:
+        /// Called from poll() with the copied bytes, which are only valid during the call.
+        typedef std::function<void(void const* data, size_t byte_size)> Callback;
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t request_count = 0;
+            size_t completed_count = 0;
+            size_t bytes_requested = 0;
+            size_t bytes_completed = 0;
+            size_t busy_poll_count = 0;     // maps that returned DXGI_ERROR_WAS_STILL_DRAWING
+            size_t pending_count = 0;
+            size_t staging_count = 0;
+            size_t staging_bytes = 0;
+        };
+
+        ReadbackQueue(ID3D11Device4* d3d11_device, uint32_t latency_frames = 2);
+        ~ReadbackQueue() = default;
+
+        ReadbackQueue(const ReadbackQueue& cpy) = delete;
+        ReadbackQueue(ReadbackQueue&& other) = delete;
+        ReadbackQueue& operator=(ReadbackQueue&& rhs) = delete;
+        ReadbackQueue& operator=(const ReadbackQueue& rhs) = delete;
+
+        /// Number of frames a request waits before it is polled. Zero polls in the frame of the request.
+        void setLatency(uint32_t latency_frames);
+        uint32_t getLatency() const;
+
+        /// Copies the whole buffer with CopyResource.
+        void enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src, Callback callback);
+
+        /// Copies byte_size bytes starting at byte_offset with CopySubresourceRegion.
+        void enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src, UINT byte_offset, UINT byte_size, Callback callback);
+
+        std::future<std::vector<std::byte>> enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src);
+        std::future<std::vector<std::byte>> enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src, UINT byte_offset, UINT byte_size);
+
+        /// Delivers all requests whose copies finished, never blocks. Call once per frame after beginFrame.
+        void poll(ID3D11DeviceContext4* d3d11_ctx);
+
+        /// Blocks until all pending requests are delivered, e.g. before shutdown or a device reset.
+        void flush(ID3D11DeviceContext4* d3d11_ctx);
+
+        size_t getPendingCount() const;
+
+        /// Releases staging buffers that are not in use.
+        void trim();
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct Request
+        {
+            std::unique_ptr<Buffer> staging;
+            UINT byte_size;
+            uint64_t epoch;
+            Callback callback;
+        };
+
+        std::unique_ptr<Buffer> acquireStaging(UINT byte_size);
+
+        /// Returns false if the copy of the request has not finished yet and wait is false.
+        bool tryComplete(ID3D11DeviceContext4* d3d11_ctx, Request& request, bool wait);
+
+        static Callback makePromiseCallback(std::shared_ptr<std::promise<std::vector<std::byte>>> const& promise);
+
+        ID3D11Device4* m_d3d11_device;
+        uint32_t m_latency_frames;
+
+        std::deque<Request> m_pending;
+        std::vector<std::unique_ptr<Buffer>> m_free_staging;
+
+        uint64_t m_epoch; // counts beginFrame calls, so latency does not depend on the frame numbers passed in
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline ReadbackQueue::ReadbackQueue(ID3D11Device4* d3d11_device, uint32_t latency_frames)
+        : m_d3d11_device(d3d11_device), m_latency_frames(latency_frames), m_epoch(0)
+    {
+    }
+
+    inline void ReadbackQueue::setLatency(uint32_t latency_frames)
+    {
+        m_latency_frames = latency_frames;
+    }
+
+    inline uint32_t ReadbackQueue::getLatency() const
+    {
+        return m_latency_frames;
+    }
+
+    inline void ReadbackQueue::enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src, Callback callback)
+    {
+        D3D11_BUFFER_DESC desc;
+        src->GetDesc(&desc);
+
+        Request request;
+        request.staging = acquireStaging(desc.ByteWidth);
+        request.byte_size = desc.ByteWidth;
+        request.epoch = m_epoch;
+        request.callback = std::move(callback);
+
+        // CopyResource requires identical sizes, pooled staging buffers of the exact size are reused
+        if (request.staging->getDescriptor().ByteWidth == desc.ByteWidth)
+        {
+            d3d11_ctx->CopyResource(request.staging->getBuffer().Get(), src);
+        }
+        else
+        {
+            D3D11_BOX const box = { 0, 0, 0, desc.ByteWidth, 1, 1 };
+            d3d11_ctx->CopySubresourceRegion(request.staging->getBuffer().Get(), 0, 0, 0, 0, src, 0, &box);
+        }
+
+        ++m_current_stats.request_count;
+        m_current_stats.bytes_requested += desc.ByteWidth;
+        m_pending.push_back(std::move(request));
+    }
+
+    inline void ReadbackQueue::enqueue(
+        ID3D11DeviceContext4* d3d11_ctx,
+        ID3D11Buffer* src,
+        UINT byte_offset,
+        UINT byte_size,
+        Callback callback)
+    {
+        D3D11_BUFFER_DESC desc;
+        src->GetDesc(&desc);
+        if (byte_size == 0 || byte_offset > desc.ByteWidth || byte_size > desc.ByteWidth - byte_offset)
+        {
+            throw std::out_of_range("ReadbackQueue: range exceeds source buffer");
+        }
+
+        Request request;
+        request.staging = acquireStaging(byte_size);
+        request.byte_size = byte_size;
+        request.epoch = m_epoch;
+        request.callback = std::move(callback);
+
+        D3D11_BOX const box = { byte_offset, 0, 0, byte_offset + byte_size, 1, 1 };
+        d3d11_ctx->CopySubresourceRegion(request.staging->getBuffer().Get(), 0, 0, 0, 0, src, 0, &box);
+
+        ++m_current_stats.request_count;
+        m_current_stats.bytes_requested += byte_size;
+        m_pending.push_back(std::move(request));
+    }
+
+    inline std::future<std::vector<std::byte>> ReadbackQueue::enqueue(ID3D11DeviceContext4* d3d11_ctx, ID3D11Buffer* src)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<std::byte>>>();
+        std::future<std::vector<std::byte>> retval = promise->get_future();
+        enqueue(d3d11_ctx, src, makePromiseCallback(promise));
+        return retval;
+    }
+
+    inline std::future<std::vector<std::byte>> ReadbackQueue::enqueue(
+        ID3D11DeviceContext4* d3d11_ctx,
+        ID3D11Buffer* src,
+        UINT byte_offset,
+        UINT byte_size)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<std::byte>>>();
+        std::future<std::vector<std::byte>> retval = promise->get_future();
+        enqueue(d3d11_ctx, src, byte_offset, byte_size, makePromiseCallback(promise));
+        return retval;
+    }
+
+    inline void ReadbackQueue::poll(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        while (!m_pending.empty())
+        {
+            Request& request = m_pending.front();
+            if (m_epoch < request.epoch + m_latency_frames || !tryComplete(d3d11_ctx, request, false))
+            {
+                // later copies were submitted after this one and cannot have finished earlier
+                break;
+            }
+            m_free_staging.push_back(std::move(request.staging));
+            m_pending.pop_front();
+        }
+    }
+
+    inline void ReadbackQueue::flush(ID3D11DeviceContext4* d3d11_ctx)
+    {
+        while (!m_pending.empty())
+        {
+            tryComplete(d3d11_ctx, m_pending.front(), true);
+            m_free_staging.push_back(std::move(m_pending.front().staging));
+            m_pending.pop_front();
+        }
+    }
+
+    inline size_t ReadbackQueue::getPendingCount() const
+    {
+        return m_pending.size();
+    }
+
+    inline void ReadbackQueue::trim()
+    {
+        m_free_staging.clear();
+    }
+
+    inline void ReadbackQueue::beginFrame(uint64_t frame)
+    {
+        ++m_epoch;
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void ReadbackQueue::endFrame()
+    {
+        m_current_stats.pending_count = m_pending.size();
+        m_current_stats.staging_count = m_pending.size() + m_free_staging.size();
+        for (auto const& request : m_pending)
+        {
+            m_current_stats.staging_bytes += request.staging->getMemoryByteSize();
+        }
+        for (auto const& staging : m_free_staging)
+        {
+            m_current_stats.staging_bytes += staging->getMemoryByteSize();
+        }
+        m_last_stats = m_current_stats;
+    }
+
+    inline ReadbackQueue::FrameStatistics ReadbackQueue::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline ReadbackQueue::FrameStatistics ReadbackQueue::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline std::unique_ptr<Buffer> ReadbackQueue::acquireStaging(UINT byte_size)
+    {
+        // smallest free staging buffer that fits, so large buffers are not used up by small requests
+        size_t best = m_free_staging.size();
+        for (size_t i = 0; i < m_free_staging.size(); ++i)
+        {
+            UINT const staging_size = m_free_staging[i]->getDescriptor().ByteWidth;
+            if (staging_size >= byte_size && (best == m_free_staging.size() || staging_size < m_free_staging[best]->getDescriptor().ByteWidth))
+            {
+                best = i;
+            }
+        }
+
+        if (best < m_free_staging.size())
+        {
+            std::unique_ptr<Buffer> retval = std::move(m_free_staging[best]);
+            m_free_staging[best] = std::move(m_free_staging.back());
+            m_free_staging.pop_back();
+            return retval;
+        }
+
+        const CD3D11_BUFFER_DESC desc(byte_size, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
+        return std::make_unique<Buffer>(m_d3d11_device, desc);
+    }
+
+    inline bool ReadbackQueue::tryComplete(ID3D11DeviceContext4* d3d11_ctx, Request& request, bool wait)
+    {
+        ID3D11Buffer* staging = request.staging->getBuffer().Get();
+
+        D3D11_MAPPED_SUBRESOURCE map;
+        HRESULT hr = d3d11_ctx->Map(staging, 0, D3D11_MAP_READ, wait ? 0 : D3D11_MAP_FLAG_DO_NOT_WAIT, &map);
+        if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+        {
+            ++m_current_stats.busy_poll_count;
+            return false;
+        }
+        winrt::check_hresult(hr);
+
+        ++m_current_stats.completed_count;
+        m_current_stats.bytes_completed += request.byte_size;
+
+        if (request.callback)
+        {
+            request.callback(map.pData, request.byte_size);
+        }
+        d3d11_ctx->Unmap(staging, 0);
+        return true;
+    }
+
+    inline ReadbackQueue::Callback ReadbackQueue::makePromiseCallback(std::shared_ptr<std::promise<std::vector<std::byte>>> const& promise)
+    {
+        return [promise](void const* data, size_t byte_size) {
+            std::byte const* bytes = static_cast<std::byte const*>(data);
+            promise->set_value(std::vector<std::byte>(bytes, bytes + byte_size));
+        };
+    }
+
+} // namespace dxowl
+
+#endif // !ReadbackQueue_hpp
@@ -0,0 +1,611 @@
+/// <copyright file="RenderGraph.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef RenderGraph_hpp
+#define RenderGraph_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DepthStencil.hpp"
+#include "MemoryTracker.hpp"
+#include "RenderTarget.hpp"
+#include "RenderTargetPool.hpp"
+
+namespace dxowl
+{
+    /// Per-frame graph of render passes that declare which textures they read and write.
+    /// compile() culls passes whose results are never consumed, execute() runs the remaining passes and backs
+    /// transient textures with RenderTargetPool leases that live from their first to their last use, so transient
+    /// textures with disjoint lifetimes share the same pooled texture.
+    /// Passes run in declaration order, a read sees the last write declared before it. Passes that write imported
+    /// textures or are marked with a side effect are never culled.
+    /// Before a pass runs, its written textures are bound as render targets with the viewport of the first one,
+    /// transient textures are cleared on their first write, and shader resource views are unbound if a written
+    /// texture is still bound for reading. Not thread-safe, build and execute on the render thread.
+    class RenderGraph
+    {
+    public:
+        typedef uint32_t ResourceHandle;
+        static constexpr ResourceHandle InvalidResource = ~static_cast<ResourceHandle>(0);
+
+        struct TextureDesc
+        {
+            DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM; // depth stencil view format for depth stencils
+            UINT width = 0;
+            UINT height = 0;
+            UINT sample_count = 1;
+            bool depth_stencil = false;
+            bool clear = true;
+            float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float clear_depth = 1.0f;
+            UINT8 clear_stencil = 0;
+        };
+
+        class PassBuilder
+        {
+        public:
+            void read(ResourceHandle resource);
+            void write(ResourceHandle resource);
+
+            /// Keeps the pass even if none of its writes is consumed, e.g. for readbacks or buffer writes.
+            void setSideEffect();
+
+        private:
+            friend class RenderGraph;
+
+            PassBuilder(RenderGraph& graph, size_t pass_idx);
+
+            RenderGraph& m_graph;
+            size_t m_pass_idx;
+        };
+
+        class PassContext
+        {
+        public:
+            ID3D11DeviceContext4* getDeviceContext() const;
+
+            RenderTarget* getRenderTarget(ResourceHandle resource) const;
+            DepthStencil* getDepthStencil(ResourceHandle resource) const;
+            ID3D11ShaderResourceView* getShaderResourceView(ResourceHandle resource) const;
+
+            /// Viewport of the requested size and texture coordinate scale of the backing texture.
+            D3D11_VIEWPORT getViewport(ResourceHandle resource) const;
+            void getUVScale(ResourceHandle resource, float (&uv_scale)[2]) const;
+
+        private:
+            friend class RenderGraph;
+
+            PassContext(RenderGraph const& graph, ID3D11DeviceContext4* d3d11_ctx);
+
+            RenderGraph const& m_graph;
+            ID3D11DeviceContext4* m_d3d11_ctx;
+        };
+
+        typedef std::function<void(PassBuilder&)> SetupFunc;
+        typedef std::function<void(PassContext&)> ExecuteFunc;
+
+        struct Statistics
+        {
+            size_t pass_count = 0;
+            size_t culled_pass_count = 0;
+            size_t transient_count = 0;
+            size_t transient_bytes = 0;         // sum of all transient textures, as if each had its own texture
+            size_t physical_texture_count = 0;  // pooled textures that backed the transients
+            size_t physical_bytes = 0;
+        };
+
+        RenderGraph() = default;
+        ~RenderGraph() = default;
+
+        RenderGraph(const RenderGraph& cpy) = delete;
+        RenderGraph(RenderGraph&& other) = delete;
+        RenderGraph& operator=(RenderGraph&& rhs) = delete;
+        RenderGraph& operator=(const RenderGraph& rhs) = delete;
+
+        ResourceHandle createTexture(std::string const& name, TextureDesc const& desc);
+        ResourceHandle importRenderTarget(std::string const& name, RenderTarget* render_target);
+        ResourceHandle importDepthStencil(std::string const& name, DepthStencil* depth_stencil);
+
+        /// Calls setup right away to collect the reads and writes of the pass, execute runs in execute().
+        void addPass(std::string const& name, SetupFunc const& setup, ExecuteFunc execute);
+
+        /// Culls unused passes and computes the lifetimes of transient textures.
+        void compile();
+
+        /// Runs the passes that survived compile(), leasing transient textures from the pool.
+        void execute(ID3D11DeviceContext4* d3d11_ctx, RenderTargetPool& pool);
+
+        /// Removes all passes and resources to build the next frame's graph.
+        void reset();
+
+        bool isCulled(std::string const& pass_name) const;
+
+        Statistics getStatistics() const;
+
+    private:
+        static constexpr size_t invalid_pass = ~size_t(0);
+
+        struct Resource
+        {
+            std::string name;
+            TextureDesc desc;
+            RenderTarget* imported_render_target = nullptr;
+            DepthStencil* imported_depth_stencil = nullptr;
+            RenderTargetPool::Lease lease;
+            size_t first_pass = invalid_pass; // position in the execution order
+            size_t last_pass = invalid_pass;
+            bool written = false;
+
+            bool isImported() const;
+            Texture2D* getTexture() const;
+        };
+
+        struct Pass
+        {
+            std::string name;
+            ExecuteFunc execute;
+            std::vector<ResourceHandle> reads;
+            std::vector<ResourceHandle> writes;
+            std::vector<size_t> producers; // earlier passes whose writes this pass depends on
+            bool side_effect = false;
+            bool culled = false;
+        };
+
+        Resource& getResource(ResourceHandle resource);
+        Resource const& getResource(ResourceHandle resource) const;
+
+        void bindOutputs(ID3D11DeviceContext4* d3d11_ctx, Pass const& pass, std::vector<Texture2D*>& bound_for_reading);
+
+        std::vector<Resource> m_resources;
+        std::vector<Pass> m_passes;
+        std::vector<size_t> m_execution_order;
+        bool m_compiled = false;
+
+        Statistics m_stats;
+    };
+
+    inline void RenderGraph::PassBuilder::read(ResourceHandle resource)
+    {
+        m_graph.getResource(resource);
+        m_graph.m_passes[m_pass_idx].reads.push_back(resource);
+    }
+
+    inline void RenderGraph::PassBuilder::write(ResourceHandle resource)
+    {
+        m_graph.getResource(resource);
+        m_graph.m_passes[m_pass_idx].writes.push_back(resource);
+    }
+
+    inline void RenderGraph::PassBuilder::setSideEffect()
+    {
+        m_graph.m_passes[m_pass_idx].side_effect = true;
+    }
+
+    inline RenderGraph::PassBuilder::PassBuilder(RenderGraph& graph, size_t pass_idx)
+        : m_graph(graph), m_pass_idx(pass_idx)
+    {
+    }
+
+    inline ID3D11DeviceContext4* RenderGraph::PassContext::getDeviceContext() const
+    {
+        return m_d3d11_ctx;
+    }
+
+    inline RenderTarget* RenderGraph::PassContext::getRenderTarget(ResourceHandle resource) const
+    {
+        Resource const& rsrc = m_graph.getResource(resource);
+        return rsrc.imported_render_target != nullptr ? rsrc.imported_render_target : rsrc.lease.render_target;
+    }
+
+    inline DepthStencil* RenderGraph::PassContext::getDepthStencil(ResourceHandle resource) const
+    {
+        Resource const& rsrc = m_graph.getResource(resource);
+        return rsrc.imported_depth_stencil != nullptr ? rsrc.imported_depth_stencil : rsrc.lease.depth_stencil;
+    }
+
+    inline ID3D11ShaderResourceView* RenderGraph::PassContext::getShaderResourceView(ResourceHandle resource) const
+    {
+        Texture2D* texture = m_graph.getResource(resource).getTexture();
+        return texture != nullptr ? texture->getShaderResourceView().Get() : nullptr;
+    }
+
+    inline D3D11_VIEWPORT RenderGraph::PassContext::getViewport(ResourceHandle resource) const
+    {
+        return m_graph.getResource(resource).lease.viewport;
+    }
+
+    inline void RenderGraph::PassContext::getUVScale(ResourceHandle resource, float (&uv_scale)[2]) const
+    {
+        Resource const& rsrc = m_graph.getResource(resource);
+        uv_scale[0] = rsrc.lease.uv_scale[0];
+        uv_scale[1] = rsrc.lease.uv_scale[1];
+    }
+
+    inline RenderGraph::PassContext::PassContext(RenderGraph const& graph, ID3D11DeviceContext4* d3d11_ctx)
+        : m_graph(graph), m_d3d11_ctx(d3d11_ctx)
+    {
+    }
+
+    inline RenderGraph::ResourceHandle RenderGraph::createTexture(std::string const& name, TextureDesc const& desc)
+    {
+        if (desc.width == 0 || desc.height == 0)
+        {
+            throw std::invalid_argument("RenderGraph: transient texture " + name + " has no size");
+        }
+
+        Resource resource;
+        resource.name = name;
+        resource.desc = desc;
+        m_resources.push_back(resource);
+        m_compiled = false;
+        return static_cast<ResourceHandle>(m_resources.size() - 1);
+    }
+
+    inline RenderGraph::ResourceHandle RenderGraph::importRenderTarget(std::string const& name, RenderTarget* render_target)
+    {
+        Resource resource;
+        resource.name = name;
+        resource.imported_render_target = render_target;
+        resource.lease.render_target = render_target;
+
+        D3D11_TEXTURE2D_DESC texture_desc = render_target->getTextureDesc();
+        resource.desc.format = texture_desc.Format;
+        resource.desc.width = texture_desc.Width;
+        resource.desc.height = texture_desc.Height;
+        resource.desc.sample_count = texture_desc.SampleDesc.Count;
+        resource.desc.clear = false;
+        resource.lease.width = texture_desc.Width;
+        resource.lease.height = texture_desc.Height;
+        resource.lease.viewport = { 0.0f, 0.0f, static_cast<float>(texture_desc.Width), static_cast<float>(texture_desc.Height), 0.0f, 1.0f };
+
+        m_resources.push_back(resource);
+        m_compiled = false;
+        return static_cast<ResourceHandle>(m_resources.size() - 1);
+    }
+
+    inline RenderGraph::ResourceHandle RenderGraph::importDepthStencil(std::string const& name, DepthStencil* depth_stencil)
+    {
+        Resource resource;
+        resource.name = name;
+        resource.imported_depth_stencil = depth_stencil;
+        resource.lease.depth_stencil = depth_stencil;
+
+        D3D11_TEXTURE2D_DESC texture_desc = depth_stencil->getTextureDesc();
+        resource.desc.format = texture_desc.Format;
+        resource.desc.width = texture_desc.Width;
+        resource.desc.height = texture_desc.Height;
+        resource.desc.sample_count = texture_desc.SampleDesc.Count;
+        resource.desc.depth_stencil = true;
+        resource.desc.clear = false;
+        resource.lease.width = texture_desc.Width;
+        resource.lease.height = texture_desc.Height;
+        resource.lease.viewport = { 0.0f, 0.0f, static_cast<float>(texture_desc.Width), static_cast<float>(texture_desc.Height), 0.0f, 1.0f };
+
+        m_resources.push_back(resource);
+        m_compiled = false;
+        return static_cast<ResourceHandle>(m_resources.size() - 1);
+    }
+
+    inline void RenderGraph::addPass(std::string const& name, SetupFunc const& setup, ExecuteFunc execute)
+    {
+        m_passes.push_back(Pass());
+        m_passes.back().name = name;
+        m_passes.back().execute = std::move(execute);
+
+        PassBuilder builder(*this, m_passes.size() - 1);
+        setup(builder);
+
+        Pass const& pass = m_passes.back();
+        for (ResourceHandle read : pass.reads)
+        {
+            if (std::find(pass.writes.begin(), pass.writes.end(), read) != pass.writes.end())
+            {
+                throw std::invalid_argument("RenderGraph: pass " + name + " reads and writes " + m_resources[read].name);
+            }
+        }
+        m_compiled = false;
+    }
+
+    inline void RenderGraph::compile()
+    {
+        m_stats = Statistics();
+        m_stats.pass_count = m_passes.size();
+
+        // a read depends on the last writer, a write on the previous writer since it draws on top of its content
+        std::vector<size_t> last_writer(m_resources.size(), invalid_pass);
+        for (size_t pass_idx = 0; pass_idx < m_passes.size(); ++pass_idx)
+        {
+            Pass& pass = m_passes[pass_idx];
+            pass.producers.clear();
+            pass.culled = true;
+
+            for (ResourceHandle read : pass.reads)
+            {
+                if (last_writer[read] != invalid_pass)
+                {
+                    pass.producers.push_back(last_writer[read]);
+                }
+                else if (!m_resources[read].isImported())
+                {
+                    throw std::runtime_error("RenderGraph: pass " + pass.name + " reads " + m_resources[read].name + " before it is written");
+                }
+            }
+            for (ResourceHandle write : pass.writes)
+            {
+                if (last_writer[write] != invalid_pass)
+                {
+                    pass.producers.push_back(last_writer[write]);
+                }
+                last_writer[write] = pass_idx;
+            }
+        }
+
+        // keep passes with side effects or imported outputs and everything they depend on
+        std::vector<size_t> stack;
+        for (size_t pass_idx = 0; pass_idx < m_passes.size(); ++pass_idx)
+        {
+            Pass const& pass = m_passes[pass_idx];
+            bool writes_imported = std::any_of(pass.writes.begin(), pass.writes.end(),
+                [this](ResourceHandle write) { return m_resources[write].isImported(); });
+            if (pass.side_effect || writes_imported)
+            {
+                stack.push_back(pass_idx);
+            }
+        }
+        while (!stack.empty())
+        {
+            Pass& pass = m_passes[stack.back()];
+            stack.pop_back();
+            if (!pass.culled)
+            {
+                continue;
+            }
+            pass.culled = false;
+            stack.insert(stack.end(), pass.producers.begin(), pass.producers.end());
+        }
+
+        // dependencies always point to earlier passes, so the declaration order is a valid execution order
+        m_execution_order.clear();
+        for (auto& resource : m_resources)
+        {
+            resource.first_pass = invalid_pass;
+            resource.last_pass = invalid_pass;
+        }
+        for (size_t pass_idx = 0; pass_idx < m_passes.size(); ++pass_idx)
+        {
+            Pass const& pass = m_passes[pass_idx];
+            if (pass.culled)
+            {
+                ++m_stats.culled_pass_count;
+                continue;
+            }
+
+            size_t const position = m_execution_order.size();
+            m_execution_order.push_back(pass_idx);
+            for (auto const* handles : { &pass.reads, &pass.writes })
+            {
+                for (ResourceHandle handle : *handles)
+                {
+                    Resource& resource = m_resources[handle];
+                    resource.first_pass = (std::min)(resource.first_pass, position);
+                    resource.last_pass = resource.last_pass == invalid_pass ? position : (std::max)(resource.last_pass, position);
+                }
+            }
+        }
+
+        for (auto const& resource : m_resources)
+        {
+            if (!resource.isImported() && resource.first_pass != invalid_pass)
+            {
+                D3D11_TEXTURE2D_DESC texture_desc = {};
+                texture_desc.Width = resource.desc.width;
+                texture_desc.Height = resource.desc.height;
+                texture_desc.MipLevels = 1;
+                texture_desc.ArraySize = 1;
+                texture_desc.Format = resource.desc.format;
+                texture_desc.SampleDesc.Count = resource.desc.sample_count;
+
+                ++m_stats.transient_count;
+                m_stats.transient_bytes += computeResourceByteSize(texture_desc);
+            }
+        }
+
+        m_compiled = true;
+    }
+
+    inline void RenderGraph::execute(ID3D11DeviceContext4* d3d11_ctx, RenderTargetPool& pool)
+    {
+        if (!m_compiled)
+        {
+            compile();
+        }
+
+        std::vector<Texture2D*> physical_textures;
+        std::vector<Texture2D*> bound_for_reading;
+        m_stats.physical_bytes = 0;
+
+        for (size_t position = 0; position < m_execution_order.size(); ++position)
+        {
+            size_t const pass_idx = m_execution_order[position];
+            Pass const& pass = m_passes[pass_idx];
+
+            for (auto const* handles : { &pass.reads, &pass.writes })
+            {
+                for (ResourceHandle handle : *handles)
+                {
+                    Resource& resource = m_resources[handle];
+                    if (resource.isImported() || resource.first_pass != position || resource.lease.render_target != nullptr || resource.lease.depth_stencil != nullptr)
+                    {
+                        continue;
+                    }
+
+                    TextureDesc const& desc = resource.desc;
+                    resource.lease = desc.depth_stencil
+                        ? pool.acquireDepthStencil(desc.format, desc.width, desc.height, desc.sample_count)
+                        : pool.acquireRenderTarget(desc.format, desc.width, desc.height, desc.sample_count);
+                    resource.written = false;
+
+                    Texture2D* texture = resource.getTexture();
+                    if (std::find(physical_textures.begin(), physical_textures.end(), texture) == physical_textures.end())
+                    {
+                        physical_textures.push_back(texture);
+                        m_stats.physical_bytes += texture->getMemoryByteSize();
+                    }
+                }
+            }
+
+            bindOutputs(d3d11_ctx, pass, bound_for_reading);
+
+            for (ResourceHandle read : pass.reads)
+            {
+                bound_for_reading.push_back(m_resources[read].getTexture());
+            }
+
+            PassContext context(*this, d3d11_ctx);
+            pass.execute(context);
+
+            for (auto const* handles : { &pass.reads, &pass.writes })
+            {
+                for (ResourceHandle handle : *handles)
+                {
+                    Resource& resource = m_resources[handle];
+                    if (!resource.isImported() && resource.last_pass == position && (resource.lease.render_target != nullptr || resource.lease.depth_stencil != nullptr))
+                    {
+                        pool.release(resource.lease);
+                        resource.lease = RenderTargetPool::Lease();
+                    }
+                }
+            }
+        }
+
+        d3d11_ctx->OMSetRenderTargets(0, nullptr, nullptr);
+        m_stats.physical_texture_count = physical_textures.size();
+    }
+
+    inline void RenderGraph::reset()
+    {
+        m_resources.clear();
+        m_passes.clear();
+        m_execution_order.clear();
+        m_compiled = false;
+    }
+
+    inline bool RenderGraph::isCulled(std::string const& pass_name) const
+    {
+        for (auto const& pass : m_passes)
+        {
+            if (pass.name == pass_name)
+            {
+                return pass.culled;
+            }
+        }
+        throw std::invalid_argument("RenderGraph: unknown pass " + pass_name);
+    }
+
+    inline RenderGraph::Statistics RenderGraph::getStatistics() const
+    {
+        return m_stats;
+    }
+
+    inline bool RenderGraph::Resource::isImported() const
+    {
+        return imported_render_target != nullptr || imported_depth_stencil != nullptr;
+    }
+
+    inline Texture2D* RenderGraph::Resource::getTexture() const
+    {
+        if (lease.render_target != nullptr)
+        {
+            return lease.render_target;
+        }
+        return lease.depth_stencil;
+    }
+
+    inline RenderGraph::Resource& RenderGraph::getResource(ResourceHandle resource)
+    {
+        if (resource >= m_resources.size())
+        {
+            throw std::invalid_argument("RenderGraph: invalid resource handle");
+        }
+        return m_resources[resource];
+    }
+
+    inline RenderGraph::Resource const& RenderGraph::getResource(ResourceHandle resource) const
+    {
+        if (resource >= m_resources.size())
+        {
+            throw std::invalid_argument("RenderGraph: invalid resource handle");
+        }
+        return m_resources[resource];
+    }
+
+    inline void RenderGraph::bindOutputs(ID3D11DeviceContext4* d3d11_ctx, Pass const& pass, std::vector<Texture2D*>& bound_for_reading)
+    {
+        ID3D11RenderTargetView* rtvs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+        UINT rtv_cnt = 0;
+        ID3D11DepthStencilView* dsv = nullptr;
+        D3D11_VIEWPORT const* viewport = nullptr;
+        bool read_hazard = false;
+
+        for (ResourceHandle write : pass.writes)
+        {
+            Resource& resource = m_resources[write];
+            Texture2D* texture = resource.getTexture();
+            read_hazard = read_hazard || std::find(bound_for_reading.begin(), bound_for_reading.end(), texture) != bound_for_reading.end();
+            viewport = viewport != nullptr ? viewport : &resource.lease.viewport;
+
+            if (resource.lease.depth_stencil != nullptr)
+            {
+                dsv = resource.lease.depth_stencil->getDepthStencilView().Get();
+                if (!resource.written && resource.desc.clear)
+                {
+                    UINT clear_flags = D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL;
+                    d3d11_ctx->ClearDepthStencilView(dsv, clear_flags, resource.desc.clear_depth, resource.desc.clear_stencil);
+                }
+            }
+            else if (rtv_cnt < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT)
+            {
+                rtvs[rtv_cnt] = resource.lease.render_target->getRenderTargetView().Get();
+                if (!resource.written && resource.desc.clear)
+                {
+                    d3d11_ctx->ClearRenderTargetView(rtvs[rtv_cnt], resource.desc.clear_color);
+                }
+                ++rtv_cnt;
+            }
+            resource.written = true;
+        }
+
+        // a texture bound as shader resource cannot be bound as output. Passes may read in any stage,
+        // so unbind the shader resources of all stages
+        if (read_hazard)
+        {
+            ID3D11ShaderResourceView* null_srvs[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+            d3d11_ctx->VSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            d3d11_ctx->HSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            d3d11_ctx->DSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            d3d11_ctx->GSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            d3d11_ctx->PSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            d3d11_ctx->CSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, null_srvs);
+            bound_for_reading.clear();
+        }
+
+        d3d11_ctx->OMSetRenderTargets(rtv_cnt, rtv_cnt > 0 ? rtvs : nullptr, dsv);
+        if (viewport != nullptr)
+        {
+            d3d11_ctx->RSSetViewports(1, viewport);
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !RenderGraph_hpp
@@ -0,0 +1,494 @@
+/// <copyright file="RenderQueue.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef RenderQueue_hpp
+#define RenderQueue_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "GeometryArena.hpp"
+#include "Mesh.hpp"
+#include "ShaderProgram.hpp"
+#include "StateCache.hpp"
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// Collects the draws of a frame with a 64 bit sort key, radix sorts them and submits them through a
+    /// StateCache, so draws that share a shader program, input layout and geometry are issued back to back
+    /// and only rebind what changed. From the most to the least significant bits, keys hold the pass,
+    /// shader program id, layout id, geometry (mesh or arena) id and depth bucket. Ids are assigned by the
+    /// caller and must fit into their bit ranges. Not thread-safe.
+    class RenderQueue
+    {
+    public:
+        typedef uint64_t SortKey;
+
+        static constexpr uint32_t pass_bits = 8;
+        static constexpr uint32_t program_bits = 14;
+        static constexpr uint32_t layout_bits = 10;
+        static constexpr uint32_t geometry_bits = 20;
+        static constexpr uint32_t depth_bits = 12;
+
+        static constexpr uint32_t depth_shift = 0;
+        static constexpr uint32_t geometry_shift = depth_shift + depth_bits;
+        static constexpr uint32_t layout_shift = geometry_shift + geometry_bits;
+        static constexpr uint32_t program_shift = layout_shift + layout_bits;
+        static constexpr uint32_t pass_shift = program_shift + program_bits;
+
+        /// A draw of either a Mesh or a mesh of a GeometryArena. For meshes, the index range and base vertex are
+        /// passed to the draw call, so draws of the same mesh share its vertex and index buffer bindings.
+        struct Draw
+        {
+            ShaderProgram* program = nullptr;
+            Mesh* mesh = nullptr;
+            GeometryArena* arena = nullptr;
+            GeometryArena::MeshHandle arena_mesh = GeometryArena::InvalidHandle;
+            UINT index_count = 0;
+            UINT first_index = 0;
+            INT base_vertex = 0;
+            UINT instance_count = 1;
+            UINT base_instance = 0;
+            uint32_t user_data = 0;         // e.g. the index of the draw's constants
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t draw_count = 0;
+            size_t program_changes = 0;
+            size_t geometry_changes = 0;
+            size_t radix_passes = 0;        // byte passes that reordered keys, passes over a constant byte are skipped
+        };
+
+        RenderQueue() = default;
+        ~RenderQueue() = default;
+
+        RenderQueue(const RenderQueue& cpy) = delete;
+        RenderQueue(RenderQueue&& other) = delete;
+        RenderQueue& operator=(RenderQueue&& rhs) = delete;
+        RenderQueue& operator=(const RenderQueue& rhs) = delete;
+
+        static SortKey makeKey(uint32_t pass, uint32_t program_id, uint32_t layout_id, uint32_t geometry_id, uint32_t depth_bucket);
+
+        /// Quantizes a view space depth into a depth bucket. Use back_to_front for blended draws.
+        static uint32_t computeDepthBucket(float view_depth, float near_z, float far_z, bool back_to_front = false);
+
+        static uint32_t getPass(SortKey key);
+
+        /// Clears the queue, keeping its memory.
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        void add(SortKey key, Draw const& draw);
+
+        size_t getDrawCount() const;
+
+        /// Key and draw at a position of the queue, in key order after sort(), e.g. for custom submission.
+        SortKey getKey(size_t position) const;
+        Draw const& getDraw(size_t position) const;
+
+        /// Sorts the draws by key, stable for equal keys. With a thread pool, large queues are sorted in parallel.
+        void sort(ThreadPool* thread_pool = nullptr);
+
+        /// Submits all draws in key order. per_draw is called before each draw (signature: void(Draw const&)),
+        /// e.g. to bind the draw's constants.
+        void submit(StateCache& state_cache);
+
+        template <typename PerDrawFunc>
+        void submit(StateCache& state_cache, PerDrawFunc&& per_draw);
+
+        /// Submits the draws of one pass, e.g. after binding the pass's render targets. Requires sorted draws.
+        template <typename PerDrawFunc>
+        void submitPass(StateCache& state_cache, uint32_t pass, PerDrawFunc&& per_draw);
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct Item
+        {
+            SortKey key;
+            uint32_t draw_idx;
+        };
+
+        /// Below this count, sorting on multiple threads costs more than it saves.
+        static constexpr size_t parallel_threshold = 1u << 16;
+
+        static constexpr size_t radix_bits = 8;
+        static constexpr size_t radix_size = 1u << radix_bits;
+        static constexpr size_t radix_pass_count = sizeof(SortKey) * 8 / radix_bits;
+
+        typedef std::array<std::array<uint32_t, radix_size>, radix_pass_count> Histograms;
+
+        static uint32_t getDigit(SortKey key, size_t pass);
+
+        void sortSerial();
+        void sortParallel(ThreadPool& thread_pool);
+
+        template <typename PerDrawFunc>
+        void submitRange(StateCache& state_cache, size_t begin, size_t end, PerDrawFunc&& per_draw);
+
+        std::vector<Item> m_items;
+        std::vector<Item> m_scratch;
+        std::vector<Draw> m_draws;
+        bool m_sorted = true;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline RenderQueue::SortKey RenderQueue::makeKey(
+        uint32_t pass,
+        uint32_t program_id,
+        uint32_t layout_id,
+        uint32_t geometry_id,
+        uint32_t depth_bucket)
+    {
+        if ((pass >> pass_bits) != 0 || (program_id >> program_bits) != 0 || (layout_id >> layout_bits) != 0
+            || (geometry_id >> geometry_bits) != 0 || (depth_bucket >> depth_bits) != 0)
+        {
+            throw std::out_of_range("RenderQueue: sort key field exceeds its bit range");
+        }
+
+        return (static_cast<SortKey>(pass) << pass_shift)
+            | (static_cast<SortKey>(program_id) << program_shift)
+            | (static_cast<SortKey>(layout_id) << layout_shift)
+            | (static_cast<SortKey>(geometry_id) << geometry_shift)
+            | (static_cast<SortKey>(depth_bucket) << depth_shift);
+    }
+
+    inline uint32_t RenderQueue::computeDepthBucket(float view_depth, float near_z, float far_z, bool back_to_front)
+    {
+        uint32_t const max_bucket = (1u << depth_bits) - 1;
+
+        float t = far_z > near_z ? (view_depth - near_z) / (far_z - near_z) : 0.0f;
+        t = (std::min)((std::max)(t, 0.0f), 1.0f);
+
+        uint32_t bucket = static_cast<uint32_t>(t * static_cast<float>(max_bucket) + 0.5f);
+        return back_to_front ? max_bucket - bucket : bucket;
+    }
+
+    inline uint32_t RenderQueue::getPass(SortKey key)
+    {
+        return static_cast<uint32_t>(key >> pass_shift);
+    }
+
+    inline void RenderQueue::beginFrame(uint64_t frame)
+    {
+        m_items.clear();
+        m_draws.clear();
+        m_sorted = true;
+
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void RenderQueue::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline void RenderQueue::add(SortKey key, Draw const& draw)
+    {
+        if (draw.program == nullptr || (draw.mesh == nullptr) == (draw.arena == nullptr))
+        {
+            throw std::invalid_argument("RenderQueue: draw needs a shader program and either a mesh or an arena");
+        }
+
+        m_sorted = m_sorted && (m_items.empty() || m_items.back().key <= key);
+        m_items.push_back({ key, static_cast<uint32_t>(m_draws.size()) });
+        m_draws.push_back(draw);
+        ++m_current_stats.draw_count;
+    }
+
+    inline size_t RenderQueue::getDrawCount() const
+    {
+        return m_draws.size();
+    }
+
+    inline RenderQueue::SortKey RenderQueue::getKey(size_t position) const
+    {
+        if (position >= m_items.size())
+        {
+            throw std::out_of_range("RenderQueue: draw position out of range");
+        }
+        return m_items[position].key;
+    }
+
+    inline RenderQueue::Draw const& RenderQueue::getDraw(size_t position) const
+    {
+        if (position >= m_items.size())
+        {
+            throw std::out_of_range("RenderQueue: draw position out of range");
+        }
+        return m_draws[m_items[position].draw_idx];
+    }
+
+    inline void RenderQueue::sort(ThreadPool* thread_pool)
+    {
+        if (m_sorted)
+        {
+            return;
+        }
+
+        m_scratch.resize(m_items.size());
+
+        if (thread_pool != nullptr && thread_pool->getThreadCount() > 1 && m_items.size() >= parallel_threshold)
+        {
+            sortParallel(*thread_pool);
+        }
+        else
+        {
+            sortSerial();
+        }
+
+        m_sorted = true;
+    }
+
+    inline void RenderQueue::submit(StateCache& state_cache)
+    {
+        submit(state_cache, [](Draw const&) {});
+    }
+
+    template <typename PerDrawFunc>
+    inline void RenderQueue::submit(StateCache& state_cache, PerDrawFunc&& per_draw)
+    {
+        submitRange(state_cache, 0, m_items.size(), per_draw);
+    }
+
+    template <typename PerDrawFunc>
+    inline void RenderQueue::submitPass(StateCache& state_cache, uint32_t pass, PerDrawFunc&& per_draw)
+    {
+        if (!m_sorted)
+        {
+            throw std::logic_error("RenderQueue: submitPass requires sorted draws");
+        }
+
+        auto pass_less = [](Item const& item, uint32_t value) { return getPass(item.key) < value; };
+        auto begin = std::lower_bound(m_items.begin(), m_items.end(), pass, pass_less);
+        auto end = std::lower_bound(begin, m_items.end(), pass + 1, pass_less);
+
+        submitRange(state_cache, begin - m_items.begin(), end - m_items.begin(), per_draw);
+    }
+
+    inline RenderQueue::FrameStatistics RenderQueue::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline RenderQueue::FrameStatistics RenderQueue::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline uint32_t RenderQueue::getDigit(SortKey key, size_t pass)
+    {
+        return static_cast<uint32_t>(key >> (pass * radix_bits)) & (radix_size - 1);
+    }
+
+    inline void RenderQueue::sortSerial()
+    {
+        size_t const item_cnt = m_items.size();
+
+        // histograms of all digits in a single read
+        Histograms histograms = {};
+        for (Item const& item : m_items)
+        {
+            for (size_t pass = 0; pass < radix_pass_count; ++pass)
+            {
+                ++histograms[pass][getDigit(item.key, pass)];
+            }
+        }
+
+        for (size_t pass = 0; pass < radix_pass_count; ++pass)
+        {
+            auto const& histogram = histograms[pass];
+            if (histogram[getDigit(m_items.front().key, pass)] == item_cnt)
+            {
+                continue;
+            }
+
+            std::array<uint32_t, radix_size> offsets;
+            uint32_t offset = 0;
+            for (size_t digit = 0; digit < radix_size; ++digit)
+            {
+                offsets[digit] = offset;
+                offset += histogram[digit];
+            }
+
+            Item const* src = m_items.data();
+            Item* dst = m_scratch.data();
+            for (size_t i = 0; i < item_cnt; ++i)
+            {
+                dst[offsets[getDigit(src[i].key, pass)]++] = src[i];
+            }
+
+            m_items.swap(m_scratch);
+            ++m_current_stats.radix_passes;
+        }
+    }
+
+    inline void RenderQueue::sortParallel(ThreadPool& thread_pool)
+    {
+        size_t const item_cnt = m_items.size();
+        size_t const chunk_cnt = std::max<size_t>(1, (std::min)(thread_pool.getThreadCount() * 2, item_cnt / 8192));
+        size_t const chunk_size = (item_cnt + chunk_cnt - 1) / chunk_cnt;
+
+        // per chunk histograms of all digits, summed up to find the digits that are constant over all keys
+        std::vector<Histograms> chunk_histograms(chunk_cnt);
+        thread_pool.parallelFor(0, chunk_cnt, [&](size_t chunk) {
+            Histograms& histograms = chunk_histograms[chunk];
+            histograms = {};
+            size_t const end = (std::min)(item_cnt, (chunk + 1) * chunk_size);
+            for (size_t i = chunk * chunk_size; i < end; ++i)
+            {
+                for (size_t pass = 0; pass < radix_pass_count; ++pass)
+                {
+                    ++histograms[pass][getDigit(m_items[i].key, pass)];
+                }
+            }
+        });
+
+        std::vector<bool> skip_pass(radix_pass_count);
+        for (size_t pass = 0; pass < radix_pass_count; ++pass)
+        {
+            uint32_t const digit = getDigit(m_items.front().key, pass);
+            size_t count = 0;
+            for (auto const& histograms : chunk_histograms)
+            {
+                count += histograms[pass][digit];
+            }
+            skip_pass[pass] = count == item_cnt;
+        }
+
+        std::vector<std::array<uint32_t, radix_size>> chunk_offsets(chunk_cnt);
+        bool first_pass = true;
+
+        for (size_t pass = 0; pass < radix_pass_count; ++pass)
+        {
+            if (skip_pass[pass])
+            {
+                continue;
+            }
+
+            // chunk histograms of the current order, the initial ones are still valid for the first pass
+            Item const* src = m_items.data();
+            Item* dst = m_scratch.data();
+            thread_pool.parallelFor(0, chunk_cnt, [&](size_t chunk) {
+                auto& offsets = chunk_offsets[chunk];
+                if (first_pass)
+                {
+                    offsets = chunk_histograms[chunk][pass];
+                    return;
+                }
+                offsets = {};
+                size_t const end = (std::min)(item_cnt, (chunk + 1) * chunk_size);
+                for (size_t i = chunk * chunk_size; i < end; ++i)
+                {
+                    ++offsets[getDigit(src[i].key, pass)];
+                }
+            });
+
+            // chunks scatter in order, which keeps the sort stable
+            uint32_t offset = 0;
+            for (size_t digit = 0; digit < radix_size; ++digit)
+            {
+                for (size_t chunk = 0; chunk < chunk_cnt; ++chunk)
+                {
+                    uint32_t const count = chunk_offsets[chunk][digit];
+                    chunk_offsets[chunk][digit] = offset;
+                    offset += count;
+                }
+            }
+
+            thread_pool.parallelFor(0, chunk_cnt, [&](size_t chunk) {
+                auto& offsets = chunk_offsets[chunk];
+                size_t const end = (std::min)(item_cnt, (chunk + 1) * chunk_size);
+                for (size_t i = chunk * chunk_size; i < end; ++i)
+                {
+                    dst[offsets[getDigit(src[i].key, pass)]++] = src[i];
+                }
+            });
+
+            m_items.swap(m_scratch);
+            first_pass = false;
+            ++m_current_stats.radix_passes;
+        }
+    }
+
+    template <typename PerDrawFunc>
+    inline void RenderQueue::submitRange(StateCache& state_cache, size_t begin, size_t end, PerDrawFunc&& per_draw)
+    {
+        ShaderProgram* program = nullptr;
+        Mesh* mesh = nullptr;
+        GeometryArena* arena = nullptr;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            Draw const& draw = m_draws[m_items[i].draw_idx];
+
+            if (draw.program != program)
+            {
+                program = draw.program;
+                program->setInputLayout(state_cache);
+                program->setVertexShader(state_cache);
+                program->setGeometryShader(state_cache);
+                program->setPixelShader(state_cache);
+                ++m_current_stats.program_changes;
+            }
+
+            if (draw.mesh != nullptr && draw.mesh != mesh)
+            {
+                mesh = draw.mesh;
+                arena = nullptr;
+                mesh->setVertexBuffers(state_cache, 0);
+                mesh->setIndexBuffer(state_cache, 0);
+                state_cache.setPrimitiveTopology(mesh->getPrimitiveTopology());
+                ++m_current_stats.geometry_changes;
+            }
+            else if (draw.arena != nullptr && draw.arena != arena)
+            {
+                arena = draw.arena;
+                mesh = nullptr;
+                arena->setVertexBuffers(state_cache);
+                arena->setIndexBuffer(state_cache);
+                state_cache.setPrimitiveTopology(arena->getPrimitiveTopology());
+                ++m_current_stats.geometry_changes;
+            }
+
+            per_draw(draw);
+
+            UINT index_count = draw.index_count;
+            UINT first_index = draw.first_index;
+            INT base_vertex = draw.base_vertex;
+            if (draw.arena != nullptr)
+            {
+                GeometryArena::MeshView view = draw.arena->getMeshView(draw.arena_mesh);
+                index_count = view.index_count;
+                first_index = view.first_index;
+                base_vertex = static_cast<INT>(view.base_vertex);
+            }
+
+            if (draw.instance_count == 1 && draw.base_instance == 0)
+            {
+                state_cache.drawIndexed(index_count, first_index, base_vertex);
+            }
+            else
+            {
+                state_cache.drawIndexedInstanced(index_count, draw.instance_count, first_index, base_vertex, draw.base_instance);
+            }
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !RenderQueue_hpp
@@ -21,6 +21,11 @@ namespace dxowl
             D3D11_RENDER_TARGET_VIEW_DESC const &rndr_tgt_view);
         ~RenderTarget(){};
 
+        RenderTarget(const RenderTarget& cpy) = delete;
+        RenderTarget(RenderTarget&& other) = default;
+        RenderTarget& operator=(RenderTarget&& rhs) = default;
+        RenderTarget& operator=(const RenderTarget& rhs) = delete;
+
         void resize(ID3D11Device4* d3d11_device, UINT width, UINT height);
 
         inline Microsoft::WRL::ComPtr<ID3D11RenderTargetView> getRenderTargetView() const
@@ -42,14 +47,23 @@ namespace dxowl
         D3D11_RENDER_TARGET_VIEW_DESC const &rndr_tgt_view)
         : Texture2D(d3d11_device, std::vector<void *>(), desc, shdr_rsrc_view), m_rndr_tgt_view_desc(rndr_tgt_view)
     {
-        HRESULT hr = d3d11_device->CreateRenderTargetView(
-            m_texture.Get(),
-            &m_rndr_tgt_view_desc,
-            &m_rndr_tgt_view);
+        winrt::check_hresult(
+            d3d11_device->CreateRenderTargetView(
+                m_texture.Get(),
+                &m_rndr_tgt_view_desc,
+                &m_rndr_tgt_view));
+
+        m_memory_allocation.setCategory(MemoryTracker::Category::RenderTarget);
     }
 
     inline void RenderTarget::resize(ID3D11Device4* d3d11_device, UINT width, UINT height)
     {
+        // Keep the texture and its views if the size does not change
+        if (m_texture != nullptr && m_desc.Width == width && m_desc.Height == height)
+        {
+            return;
+        }
+
         m_rndr_tgt_view = nullptr;
         m_shdr_rsrc_view = nullptr;
         m_texture = nullptr;
@@ -61,22 +75,25 @@ namespace dxowl
         m_desc.Width = width;
         m_desc.Height = height;
 
-        HRESULT hr = d3d11_device->CreateTexture2D(
-            &m_desc,
-            nullptr,
-            m_texture.GetAddressOf()
-        );
-
-        hr = d3d11_device->CreateShaderResourceView(
-            m_texture.Get(),
-            &m_shdr_rsrc_view_desc,
-            m_shdr_rsrc_view.GetAddressOf()
-        );
-
-        hr = d3d11_device->CreateRenderTargetView(
-            m_texture.Get(),
-            &m_rndr_tgt_view_desc,
-            &m_rndr_tgt_view);
+        winrt::check_hresult(
+            d3d11_device->CreateTexture2D(
+                &m_desc,
+                nullptr,
+                m_texture.GetAddressOf()));
+
+        winrt::check_hresult(
+            d3d11_device->CreateShaderResourceView(
+                m_texture.Get(),
+                &m_shdr_rsrc_view_desc,
+                m_shdr_rsrc_view.GetAddressOf()));
+
+        winrt::check_hresult(
+            d3d11_device->CreateRenderTargetView(
+                m_texture.Get(),
+                &m_rndr_tgt_view_desc,
+                &m_rndr_tgt_view));
+
+        m_memory_allocation.setByteSize(computeResourceByteSize(m_desc));
     }
 
 } // namespace dxowl
@@ -0,0 +1,429 @@
+/// <copyright file="RenderTargetPool.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef RenderTargetPool_hpp
+#define RenderTargetPool_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "DepthStencil.hpp"
+#include "RenderTarget.hpp"
+
+namespace dxowl
+{
+    /// Pool of transient render targets and depth stencils that are acquired and released within a frame and reused
+    /// across frames. Textures are allocated larger than requested, rounded up to the size granularity plus growth
+    /// slack, and a pooled texture is reused for any request it covers while its area stays within max_area_ratio of
+    /// the request. Render through the returned viewport and scale texture coordinates by uv_scale when sampling,
+    /// so interactive window resizing reuses textures instead of reallocating them every frame.
+    /// Shader resource views are always created, depth formats are allocated typeless for that.
+    /// Not thread-safe, call from the render thread.
+    class RenderTargetPool
+    {
+    public:
+        struct Settings
+        {
+            UINT size_granularity = 64;
+            float growth_slack = 0.125f;   // extra size on allocation, relative to the request
+            float max_area_ratio = 2.0f;   // largest pooled area that is reused for a request
+            uint64_t trim_after_frames = 120; // unused textures are destroyed after this many frames
+        };
+
+        /// Pooled texture leased for the requested size. Exactly one of render_target and depth_stencil is set.
+        struct Lease
+        {
+            RenderTarget* render_target = nullptr;
+            DepthStencil* depth_stencil = nullptr;
+            UINT width = 0;
+            UINT height = 0;
+            D3D11_VIEWPORT viewport = {};
+            float uv_scale[2] = { 1.0f, 1.0f };
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t acquire_count = 0;
+            size_t hit_count = 0;
+            size_t allocation_count = 0;
+            size_t trim_count = 0;
+            size_t pooled_count = 0;
+            size_t pooled_bytes = 0;
+            size_t leased_peak = 0;
+
+            float getHitRate() const;
+        };
+
+        RenderTargetPool(ID3D11Device4* d3d11_device, Settings const& settings);
+        RenderTargetPool(ID3D11Device4* d3d11_device);
+        ~RenderTargetPool() = default;
+
+        RenderTargetPool(const RenderTargetPool& cpy) = delete;
+        RenderTargetPool(RenderTargetPool&& other) = delete;
+        RenderTargetPool& operator=(RenderTargetPool&& rhs) = delete;
+        RenderTargetPool& operator=(const RenderTargetPool& rhs) = delete;
+
+        void beginFrame(uint64_t frame);
+
+        /// Releases all leases that are still held and destroys textures that were not used for trim_after_frames.
+        void endFrame();
+
+        Lease acquireRenderTarget(
+            DXGI_FORMAT format,
+            UINT width,
+            UINT height,
+            UINT sample_count = 1,
+            UINT bind_flags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE);
+
+        /// format is the depth stencil view format, e.g. DXGI_FORMAT_D24_UNORM_S8_UINT.
+        Lease acquireDepthStencil(
+            DXGI_FORMAT format,
+            UINT width,
+            UINT height,
+            UINT sample_count = 1,
+            UINT bind_flags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE);
+
+        /// Returns the texture to the pool, it may be handed out again in the same frame.
+        void release(Lease const& lease);
+
+        /// Destroys all textures that are not leased.
+        void trim();
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct Key
+        {
+            DXGI_FORMAT format;
+            UINT bind_flags;
+            UINT sample_count;
+            bool depth_stencil;
+
+            bool operator<(Key const& rhs) const;
+        };
+
+        struct Entry
+        {
+            std::unique_ptr<RenderTarget> render_target;
+            std::unique_ptr<DepthStencil> depth_stencil;
+            UINT width;
+            UINT height;
+            uint64_t last_used_frame;
+            bool leased;
+        };
+
+        Lease acquire(Key const& key, UINT width, UINT height);
+        void createEntry(Key const& key, UINT width, UINT height, Entry& entry) const;
+        UINT computeAllocationExtent(UINT extent) const;
+        void updatePoolStatistics();
+
+        /// Typeless texture format and shader resource view format of a depth stencil view format.
+        static void getDepthFormats(DXGI_FORMAT dsv_format, DXGI_FORMAT& texture_format, DXGI_FORMAT& srv_format);
+
+        ID3D11Device4* m_d3d11_device;
+        Settings m_settings;
+
+        std::map<Key, std::vector<std::unique_ptr<Entry>>> m_entries;
+        size_t m_leased_count;
+
+        uint64_t m_frame;
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline float RenderTargetPool::FrameStatistics::getHitRate() const
+    {
+        return acquire_count > 0 ? static_cast<float>(hit_count) / static_cast<float>(acquire_count) : 1.0f;
+    }
+
+    inline RenderTargetPool::RenderTargetPool(ID3D11Device4* d3d11_device, Settings const& settings)
+        : m_d3d11_device(d3d11_device), m_settings(settings), m_leased_count(0), m_frame(0)
+    {
+        if (m_settings.size_granularity == 0 || m_settings.max_area_ratio < 1.0f)
+        {
+            throw std::invalid_argument("RenderTargetPool: size granularity must be positive and the area ratio at least 1");
+        }
+    }
+
+    inline RenderTargetPool::RenderTargetPool(ID3D11Device4* d3d11_device)
+        : RenderTargetPool(d3d11_device, Settings())
+    {
+    }
+
+    inline void RenderTargetPool::beginFrame(uint64_t frame)
+    {
+        m_frame = frame;
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void RenderTargetPool::endFrame()
+    {
+        for (auto& bucket : m_entries)
+        {
+            auto& entries = bucket.second;
+            for (auto& entry : entries)
+            {
+                entry->leased = false;
+            }
+
+            auto stale = std::remove_if(entries.begin(), entries.end(), [this](std::unique_ptr<Entry> const& entry) {
+                return m_frame - entry->last_used_frame > m_settings.trim_after_frames;
+            });
+            m_current_stats.trim_count += static_cast<size_t>(entries.end() - stale);
+            entries.erase(stale, entries.end());
+        }
+        m_leased_count = 0;
+
+        updatePoolStatistics();
+        m_last_stats = m_current_stats;
+    }
+
+    inline RenderTargetPool::Lease RenderTargetPool::acquireRenderTarget(
+        DXGI_FORMAT format,
+        UINT width,
+        UINT height,
+        UINT sample_count,
+        UINT bind_flags)
+    {
+        return acquire({ format, bind_flags | D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE, sample_count, false }, width, height);
+    }
+
+    inline RenderTargetPool::Lease RenderTargetPool::acquireDepthStencil(
+        DXGI_FORMAT format,
+        UINT width,
+        UINT height,
+        UINT sample_count,
+        UINT bind_flags)
+    {
+        return acquire({ format, bind_flags | D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE, sample_count, true }, width, height);
+    }
+
+    inline void RenderTargetPool::release(Lease const& lease)
+    {
+        Texture2D const* texture = lease.render_target != nullptr
+            ? static_cast<Texture2D const*>(lease.render_target)
+            : static_cast<Texture2D const*>(lease.depth_stencil);
+
+        for (auto& bucket : m_entries)
+        {
+            for (auto& entry : bucket.second)
+            {
+                Texture2D const* entry_texture = entry->render_target != nullptr
+                    ? static_cast<Texture2D const*>(entry->render_target.get())
+                    : static_cast<Texture2D const*>(entry->depth_stencil.get());
+                if (entry_texture == texture && entry->leased)
+                {
+                    entry->leased = false;
+                    --m_leased_count;
+                    return;
+                }
+            }
+        }
+
+        throw std::invalid_argument("RenderTargetPool: lease does not belong to the pool or was already released");
+    }
+
+    inline void RenderTargetPool::trim()
+    {
+        for (auto& bucket : m_entries)
+        {
+            auto& entries = bucket.second;
+            auto unused = std::remove_if(entries.begin(), entries.end(), [](std::unique_ptr<Entry> const& entry) {
+                return !entry->leased;
+            });
+            m_current_stats.trim_count += static_cast<size_t>(entries.end() - unused);
+            entries.erase(unused, entries.end());
+        }
+        updatePoolStatistics();
+    }
+
+    inline RenderTargetPool::FrameStatistics RenderTargetPool::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline RenderTargetPool::FrameStatistics RenderTargetPool::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline bool RenderTargetPool::Key::operator<(Key const& rhs) const
+    {
+        return std::tie(format, bind_flags, sample_count, depth_stencil)
+            < std::tie(rhs.format, rhs.bind_flags, rhs.sample_count, rhs.depth_stencil);
+    }
+
+    inline RenderTargetPool::Lease RenderTargetPool::acquire(Key const& key, UINT width, UINT height)
+    {
+        if (width == 0 || height == 0)
+        {
+            throw std::invalid_argument("RenderTargetPool: empty render target requested");
+        }
+
+        ++m_current_stats.acquire_count;
+
+        // smallest free texture that covers the request without wasting too much memory
+        auto& entries = m_entries[key];
+        Entry* best = nullptr;
+        uint64_t const requested_area = static_cast<uint64_t>(width) * height;
+        for (auto& entry : entries)
+        {
+            uint64_t area = static_cast<uint64_t>(entry->width) * entry->height;
+            if (!entry->leased && entry->width >= width && entry->height >= height
+                && static_cast<float>(area) <= m_settings.max_area_ratio * static_cast<float>(requested_area)
+                && (best == nullptr || area < static_cast<uint64_t>(best->width) * best->height))
+            {
+                best = entry.get();
+            }
+        }
+
+        if (best != nullptr)
+        {
+            ++m_current_stats.hit_count;
+        }
+        else
+        {
+            // create first, so a failed creation leaves the pool unchanged
+            auto created = std::make_unique<Entry>();
+            createEntry(key, computeAllocationExtent(width), computeAllocationExtent(height), *created);
+            ++m_current_stats.allocation_count;
+
+            // replace a free texture of the same kind that is too small or too large, if any
+            auto replaced = std::find_if(entries.begin(), entries.end(), [this](std::unique_ptr<Entry> const& entry) {
+                return !entry->leased && entry->last_used_frame != m_frame;
+            });
+            if (replaced == entries.end())
+            {
+                entries.push_back(std::move(created));
+                best = entries.back().get();
+            }
+            else
+            {
+                replaced->swap(created);
+                best = replaced->get();
+            }
+        }
+
+        best->leased = true;
+        best->last_used_frame = m_frame;
+        m_current_stats.leased_peak = (std::max)(m_current_stats.leased_peak, ++m_leased_count);
+
+        Lease retval;
+        retval.render_target = best->render_target.get();
+        retval.depth_stencil = best->depth_stencil.get();
+        retval.width = width;
+        retval.height = height;
+        retval.viewport = { 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f };
+        retval.uv_scale[0] = static_cast<float>(width) / static_cast<float>(best->width);
+        retval.uv_scale[1] = static_cast<float>(height) / static_cast<float>(best->height);
+        return retval;
+    }
+
+    inline void RenderTargetPool::createEntry(Key const& key, UINT width, UINT height, Entry& entry) const
+    {
+        D3D11_TEXTURE2D_DESC desc = {};
+        desc.Width = width;
+        desc.Height = height;
+        desc.MipLevels = 1;
+        desc.ArraySize = 1;
+        desc.Format = key.format;
+        desc.SampleDesc.Count = key.sample_count;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = key.bind_flags;
+
+        bool const multisampled = key.sample_count > 1;
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+        srv_desc.Format = key.format;
+        srv_desc.ViewDimension = multisampled ? D3D11_SRV_DIMENSION_TEXTURE2DMS : D3D11_SRV_DIMENSION_TEXTURE2D;
+        srv_desc.Texture2D.MostDetailedMip = 0;
+        srv_desc.Texture2D.MipLevels = 1;
+
+        if (key.depth_stencil)
+        {
+            getDepthFormats(key.format, desc.Format, srv_desc.Format);
+
+            D3D11_DEPTH_STENCIL_VIEW_DESC dsv_desc = {};
+            dsv_desc.Format = key.format;
+            dsv_desc.ViewDimension = multisampled ? D3D11_DSV_DIMENSION_TEXTURE2DMS : D3D11_DSV_DIMENSION_TEXTURE2D;
+            entry.depth_stencil = std::make_unique<DepthStencil>(m_d3d11_device, desc, srv_desc, dsv_desc);
+        }
+        else
+        {
+            D3D11_RENDER_TARGET_VIEW_DESC rtv_desc = {};
+            rtv_desc.Format = key.format;
+            rtv_desc.ViewDimension = multisampled ? D3D11_RTV_DIMENSION_TEXTURE2DMS : D3D11_RTV_DIMENSION_TEXTURE2D;
+            entry.render_target = std::make_unique<RenderTarget>(m_d3d11_device, desc, srv_desc, rtv_desc);
+        }
+
+        entry.width = width;
+        entry.height = height;
+        entry.last_used_frame = m_frame;
+        entry.leased = false;
+    }
+
+    inline UINT RenderTargetPool::computeAllocationExtent(UINT extent) const
+    {
+        UINT const granularity = m_settings.size_granularity;
+        UINT slack_extent = extent + static_cast<UINT>(static_cast<float>(extent) * m_settings.growth_slack);
+        UINT retval = ((slack_extent + granularity - 1) / granularity) * granularity;
+        return (std::max)(std::min<UINT>(retval, D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION), extent);
+    }
+
+    inline void RenderTargetPool::updatePoolStatistics()
+    {
+        m_current_stats.pooled_count = 0;
+        m_current_stats.pooled_bytes = 0;
+        for (auto const& bucket : m_entries)
+        {
+            for (auto const& entry : bucket.second)
+            {
+                ++m_current_stats.pooled_count;
+                m_current_stats.pooled_bytes += entry->render_target != nullptr
+                    ? entry->render_target->getMemoryByteSize()
+                    : entry->depth_stencil->getMemoryByteSize();
+            }
+        }
+    }
+
+    inline void RenderTargetPool::getDepthFormats(DXGI_FORMAT dsv_format, DXGI_FORMAT& texture_format, DXGI_FORMAT& srv_format)
+    {
+        switch (dsv_format)
+        {
+        case DXGI_FORMAT_D16_UNORM:
+            texture_format = DXGI_FORMAT_R16_TYPELESS;
+            srv_format = DXGI_FORMAT_R16_UNORM;
+            break;
+        case DXGI_FORMAT_D24_UNORM_S8_UINT:
+            texture_format = DXGI_FORMAT_R24G8_TYPELESS;
+            srv_format = DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+            break;
+        case DXGI_FORMAT_D32_FLOAT:
+            texture_format = DXGI_FORMAT_R32_TYPELESS;
+            srv_format = DXGI_FORMAT_R32_FLOAT;
+            break;
+        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+            texture_format = DXGI_FORMAT_R32G8X24_TYPELESS;
+            srv_format = DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+            break;
+        default:
+            throw std::invalid_argument("RenderTargetPool: unsupported depth stencil format");
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !RenderTargetPool_hpp
@@ -0,0 +1,328 @@
+/// <copyright file="ResidencyManager.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ResidencyManager_hpp
+#define ResidencyManager_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "MemoryTracker.hpp"
+#include "Mesh.hpp"
+#include "Texture2D.hpp"
+
+namespace dxowl
+{
+    /// Keeps the video memory reported by the MemoryTracker within a budget by evicting the least recently used
+    /// textures and meshes it manages. Managed resources are created lazily by a factory from their CPU-side source
+    /// and recreated transparently when they are requested after eviction. The budget covers all tracked memory,
+    /// so unmanaged resources like render targets reduce the room left for managed ones.
+    /// Resources used in the current frame are never evicted. Not thread-safe, call from the render thread.
+    class ResidencyManager
+    {
+    public:
+        typedef uint32_t Handle;
+        static constexpr Handle InvalidHandle = ~static_cast<Handle>(0);
+
+        typedef std::function<std::unique_ptr<Texture2D>(ID3D11Device4*)> TextureFactory;
+        typedef std::function<std::unique_ptr<Mesh>(ID3D11Device4*)> MeshFactory;
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t resident_count = 0;
+            size_t resident_bytes = 0;
+            size_t evicted_count = 0;
+            size_t evicted_bytes = 0;
+            size_t recreated_count = 0;
+            size_t recreated_bytes = 0;
+            bool over_budget = false; // the frame's working set alone exceeded the budget
+        };
+
+        ResidencyManager(ID3D11Device4* d3d11_device, size_t budget_byte_size);
+        ~ResidencyManager() = default;
+
+        ResidencyManager(const ResidencyManager& cpy) = delete;
+        ResidencyManager(ResidencyManager&& other) = delete;
+        ResidencyManager& operator=(ResidencyManager&& rhs) = delete;
+        ResidencyManager& operator=(const ResidencyManager& rhs) = delete;
+
+        void setBudget(size_t budget_byte_size);
+        size_t getBudget() const;
+
+        /// Registers a resource without creating it. Resources that are not evictable stay resident once created.
+        Handle addTexture(TextureFactory factory, bool evictable = true);
+        Handle addMesh(MeshFactory factory, bool evictable = true);
+
+        /// Destroys the resource, pointers returned for the handle become invalid.
+        void remove(Handle handle);
+
+        /// Returns the resource, creating it if it is not resident, and marks it as used in the current frame.
+        /// Pointers stay valid at least until the end of the frame.
+        Texture2D* getTexture(Handle handle);
+        Mesh* getMesh(Handle handle);
+
+        bool isResident(Handle handle) const;
+
+        void beginFrame(uint64_t frame);
+
+        /// Evicts resources that were not used in this frame until the tracked memory fits into the budget.
+        void endFrame();
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        struct Entry
+        {
+            TextureFactory texture_factory;
+            MeshFactory mesh_factory;
+            std::unique_ptr<Texture2D> texture;
+            std::unique_ptr<Mesh> mesh;
+            size_t byte_size = 0;
+            uint64_t last_used_frame = 0;
+            bool evictable = true;
+            bool alive = false;
+        };
+
+        Handle addEntry(Entry&& entry);
+        Entry& getEntry(Handle handle);
+
+        bool isResident(Entry const& entry) const;
+        void makeResident(Entry& entry);
+        void evict(Entry& entry);
+
+        /// Evicts least recently used entries not used in the current frame while the tracked memory exceeds the budget.
+        void enforceBudget();
+
+        ID3D11Device4* m_d3d11_device;
+        size_t m_budget_byte_size;
+
+        std::vector<Entry> m_entries;
+        std::vector<Handle> m_free_handles;
+        size_t m_resident_count;
+        size_t m_resident_bytes;
+
+        uint64_t m_frame;
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline ResidencyManager::ResidencyManager(ID3D11Device4* d3d11_device, size_t budget_byte_size)
+        : m_d3d11_device(d3d11_device), m_budget_byte_size(budget_byte_size), m_resident_count(0), m_resident_bytes(0), m_frame(0)
+    {
+    }
+
+    inline void ResidencyManager::setBudget(size_t budget_byte_size)
+    {
+        m_budget_byte_size = budget_byte_size;
+    }
+
+    inline size_t ResidencyManager::getBudget() const
+    {
+        return m_budget_byte_size;
+    }
+
+    inline ResidencyManager::Handle ResidencyManager::addTexture(TextureFactory factory, bool evictable)
+    {
+        Entry entry;
+        entry.texture_factory = std::move(factory);
+        entry.evictable = evictable;
+        return addEntry(std::move(entry));
+    }
+
+    inline ResidencyManager::Handle ResidencyManager::addMesh(MeshFactory factory, bool evictable)
+    {
+        Entry entry;
+        entry.mesh_factory = std::move(factory);
+        entry.evictable = evictable;
+        return addEntry(std::move(entry));
+    }
+
+    inline void ResidencyManager::remove(Handle handle)
+    {
+        Entry& entry = getEntry(handle);
+        evict(entry);
+        entry = Entry();
+        m_free_handles.push_back(handle);
+    }
+
+    inline Texture2D* ResidencyManager::getTexture(Handle handle)
+    {
+        Entry& entry = getEntry(handle);
+        if (!entry.texture_factory)
+        {
+            throw std::invalid_argument("ResidencyManager: handle does not refer to a texture");
+        }
+        makeResident(entry);
+        return entry.texture.get();
+    }
+
+    inline Mesh* ResidencyManager::getMesh(Handle handle)
+    {
+        Entry& entry = getEntry(handle);
+        if (!entry.mesh_factory)
+        {
+            throw std::invalid_argument("ResidencyManager: handle does not refer to a mesh");
+        }
+        makeResident(entry);
+        return entry.mesh.get();
+    }
+
+    inline bool ResidencyManager::isResident(Handle handle) const
+    {
+        return handle < m_entries.size() && m_entries[handle].alive && isResident(m_entries[handle]);
+    }
+
+    inline void ResidencyManager::beginFrame(uint64_t frame)
+    {
+        m_frame = frame;
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void ResidencyManager::endFrame()
+    {
+        enforceBudget();
+
+        m_current_stats.resident_count = m_resident_count;
+        m_current_stats.resident_bytes = m_resident_bytes;
+        m_current_stats.over_budget = MemoryTracker::get().getStatistics().total_bytes > m_budget_byte_size;
+        m_last_stats = m_current_stats;
+    }
+
+    inline ResidencyManager::FrameStatistics ResidencyManager::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline ResidencyManager::FrameStatistics ResidencyManager::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline ResidencyManager::Handle ResidencyManager::addEntry(Entry&& entry)
+    {
+        entry.alive = true;
+
+        if (!m_free_handles.empty())
+        {
+            Handle handle = m_free_handles.back();
+            m_free_handles.pop_back();
+            m_entries[handle] = std::move(entry);
+            return handle;
+        }
+
+        m_entries.push_back(std::move(entry));
+        return static_cast<Handle>(m_entries.size() - 1);
+    }
+
+    inline ResidencyManager::Entry& ResidencyManager::getEntry(Handle handle)
+    {
+        if (handle >= m_entries.size() || !m_entries[handle].alive)
+        {
+            throw std::invalid_argument("ResidencyManager: invalid handle");
+        }
+        return m_entries[handle];
+    }
+
+    inline bool ResidencyManager::isResident(Entry const& entry) const
+    {
+        return entry.texture != nullptr || entry.mesh != nullptr;
+    }
+
+    inline void ResidencyManager::makeResident(Entry& entry)
+    {
+        entry.last_used_frame = m_frame;
+        if (isResident(entry))
+        {
+            return;
+        }
+
+        if (entry.texture_factory)
+        {
+            entry.texture = entry.texture_factory(m_d3d11_device);
+            entry.byte_size = entry.texture != nullptr ? entry.texture->getMemoryByteSize() : 0;
+        }
+        else
+        {
+            entry.mesh = entry.mesh_factory(m_d3d11_device);
+            entry.byte_size = entry.mesh != nullptr ? entry.mesh->getMemoryByteSize() : 0;
+        }
+
+        if (!isResident(entry))
+        {
+            throw std::runtime_error("ResidencyManager: factory did not create a resource");
+        }
+
+        ++m_resident_count;
+        m_resident_bytes += entry.byte_size;
+        ++m_current_stats.recreated_count;
+        m_current_stats.recreated_bytes += entry.byte_size;
+
+        // make room right away, so a frame that streams in many resources does not overshoot until endFrame
+        enforceBudget();
+    }
+
+    inline void ResidencyManager::evict(Entry& entry)
+    {
+        if (!isResident(entry))
+        {
+            return;
+        }
+
+        entry.texture.reset();
+        entry.mesh.reset();
+
+        --m_resident_count;
+        m_resident_bytes -= entry.byte_size;
+    }
+
+    inline void ResidencyManager::enforceBudget()
+    {
+        size_t total_bytes = MemoryTracker::get().getStatistics().total_bytes;
+        if (total_bytes <= m_budget_byte_size)
+        {
+            return;
+        }
+
+        std::vector<std::pair<uint64_t, Handle>> candidates;
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            Entry const& entry = m_entries[i];
+            if (entry.alive && entry.evictable && isResident(entry) && entry.last_used_frame != m_frame)
+            {
+                candidates.push_back({ entry.last_used_frame, static_cast<Handle>(i) });
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (auto const& candidate : candidates)
+        {
+            if (total_bytes <= m_budget_byte_size)
+            {
+                break;
+            }
+
+            Entry& entry = m_entries[candidate.second];
+            size_t byte_size = entry.byte_size;
+            evict(entry);
+
+            total_bytes -= (std::min)(total_bytes, byte_size);
+            ++m_current_stats.evicted_count;
+            m_current_stats.evicted_bytes += byte_size;
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !ResidencyManager_hpp
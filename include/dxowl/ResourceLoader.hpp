@@ -0,0 +1,245 @@
+/// <copyright file="ResourceLoader.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ResourceLoader_hpp
+#define ResourceLoader_hpp
+
+#include <d3d11_4.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <winrt/base.h> // winrt::hresult_error
+
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// Creates dxowl resources (Mesh, Texture2D, Buffer, ShaderProgram, ...) on a pool of worker threads
+    /// using the free-threaded ID3D11Device. Failures are captured in the returned handle instead of
+    /// being thrown on a worker thread. Completion callbacks are queued and run on the thread that calls
+    /// dispatchCompletions(), usually the render thread.
+    /// Note: the immediate context is not free-threaded, so creation paths that use it
+    /// (e.g. Texture2D with generate_mipmap) must not be used through the loader.
+    class ResourceLoader
+    {
+    public:
+        template <typename Resource>
+        class Handle
+        {
+        public:
+            Handle() = default;
+
+            bool isValid() const { return m_state != nullptr; }
+            bool isReady() const { return m_state && m_state->ready.load(std::memory_order_acquire); }
+            bool hasError() const { return isReady() && m_state->error != nullptr; }
+
+            /// Blocks until the job finished. Throws std::logic_error for a handle that was not returned by a loader.
+            void wait() const
+            {
+                if (m_state == nullptr)
+                {
+                    throw std::logic_error("ResourceLoader: wait on an invalid handle");
+                }
+                std::unique_lock<std::mutex> lock(m_state->mutex);
+                m_state->cv.wait(lock, [this]() { return m_state->ready.load(std::memory_order_acquire); });
+            }
+
+            /// Returns nullptr while the resource is not ready or if creation failed.
+            std::shared_ptr<Resource> getResource() const { return isReady() ? m_state->resource : nullptr; }
+            std::exception_ptr getError() const { return isReady() ? m_state->error : nullptr; }
+            HRESULT getErrorCode() const { return isReady() ? m_state->error_code : S_OK; }
+            std::string getErrorMessage() const { return isReady() ? m_state->error_message : std::string(); }
+
+        private:
+            friend class ResourceLoader;
+
+            struct State
+            {
+                std::atomic<bool> ready{ false };
+                std::shared_ptr<Resource> resource;
+                std::exception_ptr error;
+                HRESULT error_code = S_OK;
+                std::string error_message;
+                std::mutex mutex;
+                std::condition_variable cv;
+            };
+
+            explicit Handle(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+            std::shared_ptr<State> m_state;
+        };
+
+        explicit ResourceLoader(ID3D11Device4* d3d11_device, size_t thread_cnt = 0);
+        ~ResourceLoader() = default;
+
+        ResourceLoader(const ResourceLoader& cpy) = delete;
+        ResourceLoader(ResourceLoader&& other) = delete;
+        ResourceLoader& operator=(ResourceLoader&& rhs) = delete;
+        ResourceLoader& operator=(const ResourceLoader& rhs) = delete;
+
+        /// Runs factory(d3d11_device) on a worker thread. The factory returns a std::shared_ptr<Resource>
+        /// or std::unique_ptr<Resource>. Any data it references must outlive the job.
+        template <typename Resource, typename Factory>
+        Handle<Resource> load(
+            Factory&& factory,
+            std::function<void(Handle<Resource> const&)> on_complete = nullptr);
+
+        /// Constructs Resource(d3d11_device, args...) on a worker thread. Arguments are copied into the
+        /// job, so the caller does not need to keep them alive.
+        template <typename Resource, typename... Args>
+        Handle<Resource> create(
+            std::function<void(Handle<Resource> const&)> on_complete,
+            Args&&... args);
+
+        /// Runs the completion callbacks of all jobs that finished since the last call.
+        /// Returns the number of callbacks run.
+        size_t dispatchCompletions();
+
+        size_t getPendingCount() const;
+        size_t getThreadCount() const;
+
+    private:
+        template <typename Resource>
+        static void storeError(typename Handle<Resource>::State& state);
+
+        ID3D11Device4* m_device;
+        std::atomic<size_t> m_pending;
+
+        std::mutex m_completion_mutex;
+        std::vector<std::function<void()>> m_completions;
+
+        // declared last so that workers are joined before the members above are destroyed
+        ThreadPool m_thread_pool;
+    };
+
+    inline ResourceLoader::ResourceLoader(ID3D11Device4* d3d11_device, size_t thread_cnt)
+        : m_device(d3d11_device), m_pending(0), m_thread_pool(thread_cnt)
+    {
+    }
+
+    template <typename Resource, typename Factory>
+    inline ResourceLoader::Handle<Resource> ResourceLoader::load(
+        Factory&& factory,
+        std::function<void(Handle<Resource> const&)> on_complete)
+    {
+        typedef typename Handle<Resource>::State State;
+        auto state = std::make_shared<State>();
+        Handle<Resource> handle(state);
+
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        m_thread_pool.submit([this, state, factory = std::forward<Factory>(factory), on_complete = std::move(on_complete)]() mutable {
+            try
+            {
+                state->resource = std::shared_ptr<Resource>(factory(m_device));
+            }
+            catch (...)
+            {
+                storeError<Resource>(*state);
+            }
+
+            {
+                // queue the callback together with the ready flag, so waiters and dispatchCompletions()
+                // never observe one without the other
+                std::lock_guard<std::mutex> completion_lock(m_completion_mutex);
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->ready.store(true, std::memory_order_release);
+
+                if (on_complete)
+                {
+                    m_completions.push_back([state, on_complete]() { on_complete(Handle<Resource>(state)); });
+                }
+            }
+            state->cv.notify_all();
+
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+        });
+
+        return handle;
+    }
+
+    template <typename Resource, typename... Args>
+    inline ResourceLoader::Handle<Resource> ResourceLoader::create(
+        std::function<void(Handle<Resource> const&)> on_complete,
+        Args&&... args)
+    {
+        auto arguments = std::make_tuple(std::forward<Args>(args)...);
+
+        return load<Resource>(
+            [arguments = std::move(arguments)](ID3D11Device4* d3d11_device) {
+                return std::apply(
+                    [d3d11_device](auto const&... unpacked) { return std::make_shared<Resource>(d3d11_device, unpacked...); },
+                    arguments);
+            },
+            std::move(on_complete));
+    }
+
+    inline size_t ResourceLoader::dispatchCompletions()
+    {
+        std::vector<std::function<void()>> completions;
+        {
+            std::lock_guard<std::mutex> lock(m_completion_mutex);
+            completions.swap(m_completions);
+        }
+
+        for (auto& completion : completions)
+        {
+            completion();
+        }
+
+        return completions.size();
+    }
+
+    inline size_t ResourceLoader::getPendingCount() const
+    {
+        return m_pending.load(std::memory_order_relaxed);
+    }
+
+    inline size_t ResourceLoader::getThreadCount() const
+    {
+        return m_thread_pool.getThreadCount();
+    }
+
+    template <typename Resource>
+    inline void ResourceLoader::storeError(typename Handle<Resource>::State& state)
+    {
+        state.error = std::current_exception();
+        state.error_code = E_FAIL;
+
+        try
+        {
+            std::rethrow_exception(state.error);
+        }
+        catch (winrt::hresult_error const& e)
+        {
+            state.error_code = static_cast<HRESULT>(e.code());
+
+            char code[32];
+            std::snprintf(code, sizeof(code), " (HRESULT 0x%08X)", static_cast<unsigned int>(state.error_code));
+            state.error_message = winrt::to_string(e.message()) + code;
+        }
+        catch (std::exception const& e)
+        {
+            state.error_message = e.what();
+        }
+        catch (...)
+        {
+            state.error_message = "unknown error";
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !ResourceLoader_hpp
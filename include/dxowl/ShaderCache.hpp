@@ -0,0 +1,318 @@
+/// <copyright file="ShaderCache.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ShaderCache_hpp
+#define ShaderCache_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Hash.hpp"
+#include "Lz4.hpp"
+#include "MappedFile.hpp"
+
+namespace dxowl
+{
+    namespace detail
+    {
+        // Pack file layout: header, 16 byte aligned blobs, index of entries sorted by hash.
+        struct ShaderPackHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t entry_count;
+            uint32_t flags;
+            uint64_t index_offset;
+            uint64_t reserved;
+        };
+
+        struct ShaderPackEntry
+        {
+            uint64_t hash;
+            uint64_t offset;
+            uint32_t stored_byte_size;
+            uint32_t byte_size;
+            uint32_t flags;
+            uint32_t reserved;
+        };
+
+        static constexpr char shader_pack_magic[4] = { 'D', 'X', 'S', 'P' };
+        static constexpr uint32_t shader_pack_version = 1;
+        static constexpr uint32_t shader_pack_entry_lz4 = 1u << 0;
+        static constexpr size_t shader_pack_alignment = 16;
+
+        static_assert(sizeof(ShaderPackHeader) == 32, "ShaderPackHeader layout");
+        static_assert(sizeof(ShaderPackEntry) == 32, "ShaderPackEntry layout");
+    } // namespace detail
+
+    /// Read-only view of a shader pack file. The file is memory-mapped once; lookups binary search the
+    /// index in place and uncompressed bytecode is returned as a pointer into the mapping.
+    /// LZ4 compressed blobs are decompressed on first access and kept for the lifetime of the cache.
+    class ShaderCache
+    {
+    public:
+        typedef uint64_t Handle;
+        static constexpr Handle InvalidHandle = 0;
+
+        struct Bytecode
+        {
+            void const* data;
+            size_t byte_size;
+        };
+
+        explicit ShaderCache(std::string const& path);
+        ~ShaderCache() = default;
+
+        ShaderCache(const ShaderCache& cpy) = delete;
+        ShaderCache(ShaderCache&& other) = delete;
+        ShaderCache& operator=(ShaderCache&& rhs) = delete;
+        ShaderCache& operator=(const ShaderCache& rhs) = delete;
+
+        static Handle computeHandle(void const* bytecode, size_t byte_size);
+
+        bool contains(Handle const handle) const;
+
+        /// Returns { nullptr, 0 } for InvalidHandle and handles that are not in the pack.
+        Bytecode getBytecode(Handle const handle) const;
+
+        size_t getBlobCount() const;
+
+    private:
+        detail::ShaderPackEntry const* find(Handle const handle) const;
+
+        MappedFile m_file;
+        detail::ShaderPackHeader const* m_header;
+        detail::ShaderPackEntry const* m_index;
+
+        mutable std::mutex m_mutex;
+        mutable std::unordered_map<Handle, std::vector<uint8_t>> m_decompressed;
+    };
+
+    /// Collects shader bytecode, deduplicates identical blobs by content hash and writes a pack file
+    /// that can be opened with ShaderCache.
+    class ShaderCacheWriter
+    {
+    public:
+        typedef ShaderCache::Handle Handle;
+
+        ShaderCacheWriter() : m_duplicate_count(0) {}
+        ~ShaderCacheWriter() = default;
+
+        Handle add(void const* bytecode, size_t byte_size);
+
+        template <typename ShaderFileDataContainer>
+        Handle add(ShaderFileDataContainer const& bytecode);
+
+        void write(std::string const& path, bool compress = false) const;
+
+        size_t getBlobCount() const;
+        size_t getDuplicateCount() const;
+
+    private:
+        std::map<Handle, std::vector<uint8_t>> m_blobs; // ordered by hash, matches the index order
+        size_t m_duplicate_count;
+    };
+
+    inline ShaderCache::ShaderCache(std::string const& path)
+        : m_file(path), m_header(nullptr), m_index(nullptr)
+    {
+        auto bytes = static_cast<uint8_t const*>(m_file.data());
+        size_t const file_size = m_file.size();
+
+        if (file_size < sizeof(detail::ShaderPackHeader))
+        {
+            throw std::runtime_error("ShaderCache: file too small " + path);
+        }
+
+        m_header = reinterpret_cast<detail::ShaderPackHeader const*>(bytes);
+
+        bool const valid_header =
+            std::memcmp(m_header->magic, detail::shader_pack_magic, 4) == 0
+            && m_header->version == detail::shader_pack_version
+            && m_header->index_offset >= sizeof(detail::ShaderPackHeader)
+            && m_header->index_offset % alignof(detail::ShaderPackEntry) == 0
+            && m_header->index_offset <= file_size
+            && m_header->entry_count <= (file_size - m_header->index_offset) / sizeof(detail::ShaderPackEntry);
+
+        if (!valid_header)
+        {
+            throw std::runtime_error("ShaderCache: invalid pack header " + path);
+        }
+
+        m_index = reinterpret_cast<detail::ShaderPackEntry const*>(bytes + m_header->index_offset);
+    }
+
+    inline ShaderCache::Handle ShaderCache::computeHandle(void const* bytecode, size_t byte_size)
+    {
+        Handle retval = hashBytes(bytecode, byte_size);
+        return retval != InvalidHandle ? retval : 1;
+    }
+
+    inline bool ShaderCache::contains(Handle const handle) const
+    {
+        return find(handle) != nullptr;
+    }
+
+    inline ShaderCache::Bytecode ShaderCache::getBytecode(Handle const handle) const
+    {
+        detail::ShaderPackEntry const* entry = find(handle);
+
+        // compared by subtraction, offsets from a corrupt file must not wrap around
+        if (entry == nullptr || entry->offset > m_header->index_offset || entry->stored_byte_size > m_header->index_offset - entry->offset)
+        {
+            return { nullptr, 0 };
+        }
+
+        auto stored_data = static_cast<uint8_t const*>(m_file.data()) + entry->offset;
+
+        if ((entry->flags & detail::shader_pack_entry_lz4) == 0)
+        {
+            return { stored_data, entry->byte_size };
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_decompressed.find(handle);
+        if (it == m_decompressed.end())
+        {
+            std::vector<uint8_t> bytecode(entry->byte_size);
+            if (!lz4::decompress(stored_data, entry->stored_byte_size, bytecode.data(), bytecode.size()))
+            {
+                return { nullptr, 0 };
+            }
+            it = m_decompressed.emplace(handle, std::move(bytecode)).first;
+        }
+
+        return { it->second.data(), it->second.size() };
+    }
+
+    inline size_t ShaderCache::getBlobCount() const
+    {
+        return m_header->entry_count;
+    }
+
+    inline detail::ShaderPackEntry const* ShaderCache::find(Handle const handle) const
+    {
+        if (handle == InvalidHandle)
+        {
+            return nullptr;
+        }
+
+        auto end = m_index + m_header->entry_count;
+        auto it = std::lower_bound(m_index, end, handle,
+            [](detail::ShaderPackEntry const& entry, Handle value) { return entry.hash < value; });
+
+        return (it != end && it->hash == handle) ? it : nullptr;
+    }
+
+    inline ShaderCacheWriter::Handle ShaderCacheWriter::add(void const* bytecode, size_t byte_size)
+    {
+        Handle handle = ShaderCache::computeHandle(bytecode, byte_size);
+        auto bytes = static_cast<uint8_t const*>(bytecode);
+
+        auto it = m_blobs.find(handle);
+        if (it != m_blobs.end())
+        {
+            if (it->second.size() != byte_size || std::memcmp(it->second.data(), bytes, byte_size) != 0)
+            {
+                throw std::runtime_error("ShaderCacheWriter: content hash collision");
+            }
+            ++m_duplicate_count;
+            return handle;
+        }
+
+        m_blobs.emplace(handle, std::vector<uint8_t>(bytes, bytes + byte_size));
+
+        return handle;
+    }
+
+    template <typename ShaderFileDataContainer>
+    inline ShaderCacheWriter::Handle ShaderCacheWriter::add(ShaderFileDataContainer const& bytecode)
+    {
+        return add(bytecode.data(), bytecode.size() * sizeof(typename ShaderFileDataContainer::value_type));
+    }
+
+    inline void ShaderCacheWriter::write(std::string const& path, bool compress) const
+    {
+        std::vector<detail::ShaderPackEntry> index;
+        index.reserve(m_blobs.size());
+
+        std::vector<uint8_t> data(sizeof(detail::ShaderPackHeader), 0);
+
+        for (auto const& blob : m_blobs)
+        {
+            data.resize(((data.size() + detail::shader_pack_alignment - 1) / detail::shader_pack_alignment) * detail::shader_pack_alignment, 0);
+
+            detail::ShaderPackEntry entry = {};
+            entry.hash = blob.first;
+            entry.offset = data.size();
+            entry.byte_size = static_cast<uint32_t>(blob.second.size());
+
+            std::vector<uint8_t> compressed;
+            if (compress)
+            {
+                compressed = lz4::compress(blob.second.data(), blob.second.size());
+            }
+
+            // only keep the compressed variant if it actually saves space
+            if (compress && compressed.size() < blob.second.size())
+            {
+                entry.flags = detail::shader_pack_entry_lz4;
+                entry.stored_byte_size = static_cast<uint32_t>(compressed.size());
+                data.insert(data.end(), compressed.begin(), compressed.end());
+            }
+            else
+            {
+                entry.stored_byte_size = entry.byte_size;
+                data.insert(data.end(), blob.second.begin(), blob.second.end());
+            }
+
+            index.push_back(entry);
+        }
+
+        data.resize(((data.size() + detail::shader_pack_alignment - 1) / detail::shader_pack_alignment) * detail::shader_pack_alignment, 0);
+
+        detail::ShaderPackHeader header = {};
+        std::memcpy(header.magic, detail::shader_pack_magic, 4);
+        header.version = detail::shader_pack_version;
+        header.entry_count = static_cast<uint32_t>(index.size());
+        header.index_offset = data.size();
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("ShaderCacheWriter: cannot open " + path);
+        }
+        file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+        file.write(reinterpret_cast<char const*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(detail::ShaderPackEntry)));
+        if (!file)
+        {
+            throw std::runtime_error("ShaderCacheWriter: cannot write " + path);
+        }
+    }
+
+    inline size_t ShaderCacheWriter::getBlobCount() const
+    {
+        return m_blobs.size();
+    }
+
+    inline size_t ShaderCacheWriter::getDuplicateCount() const
+    {
+        return m_duplicate_count;
+    }
+
+} // namespace dxowl
+
+#endif // !ShaderCache_hpp
@@ -7,9 +7,15 @@
 #ifndef ShaderProgram_hpp
 #define ShaderProgram_hpp
 
+#include <cstdio>
+#include <stdexcept>
+#include <string>
 #include <winrt/base.h> // winrt::check_hresult
 #include <wrl/client.h> // Microsoft::WRL::ComPtr
 
+#include "InputLayoutCache.hpp"
+#include "ShaderCache.hpp"
+#include "StateCache.hpp"
 #include "VertexDescriptor.hpp"
 
 namespace dxowl
@@ -30,7 +36,8 @@ namespace dxowl
             std::vector<VertexDescriptor> vertex_desc,
             ShaderFileDataContainer vertex_shader,
             ShaderFileDataContainer geometry_shader,
-            ShaderFileDataContainer pixel_shader);
+            ShaderFileDataContainer pixel_shader,
+            InputLayoutCache* input_layout_cache = nullptr);
         ShaderProgram(
             ID3D11Device4* d3d11_device,
             std::vector<VertexDescriptor> vertex_desc,
@@ -39,7 +46,16 @@ namespace dxowl
             void const *geometry_shader,
             size_t geometry_shader_byteSize,
             void const *pixel_shader,
-            size_t pixel_shader_byteSize);
+            size_t pixel_shader_byteSize,
+            InputLayoutCache* input_layout_cache = nullptr);
+        ShaderProgram(
+            ID3D11Device4* d3d11_device,
+            std::vector<VertexDescriptor> vertex_desc,
+            ShaderCache const& shader_cache,
+            ShaderCache::Handle vertex_shader,
+            ShaderCache::Handle geometry_shader,
+            ShaderCache::Handle pixel_shader,
+            InputLayoutCache* input_layout_cache = nullptr);
         ~ShaderProgram() = default;
 
         ShaderProgram(const ShaderProgram &cpy) = delete;
@@ -52,7 +68,34 @@ namespace dxowl
         void setGeometryShader(ID3D11DeviceContext4* d3d11_ctx);
         void setPixelShader(ID3D11DeviceContext4* d3d11_ctx);
 
+        void setInputLayout(StateCache& state_cache);
+        void setVertexShader(StateCache& state_cache);
+        void setGeometryShader(StateCache& state_cache);
+        void setPixelShader(StateCache& state_cache);
+
     private:
+        ShaderProgram(
+            ID3D11Device4* d3d11_device,
+            std::vector<VertexDescriptor> vertex_desc,
+            ShaderCache::Bytecode vertex_shader,
+            ShaderCache::Bytecode geometry_shader,
+            ShaderCache::Bytecode pixel_shader,
+            InputLayoutCache* input_layout_cache);
+
+        /// Throws if the handle is not in the cache or its blob cannot be decoded. InvalidHandle is only
+        /// accepted for the optional geometry shader and gives { nullptr, 0 }.
+        static ShaderCache::Bytecode getBytecode(
+            ShaderCache const& shader_cache,
+            ShaderCache::Handle handle,
+            ShaderType shader_type);
+
+        void createInputLayout(
+            ID3D11Device4* d3d11_device,
+            std::vector<VertexDescriptor> const& vertex_desc,
+            void const* vertex_shader,
+            size_t vertex_shader_byteSize,
+            InputLayoutCache* input_layout_cache);
+
         Microsoft::WRL::ComPtr<ID3D11InputLayout> m_inputLayout;
         Microsoft::WRL::ComPtr<ID3D11VertexShader> m_vertexShader;
         Microsoft::WRL::ComPtr<ID3D11GeometryShader> m_geometryShader;
@@ -65,7 +108,8 @@ namespace dxowl
         std::vector<VertexDescriptor> vertex_desc,
         ShaderFileDataContainer vertex_shader,
         ShaderFileDataContainer geometry_shader,
-        ShaderFileDataContainer pixel_shader)
+        ShaderFileDataContainer pixel_shader,
+        InputLayoutCache* input_layout_cache)
         : m_inputLayout(nullptr), m_vertexShader(nullptr), m_geometryShader(nullptr), m_pixelShader(nullptr)
     {
         winrt::check_hresult(
@@ -75,17 +119,12 @@ namespace dxowl
                 nullptr,
                 &m_vertexShader));
 
-        std::vector<D3D11_INPUT_ELEMENT_DESC> attributes;
-        for (auto& vl : vertex_desc) {
-            attributes.insert(std::end(attributes), std::begin(vl.attributes), std::end(vl.attributes));
-        }
-        winrt::check_hresult(
-            d3d11_device->CreateInputLayout(
-                attributes.data(),
-                static_cast<UINT>(attributes.size()),
-                vertex_shader.data(),
-                static_cast<UINT>(vertex_shader.size()),
-                &m_inputLayout));
+        createInputLayout(
+            d3d11_device,
+            vertex_desc,
+            vertex_shader.data(),
+            vertex_shader.size(),
+            input_layout_cache);
 
         winrt::check_hresult(
             d3d11_device->CreatePixelShader(
@@ -113,7 +152,8 @@ namespace dxowl
         void const *geometry_shader,
         size_t geometry_shader_byteSize,
         void const *pixel_shader,
-        size_t pixel_shader_byteSize)
+        size_t pixel_shader_byteSize,
+        InputLayoutCache* input_layout_cache)
         : m_inputLayout(nullptr), m_vertexShader(nullptr), m_geometryShader(nullptr), m_pixelShader(nullptr)
     {
         winrt::check_hresult(
@@ -123,17 +163,12 @@ namespace dxowl
                 nullptr,
                 &m_vertexShader));
 
-        std::vector<D3D11_INPUT_ELEMENT_DESC> attributes;
-        for (auto& vl : vertex_desc) {
-            attributes.insert(std::end(attributes), std::begin(vl.attributes), std::end(vl.attributes));
-        }
-        winrt::check_hresult(
-            d3d11_device->CreateInputLayout(
-                attributes.data(),
-                static_cast<UINT>(attributes.size()),
-                vertex_shader,
-                static_cast<UINT>(vertex_shader_byteSize),
-                &m_inputLayout));
+        createInputLayout(
+            d3d11_device,
+            vertex_desc,
+            vertex_shader,
+            vertex_shader_byteSize,
+            input_layout_cache);
 
         winrt::check_hresult(
             d3d11_device->CreatePixelShader(
@@ -153,6 +188,98 @@ namespace dxowl
         }
     }
 
+    inline ShaderProgram::ShaderProgram(
+        ID3D11Device4* d3d11_device,
+        std::vector<VertexDescriptor> vertex_desc,
+        ShaderCache const& shader_cache,
+        ShaderCache::Handle vertex_shader,
+        ShaderCache::Handle geometry_shader,
+        ShaderCache::Handle pixel_shader,
+        InputLayoutCache* input_layout_cache)
+        : ShaderProgram(
+              d3d11_device,
+              vertex_desc,
+              getBytecode(shader_cache, vertex_shader, VertexShader),
+              getBytecode(shader_cache, geometry_shader, GeometryShader),
+              getBytecode(shader_cache, pixel_shader, PixelShader),
+              input_layout_cache)
+    {
+    }
+
+    inline ShaderProgram::ShaderProgram(
+        ID3D11Device4* d3d11_device,
+        std::vector<VertexDescriptor> vertex_desc,
+        ShaderCache::Bytecode vertex_shader,
+        ShaderCache::Bytecode geometry_shader,
+        ShaderCache::Bytecode pixel_shader,
+        InputLayoutCache* input_layout_cache)
+        : ShaderProgram(
+              d3d11_device,
+              vertex_desc,
+              vertex_shader.data,
+              vertex_shader.byte_size,
+              geometry_shader.data,
+              geometry_shader.byte_size,
+              pixel_shader.data,
+              pixel_shader.byte_size,
+              input_layout_cache)
+    {
+    }
+
+    inline ShaderCache::Bytecode ShaderProgram::getBytecode(
+        ShaderCache const& shader_cache,
+        ShaderCache::Handle handle,
+        ShaderType shader_type)
+    {
+        char const* const stage_names[] = { "vertex", "geometry", "pixel" };
+        char const* const stage_name = stage_names[shader_type];
+
+        if (handle == ShaderCache::InvalidHandle)
+        {
+            if (shader_type == GeometryShader)
+            {
+                return { nullptr, 0 };
+            }
+            throw std::invalid_argument(std::string("ShaderProgram: no ") + stage_name + " shader handle given");
+        }
+
+        ShaderCache::Bytecode const retval = shader_cache.getBytecode(handle);
+        if (retval.data == nullptr)
+        {
+            char handle_str[24];
+            std::snprintf(handle_str, sizeof(handle_str), "0x%016llX", static_cast<unsigned long long>(handle));
+            throw std::runtime_error(std::string("ShaderProgram: ") + stage_name + " shader " + handle_str
+                + " is not in the shader cache or cannot be decoded");
+        }
+        return retval;
+    }
+
+    inline void ShaderProgram::createInputLayout(
+        ID3D11Device4* d3d11_device,
+        std::vector<VertexDescriptor> const& vertex_desc,
+        void const* vertex_shader,
+        size_t vertex_shader_byteSize,
+        InputLayoutCache* input_layout_cache)
+    {
+        if (input_layout_cache != nullptr)
+        {
+            m_inputLayout = input_layout_cache->getInputLayout(d3d11_device, vertex_desc, vertex_shader, vertex_shader_byteSize);
+            return;
+        }
+
+        std::vector<D3D11_INPUT_ELEMENT_DESC> attributes;
+        for (auto& vl : vertex_desc) {
+            attributes.insert(std::end(attributes), std::begin(vl.attributes), std::end(vl.attributes));
+        }
+        winrt::check_hresult(
+            d3d11_device->CreateInputLayout(
+                attributes.data(),
+                static_cast<UINT>(attributes.size()),
+                vertex_shader,
+                static_cast<UINT>(vertex_shader_byteSize),
+                &m_inputLayout));
+    }
+
     inline void ShaderProgram::setInputLayout(ID3D11DeviceContext4* d3d11_ctx)
     {
         d3d11_ctx->IASetInputLayout(m_inputLayout.Get());
@@ -184,6 +311,27 @@ namespace dxowl
             nullptr,
             0);
     }
+
+    inline void ShaderProgram::setInputLayout(StateCache& state_cache)
+    {
+        state_cache.setInputLayout(m_inputLayout.Get());
+    }
+
+    inline void ShaderProgram::setVertexShader(StateCache& state_cache)
+    {
+        state_cache.setVertexShader(m_vertexShader.Get());
+    }
+
+    inline void ShaderProgram::setGeometryShader(StateCache& state_cache)
+    {
+        // also binds null, so the stage of a previous program does not stay active
+        state_cache.setGeometryShader(m_geometryShader.Get());
+    }
+
+    inline void ShaderProgram::setPixelShader(StateCache& state_cache)
+    {
+        state_cache.setPixelShader(m_pixelShader.Get());
+    }
 } // namespace dxowl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,333 @@
+/// <copyright file="StateCache.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef StateCache_hpp
+#define StateCache_hpp
+
+#include <d3d11_4.h>
+#include <array>
+#include <cstdint>
+
+namespace dxowl
+{
+    /// Shadows the input assembler, vertex, geometry and pixel shader bindings of a device context and
+    /// only forwards calls that change state. Vertex buffer slot changes are collected and issued as a
+    /// single ranged IASetVertexBuffers call before the next draw (or an explicit flush).
+    /// Call invalidate() whenever the context state is changed behind the cache's back,
+    /// e.g. after ClearState or ExecuteCommandList.
+    class StateCache
+    {
+    public:
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t calls_issued = 0;
+            size_t calls_skipped = 0;
+        };
+
+        explicit StateCache(ID3D11DeviceContext4* d3d11_ctx);
+        ~StateCache() = default;
+
+        StateCache(const StateCache& cpy) = delete;
+        StateCache(StateCache&& other) = delete;
+        StateCache& operator=(StateCache&& rhs) = delete;
+        StateCache& operator=(const StateCache& rhs) = delete;
+
+        ID3D11DeviceContext4* getContext() const;
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+        void invalidate();
+
+        void setInputLayout(ID3D11InputLayout* input_layout);
+        void setVertexBuffers(
+            UINT start_slot,
+            UINT num_buffers,
+            ID3D11Buffer* const* buffers,
+            UINT const* strides,
+            UINT const* offsets);
+        void setIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset);
+        void setPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY primitive_topology);
+        void setVertexShader(ID3D11VertexShader* vertex_shader);
+        void setGeometryShader(ID3D11GeometryShader* geometry_shader);
+        void setPixelShader(ID3D11PixelShader* pixel_shader);
+
+        /// Issues pending vertex buffer changes. Called implicitly by the draw methods.
+        void flush();
+
+        void draw(UINT vertex_count, UINT start_vertex);
+        void drawIndexed(UINT index_count, UINT first_index, INT base_vertex);
+        void drawInstanced(UINT vertex_count, UINT instance_count, UINT start_vertex, UINT start_instance);
+        void drawIndexedInstanced(UINT index_count, UINT instance_count, UINT first_index, INT base_vertex, UINT start_instance);
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        static constexpr UINT VertexBufferSlotCount = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+
+        enum StateBit : uint32_t
+        {
+            InputLayoutBit = 1u << 0,
+            IndexBufferBit = 1u << 1,
+            PrimitiveTopologyBit = 1u << 2,
+            VertexShaderBit = 1u << 3,
+            GeometryShaderBit = 1u << 4,
+            PixelShaderBit = 1u << 5
+        };
+
+        template <typename T>
+        bool update(T& shadow, T const& value, StateBit state_bit);
+
+        ID3D11DeviceContext4* m_ctx;
+
+        uint32_t m_known_state; // StateBits of single value state whose context value is known
+
+        ID3D11InputLayout* m_input_layout;
+        ID3D11Buffer* m_index_buffer;
+        DXGI_FORMAT m_index_format;
+        UINT m_index_offset;
+        D3D_PRIMITIVE_TOPOLOGY m_primitive_topology;
+        ID3D11VertexShader* m_vertex_shader;
+        ID3D11GeometryShader* m_geometry_shader;
+        ID3D11PixelShader* m_pixel_shader;
+
+        // state requested by the caller, and the part of it that has already been sent to the context
+        std::array<ID3D11Buffer*, VertexBufferSlotCount> m_vertex_buffers;
+        std::array<UINT, VertexBufferSlotCount> m_vb_strides;
+        std::array<UINT, VertexBufferSlotCount> m_vb_offsets;
+        std::array<ID3D11Buffer*, VertexBufferSlotCount> m_bound_vertex_buffers;
+        std::array<UINT, VertexBufferSlotCount> m_bound_vb_strides;
+        std::array<UINT, VertexBufferSlotCount> m_bound_vb_offsets;
+        std::array<bool, VertexBufferSlotCount> m_bound_vb_valid;
+        UINT m_dirty_vb_begin;
+        UINT m_dirty_vb_end;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline StateCache::StateCache(ID3D11DeviceContext4* d3d11_ctx)
+        : m_ctx(d3d11_ctx)
+    {
+        invalidate();
+    }
+
+    inline ID3D11DeviceContext4* StateCache::getContext() const
+    {
+        return m_ctx;
+    }
+
+    inline void StateCache::beginFrame(uint64_t frame)
+    {
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void StateCache::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline void StateCache::invalidate()
+    {
+        m_known_state = 0;
+
+        m_input_layout = nullptr;
+        m_index_buffer = nullptr;
+        m_index_format = DXGI_FORMAT_UNKNOWN;
+        m_index_offset = 0;
+        m_primitive_topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+        m_vertex_shader = nullptr;
+        m_geometry_shader = nullptr;
+        m_pixel_shader = nullptr;
+
+        m_vertex_buffers.fill(nullptr);
+        m_vb_strides.fill(0);
+        m_vb_offsets.fill(0);
+        m_bound_vertex_buffers.fill(nullptr);
+        m_bound_vb_strides.fill(0);
+        m_bound_vb_offsets.fill(0);
+        m_bound_vb_valid.fill(false);
+        m_dirty_vb_begin = VertexBufferSlotCount;
+        m_dirty_vb_end = 0;
+    }
+
+    inline void StateCache::setInputLayout(ID3D11InputLayout* input_layout)
+    {
+        if (update(m_input_layout, input_layout, InputLayoutBit))
+        {
+            m_ctx->IASetInputLayout(input_layout);
+        }
+    }
+
+    inline void StateCache::setVertexBuffers(
+        UINT start_slot,
+        UINT num_buffers,
+        ID3D11Buffer* const* buffers,
+        UINT const* strides,
+        UINT const* offsets)
+    {
+        bool changed = false;
+
+        for (UINT i = 0; i < num_buffers && (start_slot + i) < VertexBufferSlotCount; ++i)
+        {
+            UINT slot = start_slot + i;
+            m_vertex_buffers[slot] = buffers[i];
+            m_vb_strides[slot] = strides[i];
+            m_vb_offsets[slot] = offsets[i];
+
+            bool const is_bound = m_bound_vb_valid[slot]
+                && m_bound_vertex_buffers[slot] == buffers[i]
+                && m_bound_vb_strides[slot] == strides[i]
+                && m_bound_vb_offsets[slot] == offsets[i];
+
+            if (!is_bound)
+            {
+                m_dirty_vb_begin = slot < m_dirty_vb_begin ? slot : m_dirty_vb_begin;
+                m_dirty_vb_end = slot + 1 > m_dirty_vb_end ? slot + 1 : m_dirty_vb_end;
+                changed = true;
+            }
+        }
+
+        // changed slots are issued (and counted) together on the next flush
+        if (!changed)
+        {
+            ++m_current_stats.calls_skipped;
+        }
+    }
+
+    inline void StateCache::setIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset)
+    {
+        if ((m_known_state & IndexBufferBit) && m_index_buffer == buffer && m_index_format == format && m_index_offset == offset)
+        {
+            ++m_current_stats.calls_skipped;
+            return;
+        }
+
+        m_index_buffer = buffer;
+        m_index_format = format;
+        m_index_offset = offset;
+        m_known_state |= IndexBufferBit;
+
+        ++m_current_stats.calls_issued;
+        m_ctx->IASetIndexBuffer(buffer, format, offset);
+    }
+
+    inline void StateCache::setPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY primitive_topology)
+    {
+        if (update(m_primitive_topology, primitive_topology, PrimitiveTopologyBit))
+        {
+            m_ctx->IASetPrimitiveTopology(primitive_topology);
+        }
+    }
+
+    inline void StateCache::setVertexShader(ID3D11VertexShader* vertex_shader)
+    {
+        if (update(m_vertex_shader, vertex_shader, VertexShaderBit))
+        {
+            m_ctx->VSSetShader(vertex_shader, nullptr, 0);
+        }
+    }
+
+    inline void StateCache::setGeometryShader(ID3D11GeometryShader* geometry_shader)
+    {
+        if (update(m_geometry_shader, geometry_shader, GeometryShaderBit))
+        {
+            m_ctx->GSSetShader(geometry_shader, nullptr, 0);
+        }
+    }
+
+    inline void StateCache::setPixelShader(ID3D11PixelShader* pixel_shader)
+    {
+        if (update(m_pixel_shader, pixel_shader, PixelShaderBit))
+        {
+            m_ctx->PSSetShader(pixel_shader, nullptr, 0);
+        }
+    }
+
+    inline void StateCache::flush()
+    {
+        if (m_dirty_vb_begin >= m_dirty_vb_end)
+        {
+            return;
+        }
+
+        UINT const begin = m_dirty_vb_begin;
+        UINT const count = m_dirty_vb_end - m_dirty_vb_begin;
+
+        m_ctx->IASetVertexBuffers(
+            begin,
+            count,
+            m_vertex_buffers.data() + begin,
+            m_vb_strides.data() + begin,
+            m_vb_offsets.data() + begin);
+        ++m_current_stats.calls_issued;
+
+        for (UINT slot = begin; slot < m_dirty_vb_end; ++slot)
+        {
+            m_bound_vertex_buffers[slot] = m_vertex_buffers[slot];
+            m_bound_vb_strides[slot] = m_vb_strides[slot];
+            m_bound_vb_offsets[slot] = m_vb_offsets[slot];
+            m_bound_vb_valid[slot] = true;
+        }
+
+        m_dirty_vb_begin = VertexBufferSlotCount;
+        m_dirty_vb_end = 0;
+    }
+
+    inline void StateCache::draw(UINT vertex_count, UINT start_vertex)
+    {
+        flush();
+        m_ctx->Draw(vertex_count, start_vertex);
+    }
+
+    inline void StateCache::drawIndexed(UINT index_count, UINT first_index, INT base_vertex)
+    {
+        flush();
+        m_ctx->DrawIndexed(index_count, first_index, base_vertex);
+    }
+
+    inline void StateCache::drawInstanced(UINT vertex_count, UINT instance_count, UINT start_vertex, UINT start_instance)
+    {
+        flush();
+        m_ctx->DrawInstanced(vertex_count, instance_count, start_vertex, start_instance);
+    }
+
+    inline void StateCache::drawIndexedInstanced(UINT index_count, UINT instance_count, UINT first_index, INT base_vertex, UINT start_instance)
+    {
+        flush();
+        m_ctx->DrawIndexedInstanced(index_count, instance_count, first_index, base_vertex, start_instance);
+    }
+
+    inline StateCache::FrameStatistics StateCache::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline StateCache::FrameStatistics StateCache::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    template <typename T>
+    inline bool StateCache::update(T& shadow, T const& value, StateBit state_bit)
+    {
+        if ((m_known_state & state_bit) && shadow == value)
+        {
+            ++m_current_stats.calls_skipped;
+            return false;
+        }
+
+        shadow = value;
+        m_known_state |= state_bit;
+        ++m_current_stats.calls_issued;
+        return true;
+    }
+
+} // namespace dxowl
+
+#endif // !StateCache_hpp
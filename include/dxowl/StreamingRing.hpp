@@ -0,0 +1,234 @@
+/// <copyright file="StreamingRing.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef StreamingRing_hpp
+#define StreamingRing_hpp
+
+#include <d3d11_4.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "MemoryTracker.hpp"
+
+namespace dxowl
+{
+    /// Large dynamic buffer that hands out per-frame chunks for streamed vertex and index data.
+    /// Allocations are appended with D3D11_MAP_WRITE_NO_OVERWRITE. When the ring runs out of space
+    /// it is mapped once with D3D11_MAP_WRITE_DISCARD and allocation restarts at offset zero, so data
+    /// the GPU may still be reading is never overwritten.
+    /// A discard also invalidates every allocation that has not been bound yet, including earlier ones of the
+    /// same frame. Allocations carry the discard generation they were written in; check them with isCurrent()
+    /// before binding.
+    class StreamingRing
+    {
+    public:
+        struct Allocation
+        {
+            ID3D11Buffer* buffer;
+            UINT byte_offset;
+            UINT byte_size;
+            uint64_t frame;
+            uint64_t generation;    // discard generation the data was written in
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t bytes_allocated = 0;
+            size_t bytes_padding = 0;       // alignment padding and ring tail skipped on wrap
+            size_t allocation_count = 0;
+            size_t discard_count = 0;
+            size_t no_overwrite_count = 0;
+        };
+
+        StreamingRing(
+            ID3D11Device4* d3d11_device,
+            size_t byte_size,
+            UINT bind_flags = D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER);
+        ~StreamingRing() = default;
+
+        StreamingRing(const StreamingRing& cpy) = delete;
+        StreamingRing(StreamingRing&& other) = delete;
+        StreamingRing& operator=(StreamingRing&& rhs) = delete;
+        StreamingRing& operator=(const StreamingRing& rhs) = delete;
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        Allocation upload(
+            ID3D11DeviceContext4* d3d11_ctx,
+            void const* data,
+            size_t byte_size,
+            size_t alignment = 16);
+
+        template <typename Container>
+        Allocation upload(
+            ID3D11DeviceContext4* d3d11_ctx,
+            Container const& data,
+            size_t alignment = 16);
+
+        /// Maps a chunk of the ring and lets write_func fill it in place (signature: void(void* dst)).
+        template <typename WriteFunc>
+        Allocation allocate(
+            ID3D11DeviceContext4* d3d11_ctx,
+            size_t byte_size,
+            size_t alignment,
+            WriteFunc&& write_func);
+
+        /// True if the allocation belongs to this ring and no discard happened since it was written.
+        bool isCurrent(Allocation const& allocation) const;
+
+        ID3D11Buffer* getBuffer() const;
+        size_t getByteSize() const;
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        D3D11_MAP reserve(size_t byte_size, size_t alignment, size_t& byte_offset);
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+        size_t m_byte_size;
+        MemoryTracker::Allocation m_memory_allocation;
+        size_t m_head;
+        bool m_needs_discard;
+        uint64_t m_generation;
+
+        uint64_t m_frame;
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline StreamingRing::StreamingRing(
+        ID3D11Device4* d3d11_device,
+        size_t byte_size,
+        UINT bind_flags)
+        : m_buffer(nullptr), m_byte_size(byte_size), m_head(0), m_needs_discard(true), m_generation(0), m_frame(0)
+    {
+        const CD3D11_BUFFER_DESC desc(static_cast<UINT>(byte_size), bind_flags, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
+        winrt::check_hresult(d3d11_device->CreateBuffer(&desc, nullptr, m_buffer.GetAddressOf()));
+        m_memory_allocation.setByteSize(computeResourceByteSize(desc));
+        m_memory_allocation.setCategory(MemoryTracker::Category::Buffer);
+    }
+
+    inline void StreamingRing::beginFrame(uint64_t frame)
+    {
+        m_frame = frame;
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void StreamingRing::endFrame()
+    {
+        m_last_stats = m_current_stats;
+    }
+
+    inline StreamingRing::Allocation StreamingRing::upload(
+        ID3D11DeviceContext4* d3d11_ctx,
+        void const* data,
+        size_t byte_size,
+        size_t alignment)
+    {
+        return allocate(d3d11_ctx, byte_size, alignment,
+            [data, byte_size](void* dst) { std::memcpy(dst, data, byte_size); });
+    }
+
+    template <typename Container>
+    inline StreamingRing::Allocation StreamingRing::upload(
+        ID3D11DeviceContext4* d3d11_ctx,
+        Container const& data,
+        size_t alignment)
+    {
+        return upload(d3d11_ctx, data.data(), data.size() * sizeof(typename Container::value_type), alignment);
+    }
+
+    template <typename WriteFunc>
+    inline StreamingRing::Allocation StreamingRing::allocate(
+        ID3D11DeviceContext4* d3d11_ctx,
+        size_t byte_size,
+        size_t alignment,
+        WriteFunc&& write_func)
+    {
+        size_t byte_offset = 0;
+        D3D11_MAP map_type = reserve(byte_size, alignment, byte_offset);
+
+        D3D11_MAPPED_SUBRESOURCE map;
+        winrt::check_hresult(d3d11_ctx->Map(m_buffer.Get(), 0, map_type, 0, &map));
+        write_func(static_cast<std::byte*>(map.pData) + byte_offset);
+        d3d11_ctx->Unmap(m_buffer.Get(), 0);
+
+        return { m_buffer.Get(), static_cast<UINT>(byte_offset), static_cast<UINT>(byte_size), m_frame, m_generation };
+    }
+
+    inline bool StreamingRing::isCurrent(Allocation const& allocation) const
+    {
+        return allocation.buffer == m_buffer.Get() && allocation.generation == m_generation;
+    }
+
+    inline ID3D11Buffer* StreamingRing::getBuffer() const
+    {
+        return m_buffer.Get();
+    }
+
+    inline size_t StreamingRing::getByteSize() const
+    {
+        return m_byte_size;
+    }
+
+    inline StreamingRing::FrameStatistics StreamingRing::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline StreamingRing::FrameStatistics StreamingRing::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline D3D11_MAP StreamingRing::reserve(size_t byte_size, size_t alignment, size_t& byte_offset)
+    {
+        if (byte_size > m_byte_size)
+        {
+            throw std::length_error("StreamingRing: allocation exceeds ring size");
+        }
+
+        alignment = alignment > 0 ? alignment : 1;
+        size_t aligned_head = ((m_head + alignment - 1) / alignment) * alignment;
+
+        D3D11_MAP map_type = D3D11_MAP_WRITE_NO_OVERWRITE;
+
+        if (m_needs_discard || aligned_head + byte_size > m_byte_size)
+        {
+            // skipped tail of the ring counts as padding of the wrapping frame
+            m_current_stats.bytes_padding += m_needs_discard ? 0 : (m_byte_size - m_head);
+            m_needs_discard = false;
+            aligned_head = 0;
+            map_type = D3D11_MAP_WRITE_DISCARD;
+            ++m_generation;
+            ++m_current_stats.discard_count;
+        }
+        else
+        {
+            m_current_stats.bytes_padding += aligned_head - m_head;
+            ++m_current_stats.no_overwrite_count;
+        }
+
+        byte_offset = aligned_head;
+        m_head = aligned_head + byte_size;
+
+        m_current_stats.bytes_allocated += byte_size;
+        ++m_current_stats.allocation_count;
+
+        return map_type;
+    }
+
+} // namespace dxowl
+
+#endif // !StreamingRing_hpp
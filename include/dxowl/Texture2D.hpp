@@ -7,6 +7,14 @@
 #ifndef Texture2D_hpp
 #define Texture2D_hpp
 
+#include <d3d11_4.h>
+#include <string>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h>
+
+#include "FormatTraits.hpp"
+#include "MemoryTracker.hpp"
 #include "VertexDescriptor.hpp"
 
 namespace dxowl
@@ -32,6 +40,11 @@ namespace dxowl
 
         ~Texture2D(){}; //TODO
 
+        Texture2D(const Texture2D& cpy) = delete;
+        Texture2D(Texture2D&& other) = default;
+        Texture2D& operator=(Texture2D&& rhs) = default;
+        Texture2D& operator=(const Texture2D& rhs) = delete;
+
         inline D3D11_TEXTURE2D_DESC getTextureDesc() const
         {
             return m_desc;
@@ -46,6 +59,16 @@ namespace dxowl
             return m_texture;
         }
 
+        inline void setMemoryTag(std::string const& tag)
+        {
+            m_memory_allocation.setTag(tag);
+        }
+
+        inline size_t getMemoryByteSize() const
+        {
+            return m_memory_allocation.getByteSize();
+        }
+
     protected:
         typedef Microsoft::WRL::ComPtr<ID3D11Texture2D> TexturePtr;
         typedef Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ShaderResourceViewPtr;
@@ -55,6 +78,9 @@ namespace dxowl
 
         TexturePtr m_texture;
         ShaderResourceViewPtr m_shdr_rsrc_view;
+
+        // render targets and depth stencils change the category in their constructor
+        MemoryTracker::Allocation m_memory_allocation;
     };
 
     template <typename TexelDataContainer>
@@ -84,24 +110,36 @@ namespace dxowl
     {
         std::vector<D3D11_SUBRESOURCE_DATA> pData(data.size());
 
+        // subresource i holds mip level (i % mip_levels) of array slice (i / mip_levels)
+        UINT mip_levels = desc.MipLevels > 0 ? desc.MipLevels : computeMipLevelCount(desc.Width, desc.Height);
+
         for (size_t i = 0; i < data.size(); ++i)
         {
             ZeroMemory(&pData[i], sizeof(D3D11_SUBRESOURCE_DATA));
 
+            UINT mip_level = static_cast<UINT>(i % mip_levels);
+            UINT width = computeMipExtent(desc.Width, mip_level);
+            UINT height = computeMipExtent(desc.Height, mip_level);
+
             pData[i].pSysMem = data[i];
-            pData[i].SysMemPitch = desc.Width * static_cast<UINT>(computeByteSize(desc.Format));
-            pData[i].SysMemSlicePitch = 0;
+            pData[i].SysMemPitch = static_cast<UINT>(computeRowPitch(desc.Format, width));
+            pData[i].SysMemSlicePitch = static_cast<UINT>(computeSlicePitch(desc.Format, width, height));
         }
 
-        HRESULT hr = d3d11_device->CreateTexture2D(
-            &m_desc,
-            pData.size() > 0 ? pData.data() : nullptr,
-            m_texture.GetAddressOf());
+        winrt::check_hresult(
+            d3d11_device->CreateTexture2D(
+                &m_desc,
+                pData.size() > 0 ? pData.data() : nullptr,
+                m_texture.GetAddressOf()));
+
+        winrt::check_hresult(
+            d3d11_device->CreateShaderResourceView(
+                m_texture.Get(),
+                &m_shdr_rsrc_view_desc,
+                m_shdr_rsrc_view.GetAddressOf()));
 
-        hr = d3d11_device->CreateShaderResourceView(
-            m_texture.Get(),
-            &m_shdr_rsrc_view_desc,
-            m_shdr_rsrc_view.GetAddressOf());
+        m_memory_allocation.setByteSize(computeResourceByteSize(m_desc));
+        m_memory_allocation.setCategory(MemoryTracker::Category::Texture);
 
         if (generate_mipmap) {
             Microsoft::WRL::ComPtr<ID3D11DeviceContext> ctx;
@@ -110,8 +148,6 @@ namespace dxowl
             // generate mipmap if requested using device context
             ctx->GenerateMips(m_shdr_rsrc_view.Get());
         }
-
-        //TODO do something with hr
     }
 } // namespace dxowl
 
@@ -7,16 +7,166 @@
 #ifndef Texture3D_hpp
 #define Texture3D_hpp
 
+#include <d3d11_4.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <wrl.h>
+#include <winrt/base.h> // winrt::check_hresult
+
+#include "FormatTraits.hpp"
+#include "MemoryTracker.hpp"
+
 namespace dxowl
 {
     class Texture3D
     {
     public:
-        Texture3D() = default;
+        /// Level 0 texels of all depth slices in one contiguous container, e.g. a std::vector<uint8_t>.
+        template <typename TexelDataContainer>
+        Texture3D(
+            ID3D11Device4* d3d11_device,
+            TexelDataContainer const &data,
+            D3D11_TEXTURE3D_DESC const &desc,
+            D3D11_SHADER_RESOURCE_VIEW_DESC const &shdr_rsrc_view);
+
+        /// One pointer per mip level, texels tightly packed. An empty vector creates the texture without
+        /// initial data, fill it with updateSubresource afterwards (requires D3D11_USAGE_DEFAULT).
+        /// Only vectors of pointers select this overload, vectors of texels go to the container overload.
+        template <typename TexelDataPtr, typename = std::enable_if_t<std::is_pointer<TexelDataPtr>::value>>
+        Texture3D(
+            ID3D11Device4* d3d11_device,
+            std::vector<TexelDataPtr> const &data,
+            D3D11_TEXTURE3D_DESC const &desc,
+            D3D11_SHADER_RESOURCE_VIEW_DESC const &shdr_rsrc_view);
+
         ~Texture3D() = default;
 
+        Texture3D(const Texture3D& cpy) = delete;
+        Texture3D(Texture3D&& other) = default;
+        Texture3D& operator=(Texture3D&& rhs) = default;
+        Texture3D& operator=(const Texture3D& rhs) = delete;
+
+        /// Uploads texels to a box of the given mip level. Pitches of 0 mean tightly packed box data.
+        void updateSubresource(
+            ID3D11DeviceContext4* d3d11_ctx,
+            UINT mip_level,
+            D3D11_BOX const &box,
+            void const* data,
+            UINT row_pitch = 0,
+            UINT depth_pitch = 0);
+
+        inline D3D11_TEXTURE3D_DESC getTextureDesc() const
+        {
+            return m_desc;
+        }
+
+        inline Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> getShaderResourceView() const
+        {
+            return m_shdr_rsrc_view;
+        }
+
+        inline Microsoft::WRL::ComPtr<ID3D11Texture3D> getTexture() const
+        {
+            return m_texture;
+        }
+
+        inline void setMemoryTag(std::string const& tag)
+        {
+            m_memory_allocation.setTag(tag);
+        }
+
+        inline size_t getMemoryByteSize() const
+        {
+            return m_memory_allocation.getByteSize();
+        }
+
     private:
+        typedef Microsoft::WRL::ComPtr<ID3D11Texture3D> TexturePtr;
+        typedef Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ShaderResourceViewPtr;
+
+        D3D11_TEXTURE3D_DESC m_desc;
+        D3D11_SHADER_RESOURCE_VIEW_DESC m_shdr_rsrc_view_desc;
+
+        TexturePtr m_texture;
+        ShaderResourceViewPtr m_shdr_rsrc_view;
+
+        MemoryTracker::Allocation m_memory_allocation;
     };
+
+    template <typename TexelDataContainer>
+    inline Texture3D::Texture3D(
+        ID3D11Device4* d3d11_device,
+        TexelDataContainer const &data,
+        D3D11_TEXTURE3D_DESC const &desc,
+        D3D11_SHADER_RESOURCE_VIEW_DESC const &shdr_rsrc_view)
+        : Texture3D(
+              d3d11_device,
+              std::vector<typename TexelDataContainer::value_type const*>{ data.data() },
+              desc,
+              shdr_rsrc_view)
+    {
+    }
+
+    template <typename TexelDataPtr, typename>
+    inline Texture3D::Texture3D(
+        ID3D11Device4* d3d11_device,
+        std::vector<TexelDataPtr> const &data,
+        D3D11_TEXTURE3D_DESC const &desc,
+        D3D11_SHADER_RESOURCE_VIEW_DESC const &shdr_rsrc_view)
+        : m_desc(desc), m_shdr_rsrc_view_desc(shdr_rsrc_view)
+    {
+        std::vector<D3D11_SUBRESOURCE_DATA> pData(data.size());
+
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            ZeroMemory(&pData[i], sizeof(D3D11_SUBRESOURCE_DATA));
+
+            UINT mip_level = static_cast<UINT>(i);
+            UINT width = computeMipExtent(desc.Width, mip_level);
+            UINT height = computeMipExtent(desc.Height, mip_level);
+
+            pData[i].pSysMem = data[i];
+            pData[i].SysMemPitch = static_cast<UINT>(computeRowPitch(desc.Format, width));
+            pData[i].SysMemSlicePitch = static_cast<UINT>(computeSlicePitch(desc.Format, width, height));
+        }
+
+        winrt::check_hresult(d3d11_device->CreateTexture3D(
+            &m_desc,
+            pData.size() > 0 ? pData.data() : nullptr,
+            m_texture.GetAddressOf()));
+
+        winrt::check_hresult(d3d11_device->CreateShaderResourceView(
+            m_texture.Get(),
+            &m_shdr_rsrc_view_desc,
+            m_shdr_rsrc_view.GetAddressOf()));
+
+        m_memory_allocation.setByteSize(computeResourceByteSize(m_desc));
+        m_memory_allocation.setCategory(MemoryTracker::Category::Texture);
+    }
+
+    inline void Texture3D::updateSubresource(
+        ID3D11DeviceContext4* d3d11_ctx,
+        UINT mip_level,
+        D3D11_BOX const &box,
+        void const* data,
+        UINT row_pitch,
+        UINT depth_pitch)
+    {
+        UINT box_width = box.right - box.left;
+        UINT box_height = box.bottom - box.top;
+
+        if (row_pitch == 0)
+        {
+            row_pitch = static_cast<UINT>(computeRowPitch(m_desc.Format, box_width));
+        }
+        if (depth_pitch == 0)
+        {
+            depth_pitch = row_pitch * static_cast<UINT>(computeRowCount(m_desc.Format, box_height));
+        }
+
+        d3d11_ctx->UpdateSubresource(m_texture.Get(), mip_level, &box, data, row_pitch, depth_pitch);
+    }
 } // namespace dxowl
 
-#endif
\ No newline at end of file
+#endif
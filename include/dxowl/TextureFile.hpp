@@ -0,0 +1,736 @@
+/// <copyright file="TextureFile.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef TextureFile_hpp
+#define TextureFile_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FormatTraits.hpp"
+#include "MappedFile.hpp"
+
+namespace dxowl
+{
+    /// DDS or KTX2 texture container read through a memory mapping. The subresource data points directly into
+    /// the mapping, so texels are not copied before the driver reads them on texture creation and pages that
+    /// are never uploaded are never loaded. Supercompressed KTX2 levels are the exception, they are decoded
+    /// into owned memory by a user provided decompressor.
+    /// Subresources are ordered as D3D11 expects them, i.e. all mips of array slice 0 first, with one entry per
+    /// mip level for volume textures. Keep the TextureFile alive until the texture is created.
+    class TextureFile
+    {
+    public:
+        enum class Container
+        {
+            DDS,
+            KTX2
+        };
+
+        struct Info
+        {
+            Container container = Container::DDS;
+            DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+            UINT width = 0;
+            UINT height = 0;
+            UINT depth = 0;
+            UINT mip_levels = 0;
+            UINT array_size = 0; // 2D slices, six per cube map
+            bool is_cube = false;
+            bool is_volume = false;
+        };
+
+        /// Decodes a supercompressed KTX2 mip level (scheme 2 is zstd, 3 is zlib) into exactly dst_size bytes.
+        /// Throws on failure.
+        typedef std::function<void(uint32_t scheme, void const* src, size_t src_size, void* dst, size_t dst_size)> Decompressor;
+
+        explicit TextureFile(std::string const& path, Decompressor const& decompressor = nullptr);
+        ~TextureFile() = default;
+
+        TextureFile(const TextureFile& cpy) = delete;
+        TextureFile(TextureFile&& other) = delete;
+        TextureFile& operator=(TextureFile&& rhs) = delete;
+        TextureFile& operator=(const TextureFile& rhs) = delete;
+
+        /// Validates the headers of a file prefix against the file size without touching the texel data.
+        /// Throws std::runtime_error for malformed or unsupported files.
+        static Info readInfo(void const* header_data, size_t header_byte_size, size_t file_byte_size);
+
+        /// Reads and validates only the headers of a file, e.g. to scan asset directories. Returns false instead
+        /// of throwing if the file cannot be used.
+        static bool probe(std::string const& path, Info& info);
+
+        Info const& getInfo() const;
+
+        /// True if all subresources point into the file mapping.
+        bool isZeroCopy() const;
+
+        /// One pointer per subresource, usable with the Texture2D and Texture3D constructors.
+        std::vector<void const*> getSubresourceData() const;
+        std::vector<D3D11_SUBRESOURCE_DATA> const& getInitialData() const;
+
+        /// Immutable shader resource textures matching the file, the 2D variant also covers arrays and cube maps.
+        D3D11_TEXTURE2D_DESC getTexture2DDesc() const;
+        D3D11_TEXTURE3D_DESC getTexture3DDesc() const;
+        D3D11_SHADER_RESOURCE_VIEW_DESC getShaderResourceViewDesc() const;
+
+    private:
+        // largest DDS header is 148 bytes, largest KTX2 header plus level index is 80 + 15 * 24 bytes
+        static constexpr size_t max_header_byte_size = 512;
+
+        struct LevelRange
+        {
+            uint64_t offset;
+            uint64_t byte_size;
+            uint64_t uncompressed_byte_size;
+        };
+
+        struct SubresourceRange
+        {
+            UINT mip_level;
+            uint64_t offset; // into the file, or into the decoded mip level for supercompressed files
+            uint64_t byte_size;
+        };
+
+        struct Layout
+        {
+            Info info;
+            uint32_t supercompression_scheme = 0;
+            std::vector<LevelRange> levels;
+            std::vector<SubresourceRange> subresources;
+        };
+
+        static uint32_t read32(uint8_t const* ptr);
+        static uint64_t read64(uint8_t const* ptr);
+
+        static Layout parse(uint8_t const* data, size_t byte_size, size_t file_byte_size);
+        static void parseDDS(uint8_t const* data, size_t byte_size, size_t file_byte_size, Layout& layout);
+        static void parseKTX2(uint8_t const* data, size_t byte_size, size_t file_byte_size, Layout& layout);
+        static void validateInfo(Info const& info);
+
+        static DXGI_FORMAT translateDDSPixelFormat(uint8_t const* pixel_format);
+        static DXGI_FORMAT translateVkFormat(uint32_t vk_format);
+
+        MappedFile m_file;
+        Info m_info;
+
+        std::vector<std::vector<uint8_t>> m_decoded_levels;
+        std::vector<D3D11_SUBRESOURCE_DATA> m_initial_data;
+    };
+
+    inline TextureFile::TextureFile(std::string const& path, Decompressor const& decompressor)
+        : m_file(path)
+    {
+        auto file_data = static_cast<uint8_t const*>(m_file.data());
+        Layout layout = parse(file_data, m_file.size(), m_file.size());
+        m_info = layout.info;
+
+        if (layout.supercompression_scheme != 0)
+        {
+            if (!decompressor)
+            {
+                throw std::runtime_error(
+                    "TextureFile: " + path + " uses supercompression scheme "
+                    + std::to_string(layout.supercompression_scheme) + ", no decompressor given");
+            }
+
+            m_decoded_levels.resize(layout.levels.size());
+            for (size_t level = 0; level < layout.levels.size(); ++level)
+            {
+                LevelRange const& range = layout.levels[level];
+                m_decoded_levels[level].resize(static_cast<size_t>(range.uncompressed_byte_size));
+                decompressor(
+                    layout.supercompression_scheme,
+                    file_data + range.offset,
+                    static_cast<size_t>(range.byte_size),
+                    m_decoded_levels[level].data(),
+                    m_decoded_levels[level].size());
+            }
+        }
+
+        m_initial_data.resize(layout.subresources.size());
+        for (size_t i = 0; i < layout.subresources.size(); ++i)
+        {
+            SubresourceRange const& range = layout.subresources[i];
+            UINT width = computeMipExtent(m_info.width, range.mip_level);
+            UINT height = computeMipExtent(m_info.height, range.mip_level);
+
+            uint8_t const* base = m_decoded_levels.empty() ? file_data : m_decoded_levels[range.mip_level].data();
+
+            ZeroMemory(&m_initial_data[i], sizeof(D3D11_SUBRESOURCE_DATA));
+            m_initial_data[i].pSysMem = base + range.offset;
+            m_initial_data[i].SysMemPitch = static_cast<UINT>(computeRowPitch(m_info.format, width));
+            m_initial_data[i].SysMemSlicePitch = static_cast<UINT>(computeSlicePitch(m_info.format, width, height));
+        }
+    }
+
+    inline TextureFile::Info TextureFile::readInfo(void const* header_data, size_t header_byte_size, size_t file_byte_size)
+    {
+        return parse(static_cast<uint8_t const*>(header_data), header_byte_size, file_byte_size).info;
+    }
+
+    inline bool TextureFile::probe(std::string const& path, Info& info)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            return false;
+        }
+
+        size_t file_byte_size = static_cast<size_t>(file.tellg());
+        std::vector<uint8_t> header((std::min)(file_byte_size, max_header_byte_size));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(header.data()), header.size()))
+        {
+            return false;
+        }
+
+        try
+        {
+            info = readInfo(header.data(), header.size(), file_byte_size);
+        }
+        catch (std::runtime_error const&)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    inline TextureFile::Info const& TextureFile::getInfo() const
+    {
+        return m_info;
+    }
+
+    inline bool TextureFile::isZeroCopy() const
+    {
+        return m_decoded_levels.empty();
+    }
+
+    inline std::vector<void const*> TextureFile::getSubresourceData() const
+    {
+        std::vector<void const*> retval;
+        retval.reserve(m_initial_data.size());
+        for (auto const& subresource : m_initial_data)
+        {
+            retval.push_back(subresource.pSysMem);
+        }
+        return retval;
+    }
+
+    inline std::vector<D3D11_SUBRESOURCE_DATA> const& TextureFile::getInitialData() const
+    {
+        return m_initial_data;
+    }
+
+    inline D3D11_TEXTURE2D_DESC TextureFile::getTexture2DDesc() const
+    {
+        if (m_info.is_volume)
+        {
+            throw std::invalid_argument("TextureFile: volume texture has no 2D description");
+        }
+
+        D3D11_TEXTURE2D_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Width = m_info.width;
+        desc.Height = m_info.height;
+        desc.MipLevels = m_info.mip_levels;
+        desc.ArraySize = m_info.array_size;
+        desc.Format = m_info.format;
+        desc.SampleDesc.Count = 1;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        desc.MiscFlags = m_info.is_cube ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+        return desc;
+    }
+
+    inline D3D11_TEXTURE3D_DESC TextureFile::getTexture3DDesc() const
+    {
+        if (!m_info.is_volume)
+        {
+            throw std::invalid_argument("TextureFile: 2D texture has no volume description");
+        }
+
+        D3D11_TEXTURE3D_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Width = m_info.width;
+        desc.Height = m_info.height;
+        desc.Depth = m_info.depth;
+        desc.MipLevels = m_info.mip_levels;
+        desc.Format = m_info.format;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        return desc;
+    }
+
+    inline D3D11_SHADER_RESOURCE_VIEW_DESC TextureFile::getShaderResourceViewDesc() const
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Format = m_info.format;
+        if (m_info.is_volume)
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE3D;
+            desc.Texture3D.MostDetailedMip = 0;
+            desc.Texture3D.MipLevels = m_info.mip_levels;
+        }
+        else if (m_info.is_cube && m_info.array_size > 6)
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+            desc.TextureCubeArray.MostDetailedMip = 0;
+            desc.TextureCubeArray.MipLevels = m_info.mip_levels;
+            desc.TextureCubeArray.First2DArrayFace = 0;
+            desc.TextureCubeArray.NumCubes = m_info.array_size / 6;
+        }
+        else if (m_info.is_cube)
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+            desc.TextureCube.MostDetailedMip = 0;
+            desc.TextureCube.MipLevels = m_info.mip_levels;
+        }
+        else if (m_info.array_size > 1)
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+            desc.Texture2DArray.MostDetailedMip = 0;
+            desc.Texture2DArray.MipLevels = m_info.mip_levels;
+            desc.Texture2DArray.FirstArraySlice = 0;
+            desc.Texture2DArray.ArraySize = m_info.array_size;
+        }
+        else
+        {
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            desc.Texture2D.MostDetailedMip = 0;
+            desc.Texture2D.MipLevels = m_info.mip_levels;
+        }
+        return desc;
+    }
+
+    inline uint32_t TextureFile::read32(uint8_t const* ptr)
+    {
+        uint32_t value;
+        std::memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t TextureFile::read64(uint8_t const* ptr)
+    {
+        uint64_t value;
+        std::memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    inline TextureFile::Layout TextureFile::parse(uint8_t const* data, size_t byte_size, size_t file_byte_size)
+    {
+        static uint8_t const ktx2_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+        Layout layout;
+        if (byte_size >= 4 && std::memcmp(data, "DDS ", 4) == 0)
+        {
+            parseDDS(data, byte_size, file_byte_size, layout);
+        }
+        else if (byte_size >= sizeof(ktx2_identifier) && std::memcmp(data, ktx2_identifier, sizeof(ktx2_identifier)) == 0)
+        {
+            parseKTX2(data, byte_size, file_byte_size, layout);
+        }
+        else
+        {
+            throw std::runtime_error("TextureFile: unknown container");
+        }
+        return layout;
+    }
+
+    inline void TextureFile::parseDDS(uint8_t const* data, size_t byte_size, size_t file_byte_size, Layout& layout)
+    {
+        // DDS_HEADER starts after the magic, DDS_PIXELFORMAT at byte 72 of the header
+        constexpr size_t header_offset = 4;
+        constexpr size_t header_byte_size = 124;
+        constexpr size_t dx10_header_byte_size = 20;
+        constexpr uint32_t ddsd_depth = 0x800000;
+        constexpr uint32_t ddscaps2_cubemap = 0x200;
+        constexpr uint32_t ddscaps2_cubemap_all_faces = 0xFC00;
+        constexpr uint32_t ddscaps2_volume = 0x200000;
+
+        if (byte_size < header_offset + header_byte_size)
+        {
+            throw std::runtime_error("TextureFile: truncated DDS header");
+        }
+
+        uint8_t const* header = data + header_offset;
+        uint8_t const* pixel_format = header + 72;
+        if (read32(header) != header_byte_size || read32(pixel_format) != 32)
+        {
+            throw std::runtime_error("TextureFile: invalid DDS header");
+        }
+
+        uint32_t flags = read32(header + 4);
+        uint32_t caps2 = read32(header + 108);
+
+        Info& info = layout.info;
+        info.container = Container::DDS;
+        info.height = read32(header + 8);
+        info.width = read32(header + 12);
+        info.depth = 1;
+        info.mip_levels = (std::max)(read32(header + 24), 1u);
+        info.array_size = 1;
+
+        size_t data_offset = header_offset + header_byte_size;
+
+        if (read32(pixel_format + 8) == read32(reinterpret_cast<uint8_t const*>("DX10")))
+        {
+            if (byte_size < data_offset + dx10_header_byte_size)
+            {
+                throw std::runtime_error("TextureFile: truncated DDS DX10 header");
+            }
+
+            uint8_t const* dx10_header = data + data_offset;
+            data_offset += dx10_header_byte_size;
+
+            info.format = static_cast<DXGI_FORMAT>(read32(dx10_header));
+            info.array_size = read32(dx10_header + 12);
+
+            // D3D10_RESOURCE_DIMENSION: 2 is 1D, 3 is 2D, 4 is 3D
+            switch (read32(dx10_header + 4))
+            {
+            case 2:
+                info.height = 1;
+                break;
+            case 3:
+                info.is_cube = (read32(dx10_header + 8) & D3D11_RESOURCE_MISC_TEXTURECUBE) != 0;
+                break;
+            case 4:
+                info.depth = read32(header + 20);
+                info.is_volume = true;
+                break;
+            default:
+                throw std::runtime_error("TextureFile: unsupported DDS resource dimension");
+            }
+        }
+        else
+        {
+            info.format = translateDDSPixelFormat(pixel_format);
+
+            if ((caps2 & ddscaps2_volume) != 0 && (flags & ddsd_depth) != 0)
+            {
+                info.depth = read32(header + 20);
+                info.is_volume = true;
+            }
+            else if ((caps2 & ddscaps2_cubemap) != 0)
+            {
+                if ((caps2 & ddscaps2_cubemap_all_faces) != ddscaps2_cubemap_all_faces)
+                {
+                    throw std::runtime_error("TextureFile: partial DDS cube maps are not supported");
+                }
+                info.is_cube = true;
+            }
+        }
+
+        if (info.is_cube)
+        {
+            info.array_size *= 6;
+        }
+
+        validateInfo(info);
+
+        // payload is tightly packed, all mips of a slice (or all depth slices of a mip) are contiguous
+        uint64_t offset = data_offset;
+        for (UINT slice = 0; slice < info.array_size; ++slice)
+        {
+            for (UINT mip_level = 0; mip_level < info.mip_levels; ++mip_level)
+            {
+                uint64_t subresource_byte_size = computeSubresourceByteSize(
+                    info.format,
+                    computeMipExtent(info.width, mip_level),
+                    computeMipExtent(info.height, mip_level),
+                    computeMipExtent(info.depth, mip_level));
+                layout.subresources.push_back({ mip_level, offset, subresource_byte_size });
+                offset += subresource_byte_size;
+            }
+        }
+
+        if (offset > file_byte_size)
+        {
+            throw std::runtime_error("TextureFile: truncated DDS texel data");
+        }
+    }
+
+    inline void TextureFile::parseKTX2(uint8_t const* data, size_t byte_size, size_t file_byte_size, Layout& layout)
+    {
+        constexpr size_t header_byte_size = 80;
+        constexpr size_t level_index_entry_byte_size = 24;
+
+        if (byte_size < header_byte_size)
+        {
+            throw std::runtime_error("TextureFile: truncated KTX2 header");
+        }
+
+        uint32_t vk_format = read32(data + 12);
+        uint32_t pixel_height = read32(data + 24);
+        uint32_t pixel_depth = read32(data + 28);
+        uint32_t layer_cnt = read32(data + 32);
+        uint32_t face_cnt = read32(data + 36);
+        uint32_t level_cnt = read32(data + 40);
+        layout.supercompression_scheme = read32(data + 44);
+
+        // 1 is BasisLZ, which needs transcoding rather than decompression
+        if (layout.supercompression_scheme == 1 || layout.supercompression_scheme > 3)
+        {
+            throw std::runtime_error("TextureFile: unsupported KTX2 supercompression scheme");
+        }
+        if (face_cnt != 1 && face_cnt != 6)
+        {
+            throw std::runtime_error("TextureFile: invalid KTX2 face count");
+        }
+        if (pixel_depth > 0 && layer_cnt > 1)
+        {
+            throw std::runtime_error("TextureFile: KTX2 volume arrays are not supported");
+        }
+
+        Info& info = layout.info;
+        info.container = Container::KTX2;
+        info.format = translateVkFormat(vk_format);
+        info.width = read32(data + 20);
+        info.height = (std::max)(pixel_height, 1u);
+        info.depth = (std::max)(pixel_depth, 1u);
+        // a level count of 0 asks the loader to generate mips, only the base level is stored
+        info.mip_levels = (std::max)(level_cnt, 1u);
+        info.array_size = (std::max)(layer_cnt, 1u) * face_cnt;
+        info.is_cube = face_cnt == 6;
+        info.is_volume = pixel_depth > 0;
+
+        validateInfo(info);
+
+        if (byte_size < header_byte_size + info.mip_levels * level_index_entry_byte_size)
+        {
+            throw std::runtime_error("TextureFile: truncated KTX2 level index");
+        }
+
+        // level index entry i describes mip level i, even though the file stores the smallest level first
+        for (UINT mip_level = 0; mip_level < info.mip_levels; ++mip_level)
+        {
+            uint8_t const* entry = data + header_byte_size + mip_level * level_index_entry_byte_size;
+            LevelRange range = { read64(entry), read64(entry + 8), read64(entry + 16) };
+
+            uint64_t expected_byte_size = computeSubresourceByteSize(
+                info.format,
+                computeMipExtent(info.width, mip_level),
+                computeMipExtent(info.height, mip_level),
+                computeMipExtent(info.depth, mip_level)) * info.array_size;
+
+            if (range.uncompressed_byte_size != expected_byte_size
+                || (layout.supercompression_scheme == 0 && range.byte_size != expected_byte_size))
+            {
+                throw std::runtime_error("TextureFile: KTX2 level size does not match its format");
+            }
+            if (range.offset > file_byte_size || range.byte_size > file_byte_size - range.offset)
+            {
+                throw std::runtime_error("TextureFile: truncated KTX2 texel data");
+            }
+
+            layout.levels.push_back(range);
+        }
+
+        // within a level, images are ordered by layer then face, matching the D3D11 array slice order
+        for (UINT slice = 0; slice < info.array_size; ++slice)
+        {
+            for (UINT mip_level = 0; mip_level < info.mip_levels; ++mip_level)
+            {
+                uint64_t image_byte_size = layout.levels[mip_level].uncompressed_byte_size / info.array_size;
+                uint64_t level_offset = layout.supercompression_scheme == 0 ? layout.levels[mip_level].offset : 0;
+                layout.subresources.push_back({ mip_level, level_offset + slice * image_byte_size, image_byte_size });
+            }
+        }
+    }
+
+    inline void TextureFile::validateInfo(Info const& info)
+    {
+        FormatTraits const& traits = getFormatTraits(info.format);
+        if (info.format == DXGI_FORMAT_UNKNOWN || traits.bytes_per_block == 0 || isPlanar(info.format))
+        {
+            throw std::runtime_error("TextureFile: unsupported format");
+        }
+
+        // D3D11 limits also keep all size computations far from overflowing
+        UINT max_extent = info.is_volume ? D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION : D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+        if (info.width == 0 || info.height == 0 || info.depth == 0 || info.array_size == 0
+            || info.width > max_extent || info.height > max_extent || info.depth > max_extent
+            || info.array_size > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION)
+        {
+            throw std::runtime_error("TextureFile: invalid texture extent");
+        }
+        if (info.mip_levels > computeMipLevelCount(info.width, info.height, info.depth))
+        {
+            throw std::runtime_error("TextureFile: invalid mip level count");
+        }
+        if (info.is_cube && info.width != info.height)
+        {
+            throw std::runtime_error("TextureFile: cube map faces are not square");
+        }
+    }
+
+    inline DXGI_FORMAT TextureFile::translateDDSPixelFormat(uint8_t const* pixel_format)
+    {
+        constexpr uint32_t ddpf_alpha_pixels = 0x1;
+        constexpr uint32_t ddpf_alpha = 0x2;
+        constexpr uint32_t ddpf_fourcc = 0x4;
+        constexpr uint32_t ddpf_rgb = 0x40;
+        constexpr uint32_t ddpf_luminance = 0x20000;
+
+        uint32_t flags = read32(pixel_format + 4);
+        uint32_t four_cc = read32(pixel_format + 8);
+        uint32_t bit_cnt = read32(pixel_format + 12);
+        uint32_t r_mask = read32(pixel_format + 16);
+        uint32_t g_mask = read32(pixel_format + 20);
+        uint32_t b_mask = read32(pixel_format + 24);
+        uint32_t a_mask = (flags & (ddpf_alpha_pixels | ddpf_alpha)) != 0 ? read32(pixel_format + 28) : 0;
+
+        auto isFourCC = [four_cc](char const* code) {
+            return four_cc == read32(reinterpret_cast<uint8_t const*>(code));
+        };
+        auto hasMasks = [=](uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+            return r_mask == r && g_mask == g && b_mask == b && a_mask == a;
+        };
+
+        if ((flags & ddpf_fourcc) != 0)
+        {
+            if (isFourCC("DXT1")) return DXGI_FORMAT_BC1_UNORM;
+            if (isFourCC("DXT2") || isFourCC("DXT3")) return DXGI_FORMAT_BC2_UNORM;
+            if (isFourCC("DXT4") || isFourCC("DXT5")) return DXGI_FORMAT_BC3_UNORM;
+            if (isFourCC("ATI1") || isFourCC("BC4U")) return DXGI_FORMAT_BC4_UNORM;
+            if (isFourCC("BC4S")) return DXGI_FORMAT_BC4_SNORM;
+            if (isFourCC("ATI2") || isFourCC("BC5U")) return DXGI_FORMAT_BC5_UNORM;
+            if (isFourCC("BC5S")) return DXGI_FORMAT_BC5_SNORM;
+
+            // legacy D3DFORMAT values stored in the FourCC field
+            switch (four_cc)
+            {
+            case 36: return DXGI_FORMAT_R16G16B16A16_UNORM;
+            case 110: return DXGI_FORMAT_R16G16B16A16_SNORM;
+            case 111: return DXGI_FORMAT_R16_FLOAT;
+            case 112: return DXGI_FORMAT_R16G16_FLOAT;
+            case 113: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case 114: return DXGI_FORMAT_R32_FLOAT;
+            case 115: return DXGI_FORMAT_R32G32_FLOAT;
+            case 116: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+            default: return DXGI_FORMAT_UNKNOWN;
+            }
+        }
+
+        if ((flags & ddpf_rgb) != 0 && bit_cnt == 32)
+        {
+            if (hasMasks(0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000)) return DXGI_FORMAT_R8G8B8A8_UNORM;
+            if (hasMasks(0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000)) return DXGI_FORMAT_B8G8R8A8_UNORM;
+            if (hasMasks(0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000)) return DXGI_FORMAT_B8G8R8X8_UNORM;
+            if (hasMasks(0x000003ff, 0x000ffc00, 0x3ff00000, 0xc0000000)) return DXGI_FORMAT_R10G10B10A2_UNORM;
+            if (hasMasks(0x0000ffff, 0xffff0000, 0x00000000, 0x00000000)) return DXGI_FORMAT_R16G16_UNORM;
+            if (hasMasks(0xffffffff, 0x00000000, 0x00000000, 0x00000000)) return DXGI_FORMAT_R32_FLOAT;
+        }
+        else if ((flags & ddpf_rgb) != 0 && bit_cnt == 16)
+        {
+            if (hasMasks(0xf800, 0x07e0, 0x001f, 0x0000)) return DXGI_FORMAT_B5G6R5_UNORM;
+            if (hasMasks(0x7c00, 0x03e0, 0x001f, 0x8000)) return DXGI_FORMAT_B5G5R5A1_UNORM;
+            if (hasMasks(0x0f00, 0x00f0, 0x000f, 0xf000)) return DXGI_FORMAT_B4G4R4A4_UNORM;
+        }
+        else if ((flags & ddpf_luminance) != 0)
+        {
+            if (bit_cnt == 8 && hasMasks(0xff, 0, 0, 0)) return DXGI_FORMAT_R8_UNORM;
+            if (bit_cnt == 16 && hasMasks(0xffff, 0, 0, 0)) return DXGI_FORMAT_R16_UNORM;
+            if (bit_cnt == 16 && hasMasks(0x00ff, 0, 0, 0xff00)) return DXGI_FORMAT_R8G8_UNORM;
+        }
+        else if ((flags & ddpf_alpha) != 0 && bit_cnt == 8)
+        {
+            return DXGI_FORMAT_A8_UNORM;
+        }
+
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    inline DXGI_FORMAT TextureFile::translateVkFormat(uint32_t vk_format)
+    {
+        // VkFormat values, packed formats name components from the most significant bit in Vulkan and from the
+        // least significant bit in DXGI
+        switch (vk_format)
+        {
+        case 4: return DXGI_FORMAT_B5G6R5_UNORM;        // R5G6B5_UNORM_PACK16
+        case 8: return DXGI_FORMAT_B5G5R5A1_UNORM;      // A1R5G5B5_UNORM_PACK16
+        case 9: return DXGI_FORMAT_R8_UNORM;
+        case 10: return DXGI_FORMAT_R8_SNORM;
+        case 13: return DXGI_FORMAT_R8_UINT;
+        case 14: return DXGI_FORMAT_R8_SINT;
+        case 16: return DXGI_FORMAT_R8G8_UNORM;
+        case 17: return DXGI_FORMAT_R8G8_SNORM;
+        case 20: return DXGI_FORMAT_R8G8_UINT;
+        case 21: return DXGI_FORMAT_R8G8_SINT;
+        case 37: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case 38: return DXGI_FORMAT_R8G8B8A8_SNORM;
+        case 41: return DXGI_FORMAT_R8G8B8A8_UINT;
+        case 42: return DXGI_FORMAT_R8G8B8A8_SINT;
+        case 43: return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+        case 44: return DXGI_FORMAT_B8G8R8A8_UNORM;
+        case 50: return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+        case 64: return DXGI_FORMAT_R10G10B10A2_UNORM;  // A2B10G10R10_UNORM_PACK32
+        case 68: return DXGI_FORMAT_R10G10B10A2_UINT;   // A2B10G10R10_UINT_PACK32
+        case 70: return DXGI_FORMAT_R16_UNORM;
+        case 71: return DXGI_FORMAT_R16_SNORM;
+        case 74: return DXGI_FORMAT_R16_UINT;
+        case 75: return DXGI_FORMAT_R16_SINT;
+        case 76: return DXGI_FORMAT_R16_FLOAT;
+        case 77: return DXGI_FORMAT_R16G16_UNORM;
+        case 78: return DXGI_FORMAT_R16G16_SNORM;
+        case 81: return DXGI_FORMAT_R16G16_UINT;
+        case 82: return DXGI_FORMAT_R16G16_SINT;
+        case 83: return DXGI_FORMAT_R16G16_FLOAT;
+        case 91: return DXGI_FORMAT_R16G16B16A16_UNORM;
+        case 92: return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case 95: return DXGI_FORMAT_R16G16B16A16_UINT;
+        case 96: return DXGI_FORMAT_R16G16B16A16_SINT;
+        case 97: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case 98: return DXGI_FORMAT_R32_UINT;
+        case 99: return DXGI_FORMAT_R32_SINT;
+        case 100: return DXGI_FORMAT_R32_FLOAT;
+        case 101: return DXGI_FORMAT_R32G32_UINT;
+        case 102: return DXGI_FORMAT_R32G32_SINT;
+        case 103: return DXGI_FORMAT_R32G32_FLOAT;
+        case 104: return DXGI_FORMAT_R32G32B32_UINT;
+        case 105: return DXGI_FORMAT_R32G32B32_SINT;
+        case 106: return DXGI_FORMAT_R32G32B32_FLOAT;
+        case 107: return DXGI_FORMAT_R32G32B32A32_UINT;
+        case 108: return DXGI_FORMAT_R32G32B32A32_SINT;
+        case 109: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case 122: return DXGI_FORMAT_R11G11B10_FLOAT;   // B10G11R11_UFLOAT_PACK32
+        case 123: return DXGI_FORMAT_R9G9B9E5_SHAREDEXP; // E5B9G9R9_UFLOAT_PACK32
+        case 124: return DXGI_FORMAT_D16_UNORM;
+        case 126: return DXGI_FORMAT_D32_FLOAT;
+        case 129: return DXGI_FORMAT_D24_UNORM_S8_UINT;
+        case 131: // BC1_RGB_UNORM_BLOCK
+        case 133: return DXGI_FORMAT_BC1_UNORM;
+        case 132: // BC1_RGB_SRGB_BLOCK
+        case 134: return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case 135: return DXGI_FORMAT_BC2_UNORM;
+        case 136: return DXGI_FORMAT_BC2_UNORM_SRGB;
+        case 137: return DXGI_FORMAT_BC3_UNORM;
+        case 138: return DXGI_FORMAT_BC3_UNORM_SRGB;
+        case 139: return DXGI_FORMAT_BC4_UNORM;
+        case 140: return DXGI_FORMAT_BC4_SNORM;
+        case 141: return DXGI_FORMAT_BC5_UNORM;
+        case 142: return DXGI_FORMAT_BC5_SNORM;
+        case 143: return DXGI_FORMAT_BC6H_UF16;
+        case 144: return DXGI_FORMAT_BC6H_SF16;
+        case 145: return DXGI_FORMAT_BC7_UNORM;
+        case 146: return DXGI_FORMAT_BC7_UNORM_SRGB;
+        default: return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+} // namespace dxowl
+
+#endif // !TextureFile_hpp
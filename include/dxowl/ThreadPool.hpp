@@ -0,0 +1,275 @@
+/// <copyright file="ThreadPool.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dxowl
+{
+    /// Work-stealing thread pool. Every worker owns a task queue; tasks submitted from a worker go to
+    /// its own queue, tasks submitted from other threads are distributed round-robin. Idle workers
+    /// steal from the front of other queues. Tasks passed to submit() must not throw.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t thread_cnt = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool& cpy) = delete;
+        ThreadPool(ThreadPool&& other) = delete;
+        ThreadPool& operator=(ThreadPool&& rhs) = delete;
+        ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+        void submit(std::function<void()> task);
+
+        /// Calls func(i) for all i in [begin, end) and blocks until all calls have returned. The calling
+        /// thread takes part in the work, so this may be used from within pool tasks. The first exception
+        /// thrown by func is rethrown on the calling thread.
+        template <typename Func>
+        void parallelFor(size_t begin, size_t end, Func&& func, size_t grain_size = 1);
+
+        size_t getThreadCount() const;
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool tryPop(size_t queue_idx, std::function<void()>& task);
+        bool trySteal(size_t thief_idx, std::function<void()>& task);
+        bool runPendingTask(size_t queue_idx);
+        void workerLoop(size_t queue_idx);
+
+        static size_t& currentWorkerIndex();
+        static ThreadPool*& currentPool();
+
+        std::vector<std::unique_ptr<WorkQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        std::atomic<size_t> m_next_queue;
+        std::atomic<size_t> m_pending;
+
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake;
+        bool m_stop;
+    };
+
+    inline ThreadPool::ThreadPool(size_t thread_cnt)
+        : m_next_queue(0), m_pending(0), m_stop(false)
+    {
+        if (thread_cnt == 0)
+        {
+            thread_cnt = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        for (size_t i = 0; i < thread_cnt; ++i)
+        {
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        for (size_t i = 0; i < thread_cnt; ++i)
+        {
+            m_threads.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    inline void ThreadPool::submit(std::function<void()> task)
+    {
+        size_t queue_idx = currentPool() == this
+            ? currentWorkerIndex()
+            : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+        {
+            std::lock_guard<std::mutex> lock(m_queues[queue_idx]->mutex);
+            m_queues[queue_idx]->tasks.push_back(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_pending.fetch_add(1, std::memory_order_release);
+        }
+        m_wake.notify_one();
+    }
+
+    template <typename Func>
+    inline void ThreadPool::parallelFor(size_t begin, size_t end, Func&& func, size_t grain_size)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        grain_size = std::max<size_t>(1, grain_size);
+        size_t const item_cnt = end - begin;
+        size_t const chunk_size = (std::max)(grain_size, item_cnt / (m_queues.size() * 4) + 1);
+        size_t const chunk_cnt = (item_cnt + chunk_size - 1) / chunk_size;
+
+        std::atomic<size_t> remaining(chunk_cnt);
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        for (size_t chunk = 0; chunk < chunk_cnt; ++chunk)
+        {
+            size_t chunk_begin = begin + chunk * chunk_size;
+            size_t chunk_end = (std::min)(end, chunk_begin + chunk_size);
+
+            submit([&, chunk_begin, chunk_end]() {
+                try
+                {
+                    for (size_t i = chunk_begin; i < chunk_end; ++i)
+                    {
+                        func(i);
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+
+        size_t const queue_idx = currentPool() == this ? currentWorkerIndex() : 0;
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!runPendingTask(queue_idx))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    inline size_t ThreadPool::getThreadCount() const
+    {
+        return m_threads.size();
+    }
+
+    inline bool ThreadPool::tryPop(size_t queue_idx, std::function<void()>& task)
+    {
+        WorkQueue& queue = *m_queues[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    inline bool ThreadPool::trySteal(size_t thief_idx, std::function<void()>& task)
+    {
+        for (size_t i = 1; i < m_queues.size(); ++i)
+        {
+            WorkQueue& queue = *m_queues[(thief_idx + i) % m_queues.size()];
+            std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+
+            if (lock.owns_lock() && !queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline bool ThreadPool::runPendingTask(size_t queue_idx)
+    {
+        std::function<void()> task;
+
+        if (tryPop(queue_idx, task) || trySteal(queue_idx, task))
+        {
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                // submit() requires tasks that handle their own errors, never take down a worker
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    inline void ThreadPool::workerLoop(size_t queue_idx)
+    {
+        currentPool() = this;
+        currentWorkerIndex() = queue_idx;
+
+        while (true)
+        {
+            if (runPendingTask(queue_idx))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || m_pending.load(std::memory_order_acquire) > 0; });
+
+            if (m_stop && m_pending.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    inline size_t& ThreadPool::currentWorkerIndex()
+    {
+        thread_local size_t worker_idx = 0;
+        return worker_idx;
+    }
+
+    inline ThreadPool*& ThreadPool::currentPool()
+    {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+} // namespace dxowl
+
+#endif // !ThreadPool_hpp
@@ -8,8 +8,13 @@
 #define VertexDescriptor_h
 
 #include <d3d11_4.h>
+#include <cctype>
+#include <cstdint>
 #include <vector>
 
+#include "FormatTraits.hpp"
+#include "Hash.hpp"
+
 namespace dxowl
 {
     struct VertexDescriptor
@@ -20,6 +25,23 @@ namespace dxowl
         std::vector<D3D11_INPUT_ELEMENT_DESC> attributes;
     };
 
+    /// Semantic names are compared by content. Like D3D11, the comparison ignores case.
+    inline bool compareSemanticNames(LPCSTR lhs, LPCSTR rhs)
+    {
+        if (lhs == rhs)
+            return true;
+        if (lhs == nullptr || rhs == nullptr)
+            return false;
+
+        for (; *lhs != '\0' && *rhs != '\0'; ++lhs, ++rhs)
+        {
+            if (std::tolower(static_cast<unsigned char>(*lhs)) != std::tolower(static_cast<unsigned char>(*rhs)))
+                return false;
+        }
+
+        return *lhs == *rhs;
+    }
+
     inline bool VertexDescriptor::operator==(VertexDescriptor const &rhs) const
     {
         bool retval = stride == rhs.stride;
@@ -34,7 +56,7 @@ namespace dxowl
                 retval = retval && attributes[i].InputSlotClass == rhs.attributes[i].InputSlotClass;
                 retval = retval && attributes[i].InstanceDataStepRate == rhs.attributes[i].InstanceDataStepRate;
                 retval = retval && attributes[i].SemanticIndex == rhs.attributes[i].SemanticIndex;
-                retval = retval && attributes[i].SemanticName == rhs.attributes[i].SemanticName;
+                retval = retval && compareSemanticNames(attributes[i].SemanticName, rhs.attributes[i].SemanticName);
             }
         }
         else
@@ -45,306 +67,108 @@ namespace dxowl
         return retval;
     }
 
-    static constexpr size_t computeByteSize(DXGI_FORMAT value_type)
+    /// Content based hash, consistent with operator==.
+    inline uint64_t computeHash(VertexDescriptor const& vertex_descriptor)
+    {
+        uint64_t retval = hashCombine(hash_seed, vertex_descriptor.stride);
+
+        for (auto const& attrib : vertex_descriptor.attributes)
+        {
+            uint64_t name_hash = 0;
+            for (LPCSTR c = attrib.SemanticName; c != nullptr && *c != '\0'; ++c)
+            {
+                name_hash = name_hash * 31 + static_cast<uint64_t>(std::tolower(static_cast<unsigned char>(*c)));
+            }
+
+            retval = hashCombine(retval, name_hash);
+            retval = hashCombine(retval, attrib.SemanticIndex);
+            retval = hashCombine(retval, static_cast<uint64_t>(attrib.Format));
+            retval = hashCombine(retval, attrib.InputSlot);
+            retval = hashCombine(retval, attrib.AlignedByteOffset);
+            retval = hashCombine(retval, static_cast<uint64_t>(attrib.InputSlotClass));
+            retval = hashCombine(retval, attrib.InstanceDataStepRate);
+        }
+
+        return retval;
+    }
+
+    inline uint64_t computeHash(std::vector<VertexDescriptor> const& vertex_layout)
     {
-        size_t retval = 0;
+        uint64_t retval = hashCombine(hash_seed, vertex_layout.size());
 
-        switch (value_type)
+        for (auto const& vertex_descriptor : vertex_layout)
         {
-        case DXGI_FORMAT_UNKNOWN:
-            break;
-        case DXGI_FORMAT_R32G32B32A32_TYPELESS:
-            retval = 16;
-            break;
-        case DXGI_FORMAT_R32G32B32A32_FLOAT:
-            retval = 16;
-            break;
-        case DXGI_FORMAT_R32G32B32A32_UINT:
-            retval = 16;
-            break;
-        case DXGI_FORMAT_R32G32B32A32_SINT:
-            retval = 16;
-            break;
-        case DXGI_FORMAT_R32G32B32_TYPELESS:
-            retval = 12;
-            break;
-        case DXGI_FORMAT_R32G32B32_FLOAT:
-            retval = 12;
-            break;
-        case DXGI_FORMAT_R32G32B32_UINT:
-            retval = 12;
-            break;
-        case DXGI_FORMAT_R32G32B32_SINT:
-            retval = 12;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_TYPELESS:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_FLOAT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_UNORM:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_UINT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_SNORM:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R16G16B16A16_SINT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R32G32_TYPELESS:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R32G32_FLOAT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R32G32_UINT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R32G32_SINT:
-            retval = 8;
-            break;
-        case DXGI_FORMAT_R32G8X24_TYPELESS:
-            break;
-        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
-            break;
-        case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
-            break;
-        case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
-            break;
-        case DXGI_FORMAT_R10G10B10A2_TYPELESS:
-            break;
-        case DXGI_FORMAT_R10G10B10A2_UNORM:
-            break;
-        case DXGI_FORMAT_R10G10B10A2_UINT:
-            break;
-        case DXGI_FORMAT_R11G11B10_FLOAT:
-            break;
-        case DXGI_FORMAT_R8G8B8A8_TYPELESS:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R8G8B8A8_UNORM:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R8G8B8A8_UINT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R8G8B8A8_SNORM:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R8G8B8A8_SINT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R16G16_TYPELESS:
-            break;
-        case DXGI_FORMAT_R16G16_FLOAT:
-            break;
-        case DXGI_FORMAT_R16G16_UNORM:
-            break;
-        case DXGI_FORMAT_R16G16_UINT:
-            break;
-        case DXGI_FORMAT_R16G16_SNORM:
-            break;
-        case DXGI_FORMAT_R16G16_SINT:
-            break;
-        case DXGI_FORMAT_R32_TYPELESS:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_D32_FLOAT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R32_FLOAT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R32_UINT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R32_SINT:
-            retval = 4;
-            break;
-        case DXGI_FORMAT_R24G8_TYPELESS:
-            break;
-        case DXGI_FORMAT_D24_UNORM_S8_UINT:
-            break;
-        case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
-            break;
-        case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
-            break;
-        case DXGI_FORMAT_R8G8_TYPELESS:
-            break;
-        case DXGI_FORMAT_R8G8_UNORM:
-            break;
-        case DXGI_FORMAT_R8G8_UINT:
-            break;
-        case DXGI_FORMAT_R8G8_SNORM:
-            break;
-        case DXGI_FORMAT_R8G8_SINT:
-            break;
-        case DXGI_FORMAT_R16_TYPELESS:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R16_FLOAT:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_D16_UNORM:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R16_UNORM:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R16_UINT:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R16_SNORM:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R16_SINT:
-            retval = 2;
-            break;
-        case DXGI_FORMAT_R8_TYPELESS:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_R8_UNORM:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_R8_UINT:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_R8_SNORM:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_R8_SINT:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_A8_UNORM:
-            retval = 1;
-            break;
-        case DXGI_FORMAT_R1_UNORM:
-            break;
-        case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
-            break;
-        case DXGI_FORMAT_R8G8_B8G8_UNORM:
-            break;
-        case DXGI_FORMAT_G8R8_G8B8_UNORM:
-            break;
-        case DXGI_FORMAT_BC1_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC1_UNORM:
-            break;
-        case DXGI_FORMAT_BC1_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_BC2_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC2_UNORM:
-            break;
-        case DXGI_FORMAT_BC2_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_BC3_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC3_UNORM:
-            break;
-        case DXGI_FORMAT_BC3_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_BC4_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC4_UNORM:
-            break;
-        case DXGI_FORMAT_BC4_SNORM:
-            break;
-        case DXGI_FORMAT_BC5_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC5_UNORM:
-            break;
-        case DXGI_FORMAT_BC5_SNORM:
-            break;
-        case DXGI_FORMAT_B5G6R5_UNORM:
-            break;
-        case DXGI_FORMAT_B5G5R5A1_UNORM:
-            break;
-        case DXGI_FORMAT_B8G8R8A8_UNORM:
-            break;
-        case DXGI_FORMAT_B8G8R8X8_UNORM:
-            break;
-        case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
-            break;
-        case DXGI_FORMAT_B8G8R8A8_TYPELESS:
-            break;
-        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_B8G8R8X8_TYPELESS:
-            break;
-        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_BC6H_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC6H_UF16:
-            break;
-        case DXGI_FORMAT_BC6H_SF16:
-            break;
-        case DXGI_FORMAT_BC7_TYPELESS:
-            break;
-        case DXGI_FORMAT_BC7_UNORM:
-            break;
-        case DXGI_FORMAT_BC7_UNORM_SRGB:
-            break;
-        case DXGI_FORMAT_AYUV:
-            break;
-        case DXGI_FORMAT_Y410:
-            break;
-        case DXGI_FORMAT_Y416:
-            break;
-        case DXGI_FORMAT_NV12:
-            break;
-        case DXGI_FORMAT_P010:
-            break;
-        case DXGI_FORMAT_P016:
-            break;
-        case DXGI_FORMAT_420_OPAQUE:
-            break;
-        case DXGI_FORMAT_YUY2:
-            break;
-        case DXGI_FORMAT_Y210:
-            break;
-        case DXGI_FORMAT_Y216:
-            break;
-        case DXGI_FORMAT_NV11:
-            break;
-        case DXGI_FORMAT_AI44:
-            break;
-        case DXGI_FORMAT_IA44:
-            break;
-        case DXGI_FORMAT_P8:
-            break;
-        case DXGI_FORMAT_A8P8:
-            break;
-        case DXGI_FORMAT_B4G4R4A4_UNORM:
-            break;
-        case DXGI_FORMAT_P208:
-            break;
-        case DXGI_FORMAT_V208:
-            break;
-        case DXGI_FORMAT_V408:
-            break;
-        case DXGI_FORMAT_FORCE_UINT:
-            break;
-        default:
-            break;
+            retval = hashCombine(retval, computeHash(vertex_descriptor));
         }
 
         return retval;
     }
 
+    static constexpr size_t computeByteSize(DXGI_FORMAT value_type)
+    {
+        return computeBytesPerElement(value_type);
+    }
+
     static constexpr size_t computeAttributeByteSize(D3D11_INPUT_ELEMENT_DESC attrib_desc)
     {
         return computeByteSize(attrib_desc.Format);
     }
 
+    /// A vertex buffer slot holds instance data if its attributes step per instance.
+    inline bool isPerInstance(VertexDescriptor const& vertex_descriptor)
+    {
+        for (auto const& attrib : vertex_descriptor.attributes)
+        {
+            if (attrib.InputSlotClass == D3D11_INPUT_PER_INSTANCE_DATA)
+                return true;
+        }
+        return false;
+    }
+
+    /// Instance data step rate of a vertex buffer slot, taken from its first per-instance attribute.
+    /// Per-vertex slots return 1.
+    inline UINT getInstanceDataStepRate(VertexDescriptor const& vertex_descriptor)
+    {
+        for (auto const& attrib : vertex_descriptor.attributes)
+        {
+            if (attrib.InputSlotClass == D3D11_INPUT_PER_INSTANCE_DATA)
+                return attrib.InstanceDataStepRate;
+        }
+        return 1;
+    }
+
+    /// Finds the first per-vertex attribute with the given semantic. On success, vertex_buffer_idx is the index of
+    /// the vertex descriptor that holds it and byte_offset its offset, with D3D11_APPEND_ALIGNED_ELEMENT resolved.
+    inline bool findVertexAttribute(
+        std::vector<VertexDescriptor> const& vertex_layout,
+        LPCSTR semantic_name,
+        UINT semantic_index,
+        size_t& vertex_buffer_idx,
+        D3D11_INPUT_ELEMENT_DESC& attrib_desc,
+        size_t& byte_offset)
+    {
+        for (size_t i = 0; i < vertex_layout.size(); ++i)
+        {
+            size_t offset = 0;
+            for (auto const& attrib : vertex_layout[i].attributes)
+            {
+                offset = attrib.AlignedByteOffset == D3D11_APPEND_ALIGNED_ELEMENT ? offset : attrib.AlignedByteOffset;
+
+                if (attrib.SemanticIndex == semantic_index && attrib.InputSlotClass == D3D11_INPUT_PER_VERTEX_DATA
+                    && compareSemanticNames(attrib.SemanticName, semantic_name))
+                {
+                    vertex_buffer_idx = i;
+                    attrib_desc = attrib;
+                    byte_offset = offset;
+                    return true;
+                }
+
+                offset += computeAttributeByteSize(attrib);
+            }
+        }
+        return false;
+    }
+
 } // namespace dxowl
 
 #endif // !VertexDescriptor_h
@@ -0,0 +1,736 @@
+/// <copyright file="VertexQuantizer.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef VertexQuantizer_hpp
+#define VertexQuantizer_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "FormatTraits.hpp"
+#include "ThreadPool.hpp"
+#include "VertexDescriptor.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define DXOWL_QUANTIZE_SSE
+#include <immintrin.h>
+#endif
+
+namespace dxowl
+{
+    /// Rewrites 32 bit float vertex attributes into compact encodings, selected by semantic name:
+    ///  POSITION float3          -> R16G16B16A16_SNORM, dequantize with position * scale + offset (w becomes 1)
+    ///  NORMAL, BINORMAL float3  -> R16G16_SNORM octahedral
+    ///  TANGENT float3           -> R16G16_SNORM octahedral
+    ///  TANGENT float4           -> R16G16B16A16_SNORM, octahedral xy and handedness in z
+    ///  TEXCOORD float2          -> R16G16_FLOAT, float3 and float4 to R16G16B16A16_FLOAT
+    ///  COLOR float3, float4     -> R8G8B8A8_UNORM
+    /// All other attributes are copied unchanged. Per-instance streams are not touched. The positions of a mesh share
+    /// one scale and offset so that adjacent submeshes stay watertight. Octahedral vectors decode with
+    /// n = float3(e.xy, 1 - abs(e.x) - abs(e.y)); if (n.z < 0) n.xy = (1 - abs(n.yx)) * sign(n.xy); normalize(n).
+    /// The returned layout keeps the semantic name pointers of the input layout.
+    class VertexQuantizer
+    {
+    public:
+        /// Constant buffer ready dequantization constants.
+        struct DequantizationConstants
+        {
+            float position_scale[4];
+            float position_offset[4];
+        };
+
+        struct Report
+        {
+            size_t bytes_per_vertex_before = 0;
+            size_t bytes_per_vertex_after = 0;
+            float max_position_error = 0.0f;     // absolute, in object space units
+            float max_normal_error_degrees = 0.0f;
+            float max_texcoord_error = 0.0f;     // absolute
+            float max_color_error = 0.0f;        // absolute, in [0,1]
+        };
+
+        class QuantizedMesh
+        {
+        public:
+            std::vector<VertexDescriptor> const& getVertexLayout() const;
+            std::vector<void const*> getVertexData() const;
+            std::vector<size_t> getVertexDataByteSizes() const;
+            size_t getVertexCount() const;
+
+            DequantizationConstants const& getDequantizationConstants() const;
+            Report const& getReport() const;
+
+        private:
+            friend class VertexQuantizer;
+
+            std::vector<VertexDescriptor> m_vertex_layout;
+            std::vector<std::vector<uint8_t>> m_vertex_data;
+            size_t m_vertex_count = 0;
+            DequantizationConstants m_constants = {};
+            Report m_report;
+        };
+
+        /// vertex_data holds one stream of vertex_count elements per vertex descriptor.
+        static QuantizedMesh quantize(
+            std::vector<VertexDescriptor> const& vertex_layout,
+            std::vector<void const*> const& vertex_data,
+            size_t vertex_count,
+            ThreadPool* thread_pool = nullptr);
+
+    private:
+        enum class Encoding
+        {
+            Copy,
+            Position,
+            Octahedral,
+            OctahedralSigned,
+            Half,
+            Color
+        };
+
+        struct AttributePlan
+        {
+            Encoding encoding;
+            size_t src_offset;
+            size_t dst_offset;
+            size_t src_byte_size;
+            UINT component_cnt; // float components read from the source
+        };
+
+        struct StreamPlan
+        {
+            bool per_instance;
+            size_t src_stride;
+            size_t dst_stride;
+            std::vector<AttributePlan> attributes;
+        };
+
+        struct ErrorBounds
+        {
+            float position = 0.0f;
+            float normal_cos = 1.0f; // smallest cosine between original and decoded direction
+            float texcoord = 0.0f;
+            float color = 0.0f;
+        };
+
+        static constexpr size_t vertices_per_task = 4096;
+
+        static StreamPlan planStream(VertexDescriptor const& src_descriptor, VertexDescriptor& dst_descriptor);
+
+        static void computePositionBounds(
+            std::vector<StreamPlan> const& plans,
+            std::vector<void const*> const& vertex_data,
+            size_t vertex_count,
+            DequantizationConstants& constants);
+
+        static void encodeRange(
+            StreamPlan const& plan,
+            uint8_t const* src,
+            uint8_t* dst,
+            size_t begin,
+            size_t end,
+            DequantizationConstants const& constants,
+            ErrorBounds& errors);
+
+        static void encodePositions(AttributePlan const& attrib, StreamPlan const& plan, uint8_t const* src, uint8_t* dst, size_t begin, size_t end, DequantizationConstants const& constants);
+        static void encodeOctahedral(AttributePlan const& attrib, StreamPlan const& plan, uint8_t const* src, uint8_t* dst, size_t begin, size_t end);
+        static void encodeHalf(AttributePlan const& attrib, StreamPlan const& plan, uint8_t const* src, uint8_t* dst, size_t begin, size_t end);
+        static void encodeColor(AttributePlan const& attrib, StreamPlan const& plan, uint8_t const* src, uint8_t* dst, size_t begin, size_t end);
+
+        static void measureErrors(AttributePlan const& attrib, StreamPlan const& plan, uint8_t const* src, uint8_t const* dst, size_t begin, size_t end, DequantizationConstants const& constants, ErrorBounds& errors);
+
+        /// Rounds to nearest even like _mm_cvtps_epi32, so scalar and SSE paths produce identical output.
+        static int16_t quantizeSnorm16(float value);
+        static int16_t quantizeScaledSnorm16(float scaled_value);
+        static void decodeOctahedral(int16_t const (&encoded)[2], float (&direction)[3]);
+    };
+
+    inline std::vector<VertexDescriptor> const& VertexQuantizer::QuantizedMesh::getVertexLayout() const
+    {
+        return m_vertex_layout;
+    }
+
+    inline std::vector<void const*> VertexQuantizer::QuantizedMesh::getVertexData() const
+    {
+        std::vector<void const*> retval;
+        retval.reserve(m_vertex_data.size());
+        for (auto const& stream : m_vertex_data)
+        {
+            retval.push_back(stream.data());
+        }
+        return retval;
+    }
+
+    inline std::vector<size_t> VertexQuantizer::QuantizedMesh::getVertexDataByteSizes() const
+    {
+        std::vector<size_t> retval;
+        retval.reserve(m_vertex_data.size());
+        for (auto const& stream : m_vertex_data)
+        {
+            retval.push_back(stream.size());
+        }
+        return retval;
+    }
+
+    inline size_t VertexQuantizer::QuantizedMesh::getVertexCount() const
+    {
+        return m_vertex_count;
+    }
+
+    inline VertexQuantizer::DequantizationConstants const& VertexQuantizer::QuantizedMesh::getDequantizationConstants() const
+    {
+        return m_constants;
+    }
+
+    inline VertexQuantizer::Report const& VertexQuantizer::QuantizedMesh::getReport() const
+    {
+        return m_report;
+    }
+
+    inline VertexQuantizer::QuantizedMesh VertexQuantizer::quantize(
+        std::vector<VertexDescriptor> const& vertex_layout,
+        std::vector<void const*> const& vertex_data,
+        size_t vertex_count,
+        ThreadPool* thread_pool)
+    {
+        if (vertex_data.size() != vertex_layout.size())
+        {
+            throw std::invalid_argument("VertexQuantizer: one vertex stream per vertex descriptor required");
+        }
+
+        QuantizedMesh retval;
+        retval.m_vertex_count = vertex_count;
+        retval.m_vertex_layout.resize(vertex_layout.size());
+
+        std::vector<StreamPlan> plans;
+        for (size_t s = 0; s < vertex_layout.size(); ++s)
+        {
+            plans.push_back(planStream(vertex_layout[s], retval.m_vertex_layout[s]));
+            if (!plans.back().per_instance)
+            {
+                retval.m_report.bytes_per_vertex_before += plans.back().src_stride;
+                retval.m_report.bytes_per_vertex_after += plans.back().dst_stride;
+            }
+        }
+
+        computePositionBounds(plans, vertex_data, vertex_count, retval.m_constants);
+
+        size_t const task_cnt = (vertex_count + vertices_per_task - 1) / vertices_per_task;
+        std::vector<ErrorBounds> task_errors(task_cnt * plans.size());
+
+        retval.m_vertex_data.resize(plans.size());
+        for (size_t s = 0; s < plans.size(); ++s)
+        {
+            if (plans[s].per_instance)
+            {
+                auto src = static_cast<uint8_t const*>(vertex_data[s]);
+                retval.m_vertex_data[s].assign(src, src + vertex_count * plans[s].src_stride);
+            }
+            else
+            {
+                retval.m_vertex_data[s].assign(vertex_count * plans[s].dst_stride, 0);
+            }
+        }
+
+        auto encodeTask = [&](size_t task_idx) {
+            size_t const begin = task_idx * vertices_per_task;
+            size_t const end = (std::min)(begin + vertices_per_task, vertex_count);
+            for (size_t s = 0; s < plans.size(); ++s)
+            {
+                if (!plans[s].per_instance)
+                {
+                    encodeRange(plans[s], static_cast<uint8_t const*>(vertex_data[s]), retval.m_vertex_data[s].data(), begin, end,
+                        retval.m_constants, task_errors[task_idx * plans.size() + s]);
+                }
+            }
+        };
+
+        if (thread_pool != nullptr)
+        {
+            thread_pool->parallelFor(0, task_cnt, encodeTask);
+        }
+        else
+        {
+            for (size_t task_idx = 0; task_idx < task_cnt; ++task_idx)
+            {
+                encodeTask(task_idx);
+            }
+        }
+
+        float normal_cos = 1.0f;
+        for (ErrorBounds const& errors : task_errors)
+        {
+            retval.m_report.max_position_error = (std::max)(retval.m_report.max_position_error, errors.position);
+            retval.m_report.max_texcoord_error = (std::max)(retval.m_report.max_texcoord_error, errors.texcoord);
+            retval.m_report.max_color_error = (std::max)(retval.m_report.max_color_error, errors.color);
+            normal_cos = (std::min)(normal_cos, errors.normal_cos);
+        }
+        retval.m_report.max_normal_error_degrees = std::acos((std::max)(-1.0f, (std::min)(1.0f, normal_cos))) * (180.0f / 3.14159265f);
+
+        return retval;
+    }
+
+    inline VertexQuantizer::StreamPlan VertexQuantizer::planStream(VertexDescriptor const& src_descriptor, VertexDescriptor& dst_descriptor)
+    {
+        StreamPlan plan;
+        plan.src_stride = src_descriptor.stride;
+        plan.per_instance = isPerInstance(src_descriptor);
+
+        if (plan.per_instance)
+        {
+            plan.dst_stride = plan.src_stride;
+            dst_descriptor = src_descriptor;
+            return plan;
+        }
+
+        dst_descriptor.attributes.clear();
+
+        size_t src_offset = 0;
+        size_t dst_offset = 0;
+        for (auto const& attrib : src_descriptor.attributes)
+        {
+            src_offset = attrib.AlignedByteOffset == D3D11_APPEND_ALIGNED_ELEMENT ? src_offset : attrib.AlignedByteOffset;
+
+            AttributePlan attrib_plan = { Encoding::Copy, src_offset, 0, computeByteSize(attrib.Format), 0 };
+            DXGI_FORMAT dst_format = attrib.Format;
+
+            bool const float3 = attrib.Format == DXGI_FORMAT_R32G32B32_FLOAT;
+            bool const float4 = attrib.Format == DXGI_FORMAT_R32G32B32A32_FLOAT;
+            bool const float2 = attrib.Format == DXGI_FORMAT_R32G32_FLOAT;
+            LPCSTR name = attrib.SemanticName;
+
+            if (float3 && compareSemanticNames(name, "POSITION"))
+            {
+                attrib_plan.encoding = Encoding::Position;
+                dst_format = DXGI_FORMAT_R16G16B16A16_SNORM;
+            }
+            else if (float3 && (compareSemanticNames(name, "NORMAL") || compareSemanticNames(name, "TANGENT") || compareSemanticNames(name, "BINORMAL")))
+            {
+                attrib_plan.encoding = Encoding::Octahedral;
+                dst_format = DXGI_FORMAT_R16G16_SNORM;
+            }
+            else if (float4 && compareSemanticNames(name, "TANGENT"))
+            {
+                attrib_plan.encoding = Encoding::OctahedralSigned;
+                dst_format = DXGI_FORMAT_R16G16B16A16_SNORM;
+            }
+            else if ((float2 || float3 || float4) && compareSemanticNames(name, "TEXCOORD"))
+            {
+                attrib_plan.encoding = Encoding::Half;
+                dst_format = float2 ? DXGI_FORMAT_R16G16_FLOAT : DXGI_FORMAT_R16G16B16A16_FLOAT;
+            }
+            else if ((float3 || float4) && compareSemanticNames(name, "COLOR"))
+            {
+                attrib_plan.encoding = Encoding::Color;
+                dst_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            }
+            attrib_plan.component_cnt = float2 ? 2 : (float3 ? 3 : 4);
+
+            // keep every element 4 byte aligned
+            dst_offset = (dst_offset + 3) & ~size_t(3);
+            attrib_plan.dst_offset = dst_offset;
+
+            D3D11_INPUT_ELEMENT_DESC dst_attrib = attrib;
+            dst_attrib.Format = dst_format;
+            dst_attrib.AlignedByteOffset = static_cast<UINT>(dst_offset);
+            dst_descriptor.attributes.push_back(dst_attrib);
+
+            plan.attributes.push_back(attrib_plan);
+            src_offset += attrib_plan.src_byte_size;
+            dst_offset += computeByteSize(dst_format);
+        }
+
+        plan.dst_stride = (dst_offset + 3) & ~size_t(3);
+        dst_descriptor.stride = plan.dst_stride;
+        return plan;
+    }
+
+    inline void VertexQuantizer::computePositionBounds(
+        std::vector<StreamPlan> const& plans,
+        std::vector<void const*> const& vertex_data,
+        size_t vertex_count,
+        DequantizationConstants& constants)
+    {
+        float bounds_min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float bounds_max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        for (size_t s = 0; s < plans.size(); ++s)
+        {
+            for (AttributePlan const& attrib : plans[s].attributes)
+            {
+                if (attrib.encoding != Encoding::Position)
+                {
+                    continue;
+                }
+                auto src = static_cast<uint8_t const*>(vertex_data[s]) + attrib.src_offset;
+                for (size_t v = 0; v < vertex_count; ++v)
+                {
+                    float p[3];
+                    std::memcpy(p, src + v * plans[s].src_stride, sizeof(p));
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        bounds_min[k] = (std::min)(bounds_min[k], p[k]);
+                        bounds_max[k] = (std::max)(bounds_max[k], p[k]);
+                    }
+                }
+            }
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            bool const empty = bounds_min[k] > bounds_max[k];
+            float const half_extent = empty ? 0.0f : 0.5f * (bounds_max[k] - bounds_min[k]);
+            constants.position_offset[k] = empty ? 0.0f : 0.5f * (bounds_max[k] + bounds_min[k]);
+            constants.position_scale[k] = half_extent > 0.0f ? half_extent : 1.0f;
+        }
+        constants.position_scale[3] = 0.0f;
+        constants.position_offset[3] = 1.0f;
+    }
+
+    inline void VertexQuantizer::encodeRange(
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t* dst,
+        size_t begin,
+        size_t end,
+        DequantizationConstants const& constants,
+        ErrorBounds& errors)
+    {
+        for (AttributePlan const& attrib : plan.attributes)
+        {
+            switch (attrib.encoding)
+            {
+            case Encoding::Copy:
+                for (size_t v = begin; v < end; ++v)
+                {
+                    std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, src + v * plan.src_stride + attrib.src_offset, attrib.src_byte_size);
+                }
+                break;
+            case Encoding::Position:
+                encodePositions(attrib, plan, src, dst, begin, end, constants);
+                break;
+            case Encoding::Octahedral:
+            case Encoding::OctahedralSigned:
+                encodeOctahedral(attrib, plan, src, dst, begin, end);
+                break;
+            case Encoding::Half:
+                encodeHalf(attrib, plan, src, dst, begin, end);
+                break;
+            case Encoding::Color:
+                encodeColor(attrib, plan, src, dst, begin, end);
+                break;
+            }
+
+            measureErrors(attrib, plan, src, dst, begin, end, constants, errors);
+        }
+    }
+
+    inline void VertexQuantizer::encodePositions(
+        AttributePlan const& attrib,
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t* dst,
+        size_t begin,
+        size_t end,
+        DequantizationConstants const& constants)
+    {
+        float inv_scale[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            inv_scale[k] = 32767.0f / constants.position_scale[k];
+        }
+
+#ifdef DXOWL_QUANTIZE_SSE
+        __m128 const offset4 = _mm_setr_ps(constants.position_offset[0], constants.position_offset[1], constants.position_offset[2], 0.0f);
+        __m128 const inv_scale4 = _mm_setr_ps(inv_scale[0], inv_scale[1], inv_scale[2], 0.0f);
+        for (size_t v = begin; v < end; ++v)
+        {
+            float p[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            std::memcpy(p, src + v * plan.src_stride + attrib.src_offset, 3 * sizeof(float));
+
+            // clamp to [-32767, 32767], round to nearest even
+            __m128 scaled = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p), offset4), inv_scale4);
+            scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(-32767.0f)), _mm_set1_ps(32767.0f));
+            __m128i q = _mm_cvtps_epi32(scaled);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + v * plan.dst_stride + attrib.dst_offset), _mm_packs_epi32(q, q));
+        }
+#else
+        for (size_t v = begin; v < end; ++v)
+        {
+            float p[3];
+            std::memcpy(p, src + v * plan.src_stride + attrib.src_offset, sizeof(p));
+
+            int16_t q[4] = { 0, 0, 0, 0 };
+            for (int k = 0; k < 3; ++k)
+            {
+                q[k] = quantizeScaledSnorm16((p[k] - constants.position_offset[k]) * inv_scale[k]);
+            }
+            std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, q, sizeof(q));
+        }
+#endif
+    }
+
+    inline void VertexQuantizer::encodeOctahedral(
+        AttributePlan const& attrib,
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t* dst,
+        size_t begin,
+        size_t end)
+    {
+        bool const with_sign = attrib.encoding == Encoding::OctahedralSigned;
+        size_t v = begin;
+
+#ifdef DXOWL_QUANTIZE_SSE
+        // four vectors per iteration in structure of arrays layout
+        __m128 const zero = _mm_setzero_ps();
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const sign_mask = _mm_set1_ps(-0.0f);
+        __m128 const snorm_scale = _mm_set1_ps(32767.0f);
+
+        for (; v + 4 <= end; v += 4)
+        {
+            float x[4], y[4], z[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                float n[3];
+                std::memcpy(n, src + (v + i) * plan.src_stride + attrib.src_offset, sizeof(n));
+                x[i] = n[0];
+                y[i] = n[1];
+                z[i] = n[2];
+            }
+
+            __m128 nx = _mm_loadu_ps(x);
+            __m128 ny = _mm_loadu_ps(y);
+            __m128 nz = _mm_loadu_ps(z);
+
+            __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_mask, nx), _mm_andnot_ps(sign_mask, ny)), _mm_andnot_ps(sign_mask, nz));
+            __m128 inv_l1 = _mm_div_ps(one, _mm_max_ps(l1, _mm_set1_ps(FLT_MIN)));
+            nx = _mm_mul_ps(nx, inv_l1);
+            ny = _mm_mul_ps(ny, inv_l1);
+
+            // fold the lower hemisphere over the diagonals
+            __m128 lower = _mm_cmplt_ps(nz, zero);
+            __m128 fold_x = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, ny)), _mm_and_ps(sign_mask, nx));
+            __m128 fold_y = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, nx)), _mm_and_ps(sign_mask, ny));
+            nx = _mm_or_ps(_mm_and_ps(lower, fold_x), _mm_andnot_ps(lower, nx));
+            ny = _mm_or_ps(_mm_and_ps(lower, fold_y), _mm_andnot_ps(lower, ny));
+
+            __m128i qx = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(nx, _mm_set1_ps(-1.0f)), one), snorm_scale));
+            __m128i qy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ny, _mm_set1_ps(-1.0f)), one), snorm_scale));
+
+            // interleave to x0 y0 x1 y1 ...
+            __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(qx, qy), _mm_unpackhi_epi32(qx, qy));
+            alignas(16) int16_t encoded[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(encoded), packed);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                uint8_t* out = dst + (v + i) * plan.dst_stride + attrib.dst_offset;
+                std::memcpy(out, encoded + 2 * i, 2 * sizeof(int16_t));
+                if (with_sign)
+                {
+                    float w;
+                    std::memcpy(&w, src + (v + i) * plan.src_stride + attrib.src_offset + 3 * sizeof(float), sizeof(w));
+                    int16_t const handedness[2] = { static_cast<int16_t>(w < 0.0f ? -32767 : 32767), 0 };
+                    std::memcpy(out + 2 * sizeof(int16_t), handedness, sizeof(handedness));
+                }
+            }
+        }
+#endif
+
+        for (; v < end; ++v)
+        {
+            float n[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            std::memcpy(n, src + v * plan.src_stride + attrib.src_offset, (with_sign ? 4 : 3) * sizeof(float));
+
+            // same operations as the SSE path: reciprocal of the L1 norm, fold keeps the sign bit including -0
+            float inv_l1 = 1.0f / (std::max)(std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]), FLT_MIN);
+            float ex = n[0] * inv_l1;
+            float ey = n[1] * inv_l1;
+            if (n[2] < 0.0f)
+            {
+                float fx = std::copysign(1.0f - std::fabs(ey), ex);
+                float fy = std::copysign(1.0f - std::fabs(ex), ey);
+                ex = fx;
+                ey = fy;
+            }
+
+            int16_t encoded[4] = { quantizeSnorm16(ex), quantizeSnorm16(ey), static_cast<int16_t>(n[3] < 0.0f ? -32767 : 32767), 0 };
+            std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, encoded, (with_sign ? 4 : 2) * sizeof(int16_t));
+        }
+    }
+
+    inline void VertexQuantizer::encodeHalf(
+        AttributePlan const& attrib,
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t* dst,
+        size_t begin,
+        size_t end)
+    {
+        UINT const dst_component_cnt = attrib.component_cnt == 2 ? 2 : 4;
+
+        for (size_t v = begin; v < end; ++v)
+        {
+            float values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            std::memcpy(values, src + v * plan.src_stride + attrib.src_offset, attrib.component_cnt * sizeof(float));
+
+            uint16_t encoded[4];
+#if defined(__F16C__)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(encoded), _mm_cvtps_ph(_mm_loadu_ps(values), _MM_FROUND_TO_NEAREST_INT));
+#else
+            for (UINT c = 0; c < 4; ++c)
+            {
+                encoded[c] = floatToHalf(values[c]);
+            }
+#endif
+            std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, encoded, dst_component_cnt * sizeof(uint16_t));
+        }
+    }
+
+    inline void VertexQuantizer::encodeColor(
+        AttributePlan const& attrib,
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t* dst,
+        size_t begin,
+        size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            float color[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            std::memcpy(color, src + v * plan.src_stride + attrib.src_offset, attrib.component_cnt * sizeof(float));
+
+#ifdef DXOWL_QUANTIZE_SSE
+            __m128 c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(color), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            __m128i q = _mm_cvtps_epi32(_mm_mul_ps(c, _mm_set1_ps(255.0f)));
+            q = _mm_packus_epi16(_mm_packs_epi32(q, q), _mm_setzero_si128());
+            uint32_t encoded = static_cast<uint32_t>(_mm_cvtsi128_si32(q));
+            std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, &encoded, sizeof(encoded));
+#else
+            uint8_t encoded[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                encoded[k] = static_cast<uint8_t>(std::nearbyint((std::min)((std::max)(color[k], 0.0f), 1.0f) * 255.0f));
+            }
+            std::memcpy(dst + v * plan.dst_stride + attrib.dst_offset, encoded, sizeof(encoded));
+#endif
+        }
+    }
+
+    inline void VertexQuantizer::measureErrors(
+        AttributePlan const& attrib,
+        StreamPlan const& plan,
+        uint8_t const* src,
+        uint8_t const* dst,
+        size_t begin,
+        size_t end,
+        DequantizationConstants const& constants,
+        ErrorBounds& errors)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            uint8_t const* in = src + v * plan.src_stride + attrib.src_offset;
+            uint8_t const* out = dst + v * plan.dst_stride + attrib.dst_offset;
+
+            float original[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            if (attrib.encoding != Encoding::Copy)
+            {
+                std::memcpy(original, in, attrib.component_cnt * sizeof(float));
+            }
+
+            switch (attrib.encoding)
+            {
+            case Encoding::Position:
+            {
+                int16_t q[3];
+                std::memcpy(q, out, sizeof(q));
+                for (int k = 0; k < 3; ++k)
+                {
+                    float decoded = (std::max)(q[k] / 32767.0f, -1.0f) * constants.position_scale[k] + constants.position_offset[k];
+                    errors.position = (std::max)(errors.position, std::fabs(decoded - original[k]));
+                }
+                break;
+            }
+            case Encoding::Octahedral:
+            case Encoding::OctahedralSigned:
+            {
+                int16_t q[2];
+                std::memcpy(q, out, sizeof(q));
+                float decoded[3];
+                decodeOctahedral(q, decoded);
+
+                float length = std::sqrt(original[0] * original[0] + original[1] * original[1] + original[2] * original[2]);
+                if (length > 0.0f)
+                {
+                    float cos_angle = (decoded[0] * original[0] + decoded[1] * original[1] + decoded[2] * original[2]) / length;
+                    errors.normal_cos = (std::min)(errors.normal_cos, cos_angle);
+                }
+                break;
+            }
+            case Encoding::Half:
+            {
+                uint16_t q[4];
+                std::memcpy(q, out, attrib.component_cnt * sizeof(uint16_t));
+                for (UINT k = 0; k < attrib.component_cnt; ++k)
+                {
+                    errors.texcoord = (std::max)(errors.texcoord, std::fabs(halfToFloat(q[k]) - original[k]));
+                }
+                break;
+            }
+            case Encoding::Color:
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    float clamped = (std::min)((std::max)(original[k], 0.0f), 1.0f);
+                    errors.color = (std::max)(errors.color, std::fabs(out[k] / 255.0f - clamped));
+                }
+                break;
+            }
+            case Encoding::Copy:
+                break;
+            }
+        }
+    }
+
+    inline int16_t VertexQuantizer::quantizeSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::nearbyint((std::min)((std::max)(value, -1.0f), 1.0f) * 32767.0f));
+    }
+
+    inline int16_t VertexQuantizer::quantizeScaledSnorm16(float scaled_value)
+    {
+        return static_cast<int16_t>(std::nearbyint((std::min)((std::max)(scaled_value, -32767.0f), 32767.0f)));
+    }
+
+    inline void VertexQuantizer::decodeOctahedral(int16_t const (&encoded)[2], float (&direction)[3])
+    {
+        float x = (std::max)(encoded[0] / 32767.0f, -1.0f);
+        float y = (std::max)(encoded[1] / 32767.0f, -1.0f);
+        float z = 1.0f - std::fabs(x) - std::fabs(y);
+        if (z < 0.0f)
+        {
+            float fx = (1.0f - std::fabs(y)) * (x < 0.0f ? -1.0f : 1.0f);
+            float fy = (1.0f - std::fabs(x)) * (y < 0.0f ? -1.0f : 1.0f);
+            x = fx;
+            y = fy;
+        }
+        float length = std::sqrt(x * x + y * y + z * z);
+        direction[0] = x / length;
+        direction[1] = y / length;
+        direction[2] = z / length;
+    }
+
+} // namespace dxowl
+
+#endif // !VertexQuantizer_hpp
@@ -0,0 +1,412 @@
+/// <copyright file="VolumeStreamer.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef VolumeStreamer_hpp
+#define VolumeStreamer_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FormatTraits.hpp"
+#include "MappedFile.hpp"
+#include "Texture3D.hpp"
+#include "ThreadPool.hpp"
+
+namespace dxowl
+{
+    /// Streams mip level 0 of a Texture3D brick by brick from a memory-mapped raw volume file
+    /// (texels of the texture format, x fastest, then y, then z, optionally after a header).
+    /// Requested bricks are uploaded in request order by update() until the per-frame byte budget is spent.
+    /// Brick texels are gathered from the mapping on worker threads, so page faults of the file do not
+    /// stall the render thread inside UpdateSubresource. Not thread-safe, call from the render thread.
+    class VolumeStreamer
+    {
+    public:
+        enum class BrickState : uint8_t
+        {
+            NotResident,
+            Queued,
+            Resident
+        };
+
+        struct FrameStatistics
+        {
+            uint64_t frame = 0;
+            size_t bytes_uploaded = 0;
+            size_t bricks_uploaded = 0;
+            size_t bricks_queued = 0;
+        };
+
+        VolumeStreamer(
+            Texture3D& texture,
+            std::string const& path,
+            UINT brick_size,
+            size_t header_byte_size = 0,
+            ThreadPool* thread_pool = nullptr);
+        ~VolumeStreamer() = default;
+
+        VolumeStreamer(const VolumeStreamer& cpy) = delete;
+        VolumeStreamer(VolumeStreamer&& other) = delete;
+        VolumeStreamer& operator=(VolumeStreamer&& rhs) = delete;
+        VolumeStreamer& operator=(const VolumeStreamer& rhs) = delete;
+
+        void beginFrame(uint64_t frame);
+        void endFrame();
+
+        /// Queues a brick for upload, resident and already queued bricks are ignored.
+        void request(size_t brick_idx);
+
+        /// Queues all bricks that intersect a box of texels, in z, y, x order.
+        void request(D3D11_BOX const& box);
+
+        void requestAll();
+
+        /// Marks a brick as not resident, e.g. to re-upload it after the texture content was overwritten.
+        void evict(size_t brick_idx);
+
+        /// Uploads queued bricks until byte_budget is spent. At least one brick is uploaded per call
+        /// if any is queued, so bricks larger than the budget still make progress. Returns the number of uploaded bricks.
+        size_t update(ID3D11DeviceContext4* d3d11_ctx, size_t byte_budget);
+
+        size_t getBrickCount() const;
+        UINT getBrickCountX() const;
+        UINT getBrickCountY() const;
+        UINT getBrickCountZ() const;
+        size_t getBrickIndex(UINT brick_x, UINT brick_y, UINT brick_z) const;
+
+        /// Texel box covered by a brick, bricks at the upper volume borders may be smaller than brick_size.
+        D3D11_BOX getBrickBox(size_t brick_idx) const;
+
+        BrickState getBrickState(size_t brick_idx) const;
+        bool isResident(size_t brick_idx) const;
+        size_t getResidentCount() const;
+        size_t getQueuedCount() const;
+
+        FrameStatistics getCurrentFrameStatistics() const;
+        FrameStatistics getLastFrameStatistics() const;
+
+    private:
+        size_t computeBrickByteSize(D3D11_BOX const& box) const;
+
+        Texture3D& m_texture;
+        MappedFile m_file;
+        uint8_t const* m_texels;
+        ThreadPool* m_thread_pool;
+
+        D3D11_TEXTURE3D_DESC m_desc;
+        size_t m_bytes_per_texel;
+        UINT m_brick_size;
+        UINT m_brick_cnt_x;
+        UINT m_brick_cnt_y;
+        UINT m_brick_cnt_z;
+
+        std::vector<BrickState> m_brick_states;
+        std::deque<size_t> m_queue;
+        size_t m_resident_cnt;
+        size_t m_queued_cnt;
+
+        // tightly packed texels of the bricks uploaded in one update() call
+        std::vector<uint8_t> m_staging;
+
+        FrameStatistics m_current_stats;
+        FrameStatistics m_last_stats;
+    };
+
+    inline VolumeStreamer::VolumeStreamer(
+        Texture3D& texture,
+        std::string const& path,
+        UINT brick_size,
+        size_t header_byte_size,
+        ThreadPool* thread_pool)
+        : m_texture(texture),
+          m_file(path),
+          m_texels(nullptr),
+          m_thread_pool(thread_pool),
+          m_desc(texture.getTextureDesc()),
+          m_bytes_per_texel(computeBytesPerElement(m_desc.Format)),
+          m_brick_size(brick_size),
+          m_resident_cnt(0),
+          m_queued_cnt(0)
+    {
+        if (m_bytes_per_texel == 0)
+        {
+            throw std::invalid_argument("VolumeStreamer: texture format must not be block compressed or planar");
+        }
+        if (brick_size == 0)
+        {
+            throw std::invalid_argument("VolumeStreamer: brick size must not be 0");
+        }
+
+        size_t const volume_byte_size = size_t(m_desc.Width) * m_desc.Height * m_desc.Depth * m_bytes_per_texel;
+        if (m_file.size() < header_byte_size + volume_byte_size)
+        {
+            throw std::runtime_error("VolumeStreamer: file smaller than the texture volume " + path);
+        }
+
+        m_texels = static_cast<uint8_t const*>(m_file.data()) + header_byte_size;
+
+        m_brick_cnt_x = (m_desc.Width + brick_size - 1) / brick_size;
+        m_brick_cnt_y = (m_desc.Height + brick_size - 1) / brick_size;
+        m_brick_cnt_z = (m_desc.Depth + brick_size - 1) / brick_size;
+        m_brick_states.assign(size_t(m_brick_cnt_x) * m_brick_cnt_y * m_brick_cnt_z, BrickState::NotResident);
+    }
+
+    inline void VolumeStreamer::beginFrame(uint64_t frame)
+    {
+        m_current_stats = FrameStatistics();
+        m_current_stats.frame = frame;
+    }
+
+    inline void VolumeStreamer::endFrame()
+    {
+        m_current_stats.bricks_queued = m_queued_cnt;
+        m_last_stats = m_current_stats;
+    }
+
+    inline void VolumeStreamer::request(size_t brick_idx)
+    {
+        if (m_brick_states[brick_idx] != BrickState::NotResident)
+        {
+            return;
+        }
+
+        m_brick_states[brick_idx] = BrickState::Queued;
+        m_queue.push_back(brick_idx);
+        ++m_queued_cnt;
+    }
+
+    inline void VolumeStreamer::request(D3D11_BOX const& box)
+    {
+        UINT const right = (std::min)(box.right, m_desc.Width);
+        UINT const bottom = (std::min)(box.bottom, m_desc.Height);
+        UINT const back = (std::min)(box.back, m_desc.Depth);
+
+        if (box.left >= right || box.top >= bottom || box.front >= back)
+        {
+            return;
+        }
+
+        for (UINT z = box.front / m_brick_size; z <= (back - 1) / m_brick_size; ++z)
+        {
+            for (UINT y = box.top / m_brick_size; y <= (bottom - 1) / m_brick_size; ++y)
+            {
+                for (UINT x = box.left / m_brick_size; x <= (right - 1) / m_brick_size; ++x)
+                {
+                    request(getBrickIndex(x, y, z));
+                }
+            }
+        }
+    }
+
+    inline void VolumeStreamer::requestAll()
+    {
+        for (size_t brick_idx = 0; brick_idx < m_brick_states.size(); ++brick_idx)
+        {
+            request(brick_idx);
+        }
+    }
+
+    inline void VolumeStreamer::evict(size_t brick_idx)
+    {
+        // queued bricks stay in the queue and are skipped by update()
+        if (m_brick_states[brick_idx] == BrickState::Resident)
+        {
+            --m_resident_cnt;
+        }
+        else if (m_brick_states[brick_idx] == BrickState::Queued)
+        {
+            --m_queued_cnt;
+        }
+
+        m_brick_states[brick_idx] = BrickState::NotResident;
+    }
+
+    inline size_t VolumeStreamer::update(ID3D11DeviceContext4* d3d11_ctx, size_t byte_budget)
+    {
+        // pick the bricks of this call and their offsets in the staging buffer
+        std::vector<size_t> bricks;
+        std::vector<size_t> staging_offsets;
+        size_t staging_size = 0;
+
+        while (!m_queue.empty())
+        {
+            size_t const brick_idx = m_queue.front();
+
+            if (m_brick_states[brick_idx] != BrickState::Queued)
+            {
+                m_queue.pop_front(); // evicted while queued
+                continue;
+            }
+
+            size_t const byte_size = computeBrickByteSize(getBrickBox(brick_idx));
+            if (!bricks.empty() && staging_size + byte_size > byte_budget)
+            {
+                break;
+            }
+
+            // marked right away, so a brick that was evicted and requested again is not picked twice
+            m_queue.pop_front();
+            m_brick_states[brick_idx] = BrickState::Resident;
+            bricks.push_back(brick_idx);
+            staging_offsets.push_back(staging_size);
+            staging_size += byte_size;
+        }
+
+        if (bricks.empty())
+        {
+            return 0;
+        }
+
+        if (m_staging.size() < staging_size)
+        {
+            m_staging.resize(staging_size);
+        }
+
+        // gather one z slab of one brick per task
+        std::vector<std::pair<size_t, UINT>> slabs;
+        for (size_t i = 0; i < bricks.size(); ++i)
+        {
+            D3D11_BOX const box = getBrickBox(bricks[i]);
+            for (UINT z = box.front; z < box.back; ++z)
+            {
+                slabs.emplace_back(i, z);
+            }
+        }
+
+        size_t const src_row_pitch = size_t(m_desc.Width) * m_bytes_per_texel;
+        size_t const src_slice_pitch = src_row_pitch * m_desc.Height;
+
+        auto gatherSlab = [&](size_t slab_idx) {
+            size_t const i = slabs[slab_idx].first;
+            UINT const z = slabs[slab_idx].second;
+            D3D11_BOX const box = getBrickBox(bricks[i]);
+
+            size_t const row_byte_size = size_t(box.right - box.left) * m_bytes_per_texel;
+            size_t const slab_byte_size = row_byte_size * (box.bottom - box.top);
+
+            uint8_t* dst = m_staging.data() + staging_offsets[i] + slab_byte_size * (z - box.front);
+            uint8_t const* src = m_texels + src_slice_pitch * z + src_row_pitch * box.top + m_bytes_per_texel * box.left;
+
+            for (UINT y = box.top; y < box.bottom; ++y)
+            {
+                std::memcpy(dst, src, row_byte_size);
+                dst += row_byte_size;
+                src += src_row_pitch;
+            }
+        };
+
+        if (m_thread_pool != nullptr)
+        {
+            m_thread_pool->parallelFor(0, slabs.size(), gatherSlab);
+        }
+        else
+        {
+            for (size_t slab_idx = 0; slab_idx < slabs.size(); ++slab_idx)
+            {
+                gatherSlab(slab_idx);
+            }
+        }
+
+        for (size_t i = 0; i < bricks.size(); ++i)
+        {
+            m_texture.updateSubresource(d3d11_ctx, 0, getBrickBox(bricks[i]), m_staging.data() + staging_offsets[i]);
+        }
+
+        m_resident_cnt += bricks.size();
+        m_queued_cnt -= bricks.size();
+
+        m_current_stats.bytes_uploaded += staging_size;
+        m_current_stats.bricks_uploaded += bricks.size();
+
+        return bricks.size();
+    }
+
+    inline size_t VolumeStreamer::getBrickCount() const
+    {
+        return m_brick_states.size();
+    }
+
+    inline UINT VolumeStreamer::getBrickCountX() const
+    {
+        return m_brick_cnt_x;
+    }
+
+    inline UINT VolumeStreamer::getBrickCountY() const
+    {
+        return m_brick_cnt_y;
+    }
+
+    inline UINT VolumeStreamer::getBrickCountZ() const
+    {
+        return m_brick_cnt_z;
+    }
+
+    inline size_t VolumeStreamer::getBrickIndex(UINT brick_x, UINT brick_y, UINT brick_z) const
+    {
+        return (size_t(brick_z) * m_brick_cnt_y + brick_y) * m_brick_cnt_x + brick_x;
+    }
+
+    inline D3D11_BOX VolumeStreamer::getBrickBox(size_t brick_idx) const
+    {
+        UINT const x = static_cast<UINT>(brick_idx % m_brick_cnt_x);
+        UINT const y = static_cast<UINT>((brick_idx / m_brick_cnt_x) % m_brick_cnt_y);
+        UINT const z = static_cast<UINT>(brick_idx / (size_t(m_brick_cnt_x) * m_brick_cnt_y));
+
+        D3D11_BOX box;
+        box.left = x * m_brick_size;
+        box.top = y * m_brick_size;
+        box.front = z * m_brick_size;
+        box.right = (std::min)(box.left + m_brick_size, m_desc.Width);
+        box.bottom = (std::min)(box.top + m_brick_size, m_desc.Height);
+        box.back = (std::min)(box.front + m_brick_size, m_desc.Depth);
+        return box;
+    }
+
+    inline VolumeStreamer::BrickState VolumeStreamer::getBrickState(size_t brick_idx) const
+    {
+        return m_brick_states[brick_idx];
+    }
+
+    inline bool VolumeStreamer::isResident(size_t brick_idx) const
+    {
+        return m_brick_states[brick_idx] == BrickState::Resident;
+    }
+
+    inline size_t VolumeStreamer::getResidentCount() const
+    {
+        return m_resident_cnt;
+    }
+
+    inline size_t VolumeStreamer::getQueuedCount() const
+    {
+        return m_queued_cnt;
+    }
+
+    inline VolumeStreamer::FrameStatistics VolumeStreamer::getCurrentFrameStatistics() const
+    {
+        return m_current_stats;
+    }
+
+    inline VolumeStreamer::FrameStatistics VolumeStreamer::getLastFrameStatistics() const
+    {
+        return m_last_stats;
+    }
+
+    inline size_t VolumeStreamer::computeBrickByteSize(D3D11_BOX const& box) const
+    {
+        return size_t(box.right - box.left) * (box.bottom - box.top) * (box.back - box.front) * m_bytes_per_texel;
+    }
+
+} // namespace dxowl
+
+#endif // !VolumeStreamer_hpp
@@ -0,0 +1,291 @@
+/// <copyright file="BcDecoder.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef BcDecoder_hpp
+#define BcDecoder_hpp
+
+#include <d3d11_4.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <dxowl/BlockCompressor.hpp>
+#include <dxowl/FormatTraits.hpp>
+
+namespace dxowl_test
+{
+    /// Reference decoder for the block compressed formats written by BlockCompressor, used to check and
+    /// measure its output. BC7 covers modes 1 and 6, the only modes the encoder emits.
+    class BcDecoder
+    {
+    public:
+        typedef std::array<std::array<uint8_t, 4>, 16> Texels; // RGBA, row major
+
+        /// Returns false for blocks the decoder does not handle.
+        static bool decodeBlock(DXGI_FORMAT format, uint8_t const* block, Texels& texels)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_BC1_UNORM:
+            case DXGI_FORMAT_BC1_UNORM_SRGB:
+                decodeColor(block, true, texels);
+                return true;
+            case DXGI_FORMAT_BC3_UNORM:
+            case DXGI_FORMAT_BC3_UNORM_SRGB:
+                decodeColor(block + 8, false, texels);
+                decodeBc4(block, 3, texels);
+                return true;
+            case DXGI_FORMAT_BC4_UNORM:
+                texels = {};
+                decodeBc4(block, 0, texels);
+                setChannel(texels, 3, 255);
+                return true;
+            case DXGI_FORMAT_BC5_UNORM:
+                texels = {};
+                decodeBc4(block, 0, texels);
+                decodeBc4(block + 8, 1, texels);
+                setChannel(texels, 3, 255);
+                return true;
+            case DXGI_FORMAT_BC7_UNORM:
+            case DXGI_FORMAT_BC7_UNORM_SRGB:
+                return decodeBc7(block, texels);
+            default:
+                return false;
+            }
+        }
+
+        /// Decodes a subresource to tightly packed RGBA8, returns an empty vector if a block is not handled.
+        static std::vector<uint8_t> decodeSubresource(DXGI_FORMAT format, void const* data, UINT width, UINT height)
+        {
+            std::vector<uint8_t> retval(size_t(width) * height * 4);
+            size_t const block_size = dxowl::getFormatTraits(format).bytes_per_block;
+            size_t const row_pitch = dxowl::computeRowPitch(format, width);
+
+            for (UINT block_y = 0; block_y < (height + 3) / 4; ++block_y)
+            {
+                for (UINT block_x = 0; block_x < (width + 3) / 4; ++block_x)
+                {
+                    Texels texels;
+                    auto block = static_cast<uint8_t const*>(data) + row_pitch * block_y + block_size * block_x;
+                    if (!decodeBlock(format, block, texels))
+                    {
+                        return {};
+                    }
+
+                    for (UINT i = 0; i < 16; ++i)
+                    {
+                        UINT const x = block_x * 4 + (i & 3);
+                        UINT const y = block_y * 4 + (i >> 2);
+                        if (x < width && y < height)
+                        {
+                            for (UINT c = 0; c < 4; ++c)
+                            {
+                                retval[(size_t(y) * width + x) * 4 + c] = texels[i][c];
+                            }
+                        }
+                    }
+                }
+            }
+
+            return retval;
+        }
+
+        /// PSNR in dB over the given channels of two RGBA8 images, 99 for identical images.
+        static double computePsnr(std::vector<uint8_t> const& a, std::vector<uint8_t> const& b, std::vector<UINT> const& channels)
+        {
+            double squared_error = 0.0;
+            size_t count = 0;
+            for (size_t texel = 0; texel + 3 < a.size() && texel + 3 < b.size(); texel += 4)
+            {
+                for (UINT c : channels)
+                {
+                    double const d = double(a[texel + c]) - double(b[texel + c]);
+                    squared_error += d * d;
+                    ++count;
+                }
+            }
+            double const mse = count > 0 ? squared_error / count : 0.0;
+            return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+        }
+
+    private:
+        struct BitReader
+        {
+            uint8_t const* data;
+            UINT position;
+
+            uint32_t read(UINT bit_cnt)
+            {
+                uint32_t retval = 0;
+                for (UINT i = 0; i < bit_cnt; ++i, ++position)
+                {
+                    retval |= uint32_t((data[position >> 3] >> (position & 7)) & 1) << i;
+                }
+                return retval;
+            }
+        };
+
+        static void setChannel(Texels& texels, UINT channel, uint8_t value)
+        {
+            for (auto& texel : texels)
+            {
+                texel[channel] = value;
+            }
+        }
+
+        static void expandRgb565(uint16_t value, int (&color)[3])
+        {
+            int const r = (value >> 11) & 31;
+            int const g = (value >> 5) & 63;
+            int const b = value & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        static void decodeColor(uint8_t const* block, bool allow_three_color, Texels& texels)
+        {
+            uint16_t const c0 = uint16_t(block[0] | (block[1] << 8));
+            uint16_t const c1 = uint16_t(block[2] | (block[3] << 8));
+            uint32_t const indices = uint32_t(block[4]) | (uint32_t(block[5]) << 8) | (uint32_t(block[6]) << 16) | (uint32_t(block[7]) << 24);
+
+            int palette[4][4];
+            int e0[3], e1[3];
+            expandRgb565(c0, e0);
+            expandRgb565(c1, e1);
+            bool const four_color = !allow_three_color || c0 > c1;
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[0][c] = e0[c];
+                palette[1][c] = e1[c];
+                palette[2][c] = four_color ? (2 * e0[c] + e1[c] + 1) / 3 : (e0[c] + e1[c]) / 2;
+                palette[3][c] = four_color ? (e0[c] + 2 * e1[c] + 1) / 3 : 0;
+            }
+            palette[0][3] = palette[1][3] = palette[2][3] = 255;
+            palette[3][3] = four_color ? 255 : 0;
+
+            for (UINT i = 0; i < 16; ++i)
+            {
+                UINT const index = (indices >> (2 * i)) & 3;
+                for (int c = 0; c < 4; ++c)
+                {
+                    texels[i][c] = uint8_t(palette[index][c]);
+                }
+            }
+        }
+
+        static void decodeBc4(uint8_t const* block, UINT channel, Texels& texels)
+        {
+            int const r0 = block[0];
+            int const r1 = block[1];
+            int palette[8] = { r0, r1 };
+            if (r0 > r1)
+            {
+                for (int i = 1; i < 7; ++i)
+                {
+                    palette[i + 1] = ((7 - i) * r0 + i * r1 + 3) / 7;
+                }
+            }
+            else
+            {
+                for (int i = 1; i < 5; ++i)
+                {
+                    palette[i + 1] = ((5 - i) * r0 + i * r1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+
+            BitReader reader{ block + 2, 0 };
+            for (UINT i = 0; i < 16; ++i)
+            {
+                texels[i][channel] = uint8_t(palette[reader.read(3)]);
+            }
+        }
+
+        static uint8_t interpolateBc7(int e0, int e1, int weight)
+        {
+            return uint8_t(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+        }
+
+        static bool decodeBc7(uint8_t const* block, Texels& texels)
+        {
+            BitReader reader{ block, 0 };
+            UINT mode = 0;
+            while (mode < 8 && reader.read(1) == 0)
+            {
+                ++mode;
+            }
+
+            if (mode == 6)
+            {
+                int endpoints[2][4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    endpoints[0][c] = int(reader.read(7));
+                    endpoints[1][c] = int(reader.read(7));
+                }
+                int const p0 = int(reader.read(1));
+                int const p1 = int(reader.read(1));
+                for (int c = 0; c < 4; ++c)
+                {
+                    endpoints[0][c] = (endpoints[0][c] << 1) | p0;
+                    endpoints[1][c] = (endpoints[1][c] << 1) | p1;
+                }
+
+                for (UINT i = 0; i < 16; ++i)
+                {
+                    int const weight = dxowl::detail::bc7_weights4[reader.read(i == 0 ? 3 : 4)];
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        texels[i][c] = interpolateBc7(endpoints[0][c], endpoints[1][c], weight);
+                    }
+                }
+                return true;
+            }
+
+            if (mode == 1)
+            {
+                UINT const partition = reader.read(6);
+                int endpoints[4][3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    for (int e = 0; e < 4; ++e)
+                    {
+                        endpoints[e][c] = int(reader.read(6));
+                    }
+                }
+                int const p[2] = { int(reader.read(1)), int(reader.read(1)) };
+                for (int e = 0; e < 4; ++e)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        int const value = (endpoints[e][c] << 1) | p[e / 2];
+                        endpoints[e][c] = (value << 1) | (value >> 6);
+                    }
+                }
+
+                UINT const anchor = dxowl::detail::bc7_anchors2[partition];
+                for (UINT i = 0; i < 16; ++i)
+                {
+                    UINT const subset = (dxowl::detail::bc7_partitions2[partition] >> i) & 1;
+                    int const weight = dxowl::detail::bc7_weights3[reader.read(i == 0 || i == anchor ? 2 : 3)];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        texels[i][c] = interpolateBc7(endpoints[2 * subset][c], endpoints[2 * subset + 1][c], weight);
+                    }
+                    texels[i][3] = 255;
+                }
+                return true;
+            }
+
+            return false;
+        }
+    };
+} // namespace dxowl_test
+
+#endif // !BcDecoder_hpp
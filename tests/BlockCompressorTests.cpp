@@ -0,0 +1,211 @@
+/// <copyright file="BlockCompressorTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/BlockCompressor.hpp>
+
+#include "BcDecoder.hpp"
+#include "TestCheck.hpp"
+#include "TestImage.hpp"
+
+using namespace dxowl;
+using dxowl_test::BcDecoder;
+using dxowl_test::makeTestImage;
+
+namespace
+{
+    std::vector<uint8_t> makeSolid(UINT width, UINT height, std::vector<uint8_t> const& texel)
+    {
+        std::vector<uint8_t> retval;
+        retval.reserve(size_t(width) * height * texel.size());
+        for (size_t i = 0; i < size_t(width) * height; ++i)
+        {
+            retval.insert(retval.end(), texel.begin(), texel.end());
+        }
+        return retval;
+    }
+
+    bool decodesTo(BlockCompressor::CompressedTexture const& texture, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        std::vector<uint8_t> decoded = BcDecoder::decodeSubresource(
+            texture.getFormat(), texture.getSubresourceData()[0], texture.getWidth(), texture.getHeight());
+        return !decoded.empty() && decoded == makeSolid(texture.getWidth(), texture.getHeight(), { r, g, b, a });
+    }
+
+    void testLayout()
+    {
+        // 64x32 with a full mip chain, the last four levels are smaller than a block
+        UINT const mip_levels = computeMipLevelCount(64, 32);
+        std::vector<std::vector<uint8_t>> levels;
+        std::vector<void const*> subresources;
+        for (UINT slice = 0; slice < 2; ++slice)
+        {
+            for (UINT mip = 0; mip < mip_levels; ++mip)
+            {
+                levels.push_back(makeTestImage(computeMipExtent(64, mip), computeMipExtent(32, mip)));
+            }
+        }
+        for (auto const& level : levels)
+        {
+            subresources.push_back(level.data());
+        }
+
+        auto texture = BlockCompressor::compress(
+            DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 64, 32, mip_levels, 2, subresources, DXGI_FORMAT_BC7_UNORM_SRGB, BlockCompressor::Preset::Fast);
+
+        DXOWL_CHECK(texture.getFormat() == DXGI_FORMAT_BC7_UNORM_SRGB);
+        DXOWL_CHECK(texture.getWidth() == 64 && texture.getHeight() == 32);
+        DXOWL_CHECK(texture.getMipLevels() == 7 && texture.getArraySize() == 2);
+        DXOWL_CHECK(texture.getSubresourceData().size() == 14);
+
+        D3D11_TEXTURE2D_DESC const desc = texture.getTextureDesc();
+        DXOWL_CHECK(desc.Width == 64 && desc.Height == 32 && desc.MipLevels == 7 && desc.ArraySize == 2);
+        DXOWL_CHECK(desc.Format == DXGI_FORMAT_BC7_UNORM_SRGB && desc.SampleDesc.Count == 1);
+        DXOWL_CHECK(desc.Usage == D3D11_USAGE_IMMUTABLE && desc.BindFlags == D3D11_BIND_SHADER_RESOURCE);
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC const srv_desc = texture.getShaderResourceViewDesc();
+        DXOWL_CHECK(srv_desc.ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2DARRAY);
+        DXOWL_CHECK(srv_desc.Texture2DArray.MipLevels == 7 && srv_desc.Texture2DArray.ArraySize == 2);
+
+        // mip 6 of slice 1 is 1x1 and padded to a single block, it holds the last texel of its source
+        std::vector<uint8_t> decoded = BcDecoder::decodeSubresource(
+            DXGI_FORMAT_BC7_UNORM_SRGB, texture.getSubresourceData()[13], 1, 1);
+        DXOWL_CHECK(decoded.size() == 4);
+        for (UINT c = 0; c < decoded.size(); ++c)
+        {
+            DXOWL_CHECK(std::abs(int(decoded[c]) - int(levels[13][c])) <= 1);
+        }
+
+        auto single = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 32, 1, 1, { levels[0].data() }, DXGI_FORMAT_BC1_UNORM);
+        DXOWL_CHECK(single.getShaderResourceViewDesc().ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2D);
+        DXOWL_CHECK(single.getShaderResourceViewDesc().Texture2D.MipLevels == 1);
+    }
+
+    void testSolidColors()
+    {
+        // colors that each format stores exactly, BC1 needs 565 values
+        std::vector<uint8_t> const magenta = makeSolid(8, 8, { 255, 0, 255, 255 });
+        std::vector<uint8_t> const rgba = makeSolid(8, 8, { 201, 99, 51, 127 });
+        std::vector<uint8_t> const bgra = makeSolid(8, 8, { 51, 99, 201, 127 });
+        std::vector<uint8_t> const rg = makeSolid(8, 8, { 17, 230 });
+        std::vector<uint8_t> const r = makeSolid(8, 8, { 77 });
+
+        for (auto preset : { BlockCompressor::Preset::Fast, BlockCompressor::Preset::Normal, BlockCompressor::Preset::High })
+        {
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1, { magenta.data() }, DXGI_FORMAT_BC1_UNORM, preset), 255, 0, 255, 255));
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1, { magenta.data() }, DXGI_FORMAT_BC3_UNORM, preset), 255, 0, 255, 255));
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1, { rgba.data() }, DXGI_FORMAT_BC7_UNORM, preset), 201, 99, 51, 127));
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_B8G8R8A8_UNORM, 8, 8, 1, 1, { bgra.data() }, DXGI_FORMAT_BC7_UNORM, preset), 201, 99, 51, 127));
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8G8_UNORM, 8, 8, 1, 1, { rg.data() }, DXGI_FORMAT_BC5_UNORM, preset), 17, 230, 0, 255));
+            DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8_UNORM, 8, 8, 1, 1, { r.data() }, DXGI_FORMAT_BC4_UNORM, preset), 77, 0, 0, 255));
+        }
+
+        // BC1 stores transparent texels with three color mode
+        std::vector<uint8_t> const clear = makeSolid(8, 8, { 0, 0, 0, 0 });
+        DXOWL_CHECK(decodesTo(BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1, { clear.data() }, DXGI_FORMAT_BC1_UNORM), 0, 0, 0, 0));
+    }
+
+    void testQuality()
+    {
+        UINT const size = 128;
+        std::vector<uint8_t> const image = makeTestImage(size, size);
+        std::vector<uint8_t> const opaque = makeTestImage(size, size, true);
+
+        struct Case
+        {
+            std::vector<uint8_t> const& source;
+            DXGI_FORMAT format;
+            BlockCompressor::Preset preset;
+            std::vector<UINT> channels;
+            double min_psnr;
+        };
+
+        // thresholds are a little below the measured values, see bench/BlockCompressorBench.cpp for the
+        // full table; BC1 gets the opaque image since it decodes texels below half alpha as transparent black
+        std::vector<Case> const cases = {
+            { opaque, DXGI_FORMAT_BC1_UNORM, BlockCompressor::Preset::Fast, { 0, 1, 2 }, 35.5 },
+            { opaque, DXGI_FORMAT_BC1_UNORM, BlockCompressor::Preset::Normal, { 0, 1, 2 }, 36.0 },
+            { image, DXGI_FORMAT_BC3_UNORM, BlockCompressor::Preset::Normal, { 0, 1, 2, 3 }, 37.0 },
+            { image, DXGI_FORMAT_BC4_UNORM, BlockCompressor::Preset::Normal, { 0 }, 41.0 },
+            { image, DXGI_FORMAT_BC5_UNORM, BlockCompressor::Preset::Normal, { 0, 1 }, 44.0 },
+            { image, DXGI_FORMAT_BC7_UNORM, BlockCompressor::Preset::Normal, { 0, 1, 2, 3 }, 33.0 },
+        };
+
+        for (auto const& test_case : cases)
+        {
+            auto texture = BlockCompressor::compress(
+                DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1, { test_case.source.data() }, test_case.format, test_case.preset);
+            std::vector<uint8_t> decoded = BcDecoder::decodeSubresource(test_case.format, texture.getSubresourceData()[0], size, size);
+            DXOWL_CHECK(BcDecoder::computePsnr(test_case.source, decoded, test_case.channels) >= test_case.min_psnr);
+        }
+
+        // High adds BC7 mode 1 for opaque blocks
+        double psnr[2];
+        BlockCompressor::Preset const presets[2] = { BlockCompressor::Preset::Normal, BlockCompressor::Preset::High };
+        for (int i = 0; i < 2; ++i)
+        {
+            auto texture = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, size, size, 1, 1, { opaque.data() }, DXGI_FORMAT_BC7_UNORM, presets[i]);
+            psnr[i] = BcDecoder::computePsnr(opaque, BcDecoder::decodeSubresource(DXGI_FORMAT_BC7_UNORM, texture.getSubresourceData()[0], size, size), { 0, 1, 2 });
+        }
+        DXOWL_CHECK(psnr[0] >= 38.0 && psnr[1] >= psnr[0] + 1.0);
+    }
+
+    void testThreadPool()
+    {
+        std::vector<uint8_t> const image = makeTestImage(64, 64);
+        ThreadPool thread_pool(4);
+
+        for (DXGI_FORMAT format : { DXGI_FORMAT_BC1_UNORM, DXGI_FORMAT_BC3_UNORM, DXGI_FORMAT_BC5_UNORM, DXGI_FORMAT_BC7_UNORM })
+        {
+            auto serial = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 64, 1, 1, { image.data() }, format, BlockCompressor::Preset::High);
+            auto parallel = BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 64, 1, 1, { image.data() }, format, BlockCompressor::Preset::High, &thread_pool);
+            DXOWL_CHECK(std::memcmp(serial.getSubresourceData()[0], parallel.getSubresourceData()[0], computeSubresourceByteSize(format, 64, 64)) == 0);
+        }
+    }
+
+    template <typename Function>
+    bool throwsInvalidArgument(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (std::invalid_argument const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testErrors()
+    {
+        std::vector<uint8_t> const image = makeTestImage(8, 8);
+        std::vector<void const*> const subresources = { image.data() };
+
+        DXOWL_CHECK(!BlockCompressor::isSupportedSource(DXGI_FORMAT_R16G16B16A16_FLOAT));
+        DXOWL_CHECK(!BlockCompressor::isSupportedTarget(DXGI_FORMAT_BC6H_UF16));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { BlockCompressor::compress(DXGI_FORMAT_R16G16B16A16_FLOAT, 8, 8, 1, 1, subresources, DXGI_FORMAT_BC7_UNORM); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1, subresources, DXGI_FORMAT_BC6H_UF16); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 6, 8, 1, 1, subresources, DXGI_FORMAT_BC1_UNORM); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 2, 1, subresources, DXGI_FORMAT_BC1_UNORM); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { BlockCompressor::compress(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 0, subresources, DXGI_FORMAT_BC1_UNORM); }));
+    }
+} // namespace
+
+int main()
+{
+    testLayout();
+    testSolidColors();
+    testQuality();
+    testThreadPool();
+    testErrors();
+
+    return dxowl_test::result();
+}
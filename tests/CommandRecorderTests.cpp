@@ -0,0 +1,149 @@
+/// <copyright file="CommandRecorderTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/CommandRecorder.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// Every batch issues one Draw with the batch index as start vertex, so the replay order on the immediate
+// context can be read back from the recorded Draw calls.
+namespace
+{
+    void recordBatch(size_t batch_idx, StateCache& state_cache)
+    {
+        state_cache.draw(3, static_cast<UINT>(batch_idx));
+    }
+
+    std::vector<uint64_t> drawOrder(dxowl_test::RecordingContext const* ctx)
+    {
+        std::vector<uint64_t> retval;
+        for (auto const& call : ctx->findCalls("Draw"))
+        {
+            retval.push_back(call.args[1]);
+        }
+        return retval;
+    }
+
+    std::vector<uint64_t> sequence(uint64_t count)
+    {
+        std::vector<uint64_t> retval;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            retval.push_back(i);
+        }
+        return retval;
+    }
+
+    void testDeferred()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        ThreadPool thread_pool(4);
+
+        // the recording device reports driver command lists, Auto picks deferred contexts
+        CommandRecorder recorder(device.Get(), ctx, thread_pool);
+        DXOWL_CHECK(recorder.getMode() == CommandRecorder::Mode::Deferred);
+        DXOWL_CHECK(recorder.getSlotCount() == 4 && device->deferred_context_cnt == 4);
+
+        recorder.beginFrame(1);
+        recorder.record(10, recordBatch, [](ID3D11DeviceContext4* d3d11_ctx) { d3d11_ctx->OMSetRenderTargets(0, nullptr, nullptr); });
+
+        // nothing reaches the immediate context before execute()
+        DXOWL_CHECK(ctx->calls.empty());
+
+        recorder.execute();
+        DXOWL_CHECK(ctx->countCalls("ExecuteCommandList") == 4);
+        DXOWL_CHECK(ctx->countCalls("OMSetRenderTargets") == 4);
+        DXOWL_CHECK(drawOrder(ctx) == sequence(10));
+
+        // the setup call opens every command list
+        std::vector<dxowl_test::RecordedCall> const& calls = ctx->calls;
+        DXOWL_CHECK(calls[1].name == "OMSetRenderTargets" && calls[2].name == "Draw");
+
+        // command lists of several record() calls replay in recording order, with fewer batches than slots
+        ctx->calls.clear();
+        recorder.record(2, [](size_t batch_idx, StateCache& state_cache) { recordBatch(batch_idx + 10, state_cache); });
+        recorder.record(3, [](size_t batch_idx, StateCache& state_cache) { recordBatch(batch_idx + 12, state_cache); });
+        recorder.execute();
+        DXOWL_CHECK(ctx->countCalls("ExecuteCommandList") == 5);
+        DXOWL_CHECK(drawOrder(ctx) == std::vector<uint64_t>({ 10, 11, 12, 13, 14 }));
+
+        recorder.endFrame();
+        CommandRecorder::FrameStatistics const stats = recorder.getLastFrameStatistics();
+        DXOWL_CHECK(stats.frame == 1 && stats.batches_recorded == 15 && stats.command_lists_executed == 9);
+
+        // execute() without queued command lists does nothing
+        ctx->calls.clear();
+        recorder.execute();
+        DXOWL_CHECK(ctx->calls.empty());
+    }
+
+    void testRecordError()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        ThreadPool thread_pool(2);
+        CommandRecorder recorder(device.Get(), ctx, thread_pool, CommandRecorder::Mode::Deferred);
+
+        bool thrown = false;
+        try
+        {
+            recorder.record(4, [](size_t batch_idx, StateCache& state_cache) {
+                if (batch_idx == 3)
+                {
+                    throw std::runtime_error("batch failed");
+                }
+                recordBatch(batch_idx, state_cache);
+            });
+        }
+        catch (std::runtime_error const&)
+        {
+            thrown = true;
+        }
+        DXOWL_CHECK(thrown);
+
+        // the failed recording is not queued and does not leak into the next one
+        recorder.record(2, recordBatch);
+        recorder.execute();
+        DXOWL_CHECK(ctx->countCalls("ExecuteCommandList") == 2);
+        DXOWL_CHECK(drawOrder(ctx) == sequence(2));
+    }
+
+    void testImmediate()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        ThreadPool thread_pool(4);
+
+        CommandRecorder recorder(device.Get(), ctx, thread_pool, CommandRecorder::Mode::Immediate);
+        DXOWL_CHECK(recorder.getSlotCount() == 1 && device->deferred_context_cnt == 0);
+
+        // batches are submitted during record(), execute() has nothing left to do
+        recorder.beginFrame(2);
+        recorder.record(6, recordBatch);
+        DXOWL_CHECK(drawOrder(ctx) == sequence(6));
+        recorder.execute();
+        DXOWL_CHECK(ctx->countCalls("ExecuteCommandList") == 0);
+        recorder.endFrame();
+        DXOWL_CHECK(recorder.getLastFrameStatistics().batches_recorded == 6 && recorder.getLastFrameStatistics().command_lists_executed == 0);
+    }
+} // namespace
+
+int main()
+{
+    testDeferred();
+    testRecordError();
+    testImmediate();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,194 @@
+/// <copyright file="ConstantBufferAllocatorTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/ConstantBufferAllocator.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// 80 byte constants take one 256 byte slice, i.e. 16 shader constants. The 4 KiB buffers hold 16 slices.
+namespace
+{
+    struct Constants
+    {
+        float values[20];
+    };
+
+    size_t const buffer_byte_size = 4096;
+
+    template <typename Exception, typename Function>
+    bool throws(Function const& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+        }
+        return false;
+    }
+
+    Constants makeConstants(float value)
+    {
+        Constants retval;
+        for (float& v : retval.values)
+        {
+            v = value;
+        }
+        return retval;
+    }
+
+    uint64_t address(void const* ptr)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+    }
+
+    bool holds(ConstantBufferAllocator::Allocation const& allocation, Constants const& constants)
+    {
+        auto buffer = static_cast<dxowl_test::RecordingBuffer*>(allocation.buffer);
+        return std::memcmp(buffer->data.data() + allocation.first_constant * 16, &constants, sizeof(Constants)) == 0;
+    }
+
+    /// Map types of the recorded Map calls, in call order.
+    std::vector<uint64_t> mapTypes(dxowl_test::RecordingContext const* ctx)
+    {
+        std::vector<uint64_t> retval;
+        for (auto const& call : ctx->findCalls("Map"))
+        {
+            retval.push_back(call.args[2]);
+        }
+        return retval;
+    }
+
+    void testUpload()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        ConstantBufferAllocator allocator(device.Get(), buffer_byte_size);
+
+        allocator.beginFrame(1);
+        Constants const first_constants = makeConstants(1.0f);
+        Constants const second_constants = makeConstants(2.0f);
+        ConstantBufferAllocator::Allocation const first = allocator.upload(ctx, first_constants);
+        ConstantBufferAllocator::Allocation const second = allocator.upload(ctx, second_constants);
+        DXOWL_CHECK(first.buffer == second.buffer);
+        DXOWL_CHECK(first.first_constant == 0 && second.first_constant == 16);
+        DXOWL_CHECK(first.constant_count == 16 && second.constant_count == 16);
+        DXOWL_CHECK(holds(first, first_constants) && holds(second, second_constants));
+
+        // the first map of the frame discards, later ones keep the slices written before
+        DXOWL_CHECK((mapTypes(ctx) == std::vector<uint64_t>{ D3D11_MAP_WRITE_DISCARD, D3D11_MAP_WRITE_NO_OVERWRITE }));
+        DXOWL_CHECK(ctx->countCalls("Unmap") == 2);
+
+        ConstantBufferAllocator::bindVS(ctx, 2, second);
+        ConstantBufferAllocator::bindPS(ctx, 0, first);
+        DXOWL_CHECK((ctx->findCalls("VSSetConstantBuffers1").back().args == std::vector<uint64_t>{ 2, 1, address(second.buffer), 16, 16 }));
+        DXOWL_CHECK((ctx->findCalls("PSSetConstantBuffers1").back().args == std::vector<uint64_t>{ 0, 1, address(first.buffer), 0, 16 }));
+
+        allocator.endFrame();
+        ConstantBufferAllocator::FrameStatistics stats = allocator.getLastFrameStatistics();
+        DXOWL_CHECK(stats.frame == 1 && stats.map_count == 2 && stats.discard_count == 1);
+        DXOWL_CHECK(stats.allocation_count == 2 && stats.buffer_count == 1);
+        DXOWL_CHECK(stats.bytes_written == 2 * sizeof(Constants) && stats.bytes_allocated == 2 * 256);
+
+        // the next frame starts over at the first buffer with a discard
+        ctx->calls.clear();
+        allocator.beginFrame(2);
+        Constants const third_constants = makeConstants(3.0f);
+        ConstantBufferAllocator::Allocation const third = allocator.upload(ctx, third_constants);
+        DXOWL_CHECK(third.buffer == first.buffer && third.first_constant == 0);
+        DXOWL_CHECK(holds(third, third_constants));
+        DXOWL_CHECK((mapTypes(ctx) == std::vector<uint64_t>{ D3D11_MAP_WRITE_DISCARD }));
+
+        // slices are written in place by allocate, at least 256 bytes are reserved per slice
+        ConstantBufferAllocator::Allocation const small = allocator.allocate(ctx, 4, [](void* dst) {
+            uint32_t const value = 42;
+            std::memcpy(dst, &value, sizeof(value));
+        });
+        DXOWL_CHECK(small.first_constant == 16 && small.constant_count == 16);
+        DXOWL_CHECK(static_cast<dxowl_test::RecordingBuffer*>(small.buffer)->data[256] == 42);
+        allocator.endFrame();
+        DXOWL_CHECK(allocator.getBufferCount() == 1);
+        DXOWL_CHECK(allocator.getBufferByteSize() == buffer_byte_size);
+
+        DXOWL_CHECK(throws<std::length_error>([&]() { allocator.upload(ctx, &third_constants, 0); }));
+        DXOWL_CHECK(throws<std::length_error>([&]() { allocator.allocate(ctx, 65537, [](void*) {}); }));
+    }
+
+    void testBatch()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        ConstantBufferAllocator allocator(device.Get(), buffer_byte_size);
+
+        allocator.beginFrame(1);
+        ConstantBufferAllocator::Allocation const single = allocator.upload(ctx, makeConstants(0.0f));
+
+        // 15 slices are left in the first buffer, the rest of the batch goes to a new one
+        std::vector<Constants> constants;
+        for (int i = 0; i < 20; ++i)
+        {
+            constants.push_back(makeConstants(float(i)));
+        }
+        std::vector<ConstantBufferAllocator::Allocation> allocations;
+        allocator.uploadBatch(ctx, constants, allocations);
+        DXOWL_CHECK(allocations.size() == constants.size());
+        DXOWL_CHECK(allocator.getBufferCount() == 2);
+
+        bool in_order = true;
+        for (size_t i = 0; i < allocations.size(); ++i)
+        {
+            bool const in_first = i < 15;
+            in_order = in_order && (allocations[i].buffer == single.buffer) == in_first;
+            in_order = in_order && allocations[i].first_constant == (in_first ? (i + 1) * 16 : (i - 15) * 16);
+            in_order = in_order && holds(allocations[i], constants[i]);
+        }
+        DXOWL_CHECK(in_order);
+
+        // one map per buffer touched, the new buffer is discarded on first use
+        DXOWL_CHECK((mapTypes(ctx) == std::vector<uint64_t>{ D3D11_MAP_WRITE_DISCARD, D3D11_MAP_WRITE_NO_OVERWRITE, D3D11_MAP_WRITE_DISCARD }));
+        allocator.endFrame();
+        ConstantBufferAllocator::FrameStatistics const stats = allocator.getLastFrameStatistics();
+        DXOWL_CHECK(stats.map_count == 3 && stats.discard_count == 2 && stats.buffer_count == 2);
+        DXOWL_CHECK(stats.allocation_count == 21);
+
+        // buffers are kept across frames
+        allocator.beginFrame(2);
+        allocator.uploadBatch(ctx, constants, allocations);
+        allocator.endFrame();
+        DXOWL_CHECK(allocator.getBufferCount() == 2);
+        DXOWL_CHECK(allocations[15].buffer != allocations[16].buffer);
+        DXOWL_CHECK(device->buffer_cnt == 2);
+    }
+
+    void testUnsupported()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        device->constant_buffer_offsetting = FALSE;
+        DXOWL_CHECK(throws<std::runtime_error>([&]() { ConstantBufferAllocator allocator(device.Get()); }));
+    }
+} // namespace
+
+int main()
+{
+    testUpload();
+    testBatch();
+    testUnsupported();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,104 @@
+/// <copyright file="FormatTraitsTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <dxowl/FormatTraits.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    uint32_t floatBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    void testTraits()
+    {
+        FormatTraits const& rgba = getFormatTraits(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+        DXOWL_CHECK(rgba.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+        DXOWL_CHECK(rgba.bytes_per_block == 4 && rgba.channel_count == 4);
+        DXOWL_CHECK(rgba.channel_type == FormatChannelType::Unorm && isSRGB(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB));
+
+        DXOWL_CHECK(isDepthStencil(DXGI_FORMAT_D24_UNORM_S8_UINT) && isDepthStencil(DXGI_FORMAT_D32_FLOAT));
+        DXOWL_CHECK(!isDepthStencil(DXGI_FORMAT_R32_FLOAT));
+        DXOWL_CHECK(isBlockCompressed(DXGI_FORMAT_BC7_UNORM) && !isBlockCompressed(DXGI_FORMAT_R8_UNORM));
+        DXOWL_CHECK(isPlanar(DXGI_FORMAT_NV12) && !isPlanar(DXGI_FORMAT_R8G8_UNORM));
+
+        // values outside of the table fall back to the DXGI_FORMAT_UNKNOWN entry
+        DXOWL_CHECK(getFormatTraits(static_cast<DXGI_FORMAT>(1000)).format == DXGI_FORMAT_UNKNOWN);
+        DXOWL_CHECK(computeBytesPerElement(static_cast<DXGI_FORMAT>(1000)) == 0);
+    }
+
+    void testSubresourceSizes()
+    {
+        // block compressed mips round up to whole 4x4 blocks
+        DXOWL_CHECK(computeSubresourceByteSize(DXGI_FORMAT_BC1_UNORM, 1, 1) == 8);
+        DXOWL_CHECK(computeSubresourceByteSize(DXGI_FORMAT_BC1_UNORM, 5, 9) == 2 * 3 * 8);
+        DXOWL_CHECK(computeSubresourceByteSize(DXGI_FORMAT_BC7_UNORM, 512, 512) == 128 * 128 * 16);
+        DXOWL_CHECK(computeSubresourceByteSize(DXGI_FORMAT_R16G16B16A16_FLOAT, 7, 3, 2) == 7 * 8 * 3 * 2);
+        DXOWL_CHECK(computeSubresourceByteSize(DXGI_FORMAT_R8_UNORM, 0, 0, 0) == 1);
+
+        uint32_t width = 300;
+        size_t total = 0;
+        for (uint32_t mip = 0; mip < computeMipLevelCount(width, 20); ++mip)
+        {
+            total += computeSubresourceByteSize(DXGI_FORMAT_R8G8B8A8_UNORM, computeMipExtent(width, mip), computeMipExtent(20, mip));
+        }
+        DXOWL_CHECK(computeMipLevelCount(width, 20) == 9);
+        DXOWL_CHECK(total == 4 * (300 * 20 + 150 * 10 + 75 * 5 + 37 * 2 + 18 + 9 + 4 + 2 + 1));
+    }
+
+    void testHalfRoundTrip()
+    {
+        // every binary16 value survives the round trip, NaNs stay NaN with their payload
+        bool all_equal = true;
+        for (uint32_t h = 0; h <= 0xffff; ++h)
+        {
+            uint16_t const half = static_cast<uint16_t>(h);
+            float const value = halfToFloat(half);
+            uint16_t const back = floatToHalf(value);
+            bool const nan = (half & 0x7c00) == 0x7c00 && (half & 0x3ff) != 0;
+            all_equal = all_equal && (nan ? back == (half | 0x200) : back == half);
+        }
+        DXOWL_CHECK(all_equal);
+    }
+
+    void testHalfRounding()
+    {
+        DXOWL_CHECK(floatToHalf(1.0f) == 0x3c00);
+        DXOWL_CHECK(floatToHalf(-2.0f) == 0xc000);
+        DXOWL_CHECK(floatToHalf(65504.0f) == 0x7bff);
+        DXOWL_CHECK(floatToHalf(65536.0f) == 0x7c00);
+        DXOWL_CHECK(floatToHalf(-0.0f) == 0x8000);
+        DXOWL_CHECK(halfToFloat(0x0001) == std::ldexp(1.0f, -24));
+
+        // ties round to even: 1 + 2^-11 lies halfway between 1 and the next half
+        DXOWL_CHECK(floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00);
+        DXOWL_CHECK(floatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3c02);
+        DXOWL_CHECK(floatToHalf(std::ldexp(1.0f, -25)) == 0x0000);
+        DXOWL_CHECK(floatToHalf(std::ldexp(3.0f, -25)) == 0x0002);
+
+        DXOWL_CHECK(floatBits(halfToFloat(0x7c00)) == 0x7f800000);
+        DXOWL_CHECK(std::isnan(halfToFloat(floatToHalf(std::nanf("")))));
+    }
+} // namespace
+
+int main()
+{
+    testTraits();
+    testSubresourceSizes();
+    testHalfRoundTrip();
+    testHalfRounding();
+    return dxowl_test::result();
+}
@@ -0,0 +1,154 @@
+/// <copyright file="FreeListAllocatorTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <vector>
+
+#include <dxowl/FreeListAllocator.hpp>
+#include <dxowl/GeometryArena.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    void testBestFit()
+    {
+        FreeListAllocator allocator(100);
+        DXOWL_CHECK(allocator.allocate(10) == 0);
+        size_t const b = allocator.allocate(20);
+        DXOWL_CHECK(b == 10);
+        DXOWL_CHECK(allocator.allocate(30) == 30);
+        allocator.free(b, 20);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 2 && allocator.getLargestFreeBlock() == 40);
+
+        // the 20 unit hole fits better than the 40 unit tail, and its rest is taken by the next small request
+        DXOWL_CHECK(allocator.allocate(15) == 10);
+        DXOWL_CHECK(allocator.allocate(5) == 25);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 1 && allocator.getUsed() == 60);
+
+        DXOWL_CHECK(allocator.allocate(0) == FreeListAllocator::InvalidOffset);
+        DXOWL_CHECK(allocator.allocate(41) == FreeListAllocator::InvalidOffset);
+        DXOWL_CHECK(allocator.allocate(40) == 60 && allocator.getFree() == 0 && allocator.getLargestFreeBlock() == 0);
+    }
+
+    void testAlignment()
+    {
+        FreeListAllocator allocator(100);
+        DXOWL_CHECK(allocator.allocate(3) == 0);
+
+        // the padding in front of an aligned allocation stays free
+        DXOWL_CHECK(allocator.allocate(8, 16) == 16);
+        DXOWL_CHECK(allocator.getUsed() == 11 && allocator.getFreeBlockCount() == 2);
+        DXOWL_CHECK(allocator.getLargestFreeBlock() == 100 - 24);
+        DXOWL_CHECK(allocator.allocate(13) == 3);
+
+        // fits the block by size, but not after aligning its start
+        FreeListAllocator tight(64);
+        DXOWL_CHECK(tight.allocate(1) == 0);
+        DXOWL_CHECK(tight.allocate(60, 8) == FreeListAllocator::InvalidOffset);
+        DXOWL_CHECK(tight.allocate(56, 8) == 8);
+        DXOWL_CHECK(tight.allocate(4, 4) == 4 && tight.allocate(3) == 1);
+    }
+
+    void testCoalescing()
+    {
+        FreeListAllocator allocator(90);
+        size_t const a = allocator.allocate(30);
+        size_t const b = allocator.allocate(30);
+        size_t const c = allocator.allocate(30);
+
+        allocator.free(a, 30);
+        allocator.free(c, 30);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 2 && allocator.getLargestFreeBlock() == 30);
+        DXOWL_CHECK(allocator.allocate(60) == FreeListAllocator::InvalidOffset);
+
+        // freeing the middle merges with both neighbours
+        allocator.free(b, 30);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 1 && allocator.getLargestFreeBlock() == 90);
+        DXOWL_CHECK(allocator.getUsed() == 0 && allocator.getFree() == 90);
+
+        allocator.free(FreeListAllocator::InvalidOffset, 10);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 1 && allocator.getUsed() == 0);
+
+        allocator.allocate(50);
+        allocator.reset(40);
+        DXOWL_CHECK(allocator.getCapacity() == 40 && allocator.getUsed() == 0 && allocator.getLargestFreeBlock() == 40);
+        allocator.reset(0);
+        DXOWL_CHECK(allocator.getFreeBlockCount() == 0 && allocator.allocate(1) == FreeListAllocator::InvalidOffset);
+    }
+
+    GeometryArena::MeshHandle addQuads(GeometryArena& arena, ID3D11DeviceContext4* ctx, size_t vertex_cnt, float value)
+    {
+        std::vector<float> const positions(vertex_cnt * 3, value);
+        std::vector<uint32_t> indices;
+        for (uint32_t i = 0; i + 3 < vertex_cnt; i += 4)
+        {
+            indices.insert(indices.end(), { i, i + 1, i + 2, i, i + 2, i + 3 });
+        }
+        return arena.addMesh(ctx, std::vector<float const*>{ positions.data() }, vertex_cnt, indices.data(), indices.size());
+    }
+
+    void testArenaCompaction(dxowl_test::TestDevice const& test_device)
+    {
+        VertexDescriptor const layout = { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+        ID3D11DeviceContext4* ctx = test_device.context.Get();
+        GeometryArena arena(test_device.device.Get(), { layout }, DXGI_FORMAT_R32_UINT, 100, 150);
+
+        GeometryArena::MeshHandle const a = addQuads(arena, ctx, 20, 1.0f);
+        GeometryArena::MeshHandle const b = addQuads(arena, ctx, 20, 2.0f);
+        GeometryArena::MeshHandle const c = addQuads(arena, ctx, 20, 3.0f);
+        arena.removeMesh(b);
+
+        GeometryArena::Statistics stats = arena.getStatistics();
+        DXOWL_CHECK(stats.mesh_count == 2 && stats.vertices_used == 40 && stats.indices_used == 60);
+        DXOWL_CHECK(stats.free_vertex_ranges == 2 && stats.largest_free_vertex_range == 40);
+        DXOWL_CHECK(addQuads(arena, ctx, 48, 4.0f) == GeometryArena::InvalidHandle);
+        DXOWL_CHECK(arena.getStatistics().vertices_used == 40);
+
+        // live meshes move to the front in their previous order, handles stay valid
+        arena.compact(test_device.device.Get(), ctx);
+        GeometryArena::MeshView const view_a = arena.getMeshView(a);
+        GeometryArena::MeshView const view_c = arena.getMeshView(c);
+        DXOWL_CHECK(view_a.base_vertex == 0 && view_a.first_index == 0);
+        DXOWL_CHECK(view_c.base_vertex == 20 && view_c.first_index == 30 && view_c.vertex_count == 20 && view_c.index_count == 30);
+        DXOWL_CHECK(arena.getMeshView(b).vertex_count == 0);
+
+        stats = arena.getStatistics();
+        DXOWL_CHECK(stats.compaction_count == 1 && stats.free_vertex_ranges == 1 && stats.largest_free_vertex_range == 60);
+        GeometryArena::MeshHandle const d = addQuads(arena, ctx, 48, 4.0f);
+        DXOWL_CHECK(d != GeometryArena::InvalidHandle && arena.getMeshView(d).base_vertex == 40);
+
+#ifndef _WIN32
+        // the recording device keeps buffer contents, c's vertices and indices were copied to their new place
+        auto* recording_ctx = static_cast<dxowl_test::RecordingContext*>(ctx);
+        recording_ctx->calls.clear();
+        arena.setVertexBuffers(ctx);
+        arena.setIndexBuffer(ctx);
+        auto const* vertices = reinterpret_cast<dxowl_test::RecordingBuffer*>(recording_ctx->findCalls("IASetVertexBuffers").at(0).args.at(2));
+        auto const* indices = reinterpret_cast<dxowl_test::RecordingBuffer*>(recording_ctx->findCalls("IASetIndexBuffer").at(0).args.at(0));
+        float const* positions = reinterpret_cast<float const*>(vertices->data.data());
+        uint32_t const* index_data = reinterpret_cast<uint32_t const*>(indices->data.data());
+        DXOWL_CHECK(positions[0] == 1.0f && positions[20 * 3 - 1] == 1.0f);
+        DXOWL_CHECK(positions[20 * 3] == 3.0f && positions[40 * 3 - 1] == 3.0f && positions[40 * 3] == 4.0f);
+        DXOWL_CHECK(index_data[30] == 0 && index_data[31] == 1 && index_data[59] == 19);
+#endif
+    }
+} // namespace
+
+int main()
+{
+    testBestFit();
+    testAlignment();
+    testCoalescing();
+
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+    testArenaCompaction(test_device);
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,227 @@
+/// <copyright file="IndexPackerTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/IndexPacker.hpp>
+
+#include "TestCheck.hpp"
+#include "TestMesh.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    VertexDescriptor const position_layout = { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+    VertexDescriptor const id_layout = { 4, { { "TEXCOORD", 0, DXGI_FORMAT_R32_UINT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+
+    typedef std::array<uint32_t, 3> Triangle;
+
+    /// Rotates to the smallest vertex first so that the winding is part of the comparison.
+    Triangle normalize(Triangle triangle)
+    {
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        return triangle;
+    }
+
+    std::vector<Triangle> listTriangles(std::vector<uint32_t> const& indices)
+    {
+        std::vector<Triangle> retval;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            retval.push_back(normalize({ indices[i], indices[i + 1], indices[i + 2] }));
+        }
+        std::sort(retval.begin(), retval.end());
+        return retval;
+    }
+
+    /// Expands a strip with restart indices the way the input assembler does.
+    std::vector<Triangle> stripTriangles(std::vector<uint32_t> const& strip)
+    {
+        std::vector<Triangle> retval;
+        size_t run_start = 0;
+        for (size_t i = 0; i <= strip.size(); ++i)
+        {
+            if (i < strip.size() && strip[i] != IndexPacker::restart_index)
+            {
+                continue;
+            }
+            for (size_t k = run_start; k + 2 < i; ++k)
+            {
+                bool const odd = (k - run_start) % 2 == 1;
+                retval.push_back(normalize({ strip[odd ? k + 1 : k], strip[odd ? k : k + 1], strip[k + 2] }));
+            }
+            run_start = i + 1;
+        }
+        std::sort(retval.begin(), retval.end());
+        return retval;
+    }
+
+    /// Row major grid of size x size quads, two triangles each.
+    std::vector<uint32_t> makeGridIndices(uint32_t size)
+    {
+        std::vector<uint32_t> retval;
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t const a = y * (size + 1) + x;
+                uint32_t const c = a + size + 1;
+                retval.insert(retval.end(), { a, c, a + 1, a + 1, c, c + 1 });
+            }
+        }
+        return retval;
+    }
+
+    template <typename Exception, typename Function>
+    bool throws(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testNarrow()
+    {
+        // large values in both the four-wide loop and the remainder, restart indices are skipped
+        std::vector<uint32_t> wide = { 1, 7, IndexPacker::restart_index, 3, 0x80000005u, 2, 9, IndexPacker::restart_index, 0x80000001u };
+        DXOWL_CHECK(IndexPacker::findMaxIndex(wide.data(), wide.size(), DXGI_FORMAT_R32_UINT) == 0x80000005u);
+        DXOWL_CHECK(IndexPacker::findMaxIndex(wide.data(), 4, DXGI_FORMAT_R32_UINT) == 7);
+        DXOWL_CHECK(IndexPacker::findMaxIndex(wide.data(), 0, DXGI_FORMAT_R32_UINT) == 0);
+        DXOWL_CHECK(!IndexPacker::canNarrow(wide.data(), wide.size(), DXGI_FORMAT_R32_UINT));
+
+        std::vector<uint16_t> const narrow16 = { 5, 0xFFFF, 0x8001, 4, 0, 0, 0, 0, 0xFFFF, 0x7000 };
+        DXOWL_CHECK(IndexPacker::findMaxIndex(narrow16.data(), narrow16.size(), DXGI_FORMAT_R16_UINT) == 0x8001);
+        DXOWL_CHECK(!IndexPacker::canNarrow(narrow16.data(), narrow16.size(), DXGI_FORMAT_R16_UINT));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { IndexPacker::findMaxIndex(narrow16.data(), narrow16.size(), DXGI_FORMAT_R8_UINT); }));
+
+        // 0xFFFE is the largest index that fits, 0xFFFF would read as a restart index
+        wide = { 0, IndexPacker::max_index_16, IndexPacker::restart_index, 17, 4, 5 };
+        DXOWL_CHECK(IndexPacker::canNarrow(wide.data(), wide.size(), DXGI_FORMAT_R32_UINT));
+        DXOWL_CHECK(!IndexPacker::canNarrow(nullptr, 0, DXGI_FORMAT_R32_UINT));
+        DXOWL_CHECK((IndexPacker::narrow(wide.data(), wide.size()) == std::vector<uint16_t>{ 0, 0xFFFE, 0xFFFF, 17, 4, 5 }));
+
+        wide[3] = 0xFFFF;
+        DXOWL_CHECK(!IndexPacker::canNarrow(wide.data(), wide.size(), DXGI_FORMAT_R32_UINT));
+        DXOWL_CHECK(throws<std::out_of_range>([&]() { IndexPacker::narrow(wide.data(), wide.size()); }));
+    }
+
+    void testSplit()
+    {
+        // 68121 vertices in shuffled triangle order, so parts share many vertices
+        dxowl_test::TestMesh const mesh = dxowl_test::makeTestSphere(260);
+        UINT const half = UINT(mesh.indices.size() / 6 * 3);
+        std::vector<MeshOptimizer::Submesh> const submeshes = { { 0, half }, { half, UINT(mesh.indices.size()) - half } };
+
+        auto const split = IndexPacker::split(
+            { mesh.positions.data(), mesh.ids.data() },
+            mesh.vertex_count,
+            { position_layout, id_layout },
+            mesh.indices.data(),
+            mesh.indices.size(),
+            DXGI_FORMAT_R32_UINT,
+            submeshes);
+
+        std::vector<IndexPacker::Part> const& parts = split.getParts();
+        DXOWL_CHECK(parts.size() > 2);
+        DXOWL_CHECK(parts.front().submesh == 0 && parts.back().submesh == 1);
+        DXOWL_CHECK(split.getIndexData().size() == mesh.indices.size());
+
+        // every part draws the original triangles of its submesh in order, through its own vertex range
+        auto ids = static_cast<uint32_t const*>(split.getVertexData()[1]);
+        auto positions = static_cast<float const*>(split.getVertexData()[0]);
+        bool same_triangles = true;
+        bool same_positions = true;
+        UINT next_first_index = 0;
+        for (IndexPacker::Part const& part : parts)
+        {
+            DXOWL_CHECK(part.vertex_count <= 65535 && part.first_index == next_first_index);
+            next_first_index += part.index_count;
+
+            for (UINT i = part.first_index; i < part.first_index + part.index_count; ++i)
+            {
+                uint16_t const local = split.getIndexData()[i];
+                size_t const vertex = size_t(part.base_vertex) + local;
+                same_triangles = same_triangles && local < part.vertex_count && ids[vertex] == mesh.indices[i];
+                same_positions = same_positions && std::memcmp(positions + vertex * 3, &mesh.positions[mesh.indices[i] * 3], 12) == 0;
+            }
+        }
+        DXOWL_CHECK(same_triangles && same_positions);
+        DXOWL_CHECK(next_first_index == mesh.indices.size() && split.getVertexCount() > mesh.vertex_count);
+
+        IndexPacker::Report const& report = split.getReport();
+        DXOWL_CHECK(report.index_format_before == DXGI_FORMAT_R32_UINT && report.index_format_after == DXGI_FORMAT_R16_UINT);
+        DXOWL_CHECK(report.index_bytes_before == mesh.indices.size() * 4 && report.index_bytes_after == mesh.indices.size() * 2);
+        DXOWL_CHECK(report.vertex_bytes_before == mesh.vertex_count * 16 && report.vertex_bytes_after == split.getVertexCount() * 16);
+        DXOWL_CHECK(report.getBytesSaved() == ptrdiff_t(mesh.indices.size() * 2) - ptrdiff_t((split.getVertexCount() - mesh.vertex_count) * 16));
+    }
+
+    void testSplitSmall()
+    {
+        // a mesh that fits stays one part with the vertices in order of first use, instance data is copied
+        std::vector<uint32_t> const indices = { 4, 2, 3, 3, 2, 0 };
+        float const positions[5][3] = {};
+        uint32_t const instances[5] = { 10, 11, 12, 13, 14 };
+        VertexDescriptor const instance_layout = { 4, { { "TEXCOORD", 1, DXGI_FORMAT_R32_UINT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 } } };
+
+        auto const split = IndexPacker::split({ positions, instances }, 5, { position_layout, instance_layout }, indices.data(), indices.size(), DXGI_FORMAT_R32_UINT);
+        DXOWL_CHECK(split.getParts().size() == 1 && split.getParts()[0].vertex_count == 4 && split.getParts()[0].base_vertex == 0);
+        DXOWL_CHECK((split.getIndexData() == std::vector<uint16_t>{ 0, 1, 2, 2, 1, 3 }));
+        DXOWL_CHECK(split.getVertexDataByteSizes()[1] == sizeof(instances));
+        DXOWL_CHECK(std::memcmp(split.getVertexData()[1], instances, sizeof(instances)) == 0);
+
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() {
+            IndexPacker::split({ positions }, 5, { position_layout, instance_layout }, indices.data(), indices.size(), DXGI_FORMAT_R32_UINT);
+        }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() {
+            IndexPacker::split({ positions }, 4, { position_layout }, indices.data(), indices.size(), DXGI_FORMAT_R32_UINT);
+        }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() {
+            IndexPacker::split({ positions }, 5, { position_layout }, indices.data(), indices.size(), DXGI_FORMAT_R32_UINT, { { 0, 4 } });
+        }));
+    }
+
+    void testStrip()
+    {
+        std::vector<uint32_t> const grid = makeGridIndices(16);
+        std::vector<uint32_t> strip;
+        DXOWL_CHECK(IndexPacker::convertToStrip(grid.data(), grid.size(), DXGI_FORMAT_R32_UINT, strip));
+        DXOWL_CHECK(stripTriangles(strip) == listTriangles(grid));
+        DXOWL_CHECK(strip.size() < grid.size() * 2 / 3);
+
+        std::vector<uint16_t> const grid16(grid.begin(), grid.end());
+        std::vector<uint32_t> strip16;
+        DXOWL_CHECK(IndexPacker::convertToStrip(grid16.data(), grid16.size(), DXGI_FORMAT_R16_UINT, strip16));
+        DXOWL_CHECK(strip16 == strip);
+
+        // triangles without shared edges cannot be chained, the strip would only add restart indices
+        std::vector<uint32_t> const separate = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+        DXOWL_CHECK(!IndexPacker::convertToStrip(separate.data(), separate.size(), DXGI_FORMAT_R32_UINT, strip));
+        DXOWL_CHECK(strip.empty());
+
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { IndexPacker::convertToStrip(grid.data(), 4, DXGI_FORMAT_R32_UINT, strip); }));
+    }
+} // namespace
+
+int main()
+{
+    testNarrow();
+    testSplit();
+    testSplitSmall();
+    testStrip();
+
+    return dxowl_test::result();
+}
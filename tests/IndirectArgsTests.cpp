@@ -0,0 +1,116 @@
+/// <copyright file="IndirectArgsTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstring>
+#include <vector>
+
+#include <dxowl/IndirectArgs.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    // D3D11_PRIMITIVE_TOPOLOGY values, spelled out since this test builds without D3D11 headers
+    constexpr uint32_t pointlist = 1;
+    constexpr uint32_t linestrip = 3;
+    constexpr uint32_t trianglelist = 4;
+    constexpr uint32_t trianglestrip = 5;
+    constexpr uint32_t trianglelist_adj = 12;
+    constexpr uint32_t patchlist_3 = 35;
+
+    void testEncode()
+    {
+        DrawIndexedInstancedArgs args = encodeDrawIndexedInstancedArgs(36, 2, 120, -8, 5);
+        DXOWL_CHECK(args.index_count_per_instance == 36);
+        DXOWL_CHECK(args.instance_count == 2);
+        DXOWL_CHECK(args.start_index_location == 120);
+        DXOWL_CHECK(args.base_vertex_location == -8);
+        DXOWL_CHECK(args.start_instance_location == 5);
+
+        // buffer layout is five consecutive 32 bit values in the order of the DrawIndexedInstanced parameters
+        std::vector<DrawIndexedInstancedArgs> records = { args, encodeDrawIndexedInstancedArgs(3, 1, 0, 0, 0) };
+        uint32_t words[10] = {};
+        writeDrawIndexedInstancedArgs(records.data(), records.size(), words);
+        int32_t base_vertex;
+        std::memcpy(&base_vertex, &words[3], sizeof(base_vertex));
+        DXOWL_CHECK(words[0] == 36 && words[1] == 2 && words[2] == 120 && base_vertex == -8 && words[4] == 5);
+        DXOWL_CHECK(words[5] == 3 && words[6] == 1 && words[7] == 0 && words[8] == 0 && words[9] == 0);
+    }
+
+    void testPrimitiveIndexCount()
+    {
+        DXOWL_CHECK(computeListPrimitiveIndexCount(pointlist) == 1);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(trianglelist) == 3);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(trianglelist_adj) == 6);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(patchlist_3) == 3);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(linestrip) == 0);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(trianglestrip) == 0);
+        DXOWL_CHECK(computeListPrimitiveIndexCount(0) == 0);
+    }
+
+    std::vector<DrawIndexedInstancedArgs> makeRecords()
+    {
+        return {
+            encodeDrawIndexedInstancedArgs(6, 1, 0, 0, 0),
+            encodeDrawIndexedInstancedArgs(0, 1, 6, 0, 0),      // empty, removed
+            encodeDrawIndexedInstancedArgs(9, 1, 6, 0, 0),      // continues the first record
+            encodeDrawIndexedInstancedArgs(3, 0, 15, 0, 0),     // no instances, removed
+            encodeDrawIndexedInstancedArgs(3, 1, 15, 0, 0),     // continues again
+            encodeDrawIndexedInstancedArgs(3, 1, 18, 4, 0),     // different base vertex
+            encodeDrawIndexedInstancedArgs(3, 2, 21, 4, 0),     // different instance count
+            encodeDrawIndexedInstancedArgs(3, 2, 30, 4, 0),     // gap in the index range
+        };
+    }
+
+    void testCompactList()
+    {
+        std::vector<DrawIndexedInstancedArgs> records = makeRecords();
+        size_t removed = compactDrawIndexedInstancedArgs(records, trianglelist);
+        DXOWL_CHECK(removed == 4);
+        DXOWL_CHECK(records.size() == 4);
+        DXOWL_CHECK(records[0].start_index_location == 0 && records[0].index_count_per_instance == 18);
+        DXOWL_CHECK(records[1].start_index_location == 18 && records[1].base_vertex_location == 4);
+        DXOWL_CHECK(records[2].start_index_location == 21 && records[2].instance_count == 2);
+        DXOWL_CHECK(records[3].start_index_location == 30);
+    }
+
+    void testCompactPartialPrimitive()
+    {
+        // a range that does not end on a whole triangle must not absorb the next one
+        std::vector<DrawIndexedInstancedArgs> records = {
+            encodeDrawIndexedInstancedArgs(4, 1, 0, 0, 0),
+            encodeDrawIndexedInstancedArgs(3, 1, 4, 0, 0),
+        };
+        DXOWL_CHECK(compactDrawIndexedInstancedArgs(records, trianglelist) == 0);
+        DXOWL_CHECK(records.size() == 2);
+    }
+
+    void testCompactStrip()
+    {
+        // strips only lose empty records, merging would connect them
+        for (uint32_t topology : { trianglestrip, linestrip, uint32_t(0) })
+        {
+            std::vector<DrawIndexedInstancedArgs> records = makeRecords();
+            size_t removed = compactDrawIndexedInstancedArgs(records, topology);
+            DXOWL_CHECK(removed == 2);
+            DXOWL_CHECK(records.size() == 6);
+            DXOWL_CHECK(records[0].index_count_per_instance == 6);
+            DXOWL_CHECK(records[1].start_index_location == 6 && records[1].index_count_per_instance == 9);
+        }
+    }
+} // namespace
+
+int main()
+{
+    testEncode();
+    testPrimitiveIndexCount();
+    testCompactList();
+    testCompactPartialPrimitive();
+    testCompactStrip();
+    return dxowl_test::result();
+}
@@ -0,0 +1,119 @@
+/// <copyright file="InputLayoutCacheTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dxowl/InputLayoutCache.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    void appendUint32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        uint8_t const* value_bytes = reinterpret_cast<uint8_t const*>(&value);
+        bytes.insert(bytes.end(), value_bytes, value_bytes + 4);
+    }
+
+    /// DXBC container with an input signature chunk and a code chunk. Only the layout the cache parses
+    /// is filled in, digest and version stay zero.
+    std::vector<uint8_t> makeShader(std::string const& signature, std::string const& code)
+    {
+        std::vector<uint8_t> retval = { 'D', 'X', 'B', 'C' };
+        retval.resize(28, 0);
+        appendUint32(retval, 2);
+        uint32_t const signature_offset = 32 + 2 * 4;
+        uint32_t const code_offset = signature_offset + 8 + static_cast<uint32_t>(signature.size());
+        appendUint32(retval, signature_offset);
+        appendUint32(retval, code_offset);
+
+        for (auto const& chunk : { std::make_pair("ISGN", signature), std::make_pair("SHEX", code) })
+        {
+            retval.insert(retval.end(), chunk.first, chunk.first + 4);
+            appendUint32(retval, static_cast<uint32_t>(chunk.second.size()));
+            retval.insert(retval.end(), chunk.second.begin(), chunk.second.end());
+        }
+        return retval;
+    }
+
+    VertexDescriptor makeLayout(LPCSTR semantic_name, DXGI_FORMAT format)
+    {
+        return { 12, { { semantic_name, 0, format, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+    }
+
+    void testHitsAndMisses()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        InputLayoutCache cache;
+
+        std::vector<uint8_t> const shader = makeShader("POSITION", "code a");
+        std::vector<uint8_t> const same_inputs = makeShader("POSITION", "code b");
+        std::vector<uint8_t> const other_inputs = makeShader("POSITION NORMAL", "code a");
+        std::vector<VertexDescriptor> const layout = { makeLayout("POSITION", DXGI_FORMAT_R32G32B32_FLOAT) };
+
+        auto const first = cache.getInputLayout(device.Get(), layout, shader.data(), shader.size());
+        DXOWL_CHECK(first != nullptr && device->input_layout_cnt == 1);
+
+        // a different vertex shader with the same input signature shares the layout
+        std::string const name = "position";
+        std::vector<VertexDescriptor> const equal_layout = { makeLayout(name.c_str(), DXGI_FORMAT_R32G32B32_FLOAT) };
+        DXOWL_CHECK(cache.getInputLayout(device.Get(), layout, same_inputs.data(), same_inputs.size()) == first);
+        DXOWL_CHECK(cache.getInputLayout(device.Get(), equal_layout, shader.data(), shader.size()) == first);
+        DXOWL_CHECK(device->input_layout_cnt == 1);
+
+        // a different signature or vertex layout does not
+        auto const second = cache.getInputLayout(device.Get(), layout, other_inputs.data(), other_inputs.size());
+        std::vector<VertexDescriptor> const half_layout = { makeLayout("POSITION", DXGI_FORMAT_R16G16B16A16_FLOAT) };
+        auto const third = cache.getInputLayout(device.Get(), half_layout, shader.data(), shader.size());
+        DXOWL_CHECK(second != first && third != first && third != second);
+        DXOWL_CHECK(device->input_layout_cnt == 3);
+
+        InputLayoutCache::Statistics stats = cache.getStatistics();
+        DXOWL_CHECK(stats.hits == 2 && stats.misses == 3 && stats.layout_count == 3);
+
+        // the created layouts point to semantic names owned by the cache
+        auto const* created = static_cast<dxowl_test::RecordingInputLayout*>(first.Get());
+        DXOWL_CHECK(created->elements.size() == 1);
+        DXOWL_CHECK(created->elements[0].SemanticName == cache.internSemanticName("POSITION"));
+        DXOWL_CHECK(cache.internSemanticName(name.c_str()) != cache.internSemanticName("POSITION"));
+        DXOWL_CHECK(cache.getStatistics().semantic_name_count == 2);
+
+        cache.clear();
+        stats = cache.getStatistics();
+        DXOWL_CHECK(stats.hits == 0 && stats.misses == 0 && stats.layout_count == 0 && stats.semantic_name_count == 2);
+        DXOWL_CHECK(cache.getInputLayout(device.Get(), layout, shader.data(), shader.size()) != first);
+        DXOWL_CHECK(device->input_layout_cnt == 4);
+    }
+
+    void testUnparsedBytecode()
+    {
+        // without a DXBC container the whole bytecode is the key
+        auto device = dxowl_test::createRecordingDevice();
+        InputLayoutCache cache;
+        std::vector<VertexDescriptor> const layout = { makeLayout("POSITION", DXGI_FORMAT_R32G32B32_FLOAT) };
+        std::vector<uint8_t> const a = { 1, 2, 3, 4 };
+        std::vector<uint8_t> const b = { 1, 2, 3, 5 };
+
+        auto const first = cache.getInputLayout(device.Get(), layout, a.data(), a.size());
+        DXOWL_CHECK(cache.getInputLayout(device.Get(), layout, a.data(), a.size()) == first);
+        DXOWL_CHECK(cache.getInputLayout(device.Get(), layout, b.data(), b.size()) != first);
+        DXOWL_CHECK(cache.getStatistics().hits == 1 && cache.getStatistics().misses == 2);
+    }
+} // namespace
+
+int main()
+{
+    testHitsAndMisses();
+    testUnparsedBytecode();
+
+    return dxowl_test::result();
+}
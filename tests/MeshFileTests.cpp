@@ -0,0 +1,288 @@
+/// <copyright file="MeshFileTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dxowl/Lz4.hpp>
+#include <dxowl/MeshFile.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    struct Position
+    {
+        float x, y, z;
+    };
+
+    struct TexCoord
+    {
+        float u, v;
+    };
+
+    /// Indexed grid of quads, large and regular enough for LZ4 to pay off.
+    struct Grid
+    {
+        std::vector<Position> positions;
+        std::vector<TexCoord> tex_coords;
+        std::vector<uint32_t> indices;
+
+        explicit Grid(uint32_t size)
+        {
+            for (uint32_t y = 0; y <= size; ++y)
+            {
+                for (uint32_t x = 0; x <= size; ++x)
+                {
+                    positions.push_back({ float(x), 0.0f, float(y) });
+                    tex_coords.push_back({ float(x) / size, float(y) / size });
+                }
+            }
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    uint32_t const v = y * (size + 1) + x;
+                    indices.insert(indices.end(), { v, v + size + 1, v + 1, v + 1, v + size + 1, v + size + 2 });
+                }
+            }
+        }
+    };
+
+    std::vector<VertexDescriptor> makeLayout()
+    {
+        return {
+            { sizeof(Position), { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+            { sizeof(TexCoord), { { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+        };
+    }
+
+    std::string tempPath(std::string const& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("dxowl_" + name)).string();
+    }
+
+    std::vector<uint8_t> readBytes(std::string const& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(std::string const& path, std::vector<uint8_t> const& bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    bool throwsRuntimeError(std::string const& path)
+    {
+        try
+        {
+            MeshFile file(path);
+        }
+        catch (std::runtime_error const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    template <typename Function>
+    bool throwsInvalidArgument(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (std::invalid_argument const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void checkGrid(MeshFile const& file, Grid const& grid, DXGI_FORMAT index_format)
+    {
+        DXOWL_CHECK(file.getIndexFormat() == index_format);
+        DXOWL_CHECK(file.getPrimitiveTopology() == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        // semantic names are read back from the file, not the pointers of the writer
+        std::vector<VertexDescriptor> const& layout = file.getVertexLayout();
+        DXOWL_CHECK(layout.size() == 2);
+        DXOWL_CHECK(layout == makeLayout());
+        DXOWL_CHECK(layout[1].attributes[0].InputSlot == 1);
+
+        DXOWL_CHECK(file.getVertexData().size() == 2);
+        DXOWL_CHECK(file.getVertexDataByteSizes()[0] == grid.positions.size() * sizeof(Position));
+        DXOWL_CHECK(file.getVertexDataByteSizes()[1] == grid.tex_coords.size() * sizeof(TexCoord));
+        DXOWL_CHECK(std::memcmp(file.getVertexData()[0], grid.positions.data(), file.getVertexDataByteSizes()[0]) == 0);
+        DXOWL_CHECK(std::memcmp(file.getVertexData()[1], grid.tex_coords.data(), file.getVertexDataByteSizes()[1]) == 0);
+
+        if (index_format == DXGI_FORMAT_R32_UINT)
+        {
+            DXOWL_CHECK(file.getIndexDataByteSize() == grid.indices.size() * 4);
+            DXOWL_CHECK(std::memcmp(file.getIndexData(), grid.indices.data(), file.getIndexDataByteSize()) == 0);
+        }
+        else
+        {
+            std::vector<uint16_t> const indices(grid.indices.begin(), grid.indices.end());
+            DXOWL_CHECK(file.getIndexDataByteSize() == indices.size() * 2);
+            DXOWL_CHECK(std::memcmp(file.getIndexData(), indices.data(), file.getIndexDataByteSize()) == 0);
+        }
+    }
+
+    void testRoundTrip()
+    {
+        Grid const grid(32);
+        std::vector<uint16_t> const indices16(grid.indices.begin(), grid.indices.end());
+
+        for (bool compress : { false, true })
+        {
+            for (DXGI_FORMAT index_format : { DXGI_FORMAT_R16_UINT, DXGI_FORMAT_R32_UINT })
+            {
+                MeshFileWriter writer(makeLayout(), index_format);
+                writer.setVertexData(0, grid.positions);
+                writer.setVertexData(1, grid.tex_coords);
+                if (index_format == DXGI_FORMAT_R16_UINT)
+                {
+                    writer.setIndexData(indices16);
+                }
+                else
+                {
+                    writer.setIndexData(grid.indices);
+                }
+
+                std::string const path = tempPath(compress ? "compressed.dxmf" : "raw.dxmf");
+                writer.write(path, compress);
+
+                {
+                    MeshFile file(path);
+                    checkGrid(file, grid, index_format);
+                    DXOWL_CHECK(file.isZeroCopy() == !compress);
+
+                    // uncompressed streams point into the mapping at 64 byte aligned offsets
+                    if (!compress)
+                    {
+                        DXOWL_CHECK(reinterpret_cast<uintptr_t>(file.getVertexData()[1]) % 64 == 0);
+                        DXOWL_CHECK(reinterpret_cast<uintptr_t>(file.getIndexData()) % 64 == 0);
+                    }
+                }
+
+                if (compress)
+                {
+                    ThreadPool thread_pool(2);
+                    MeshFile file(path, &thread_pool);
+                    checkGrid(file, grid, index_format);
+                }
+
+                std::filesystem::remove(path);
+            }
+        }
+
+        // the regular grid must shrink, otherwise the streams would have been stored as is
+        MeshFileWriter writer(makeLayout(), DXGI_FORMAT_R32_UINT);
+        writer.setVertexData(0, grid.positions);
+        writer.setVertexData(1, grid.tex_coords);
+        writer.setIndexData(grid.indices);
+        std::string const raw_path = tempPath("size_raw.dxmf");
+        std::string const compressed_path = tempPath("size_compressed.dxmf");
+        writer.write(raw_path);
+        writer.write(compressed_path, true);
+        DXOWL_CHECK(std::filesystem::file_size(compressed_path) < std::filesystem::file_size(raw_path) / 2);
+        std::filesystem::remove(raw_path);
+        std::filesystem::remove(compressed_path);
+    }
+
+    void testBadFiles()
+    {
+        Grid const grid(8);
+        MeshFileWriter writer(makeLayout(), DXGI_FORMAT_R32_UINT);
+        writer.setVertexData(0, grid.positions);
+        writer.setVertexData(1, grid.tex_coords);
+        writer.setIndexData(grid.indices);
+
+        std::string const path = tempPath("bad.dxmf");
+        writer.write(path, true);
+        std::vector<uint8_t> const good = readBytes(path);
+        DXOWL_CHECK(!throwsRuntimeError(path));
+
+        DXOWL_CHECK(throwsRuntimeError(tempPath("missing.dxmf")));
+
+        writeBytes(path, std::vector<uint8_t>(good.begin(), good.begin() + 16));
+        DXOWL_CHECK(throwsRuntimeError(path));
+
+        std::vector<uint8_t> bytes = good;
+        bytes[4] = 2; // version
+        writeBytes(path, bytes);
+        DXOWL_CHECK(throwsRuntimeError(path));
+
+        // stream data cut off
+        writeBytes(path, std::vector<uint8_t>(good.begin(), good.end() - 8));
+        DXOWL_CHECK(throwsRuntimeError(path));
+
+        // an uncompressed size the LZ4 stream does not decode to; the positions are compressed
+        bytes = good;
+        uint64_t byte_size;
+        std::memcpy(&byte_size, &bytes[32 + 16], sizeof(byte_size));
+        byte_size -= sizeof(Position);
+        std::memcpy(&bytes[32 + 16], &byte_size, sizeof(byte_size));
+        writeBytes(path, bytes);
+        DXOWL_CHECK(throwsRuntimeError(path));
+
+        std::filesystem::remove(path);
+    }
+
+    void testWriterErrors()
+    {
+        std::vector<VertexDescriptor> const layout = makeLayout();
+        DXOWL_CHECK(throwsInvalidArgument([&]() { MeshFileWriter writer(layout, DXGI_FORMAT_R8_UINT); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { MeshFileWriter writer({ { 0, {} } }, DXGI_FORMAT_R16_UINT); }));
+
+        MeshFileWriter writer(layout, DXGI_FORMAT_R32_UINT);
+        uint8_t const bytes[16] = {};
+        DXOWL_CHECK(throwsInvalidArgument([&]() { writer.setVertexData(0, bytes, 10); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { writer.setVertexData(2, bytes, 12); }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() { writer.setIndexData(bytes, 6); }));
+    }
+
+    void testLz4()
+    {
+        std::vector<uint8_t> data(4096);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = uint8_t((i / 7) % 13);
+        }
+
+        std::vector<uint8_t> const compressed = lz4::compress(data.data(), data.size());
+        DXOWL_CHECK(compressed.size() < data.size() / 4);
+
+        std::vector<uint8_t> decoded(data.size());
+        DXOWL_CHECK(lz4::decompress(compressed.data(), compressed.size(), decoded.data(), decoded.size()));
+        DXOWL_CHECK(decoded == data);
+
+        // wrong output size and truncated input are reported, not decoded partially
+        DXOWL_CHECK(!lz4::decompress(compressed.data(), compressed.size(), decoded.data(), decoded.size() - 1));
+        DXOWL_CHECK(!lz4::decompress(compressed.data(), compressed.size() / 2, decoded.data(), decoded.size()));
+    }
+} // namespace
+
+int main()
+{
+    testRoundTrip();
+    testBadFiles();
+    testWriterErrors();
+    testLz4();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,198 @@
+/// <copyright file="MeshOptimizerTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/MeshOptimizer.hpp>
+
+#include "TestCheck.hpp"
+#include "TestMesh.hpp"
+
+using namespace dxowl;
+using dxowl_test::TestMesh;
+
+namespace
+{
+    VertexDescriptor const position_layout = { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+    VertexDescriptor const id_layout = { 4, { { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+
+    /// Triangles as original vertex ids, rotated to start with the smallest id so that winding is kept.
+    std::vector<std::array<uint32_t, 3>> collectTriangles(uint32_t const* indices, size_t index_count, std::vector<uint32_t> const& ids)
+    {
+        std::vector<std::array<uint32_t, 3>> retval;
+        for (size_t i = 0; i + 2 < index_count; i += 3)
+        {
+            std::array<uint32_t, 3> triangle = { ids[indices[i]], ids[indices[i + 1]], ids[indices[i + 2]] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            retval.push_back(triangle);
+        }
+        std::sort(retval.begin(), retval.end());
+        return retval;
+    }
+
+    bool isFirstUseOrder(std::vector<uint32_t> const& indices)
+    {
+        uint32_t next = 0;
+        for (uint32_t index : indices)
+        {
+            if (index > next)
+            {
+                return false;
+            }
+            next = index == next ? next + 1 : next;
+        }
+        return true;
+    }
+
+    template <typename Function>
+    bool throwsInvalidArgument(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (std::invalid_argument const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testOptimize()
+    {
+        TestMesh const original = dxowl_test::makeTestSphere(40);
+        auto const reference = collectTriangles(original.indices.data(), original.indices.size(), original.ids);
+        ThreadPool thread_pool(2);
+
+        for (auto algorithm : { MeshOptimizer::Algorithm::Tipsify, MeshOptimizer::Algorithm::Forsyth })
+        {
+            for (float overdraw_threshold : { 0.0f, 1.05f })
+            {
+                TestMesh mesh = original;
+                MeshOptimizer::Settings settings;
+                settings.algorithm = algorithm;
+                settings.overdraw_threshold = overdraw_threshold;
+
+                MeshOptimizer::Report const report = MeshOptimizer::optimize(
+                    { mesh.positions.data(), mesh.ids.data() },
+                    mesh.vertex_count,
+                    { position_layout, id_layout },
+                    mesh.indices.data(),
+                    mesh.indices.size(),
+                    DXGI_FORMAT_R32_UINT,
+                    {},
+                    settings,
+                    algorithm == MeshOptimizer::Algorithm::Forsyth ? &thread_pool : nullptr);
+
+                // same triangles with the same winding, and every stream was permuted alike
+                DXOWL_CHECK(collectTriangles(mesh.indices.data(), mesh.indices.size(), mesh.ids) == reference);
+                bool consistent = true;
+                for (size_t v = 0; v < mesh.vertex_count; ++v)
+                {
+                    consistent = consistent && std::memcmp(&mesh.positions[v * 3], &original.positions[mesh.ids[v] * 3], 12) == 0;
+                }
+                DXOWL_CHECK(consistent);
+                DXOWL_CHECK(isFirstUseOrder(mesh.indices));
+
+                // shuffled triangles transform nearly every vertex three times
+                DXOWL_CHECK(report.before.triangles == 3200 && report.before.acmr > 2.5f);
+                DXOWL_CHECK(report.after.acmr < 0.8f && report.after.atvr < 1.5f);
+                DXOWL_CHECK(report.overdraw_sorted == (overdraw_threshold > 0.0f));
+                DXOWL_CHECK(report.cluster_count > 0);
+
+                MeshOptimizer::CacheStatistics const after = MeshOptimizer::analyzeVertexCache(
+                    mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT, mesh.vertex_count, {});
+                DXOWL_CHECK(after.vertices_transformed == report.after.vertices_transformed);
+            }
+        }
+    }
+
+    void testSubmeshes()
+    {
+        // two submeshes sharing vertices, 16 bit indices, vertex fetch left alone
+        TestMesh const original = dxowl_test::makeTestSphere(20);
+        std::vector<uint16_t> indices(original.indices.begin(), original.indices.end());
+        UINT const split = 3 * 300;
+        std::vector<MeshOptimizer::Submesh> const submeshes = { { 0, split }, { split, UINT(indices.size()) - split } };
+
+        std::vector<uint32_t> const wide(indices.begin(), indices.end());
+        auto const first = collectTriangles(wide.data(), split, original.ids);
+        auto const second = collectTriangles(wide.data() + split, wide.size() - split, original.ids);
+
+        TestMesh mesh = original;
+        MeshOptimizer::Settings settings;
+        settings.optimize_vertex_fetch = false;
+        MeshOptimizer::Report const report = MeshOptimizer::optimize(
+            { mesh.positions.data() }, mesh.vertex_count, { position_layout }, indices.data(), indices.size(), DXGI_FORMAT_R16_UINT, submeshes, settings);
+
+        std::vector<uint32_t> const result = MeshOptimizer::readIndices(indices.data(), indices.size(), DXGI_FORMAT_R16_UINT);
+        DXOWL_CHECK(collectTriangles(result.data(), split, original.ids) == first);
+        DXOWL_CHECK(collectTriangles(result.data() + split, result.size() - split, original.ids) == second);
+        DXOWL_CHECK(mesh.positions == original.positions);
+        DXOWL_CHECK(report.after.acmr < report.before.acmr);
+    }
+
+    void testInstanceStreams()
+    {
+        // per-instance streams have no per-vertex elements and must not be reordered
+        TestMesh mesh = dxowl_test::makeTestSphere(8);
+        std::vector<uint32_t> instances = { 10, 11, 12 };
+        VertexDescriptor const instance_layout = { 4, { { "TEXCOORD", 1, DXGI_FORMAT_R32_UINT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 } } };
+
+        MeshOptimizer::optimize(
+            { mesh.positions.data(), instances.data() }, mesh.vertex_count, { position_layout, instance_layout }, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT);
+        DXOWL_CHECK((instances == std::vector<uint32_t>{ 10, 11, 12 }));
+        DXOWL_CHECK(isFirstUseOrder(mesh.indices));
+    }
+
+    void testErrors()
+    {
+        TestMesh mesh = dxowl_test::makeTestSphere(4);
+        std::vector<void*> const streams = { mesh.positions.data() };
+        std::vector<VertexDescriptor> const layout = { position_layout };
+
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::optimize({}, mesh.vertex_count, layout, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT);
+        }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::optimize(streams, mesh.vertex_count, layout, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R8_UINT);
+        }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::Settings settings;
+            settings.cache_size = 0;
+            MeshOptimizer::optimize(streams, mesh.vertex_count, layout, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT, {}, settings);
+        }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::optimize(streams, mesh.vertex_count, layout, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT, { { 0, 4 } });
+        }));
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::optimize(streams, mesh.vertex_count, layout, mesh.indices.data(), mesh.indices.size(), DXGI_FORMAT_R32_UINT, { { 3, UINT(mesh.indices.size()) } });
+        }));
+
+        // an index past the vertex count is rejected before anything is written
+        std::vector<uint32_t> indices = mesh.indices;
+        indices[5] = uint32_t(mesh.vertex_count);
+        std::vector<uint32_t> const unchanged = indices;
+        DXOWL_CHECK(throwsInvalidArgument([&]() {
+            MeshOptimizer::optimize(streams, mesh.vertex_count, layout, indices.data(), indices.size(), DXGI_FORMAT_R32_UINT);
+        }));
+        DXOWL_CHECK(indices == unchanged);
+    }
+} // namespace
+
+int main()
+{
+    testOptimize();
+    testSubmeshes();
+    testInstanceStreams();
+    testErrors();
+
+    return dxowl_test::result();
+}
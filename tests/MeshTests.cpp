@@ -0,0 +1,172 @@
+/// <copyright file="MeshTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/Mesh.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// A quad with a per-vertex position stream and two per-instance streams: 16 byte offsets every instance and
+// 4 byte colors every second instance. The instance buffers are created empty with room for 4 instances.
+namespace
+{
+    typedef std::array<float, 4> InstanceOffset;
+
+    template <typename Exception, typename Function>
+    bool throws(Function const& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+        }
+        return false;
+    }
+
+    Mesh makeQuad(ID3D11Device4* d3d11_device)
+    {
+        std::vector<float> const positions = { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 };
+        std::vector<uint16_t> const indices = { 0, 1, 2, 0, 2, 3 };
+        std::vector<VertexDescriptor> const layout = {
+            { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } },
+            { 16, { { "TEXCOORD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 } } },
+            { 4, { { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 2, 0, D3D11_INPUT_PER_INSTANCE_DATA, 2 } } },
+        };
+
+        return Mesh(
+            d3d11_device,
+            std::vector<void const*>{ positions.data(), nullptr, nullptr },
+            std::vector<size_t>{ positions.size() * sizeof(float), 4 * sizeof(InstanceOffset), 4 * sizeof(uint32_t) },
+            indices.data(),
+            indices.size() * sizeof(uint16_t),
+            layout,
+            DXGI_FORMAT_R16_UINT);
+    }
+
+    std::vector<InstanceOffset> makeOffsets(size_t count)
+    {
+        std::vector<InstanceOffset> retval;
+        for (size_t i = 0; i < count; ++i)
+        {
+            retval.push_back({ float(i), 0.0f, float(i) * 2.0f, 1.0f });
+        }
+        return retval;
+    }
+
+    /// Buffer, stride and offset of a slot in a recorded IASetVertexBuffers call starting at slot 0.
+    dxowl_test::RecordingBuffer* boundBuffer(dxowl_test::RecordedCall const& call, size_t slot)
+    {
+        return static_cast<dxowl_test::RecordingBuffer*>(reinterpret_cast<ID3D11Buffer*>(static_cast<uintptr_t>(call.args[2 + slot * 3])));
+    }
+
+    uint64_t boundStride(dxowl_test::RecordedCall const& call, size_t slot)
+    {
+        return call.args[3 + slot * 3];
+    }
+
+    uint64_t boundOffset(dxowl_test::RecordedCall const& call, size_t slot)
+    {
+        return call.args[4 + slot * 3];
+    }
+
+    void testInstanceData()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        Mesh mesh = makeQuad(device.Get());
+        DXOWL_CHECK(mesh.getInstanceCount() == 0);
+        DXOWL_CHECK(mesh.getMemoryByteSize() == 48 + 64 + 16 + 12);
+
+        // instances that fit are written with a discard, without creating a buffer
+        size_t const buffer_cnt = device->buffer_cnt;
+        std::vector<InstanceOffset> offsets = makeOffsets(3);
+        mesh.setInstanceData(device.Get(), ctx, 1, offsets);
+        DXOWL_CHECK(mesh.getInstanceCount() == 3);
+        DXOWL_CHECK(device->buffer_cnt == buffer_cnt);
+        std::vector<dxowl_test::RecordedCall> const maps = ctx->findCalls("Map");
+        DXOWL_CHECK(maps.size() == 1 && maps[0].args[2] == D3D11_MAP_WRITE_DISCARD);
+
+        mesh.setVertexBuffers(ctx, 0);
+        dxowl_test::RecordingBuffer* instance_buffer = boundBuffer(ctx->findCalls("IASetVertexBuffers").back(), 1);
+        DXOWL_CHECK(std::memcmp(instance_buffer->data.data(), offsets.data(), offsets.size() * sizeof(InstanceOffset)) == 0);
+
+        // more instances grow the buffer to 1.5 times the required size, the memory tracking follows
+        offsets = makeOffsets(10);
+        mesh.setInstanceData(device.Get(), ctx, 1, offsets);
+        DXOWL_CHECK(device->buffer_cnt == buffer_cnt + 1);
+        DXOWL_CHECK(mesh.getVertexBufferByteSize(1) == 240);
+        DXOWL_CHECK(mesh.getMemoryByteSize() == 48 + 240 + 16 + 12);
+        DXOWL_CHECK(mesh.getInstanceCount() == 10);
+
+        mesh.setVertexBuffers(ctx, 0);
+        instance_buffer = boundBuffer(ctx->findCalls("IASetVertexBuffers").back(), 1);
+        DXOWL_CHECK(instance_buffer->desc.ByteWidth == 240);
+        DXOWL_CHECK(std::memcmp(instance_buffer->data.data(), offsets.data(), offsets.size() * sizeof(InstanceOffset)) == 0);
+
+        // fewer instances reuse the grown buffer
+        mesh.setInstanceData(device.Get(), ctx, 1, makeOffsets(12));
+        mesh.setInstanceData(device.Get(), ctx, 2, std::vector<uint32_t>(2, 0xFF00FF00u));
+        DXOWL_CHECK(device->buffer_cnt == buffer_cnt + 1);
+        DXOWL_CHECK(mesh.getInstanceCount() == 2);
+
+        // only per-instance slots take instance data
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { mesh.setInstanceData(device.Get(), ctx, 0, offsets); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { mesh.setInstanceData(device.Get(), ctx, 3, offsets); }));
+    }
+
+    void testDrawInstanced()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        Mesh mesh = makeQuad(device.Get());
+        mesh.setInstanceData(device.Get(), ctx, 1, makeOffsets(8));
+
+        // one draw for all instances, base vertex and base instance are applied through the binding offsets
+        ctx->calls.clear();
+        mesh.drawInstanced(ctx, 6, mesh.getInstanceCount(), 3, 2, 4);
+        DXOWL_CHECK(ctx->countCalls("DrawIndexedInstanced") == 1);
+        DXOWL_CHECK((ctx->findCalls("DrawIndexedInstanced")[0].args == std::vector<uint64_t>{ 6, 8, 0, 0, 0 }));
+        DXOWL_CHECK((ctx->findCalls("IASetIndexBuffer")[0].args[1] == DXGI_FORMAT_R16_UINT));
+        DXOWL_CHECK((ctx->findCalls("IASetIndexBuffer")[0].args[2] == 3 * sizeof(uint16_t)));
+        DXOWL_CHECK((ctx->findCalls("IASetPrimitiveTopology")[0].args[0] == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
+
+        dxowl_test::RecordedCall const bindings = ctx->findCalls("IASetVertexBuffers")[0];
+        DXOWL_CHECK(bindings.args[0] == 0 && bindings.args[1] == 3);
+        DXOWL_CHECK(boundStride(bindings, 0) == 12 && boundOffset(bindings, 0) == 2 * 12);
+        DXOWL_CHECK(boundStride(bindings, 1) == 16 && boundOffset(bindings, 1) == 4 * 16);
+        DXOWL_CHECK(boundStride(bindings, 2) == 4 && boundOffset(bindings, 2) == 4 / 2 * 4);
+
+        // the color slot advances every second instance, so base_instance has to be even
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { mesh.drawInstanced(ctx, 6, 8, 0, 0, 3); }));
+
+        // no instances, no calls
+        ctx->calls.clear();
+        mesh.drawInstanced(ctx, 6, 0);
+        DXOWL_CHECK(ctx->calls.empty());
+    }
+} // namespace
+
+int main()
+{
+    testInstanceData();
+    testDrawInstanced();
+
+    return dxowl_test::result();
+}
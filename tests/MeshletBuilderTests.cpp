@@ -0,0 +1,277 @@
+/// <copyright file="MeshletBuilderTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <dxowl/MeshletBuilder.hpp>
+#include <dxowl/MeshletCuller.hpp>
+
+#include "TestCheck.hpp"
+#include "TestMesh.hpp"
+#ifndef _WIN32
+#include "RecordingDevice.hpp"
+#endif
+
+using namespace dxowl;
+
+// Meshlets of a unit sphere, checked against the triangles they were built from. The culler is compared with
+// the scalar tests it documents and, for back faces, with the facing of every triangle of a culled meshlet.
+namespace
+{
+    VertexDescriptor const position_layout = { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } };
+
+    struct Sphere
+    {
+        dxowl_test::TestMesh mesh;
+        std::vector<MeshletBuilder::Meshlet> meshlets;
+    };
+
+    Sphere buildSphere(uint32_t segments)
+    {
+        Sphere retval;
+        retval.mesh = dxowl_test::makeTestSphere(segments);
+        retval.meshlets = MeshletBuilder::build(
+            { retval.mesh.positions.data() },
+            retval.mesh.vertex_count,
+            { position_layout },
+            retval.mesh.indices.data(),
+            retval.mesh.indices.size(),
+            DXGI_FORMAT_R32_UINT);
+        return retval;
+    }
+
+    std::array<float, 3> position(dxowl_test::TestMesh const& mesh, uint32_t index)
+    {
+        return { mesh.positions[index * 3], mesh.positions[index * 3 + 1], mesh.positions[index * 3 + 2] };
+    }
+
+    std::vector<std::array<uint32_t, 3>> sortedTriangles(std::vector<uint32_t> const& indices)
+    {
+        // rotate every triangle to start at its smallest index, which keeps the winding
+        std::vector<std::array<uint32_t, 3>> retval;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::array<uint32_t, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            retval.push_back(triangle);
+        }
+        std::sort(retval.begin(), retval.end());
+        return retval;
+    }
+
+    /// True if no triangle of the meshlet faces the eye, with the clockwise front faces of the builder default.
+    bool allBackFacing(dxowl_test::TestMesh const& mesh, MeshletBuilder::Meshlet const& meshlet, float const (&eye)[3])
+    {
+        for (UINT i = meshlet.first_index; i < meshlet.first_index + meshlet.index_count; i += 3)
+        {
+            std::array<float, 3> const p0 = position(mesh, mesh.indices[i]);
+            std::array<float, 3> const p1 = position(mesh, mesh.indices[i + 1]);
+            std::array<float, 3> const p2 = position(mesh, mesh.indices[i + 2]);
+            float const e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            float const e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            float const n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            if (n[0] * (eye[0] - p0[0]) + n[1] * (eye[1] - p0[1]) + n[2] * (eye[2] - p0[2]) > 1e-6f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    MeshletCuller::View makeView(float x, float y, float z)
+    {
+        // planes far outside the unit sphere, so only the ones a test sets can cull
+        MeshletCuller::View retval = {};
+        for (auto& plane : retval.frustum_planes)
+        {
+            plane[0] = 1.0f;
+            plane[3] = 100.0f;
+        }
+        retval.camera_position[0] = x;
+        retval.camera_position[1] = y;
+        retval.camera_position[2] = z;
+        return retval;
+    }
+
+    void testBuild()
+    {
+        Sphere const sphere = buildSphere(64);
+        std::vector<uint32_t> const original = dxowl_test::makeTestSphere(64).indices;
+
+        // the meshlets tile the index buffer, which keeps the same triangles with the same winding
+        bool within_limits = true;
+        bool contiguous = true;
+        bool bounded = true;
+        UINT next_index = 0;
+        for (auto const& meshlet : sphere.meshlets)
+        {
+            within_limits = within_limits && meshlet.vertex_count <= 64 && meshlet.index_count / 3 <= 124 && meshlet.index_count > 0;
+            contiguous = contiguous && meshlet.first_index == next_index && meshlet.submesh == 0;
+            next_index = meshlet.first_index + meshlet.index_count;
+
+            std::vector<uint32_t> vertices(sphere.mesh.indices.begin() + meshlet.first_index, sphere.mesh.indices.begin() + next_index);
+            std::sort(vertices.begin(), vertices.end());
+            within_limits = within_limits && size_t(std::unique(vertices.begin(), vertices.end()) - vertices.begin()) == meshlet.vertex_count;
+
+            // every vertex lies inside the bounding sphere
+            for (uint32_t vertex : vertices)
+            {
+                std::array<float, 3> const p = position(sphere.mesh, vertex);
+                float const d[3] = { p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2] };
+                bounded = bounded && std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) <= meshlet.radius * 1.0001f;
+            }
+        }
+        DXOWL_CHECK(within_limits && contiguous && bounded);
+        DXOWL_CHECK(next_index == sphere.mesh.indices.size());
+        DXOWL_CHECK(sortedTriangles(sphere.mesh.indices) == sortedTriangles(original));
+
+        // 8192 triangles need at least 67 meshlets, connected growth should not leave many half empty ones
+        DXOWL_CHECK(sphere.meshlets.size() >= 67 && sphere.meshlets.size() < 140);
+
+        // meshlets on a smooth sphere are narrow enough for normal cones
+        size_t const with_cone = std::count_if(sphere.meshlets.begin(), sphere.meshlets.end(), [](MeshletBuilder::Meshlet const& meshlet) {
+            return meshlet.cone_cutoff <= 1.0f;
+        });
+        DXOWL_CHECK(with_cone > sphere.meshlets.size() * 3 / 4);
+    }
+
+    void testConeCulling()
+    {
+        Sphere const sphere = buildSphere(64);
+
+        // a meshlet culled by its cone may not have a single triangle facing the eye, from far and from close by
+        bool conservative = true;
+        size_t culled_far = 0;
+        for (float distance : { 5.0f, 1.5f })
+        {
+            // the 26 directions to the corners, edges and faces of a cube
+            for (int i = 0; i < 27; ++i)
+            {
+                float const direction[3] = { float(i % 3) - 1.0f, float(i / 3 % 3) - 1.0f, float(i / 9) - 1.0f };
+                if (i == 13)
+                {
+                    continue;
+                }
+                float const length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+                float const eye[3] = { direction[0] / length * distance, direction[1] / length * distance, direction[2] / length * distance };
+
+                for (auto const& meshlet : sphere.meshlets)
+                {
+                    float const dir[3] = { meshlet.cone_apex[0] - eye[0], meshlet.cone_apex[1] - eye[1], meshlet.cone_apex[2] - eye[2] };
+                    float const dir_length = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+                    float const dot = dir[0] * meshlet.cone_axis[0] + dir[1] * meshlet.cone_axis[1] + dir[2] * meshlet.cone_axis[2];
+                    if (dot >= meshlet.cone_cutoff * dir_length)
+                    {
+                        conservative = conservative && allBackFacing(sphere.mesh, meshlet, eye);
+                        culled_far += distance > 2.0f ? 1 : 0;
+                    }
+                }
+            }
+        }
+        DXOWL_CHECK(conservative);
+
+        // from far away half of the sphere faces away, meshlets span about 60 degrees of it, so their cones
+        // catch a fifth of all meshlets
+        DXOWL_CHECK(culled_far > sphere.meshlets.size() * 26 / 8);
+    }
+
+    void testCuller()
+    {
+        Sphere const sphere = buildSphere(128);
+        MeshletCuller culler(sphere.meshlets);
+        DXOWL_CHECK(culler.getMeshletCount() == sphere.meshlets.size());
+
+        // the plane x >= 0.25 culls the meshlets completely on the other side, the eye on -z the back faces
+        MeshletCuller::View view = makeView(0.0f, 0.0f, -4.0f);
+        view.frustum_planes[0][3] = -0.25f;
+
+        std::vector<bool> expected(sphere.meshlets.size(), true);
+        size_t expected_frustum = 0;
+        size_t expected_backface = 0;
+        size_t expected_triangles = 0;
+        for (size_t i = 0; i < sphere.meshlets.size(); ++i)
+        {
+            MeshletBuilder::Meshlet const& meshlet = sphere.meshlets[i];
+            float const dir[3] = { meshlet.cone_apex[0], meshlet.cone_apex[1], meshlet.cone_apex[2] + 4.0f };
+            float const dot = dir[0] * meshlet.cone_axis[0] + dir[1] * meshlet.cone_axis[1] + dir[2] * meshlet.cone_axis[2];
+            if (meshlet.center[0] - 0.25f < -meshlet.radius)
+            {
+                expected[i] = false;
+                ++expected_frustum;
+            }
+            else if (dot >= meshlet.cone_cutoff * std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]))
+            {
+                expected[i] = false;
+                ++expected_backface;
+            }
+            else
+            {
+                expected_triangles += meshlet.index_count / 3;
+            }
+        }
+
+        culler.beginFrame(3);
+        std::vector<MeshletCuller::DrawRange> const ranges = culler.cull(view);
+        culler.endFrame();
+
+        // the ranges cover exactly the indices of the visible meshlets, neighbours merged
+        std::vector<bool> drawn(sphere.mesh.indices.size(), false);
+        bool merged = true;
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            std::fill(drawn.begin() + ranges[i].first_index, drawn.begin() + ranges[i].first_index + ranges[i].index_count, true);
+            merged = merged && (i == 0 || ranges[i - 1].first_index + ranges[i - 1].index_count < ranges[i].first_index);
+        }
+        bool matches = true;
+        for (size_t i = 0; i < sphere.meshlets.size(); ++i)
+        {
+            for (UINT k = 0; k < sphere.meshlets[i].index_count; ++k)
+            {
+                matches = matches && drawn[sphere.meshlets[i].first_index + k] == expected[i];
+            }
+        }
+        DXOWL_CHECK(matches && merged);
+
+        MeshletCuller::FrameStatistics const stats = culler.getLastFrameStatistics();
+        DXOWL_CHECK(stats.frame == 3 && stats.meshlets_tested == sphere.meshlets.size() && stats.draw_ranges == ranges.size());
+        DXOWL_CHECK(stats.meshlets_frustum_culled == expected_frustum && stats.meshlets_backface_culled == expected_backface);
+        DXOWL_CHECK(stats.triangles_visible == expected_triangles);
+        DXOWL_CHECK(expected_frustum > 0 && expected_backface > 0 && expected_triangles < sphere.mesh.indices.size() / 3 / 2);
+
+        // the thread pool culls blocks of meshlets in parallel, with the same result
+        ThreadPool thread_pool(4);
+        DXOWL_CHECK(sphere.meshlets.size() > 256);
+        std::vector<MeshletCuller::DrawRange> const parallel = culler.cull(view, &thread_pool);
+        bool same = parallel.size() == ranges.size();
+        for (size_t i = 0; same && i < ranges.size(); ++i)
+        {
+            same = parallel[i].first_index == ranges[i].first_index && parallel[i].index_count == ranges[i].index_count;
+        }
+        DXOWL_CHECK(same);
+
+#ifndef _WIN32
+        // one DrawIndexed per range
+        auto device = dxowl_test::createRecordingDevice();
+        culler.draw(device->immediate_context.Get(), 5);
+        std::vector<dxowl_test::RecordedCall> const calls = device->immediate_context->findCalls("DrawIndexed");
+        DXOWL_CHECK(calls.size() == ranges.size());
+        DXOWL_CHECK(calls[0].args[0] == ranges[0].index_count && calls[0].args[1] == ranges[0].first_index && calls[0].args[2] == 5);
+#endif
+    }
+} // namespace
+
+int main()
+{
+    testBuild();
+    testConeCulling();
+    testCuller();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,181 @@
+/// <copyright file="MipGeneratorTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/MipGenerator.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    template <typename Exception, typename Function>
+    bool throws(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    uint8_t const* level(MipGenerator::MipChain const& chain, UINT slice, UINT mip)
+    {
+        return static_cast<uint8_t const*>(chain.getSubresourceData()[size_t(slice) * chain.getMipLevels() + mip]);
+    }
+
+    float coverage(uint8_t const* rgba, size_t texel_cnt, float reference)
+    {
+        size_t covered = 0;
+        for (size_t i = 0; i < texel_cnt; ++i)
+        {
+            covered += rgba[i * 4 + 3] / 255.0f > reference ? 1 : 0;
+        }
+        return static_cast<float>(covered) / static_cast<float>(texel_cnt);
+    }
+
+    void testLayout()
+    {
+        std::vector<uint8_t> const slice0(8 * 4, 10);
+        std::vector<uint8_t> const slice1(8 * 4, 20);
+        MipGenerator::MipChain const chain = MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 8, 4, { slice0.data(), slice1.data() });
+
+        // full chain 8x4, 4x2, 2x1, 1x1, level 0 is copied
+        DXOWL_CHECK(chain.getMipLevels() == 4 && chain.getArraySize() == 2);
+        DXOWL_CHECK(chain.getSubresourceData().size() == 8);
+        DXOWL_CHECK(std::memcmp(level(chain, 1, 0), slice1.data(), slice1.size()) == 0);
+        DXOWL_CHECK(level(chain, 0, 3)[0] == 10 && level(chain, 1, 3)[0] == 20);
+
+        // mip_levels limits the chain and is clamped to the full chain
+        MipGenerator::Settings settings;
+        settings.mip_levels = 2;
+        DXOWL_CHECK(MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 8, 4, { slice0.data() }, settings).getMipLevels() == 2);
+        settings.mip_levels = 10;
+        DXOWL_CHECK(MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 8, 4, { slice0.data() }, settings).getMipLevels() == 4);
+
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { MipGenerator::generate(DXGI_FORMAT_BC1_UNORM, 8, 4, { slice0.data() }); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 0, 4, { slice0.data() }); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 8, 4, {}); }));
+    }
+
+    void testBoxFilter()
+    {
+        // every 2x2 block averages to its own value
+        uint8_t const texels[16] = {
+            0, 100, 40, 40,
+            200, 100, 40, 40,
+            10, 10, 255, 0,
+            10, 10, 0, 255
+        };
+        MipGenerator::MipChain const chain = MipGenerator::generate(DXGI_FORMAT_R8_UNORM, 4, 4, { texels });
+        uint8_t const* mip1 = level(chain, 0, 1);
+        DXOWL_CHECK(mip1[0] == 100 && mip1[1] == 40 && mip1[2] == 10 && mip1[3] == 128);
+
+        // odd extents weigh every source texel by its overlap with the destination texel
+        float const row[3] = { 1.0f, 2.0f, 6.0f };
+        MipGenerator::MipChain const odd = MipGenerator::generate(DXGI_FORMAT_R32_FLOAT, 3, 1, { row });
+        float mip1_odd;
+        std::memcpy(&mip1_odd, level(odd, 0, 1), sizeof(float));
+        DXOWL_CHECK(odd.getMipLevels() == 2 && std::abs(mip1_odd - 3.0f) < 1e-5f);
+    }
+
+    void testSrgb()
+    {
+        // black and white average to linear 0.5, which is 188 in sRGB, alpha is filtered linearly
+        uint8_t const texels[8] = { 0, 0, 0, 0, 255, 255, 255, 255 };
+        MipGenerator::MipChain const srgb = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 2, 1, { texels });
+        uint8_t const* mip1 = level(srgb, 0, 1);
+        DXOWL_CHECK(mip1[0] == 188 && mip1[2] == 188 && mip1[3] == 128);
+
+        MipGenerator::MipChain const unorm = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 2, 1, { texels });
+        DXOWL_CHECK(level(unorm, 0, 1)[0] == 128);
+    }
+
+    void testFilters()
+    {
+        std::mt19937 rng(3);
+        std::vector<uint8_t> texels(64 * 32 * 4);
+        for (auto& texel : texels)
+        {
+            texel = static_cast<uint8_t>(rng());
+        }
+
+        // a constant image stays constant with every filter, negative lobes included
+        std::vector<uint8_t> const constant(64 * 32 * 4, 77);
+        for (MipGenerator::Filter filter : { MipGenerator::Filter::Box, MipGenerator::Filter::Triangle, MipGenerator::Filter::Kaiser })
+        {
+            MipGenerator::Settings settings;
+            settings.filter = filter;
+            MipGenerator::MipChain const chain = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 32, { constant.data() }, settings);
+            bool all_equal = true;
+            for (UINT mip = 1; mip < chain.getMipLevels(); ++mip)
+            {
+                size_t const texel_cnt = size_t(computeMipExtent(64, mip)) * computeMipExtent(32, mip);
+                for (size_t i = 0; i < texel_cnt * 4; ++i)
+                {
+                    all_equal = all_equal && level(chain, 0, mip)[i] == 77;
+                }
+            }
+            DXOWL_CHECK(all_equal);
+
+            // the thread pool splits rows between workers, the result does not change
+            ThreadPool thread_pool(4);
+            MipGenerator::MipChain const serial = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 32, { texels.data() }, settings);
+            MipGenerator::MipChain const parallel = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 64, 32, { texels.data() }, settings, &thread_pool);
+            DXOWL_CHECK(std::memcmp(level(serial, 0, 1), level(parallel, 0, 1), 32 * 16 * 4) == 0);
+            DXOWL_CHECK(std::memcmp(level(serial, 0, 3), level(parallel, 0, 3), 8 * 4 * 4) == 0);
+        }
+    }
+
+    void testAlphaCoverage()
+    {
+        // a sparse alpha-tested mask fades out when box filtered, scaling alpha keeps the coverage of level 0 up to
+        // the few texels of the small levels
+        std::mt19937 rng(4);
+        std::vector<uint8_t> texels(32 * 32 * 4, 255);
+        for (size_t i = 0; i < 32 * 32; ++i)
+        {
+            texels[i * 4 + 3] = rng() % 4 == 0 ? 255 : 0;
+        }
+        float const reference = 0.5f;
+        float const coverage0 = coverage(texels.data(), 32 * 32, reference);
+
+        MipGenerator::Settings settings;
+        MipGenerator::MipChain const plain = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 32, 32, { texels.data() }, settings);
+        settings.alpha_coverage_reference = reference;
+        MipGenerator::MipChain const preserved = MipGenerator::generate(DXGI_FORMAT_R8G8B8A8_UNORM, 32, 32, { texels.data() }, settings);
+
+        for (UINT mip = 2; mip < 4; ++mip)
+        {
+            size_t const texel_cnt = size_t(computeMipExtent(32, mip)) * computeMipExtent(32, mip);
+            float const plain_error = std::abs(coverage(level(plain, 0, mip), texel_cnt, reference) - coverage0);
+            float const preserved_error = std::abs(coverage(level(preserved, 0, mip), texel_cnt, reference) - coverage0);
+            DXOWL_CHECK(preserved_error < 0.1f && plain_error > 0.2f);
+        }
+    }
+} // namespace
+
+int main()
+{
+    testLayout();
+    testBoxFilter();
+    testSrgb();
+    testFilters();
+    testAlphaCoverage();
+
+    return dxowl_test::result();
+}
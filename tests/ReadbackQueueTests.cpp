@@ -0,0 +1,210 @@
+/// <copyright file="ReadbackQueueTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/ReadbackQueue.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// Copies on the recording device finish immediately, busy_map_cnt makes polls report them as still drawing.
+namespace
+{
+    template <typename Exception, typename Function>
+    bool throws(Function const& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+        }
+        return false;
+    }
+
+    /// Buffer whose byte i holds first + i.
+    Microsoft::WRL::ComPtr<ID3D11Buffer> makeSource(ID3D11Device4* d3d11_device, UINT byte_size, uint8_t first)
+    {
+        std::vector<uint8_t> bytes(byte_size);
+        for (UINT i = 0; i < byte_size; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(first + i);
+        }
+        D3D11_SUBRESOURCE_DATA init_data = {};
+        init_data.pSysMem = bytes.data();
+        const CD3D11_BUFFER_DESC desc(byte_size, D3D11_BIND_UNORDERED_ACCESS);
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> retval;
+        winrt::check_hresult(d3d11_device->CreateBuffer(&desc, &init_data, retval.GetAddressOf()));
+        return retval;
+    }
+
+    bool startsAt(std::vector<uint8_t> const& bytes, size_t byte_size, uint8_t first)
+    {
+        bool retval = bytes.size() == byte_size;
+        for (size_t i = 0; retval && i < bytes.size(); ++i)
+        {
+            retval = bytes[i] == static_cast<uint8_t>(first + i);
+        }
+        return retval;
+    }
+
+    /// Callback that appends the request id to order and keeps the delivered bytes.
+    ReadbackQueue::Callback record(int id, std::vector<int>& order, std::vector<uint8_t>& bytes)
+    {
+        return [id, &order, &bytes](void const* data, size_t byte_size) {
+            order.push_back(id);
+            bytes.assign(static_cast<uint8_t const*>(data), static_cast<uint8_t const*>(data) + byte_size);
+        };
+    }
+
+    void testLatency()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        auto source = makeSource(device.Get(), 64, 0);
+
+        ReadbackQueue queue(device.Get(), 2);
+        std::vector<int> order;
+        std::vector<uint8_t> bytes;
+
+        queue.beginFrame(1);
+        queue.enqueue(ctx, source.Get(), record(0, order, bytes));
+        DXOWL_CHECK(ctx->countCalls("CopyResource") == 1);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK(queue.getLastFrameStatistics().request_count == 1);
+        DXOWL_CHECK(queue.getLastFrameStatistics().bytes_requested == 64);
+        DXOWL_CHECK(queue.getLastFrameStatistics().pending_count == 1);
+
+        // the copy is not mapped before it is latency_frames old
+        queue.beginFrame(2);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK(ctx->countCalls("Map") == 0 && order.empty());
+
+        queue.beginFrame(3);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK((order == std::vector<int>{ 0 }));
+        DXOWL_CHECK(startsAt(bytes, 64, 0));
+        std::vector<dxowl_test::RecordedCall> const maps = ctx->findCalls("Map");
+        DXOWL_CHECK(maps.size() == 1 && maps[0].args[2] == D3D11_MAP_READ && maps[0].args[3] == D3D11_MAP_FLAG_DO_NOT_WAIT);
+        DXOWL_CHECK(ctx->countCalls("Unmap") == 1);
+
+        ReadbackQueue::FrameStatistics stats = queue.getLastFrameStatistics();
+        DXOWL_CHECK(stats.completed_count == 1 && stats.bytes_completed == 64);
+        DXOWL_CHECK(stats.pending_count == 0 && stats.staging_count == 1 && stats.staging_bytes == 64);
+
+        // frames are counted by beginFrame calls, not by the frame numbers passed in
+        queue.beginFrame(100);
+        queue.enqueue(ctx, source.Get(), record(1, order, bytes));
+        queue.endFrame();
+        queue.beginFrame(200);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK(queue.getPendingCount() == 1);
+
+        // without latency a request is delivered in its own frame
+        queue.setLatency(0);
+        queue.beginFrame(201);
+        queue.enqueue(ctx, source.Get(), 16, 8, record(2, order, bytes));
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK((order == std::vector<int>{ 0, 1, 2 }));
+        DXOWL_CHECK(startsAt(bytes, 8, 16));
+        DXOWL_CHECK(queue.getLatency() == 0);
+    }
+
+    void testOrdering()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        auto first_source = makeSource(device.Get(), 64, 0);
+        auto second_source = makeSource(device.Get(), 32, 100);
+
+        ReadbackQueue queue(device.Get(), 1);
+        std::vector<int> order;
+        std::vector<uint8_t> first_bytes;
+        std::vector<uint8_t> second_bytes;
+
+        queue.beginFrame(1);
+        queue.enqueue(ctx, first_source.Get(), record(0, order, first_bytes));
+        queue.enqueue(ctx, second_source.Get(), 8, 16, record(1, order, second_bytes));
+        std::future<std::vector<std::byte>> future = queue.enqueue(ctx, second_source.Get());
+        DXOWL_CHECK(ctx->countCalls("CopyResource") == 2 && ctx->countCalls("CopySubresourceRegion") == 1);
+        DXOWL_CHECK(throws<std::out_of_range>([&]() { queue.enqueue(ctx, second_source.Get(), 24, 16); }));
+        DXOWL_CHECK(throws<std::out_of_range>([&]() { queue.enqueue(ctx, second_source.Get(), 0, 0); }));
+        queue.endFrame();
+
+        // while the oldest copy is busy, later requests are not polled either
+        ctx->busy_map_cnt = 1;
+        queue.beginFrame(2);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK(order.empty());
+        DXOWL_CHECK(ctx->countCalls("Map") == 1);
+        DXOWL_CHECK(queue.getLastFrameStatistics().busy_poll_count == 1);
+        DXOWL_CHECK(queue.getLastFrameStatistics().pending_count == 3);
+        DXOWL_CHECK(future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+        queue.beginFrame(3);
+        queue.poll(ctx);
+        queue.endFrame();
+        DXOWL_CHECK((order == std::vector<int>{ 0, 1 }));
+        DXOWL_CHECK(startsAt(first_bytes, 64, 0));
+        DXOWL_CHECK(startsAt(second_bytes, 16, 108));
+        DXOWL_CHECK(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        std::vector<std::byte> const future_bytes = future.get();
+        DXOWL_CHECK(future_bytes.size() == 32 && future_bytes[0] == std::byte(100) && future_bytes[31] == std::byte(131));
+        DXOWL_CHECK(queue.getLastFrameStatistics().completed_count == 3);
+
+        // staging buffers are reused, the smallest that fits is taken and copied into with a region copy
+        size_t const buffer_cnt = device->buffer_cnt;
+        ctx->calls.clear();
+        queue.beginFrame(4);
+        queue.enqueue(ctx, second_source.Get(), 0, 12, record(2, order, second_bytes));
+        queue.enqueue(ctx, second_source.Get(), record(3, order, second_bytes));
+        queue.enqueue(ctx, second_source.Get(), record(4, order, first_bytes));
+        queue.endFrame();
+        DXOWL_CHECK(device->buffer_cnt == buffer_cnt);
+        DXOWL_CHECK(ctx->countCalls("CopyResource") == 1 && ctx->countCalls("CopySubresourceRegion") == 2);
+
+        // flush waits for copies regardless of latency and busy maps
+        ctx->busy_map_cnt = 10;
+        queue.flush(ctx);
+        DXOWL_CHECK((order == std::vector<int>{ 0, 1, 2, 3, 4 }));
+        DXOWL_CHECK(startsAt(second_bytes, 32, 100) && startsAt(first_bytes, 32, 100));
+        DXOWL_CHECK(queue.getPendingCount() == 0);
+
+        queue.trim();
+        queue.beginFrame(5);
+        queue.endFrame();
+        DXOWL_CHECK(queue.getLastFrameStatistics().staging_count == 0);
+    }
+} // namespace
+
+int main()
+{
+    testLatency();
+    testOrdering();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,825 @@
+/// <copyright file="RecordingDevice.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef RecordingDevice_hpp
+#define RecordingDevice_hpp
+
+#include <d3d11_4.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+
+#include <dxowl/FormatTraits.hpp>
+
+// D3D11 device and context that implement the interfaces of host/d3d11_4.h on the CPU. The context records
+// the calls it receives, so tests can check which state dxowl sets and how it maps resources. Buffers and
+// textures keep their contents in system memory, Map, UpdateSubresource and the copies work on it.
+// Only builds against host/, the SDK interfaces have far more methods than dxowl uses.
+namespace dxowl_test
+{
+    /// Reference counting for the recording objects. QueryInterface hands out the object itself for every
+    /// interface id, each recording class implements the most derived interface dxowl asks for.
+    template <typename Interface>
+    class RecordingObject : public Interface
+    {
+    public:
+        HRESULT QueryInterface(REFIID, void** object) override
+        {
+            AddRef();
+            *object = static_cast<Interface*>(this);
+            return S_OK;
+        }
+
+        ULONG AddRef() override
+        {
+            return ++m_ref_cnt;
+        }
+
+        ULONG Release() override
+        {
+            ULONG const retval = --m_ref_cnt;
+            if (retval == 0)
+            {
+                delete this;
+            }
+            return retval;
+        }
+
+    protected:
+        RecordingObject() : m_ref_cnt(1) {}
+        virtual ~RecordingObject() = default;
+
+    private:
+        std::atomic<ULONG> m_ref_cnt;
+    };
+
+    /// Creates a recording object with a reference count of one and hands it to a ComPtr.
+    template <typename Object, typename... Args>
+    Microsoft::WRL::ComPtr<Object> makeRecordingObject(Args&&... args)
+    {
+        Microsoft::WRL::ComPtr<Object> retval;
+        retval.Attach(new Object(std::forward<Args>(args)...));
+        return retval;
+    }
+
+    class RecordingBuffer : public RecordingObject<ID3D11Buffer>
+    {
+    public:
+        explicit RecordingBuffer(D3D11_BUFFER_DESC const& desc) : desc(desc), data(desc.ByteWidth) {}
+
+        void GetDesc(D3D11_BUFFER_DESC* out) override { *out = desc; }
+
+        D3D11_BUFFER_DESC desc;
+        std::vector<uint8_t> data;
+    };
+
+    /// Texture contents are stored per subresource with tightly packed rows and slices.
+    template <typename Interface, typename Desc>
+    class RecordingTexture : public RecordingObject<Interface>
+    {
+    public:
+        RecordingTexture(Desc const& desc, UINT depth, UINT array_size) : desc(desc)
+        {
+            UINT const mip_cnt = desc.MipLevels != 0 ? desc.MipLevels : dxowl::computeMipLevelCount(desc.Width, desc.Height, depth);
+            this->desc.MipLevels = mip_cnt;
+            for (UINT slice = 0; slice < array_size; ++slice)
+            {
+                for (UINT mip = 0; mip < mip_cnt; ++mip)
+                {
+                    Subresource subresource;
+                    subresource.width = dxowl::computeMipExtent(desc.Width, mip);
+                    subresource.height = dxowl::computeMipExtent(desc.Height, mip);
+                    subresource.depth = dxowl::computeMipExtent(depth, mip);
+                    subresource.row_pitch = dxowl::computeRowPitch(desc.Format, subresource.width);
+                    subresource.row_cnt = dxowl::computeRowCount(desc.Format, subresource.height);
+                    subresource.data.resize(subresource.row_pitch * subresource.row_cnt * subresource.depth);
+                    subresources.push_back(std::move(subresource));
+                }
+            }
+        }
+
+        void GetDesc(Desc* out) override { *out = desc; }
+
+        struct Subresource
+        {
+            UINT width;
+            UINT height;
+            UINT depth;
+            size_t row_pitch;
+            size_t row_cnt;
+            std::vector<uint8_t> data;
+
+            size_t getSlicePitch() const { return row_pitch * row_cnt; }
+
+            /// Copies rows and slices from data with the given pitches into the packed storage.
+            void write(void const* src, size_t src_row_pitch, size_t src_slice_pitch)
+            {
+                uint8_t const* src_bytes = static_cast<uint8_t const*>(src);
+                for (size_t z = 0; z < depth; ++z)
+                {
+                    for (size_t row = 0; row < row_cnt; ++row)
+                    {
+                        std::memcpy(
+                            data.data() + z * getSlicePitch() + row * row_pitch,
+                            src_bytes + z * src_slice_pitch + row * src_row_pitch,
+                            row_pitch);
+                    }
+                }
+            }
+        };
+
+        Desc desc;
+        std::vector<Subresource> subresources;
+    };
+
+    class RecordingTexture2D : public RecordingTexture<ID3D11Texture2D, D3D11_TEXTURE2D_DESC>
+    {
+    public:
+        explicit RecordingTexture2D(D3D11_TEXTURE2D_DESC const& desc) : RecordingTexture(desc, 1, desc.ArraySize) {}
+    };
+
+    class RecordingTexture3D : public RecordingTexture<ID3D11Texture3D, D3D11_TEXTURE3D_DESC>
+    {
+    public:
+        explicit RecordingTexture3D(D3D11_TEXTURE3D_DESC const& desc) : RecordingTexture(desc, desc.Depth, 1) {}
+    };
+
+    template <typename Interface, typename Desc>
+    class RecordingView : public RecordingObject<Interface>
+    {
+    public:
+        RecordingView(ID3D11Resource* resource, Desc const* desc) : resource(resource), desc(), has_desc(desc != nullptr)
+        {
+            if (desc != nullptr)
+            {
+                this->desc = *desc;
+            }
+        }
+
+        Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+        Desc desc;
+        bool has_desc;
+    };
+
+    typedef RecordingView<ID3D11ShaderResourceView, D3D11_SHADER_RESOURCE_VIEW_DESC> RecordingShaderResourceView;
+    typedef RecordingView<ID3D11UnorderedAccessView, D3D11_UNORDERED_ACCESS_VIEW_DESC> RecordingUnorderedAccessView;
+    typedef RecordingView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC> RecordingRenderTargetView;
+    typedef RecordingView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC> RecordingDepthStencilView;
+
+    class RecordingInputLayout : public RecordingObject<ID3D11InputLayout>
+    {
+    public:
+        RecordingInputLayout(D3D11_INPUT_ELEMENT_DESC const* elements, UINT element_cnt)
+            : elements(elements, elements + element_cnt)
+        {
+        }
+
+        std::vector<D3D11_INPUT_ELEMENT_DESC> elements;
+    };
+
+    template <typename Interface>
+    class RecordingShader : public RecordingObject<Interface>
+    {
+    public:
+        RecordingShader(void const* bytecode, SIZE_T bytecode_length)
+            : bytecode(static_cast<uint8_t const*>(bytecode), static_cast<uint8_t const*>(bytecode) + bytecode_length)
+        {
+        }
+
+        std::vector<uint8_t> bytecode;
+    };
+
+    struct RecordedCall
+    {
+        std::string name;
+        std::vector<uint64_t> args;     // integer arguments and resource addresses, in call order
+    };
+
+    class RecordingCommandList : public RecordingObject<ID3D11CommandList>
+    {
+    public:
+        explicit RecordingCommandList(std::vector<RecordedCall> calls) : calls(std::move(calls)) {}
+
+        std::vector<RecordedCall> calls;
+    };
+
+    class RecordingContext : public RecordingObject<ID3D11DeviceContext4>
+    {
+    public:
+        explicit RecordingContext(D3D11_DEVICE_CONTEXT_TYPE type) : record(true), busy_map_cnt(0), m_type(type) {}
+
+        size_t countCalls(std::string const& name) const
+        {
+            return static_cast<size_t>(std::count_if(calls.begin(), calls.end(), [&name](RecordedCall const& call) { return call.name == name; }));
+        }
+
+        std::vector<RecordedCall> findCalls(std::string const& name) const
+        {
+            std::vector<RecordedCall> retval;
+            std::copy_if(calls.begin(), calls.end(), std::back_inserter(retval), [&name](RecordedCall const& call) { return call.name == name; });
+            return retval;
+        }
+
+        void IASetInputLayout(ID3D11InputLayout* input_layout) override
+        {
+            log("IASetInputLayout", { address(input_layout) });
+        }
+
+        void IASetVertexBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* strides, UINT const* offsets) override
+        {
+            std::vector<uint64_t> args = { start_slot, buffer_cnt };
+            for (UINT i = 0; i < buffer_cnt; ++i)
+            {
+                args.insert(args.end(), { address(buffers[i]), strides[i], offsets[i] });
+            }
+            log("IASetVertexBuffers", std::move(args));
+        }
+
+        void IASetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset) override
+        {
+            log("IASetIndexBuffer", { address(buffer), uint64_t(format), offset });
+        }
+
+        void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override
+        {
+            log("IASetPrimitiveTopology", { uint64_t(topology) });
+        }
+
+        void VSSetShader(ID3D11VertexShader* shader, ID3D11ClassInstance* const*, UINT) override
+        {
+            log("VSSetShader", { address(shader) });
+        }
+
+        void GSSetShader(ID3D11GeometryShader* shader, ID3D11ClassInstance* const*, UINT) override
+        {
+            log("GSSetShader", { address(shader) });
+        }
+
+        void PSSetShader(ID3D11PixelShader* shader, ID3D11ClassInstance* const*, UINT) override
+        {
+            log("PSSetShader", { address(shader) });
+        }
+
+        void VSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) override
+        {
+            log("VSSetConstantBuffers", slotArgs(start_slot, buffer_cnt, buffers));
+        }
+
+        void GSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) override
+        {
+            log("GSSetConstantBuffers", slotArgs(start_slot, buffer_cnt, buffers));
+        }
+
+        void PSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) override
+        {
+            log("PSSetConstantBuffers", slotArgs(start_slot, buffer_cnt, buffers));
+        }
+
+        void CSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) override
+        {
+            log("CSSetConstantBuffers", slotArgs(start_slot, buffer_cnt, buffers));
+        }
+
+        void VSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) override
+        {
+            log("VSSetConstantBuffers1", rangeArgs(start_slot, buffer_cnt, buffers, first_constants, constant_cnts));
+        }
+
+        void GSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) override
+        {
+            log("GSSetConstantBuffers1", rangeArgs(start_slot, buffer_cnt, buffers, first_constants, constant_cnts));
+        }
+
+        void PSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) override
+        {
+            log("PSSetConstantBuffers1", rangeArgs(start_slot, buffer_cnt, buffers, first_constants, constant_cnts));
+        }
+
+        void CSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) override
+        {
+            log("CSSetConstantBuffers1", rangeArgs(start_slot, buffer_cnt, buffers, first_constants, constant_cnts));
+        }
+
+        void VSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("VSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void HSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("HSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void DSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("DSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void GSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("GSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void PSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("PSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void CSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) override
+        {
+            log("CSSetShaderResources", slotArgs(start_slot, view_cnt, views));
+        }
+
+        void OMSetRenderTargets(UINT view_cnt, ID3D11RenderTargetView* const* render_target_views, ID3D11DepthStencilView* depth_stencil_view) override
+        {
+            std::vector<uint64_t> args = slotArgs(0, view_cnt, render_target_views);
+            args.push_back(address(depth_stencil_view));
+            log("OMSetRenderTargets", std::move(args));
+        }
+
+        void RSSetViewports(UINT viewport_cnt, D3D11_VIEWPORT const*) override
+        {
+            log("RSSetViewports", { viewport_cnt });
+        }
+
+        void ClearRenderTargetView(ID3D11RenderTargetView* render_target_view, FLOAT const[4]) override
+        {
+            log("ClearRenderTargetView", { address(render_target_view) });
+        }
+
+        void ClearDepthStencilView(ID3D11DepthStencilView* depth_stencil_view, UINT clear_flags, FLOAT, UINT8 stencil) override
+        {
+            log("ClearDepthStencilView", { address(depth_stencil_view), clear_flags, stencil });
+        }
+
+        void Draw(UINT vertex_cnt, UINT start_vertex) override
+        {
+            log("Draw", { vertex_cnt, start_vertex });
+        }
+
+        void DrawIndexed(UINT index_cnt, UINT start_index, INT base_vertex) override
+        {
+            log("DrawIndexed", { index_cnt, start_index, uint64_t(base_vertex) });
+        }
+
+        void DrawInstanced(UINT vertex_cnt, UINT instance_cnt, UINT start_vertex, UINT start_instance) override
+        {
+            log("DrawInstanced", { vertex_cnt, instance_cnt, start_vertex, start_instance });
+        }
+
+        void DrawIndexedInstanced(UINT index_cnt, UINT instance_cnt, UINT start_index, INT base_vertex, UINT start_instance) override
+        {
+            log("DrawIndexedInstanced", { index_cnt, instance_cnt, start_index, uint64_t(base_vertex), start_instance });
+        }
+
+        void DrawIndexedInstancedIndirect(ID3D11Buffer* args, UINT args_offset) override
+        {
+            log("DrawIndexedInstancedIndirect", { address(args), args_offset });
+        }
+
+        void DrawInstancedIndirect(ID3D11Buffer* args, UINT args_offset) override
+        {
+            log("DrawInstancedIndirect", { address(args), args_offset });
+        }
+
+        /// Recorded with the subresource, map type and flags. While busy_map_cnt is above zero, maps with
+        /// D3D11_MAP_FLAG_DO_NOT_WAIT count it down and fail as if the GPU still used the resource.
+        HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP map_type, UINT map_flags, D3D11_MAPPED_SUBRESOURCE* mapped) override
+        {
+            log("Map", { address(resource), subresource, uint64_t(map_type), map_flags });
+            if ((map_flags & D3D11_MAP_FLAG_DO_NOT_WAIT) != 0 && busy_map_cnt > 0)
+            {
+                --busy_map_cnt;
+                return DXGI_ERROR_WAS_STILL_DRAWING;
+            }
+
+            if (RecordingBuffer* buffer = dynamic_cast<RecordingBuffer*>(resource))
+            {
+                mapped->pData = buffer->data.data();
+                mapped->RowPitch = buffer->desc.ByteWidth;
+                mapped->DepthPitch = buffer->desc.ByteWidth;
+                return S_OK;
+            }
+            return mapTexture(resource, subresource, mapped);
+        }
+
+        void Unmap(ID3D11Resource* resource, UINT subresource) override
+        {
+            log("Unmap", { address(resource), subresource });
+        }
+
+        /// Buffers take the box into account, textures are always written as a whole subresource.
+        void UpdateSubresource(ID3D11Resource* resource, UINT subresource, D3D11_BOX const* box, void const* data, UINT row_pitch, UINT depth_pitch) override
+        {
+            log("UpdateSubresource", { address(resource), subresource, box != nullptr ? 1u : 0u, row_pitch, depth_pitch });
+            if (RecordingBuffer* buffer = dynamic_cast<RecordingBuffer*>(resource))
+            {
+                UINT const left = box != nullptr ? box->left : 0;
+                UINT const right = box != nullptr ? box->right : buffer->desc.ByteWidth;
+                std::memcpy(buffer->data.data() + left, data, right - left);
+            }
+            else if (RecordingTexture2D* texture = dynamic_cast<RecordingTexture2D*>(resource))
+            {
+                texture->subresources.at(subresource).write(data, row_pitch, depth_pitch);
+            }
+            else if (RecordingTexture3D* texture = dynamic_cast<RecordingTexture3D*>(resource))
+            {
+                texture->subresources.at(subresource).write(data, row_pitch, depth_pitch);
+            }
+        }
+
+        void CopyResource(ID3D11Resource* destination, ID3D11Resource* source) override
+        {
+            log("CopyResource", { address(destination), address(source) });
+            RecordingBuffer* destination_buffer = dynamic_cast<RecordingBuffer*>(destination);
+            RecordingBuffer* source_buffer = dynamic_cast<RecordingBuffer*>(source);
+            RecordingTexture2D* destination_texture = dynamic_cast<RecordingTexture2D*>(destination);
+            RecordingTexture2D* source_texture = dynamic_cast<RecordingTexture2D*>(source);
+            if (destination_buffer != nullptr && source_buffer != nullptr)
+            {
+                destination_buffer->data = source_buffer->data;
+            }
+            else if (destination_texture != nullptr && source_texture != nullptr)
+            {
+                destination_texture->subresources = source_texture->subresources;
+            }
+        }
+
+        /// Copies between buffers, texture regions are only recorded.
+        void CopySubresourceRegion(ID3D11Resource* destination, UINT destination_subresource, UINT x, UINT y, UINT z, ID3D11Resource* source, UINT source_subresource, D3D11_BOX const* box) override
+        {
+            log("CopySubresourceRegion", { address(destination), destination_subresource, x, y, z, address(source), source_subresource });
+            RecordingBuffer* destination_buffer = dynamic_cast<RecordingBuffer*>(destination);
+            RecordingBuffer* source_buffer = dynamic_cast<RecordingBuffer*>(source);
+            if (destination_buffer != nullptr && source_buffer != nullptr)
+            {
+                UINT const left = box != nullptr ? box->left : 0;
+                UINT const right = box != nullptr ? box->right : source_buffer->desc.ByteWidth;
+                std::memmove(destination_buffer->data.data() + x, source_buffer->data.data() + left, right - left);
+            }
+        }
+
+        void GenerateMips(ID3D11ShaderResourceView* view) override
+        {
+            log("GenerateMips", { address(view) });
+        }
+
+        /// Recorded, followed by the calls of the command list.
+        void ExecuteCommandList(ID3D11CommandList* command_list, BOOL restore_context_state) override
+        {
+            log("ExecuteCommandList", { address(command_list), uint64_t(restore_context_state) });
+            if (record)
+            {
+                std::vector<RecordedCall> const& list_calls = static_cast<RecordingCommandList*>(command_list)->calls;
+                calls.insert(calls.end(), list_calls.begin(), list_calls.end());
+            }
+        }
+
+        /// Moves the calls recorded so far into a command list.
+        HRESULT FinishCommandList(BOOL, ID3D11CommandList** command_list) override
+        {
+            if (m_type != D3D11_DEVICE_CONTEXT_DEFERRED)
+            {
+                return DXGI_ERROR_INVALID_CALL;
+            }
+            *command_list = makeRecordingObject<RecordingCommandList>(std::move(calls)).Detach();
+            calls.clear();
+            return S_OK;
+        }
+
+        void ClearState() override
+        {
+            log("ClearState", {});
+        }
+
+        void Flush() override
+        {
+            log("Flush", {});
+        }
+
+        D3D11_DEVICE_CONTEXT_TYPE GetType() override
+        {
+            return m_type;
+        }
+
+        std::vector<RecordedCall> calls;
+        bool record;            // off for benchmarks, which would mostly measure the recording
+        UINT busy_map_cnt;
+
+    private:
+        static uint64_t address(void const* ptr)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+        }
+
+        template <typename Interface>
+        static std::vector<uint64_t> slotArgs(UINT start_slot, UINT cnt, Interface* const* objects)
+        {
+            std::vector<uint64_t> retval = { start_slot, cnt };
+            for (UINT i = 0; i < cnt; ++i)
+            {
+                retval.push_back(address(objects[i]));
+            }
+            return retval;
+        }
+
+        static std::vector<uint64_t> rangeArgs(UINT start_slot, UINT cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts)
+        {
+            std::vector<uint64_t> retval = { start_slot, cnt };
+            for (UINT i = 0; i < cnt; ++i)
+            {
+                retval.insert(retval.end(), { address(buffers[i]), first_constants[i], constant_cnts[i] });
+            }
+            return retval;
+        }
+
+        void log(char const* name, std::vector<uint64_t> args)
+        {
+            if (record)
+            {
+                calls.push_back({ name, std::move(args) });
+            }
+        }
+
+        template <typename Texture>
+        static HRESULT mapSubresource(Texture* texture, UINT subresource, D3D11_MAPPED_SUBRESOURCE* mapped)
+        {
+            if (subresource >= texture->subresources.size())
+            {
+                return E_INVALIDARG;
+            }
+            auto& storage = texture->subresources[subresource];
+            mapped->pData = storage.data.data();
+            mapped->RowPitch = static_cast<UINT>(storage.row_pitch);
+            mapped->DepthPitch = static_cast<UINT>(storage.getSlicePitch());
+            return S_OK;
+        }
+
+        static HRESULT mapTexture(ID3D11Resource* resource, UINT subresource, D3D11_MAPPED_SUBRESOURCE* mapped)
+        {
+            if (RecordingTexture2D* texture = dynamic_cast<RecordingTexture2D*>(resource))
+            {
+                return mapSubresource(texture, subresource, mapped);
+            }
+            if (RecordingTexture3D* texture = dynamic_cast<RecordingTexture3D*>(resource))
+            {
+                return mapSubresource(texture, subresource, mapped);
+            }
+            return E_INVALIDARG;
+        }
+
+        D3D11_DEVICE_CONTEXT_TYPE m_type;
+    };
+
+    /// Creation can be delayed to simulate a driver that compiles or uploads, and made to fail for error paths.
+    /// The counters and creation are safe to use from several threads, the contexts are not.
+    class RecordingDevice : public RecordingObject<ID3D11Device4>
+    {
+    public:
+        RecordingDevice()
+            : immediate_context(makeRecordingObject<RecordingContext>(D3D11_DEVICE_CONTEXT_IMMEDIATE)),
+            create_latency(0),
+            failing_create_cnt(0),
+            buffer_cnt(0),
+            texture_cnt(0),
+            view_cnt(0),
+            input_layout_cnt(0),
+            shader_cnt(0),
+            deferred_context_cnt(0),
+            constant_buffer_offsetting(TRUE)
+        {
+        }
+
+        HRESULT CreateBuffer(D3D11_BUFFER_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Buffer** buffer) override
+        {
+            HRESULT const hr = beginCreate(desc->ByteWidth == 0);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            auto retval = makeRecordingObject<RecordingBuffer>(*desc);
+            if (initial_data != nullptr)
+            {
+                std::memcpy(retval->data.data(), initial_data->pSysMem, desc->ByteWidth);
+            }
+            ++buffer_cnt;
+            *buffer = retval.Detach();
+            return S_OK;
+        }
+
+        HRESULT CreateTexture2D(D3D11_TEXTURE2D_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Texture2D** texture) override
+        {
+            HRESULT const hr = beginCreate(desc->Width == 0 || desc->Height == 0 || desc->ArraySize == 0);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            auto retval = makeRecordingObject<RecordingTexture2D>(*desc);
+            writeInitialData(retval.Get(), initial_data);
+            ++texture_cnt;
+            *texture = retval.Detach();
+            return S_OK;
+        }
+
+        HRESULT CreateTexture3D(D3D11_TEXTURE3D_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Texture3D** texture) override
+        {
+            HRESULT const hr = beginCreate(desc->Width == 0 || desc->Height == 0 || desc->Depth == 0);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            auto retval = makeRecordingObject<RecordingTexture3D>(*desc);
+            writeInitialData(retval.Get(), initial_data);
+            ++texture_cnt;
+            *texture = retval.Detach();
+            return S_OK;
+        }
+
+        HRESULT CreateShaderResourceView(ID3D11Resource* resource, D3D11_SHADER_RESOURCE_VIEW_DESC const* desc, ID3D11ShaderResourceView** view) override
+        {
+            return createView<RecordingShaderResourceView>(resource, desc, view);
+        }
+
+        HRESULT CreateUnorderedAccessView(ID3D11Resource* resource, D3D11_UNORDERED_ACCESS_VIEW_DESC const* desc, ID3D11UnorderedAccessView** view) override
+        {
+            return createView<RecordingUnorderedAccessView>(resource, desc, view);
+        }
+
+        HRESULT CreateRenderTargetView(ID3D11Resource* resource, D3D11_RENDER_TARGET_VIEW_DESC const* desc, ID3D11RenderTargetView** view) override
+        {
+            return createView<RecordingRenderTargetView>(resource, desc, view);
+        }
+
+        HRESULT CreateDepthStencilView(ID3D11Resource* resource, D3D11_DEPTH_STENCIL_VIEW_DESC const* desc, ID3D11DepthStencilView** view) override
+        {
+            return createView<RecordingDepthStencilView>(resource, desc, view);
+        }
+
+        HRESULT CreateInputLayout(D3D11_INPUT_ELEMENT_DESC const* elements, UINT element_cnt, void const* shader_bytecode, SIZE_T, ID3D11InputLayout** input_layout) override
+        {
+            HRESULT const hr = beginCreate(element_cnt == 0 || shader_bytecode == nullptr);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            ++input_layout_cnt;
+            *input_layout = makeRecordingObject<RecordingInputLayout>(elements, element_cnt).Detach();
+            return S_OK;
+        }
+
+        HRESULT CreateVertexShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage*, ID3D11VertexShader** shader) override
+        {
+            return createShader(shader_bytecode, bytecode_length, shader);
+        }
+
+        HRESULT CreateGeometryShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage*, ID3D11GeometryShader** shader) override
+        {
+            return createShader(shader_bytecode, bytecode_length, shader);
+        }
+
+        HRESULT CreatePixelShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage*, ID3D11PixelShader** shader) override
+        {
+            return createShader(shader_bytecode, bytecode_length, shader);
+        }
+
+        HRESULT CreateDeferredContext(UINT, ID3D11DeviceContext** context) override
+        {
+            ++deferred_context_cnt;
+            *context = makeRecordingObject<RecordingContext>(D3D11_DEVICE_CONTEXT_DEFERRED).Detach();
+            return S_OK;
+        }
+
+        HRESULT CreateDeferredContext3(UINT, ID3D11DeviceContext3** context) override
+        {
+            ++deferred_context_cnt;
+            *context = makeRecordingObject<RecordingContext>(D3D11_DEVICE_CONTEXT_DEFERRED).Detach();
+            return S_OK;
+        }
+
+        /// Reports concurrent creates, driver command lists and constant buffer offsetting.
+        HRESULT CheckFeatureSupport(D3D11_FEATURE feature, void* feature_support_data, UINT feature_support_data_size) override
+        {
+            if (feature == D3D11_FEATURE_THREADING && feature_support_data_size == sizeof(D3D11_FEATURE_DATA_THREADING))
+            {
+                D3D11_FEATURE_DATA_THREADING* threading = static_cast<D3D11_FEATURE_DATA_THREADING*>(feature_support_data);
+                threading->DriverConcurrentCreates = TRUE;
+                threading->DriverCommandLists = TRUE;
+                return S_OK;
+            }
+            if (feature == D3D11_FEATURE_D3D11_OPTIONS && feature_support_data_size == sizeof(D3D11_FEATURE_DATA_D3D11_OPTIONS))
+            {
+                D3D11_FEATURE_DATA_D3D11_OPTIONS* options = static_cast<D3D11_FEATURE_DATA_D3D11_OPTIONS*>(feature_support_data);
+                ZeroMemory(options, sizeof(D3D11_FEATURE_DATA_D3D11_OPTIONS));
+                options->ConstantBufferOffsetting = constant_buffer_offsetting;
+                options->MapNoOverwriteOnDynamicConstantBuffer = constant_buffer_offsetting;
+                return S_OK;
+            }
+            return E_INVALIDARG;
+        }
+
+        void GetImmediateContext(ID3D11DeviceContext** context) override
+        {
+            immediate_context->AddRef();
+            *context = immediate_context.Get();
+        }
+
+        void GetImmediateContext3(ID3D11DeviceContext3** context) override
+        {
+            immediate_context->AddRef();
+            *context = immediate_context.Get();
+        }
+
+        Microsoft::WRL::ComPtr<RecordingContext> immediate_context;
+
+        std::chrono::microseconds create_latency;   // added to every resource and shader creation
+        std::atomic<int> failing_create_cnt;        // this many of the next creations fail with E_OUTOFMEMORY
+
+        std::atomic<size_t> buffer_cnt;
+        std::atomic<size_t> texture_cnt;
+        std::atomic<size_t> view_cnt;
+        std::atomic<size_t> input_layout_cnt;
+        std::atomic<size_t> shader_cnt;
+        std::atomic<size_t> deferred_context_cnt;
+
+        BOOL constant_buffer_offsetting;
+
+    private:
+        HRESULT beginCreate(bool invalid_arg)
+        {
+            if (create_latency.count() > 0)
+            {
+                std::this_thread::sleep_for(create_latency);
+            }
+            if (invalid_arg)
+            {
+                return E_INVALIDARG;
+            }
+            int failing = failing_create_cnt.load();
+            while (failing > 0)
+            {
+                if (failing_create_cnt.compare_exchange_weak(failing, failing - 1))
+                {
+                    return E_OUTOFMEMORY;
+                }
+            }
+            return S_OK;
+        }
+
+        template <typename Texture>
+        static void writeInitialData(Texture* texture, D3D11_SUBRESOURCE_DATA const* initial_data)
+        {
+            if (initial_data == nullptr)
+            {
+                return;
+            }
+            for (size_t i = 0; i < texture->subresources.size(); ++i)
+            {
+                texture->subresources[i].write(initial_data[i].pSysMem, initial_data[i].SysMemPitch, initial_data[i].SysMemSlicePitch);
+            }
+        }
+
+        template <typename View, typename Interface, typename Desc>
+        HRESULT createView(ID3D11Resource* resource, Desc const* desc, Interface** view)
+        {
+            HRESULT const hr = beginCreate(resource == nullptr);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            ++view_cnt;
+            *view = makeRecordingObject<View>(resource, desc).Detach();
+            return S_OK;
+        }
+
+        template <typename Interface>
+        HRESULT createShader(void const* shader_bytecode, SIZE_T bytecode_length, Interface** shader)
+        {
+            HRESULT const hr = beginCreate(shader_bytecode == nullptr || bytecode_length == 0);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            ++shader_cnt;
+            *shader = makeRecordingObject<RecordingShader<Interface>>(shader_bytecode, bytecode_length).Detach();
+            return S_OK;
+        }
+    };
+
+    inline Microsoft::WRL::ComPtr<RecordingDevice> createRecordingDevice()
+    {
+        return makeRecordingObject<RecordingDevice>();
+    }
+} // namespace dxowl_test
+
+#endif // !RecordingDevice_hpp
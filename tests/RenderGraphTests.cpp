@@ -0,0 +1,141 @@
+/// <copyright file="RenderGraphTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dxowl/RenderGraph.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// compile() only looks at the declared reads and writes, so the graphs are built without a device. Passes
+// that would write an imported texture are marked with a side effect instead.
+namespace
+{
+    typedef RenderGraph::PassBuilder PassBuilder;
+    typedef RenderGraph::PassContext PassContext;
+
+    RenderGraph::TextureDesc makeDesc(DXGI_FORMAT format, UINT width, UINT height)
+    {
+        RenderGraph::TextureDesc desc;
+        desc.format = format;
+        desc.width = width;
+        desc.height = height;
+        return desc;
+    }
+
+    template <typename Exception, typename Function>
+    bool throws(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testCulling()
+    {
+        RenderGraph graph;
+        RenderGraph::TextureDesc const color = makeDesc(DXGI_FORMAT_R16G16B16A16_FLOAT, 64, 32);
+        RenderGraph::TextureDesc depth = makeDesc(DXGI_FORMAT_D32_FLOAT, 64, 32);
+        depth.depth_stencil = true;
+
+        auto const albedo = graph.createTexture("albedo", color);
+        auto const normal = graph.createTexture("normal", color);
+        auto const depth_buffer = graph.createTexture("depth", depth);
+        auto const light = graph.createTexture("light", color);
+        auto const debug = graph.createTexture("debug", color);
+        auto const debug_blur = graph.createTexture("debug_blur", color);
+
+        std::vector<std::string> executed;
+        auto record = [&executed](char const* name) { return [&executed, name](PassContext&) { executed.push_back(name); }; };
+
+        graph.addPass("gbuffer", [&](PassBuilder& builder) { builder.write(albedo); builder.write(normal); builder.write(depth_buffer); }, record("gbuffer"));
+        graph.addPass("debug", [&](PassBuilder& builder) { builder.read(normal); builder.write(debug); }, record("debug"));
+        graph.addPass("debug_blur", [&](PassBuilder& builder) { builder.read(debug); builder.write(debug_blur); }, record("debug_blur"));
+        graph.addPass("lighting", [&](PassBuilder& builder) { builder.read(albedo); builder.read(normal); builder.read(depth_buffer); builder.write(light); }, record("lighting"));
+        graph.addPass("present", [&](PassBuilder& builder) { builder.read(light); builder.setSideEffect(); }, record("present"));
+        graph.compile();
+
+        // the debug chain is never consumed, everything the presenting pass depends on survives
+        DXOWL_CHECK(!graph.isCulled("gbuffer") && !graph.isCulled("lighting") && !graph.isCulled("present"));
+        DXOWL_CHECK(graph.isCulled("debug") && graph.isCulled("debug_blur"));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { graph.isCulled("missing"); }));
+        DXOWL_CHECK(executed.empty());
+
+        RenderGraph::Statistics const stats = graph.getStatistics();
+        DXOWL_CHECK(stats.pass_count == 5 && stats.culled_pass_count == 2);
+        DXOWL_CHECK(stats.transient_count == 4);
+        DXOWL_CHECK(stats.transient_bytes == 3 * 64 * 32 * 8 + 64 * 32 * 4);
+        DXOWL_CHECK(stats.physical_texture_count == 0 && stats.physical_bytes == 0);
+
+        // a pass with a side effect keeps its producers even if nothing reads its outputs
+        graph.addPass("capture", [&](PassBuilder& builder) { builder.read(debug_blur); builder.setSideEffect(); }, record("capture"));
+        graph.compile();
+        DXOWL_CHECK(!graph.isCulled("debug") && !graph.isCulled("debug_blur"));
+        DXOWL_CHECK(graph.getStatistics().culled_pass_count == 0 && graph.getStatistics().transient_count == 6);
+
+        graph.reset();
+        graph.compile();
+        DXOWL_CHECK(graph.getStatistics().pass_count == 0 && graph.getStatistics().transient_count == 0);
+    }
+
+    void testWriteOrder()
+    {
+        RenderGraph graph;
+        auto const target = graph.createTexture("target", makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 16, 16));
+        auto const unused = graph.createTexture("unused", makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 16, 16));
+        auto const nothing = [](PassContext&) {};
+
+        // drawing on top depends on the previous write, a read sees only the last write before it
+        graph.addPass("opaque", [&](PassBuilder& builder) { builder.write(target); }, nothing);
+        graph.addPass("transparent", [&](PassBuilder& builder) { builder.write(target); }, nothing);
+        graph.addPass("readback", [&](PassBuilder& builder) { builder.read(target); builder.setSideEffect(); }, nothing);
+        graph.addPass("overwrite", [&](PassBuilder& builder) { builder.write(target); builder.write(unused); }, nothing);
+        graph.compile();
+
+        DXOWL_CHECK(!graph.isCulled("opaque") && !graph.isCulled("transparent") && !graph.isCulled("readback"));
+        DXOWL_CHECK(graph.isCulled("overwrite"));
+        DXOWL_CHECK(graph.getStatistics().transient_count == 1);
+    }
+
+    void testErrors()
+    {
+        RenderGraph graph;
+        auto const nothing = [](PassContext&) {};
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { graph.createTexture("empty", makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 0, 16)); }));
+
+        auto const texture = graph.createTexture("texture", makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 16, 16));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() {
+            graph.addPass("feedback", [&](PassBuilder& builder) { builder.read(texture); builder.write(texture); }, nothing);
+        }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() {
+            graph.addPass("invalid", [&](PassBuilder& builder) { builder.read(texture + 1); }, nothing);
+        }));
+
+        graph.reset();
+        auto const unwritten = graph.createTexture("unwritten", makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 16, 16));
+        graph.addPass("early_read", [&](PassBuilder& builder) { builder.read(unwritten); builder.setSideEffect(); }, nothing);
+        DXOWL_CHECK(throws<std::runtime_error>([&]() { graph.compile(); }));
+    }
+} // namespace
+
+int main()
+{
+    testCulling();
+    testWriteOrder();
+    testErrors();
+
+    return dxowl_test::result();
+}
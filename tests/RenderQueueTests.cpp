@@ -0,0 +1,196 @@
+/// <copyright file="RenderQueueTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dxowl/RenderQueue.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// Sorting only looks at the keys, so the draws carry placeholder program and mesh pointers that are never
+// dereferenced, and nothing is submitted. user_data holds the order in which a draw was added.
+namespace
+{
+    typedef std::vector<std::pair<RenderQueue::SortKey, uint32_t>> KeyList;
+
+    alignas(16) unsigned char placeholders[2][16];
+
+    RenderQueue::Draw makeDraw(uint32_t user_data)
+    {
+        RenderQueue::Draw draw;
+        draw.program = reinterpret_cast<ShaderProgram*>(placeholders[0]);
+        draw.mesh = reinterpret_cast<Mesh*>(placeholders[1]);
+        draw.index_count = 3;
+        draw.user_data = user_data;
+        return draw;
+    }
+
+    /// Keys with few distinct values, so that many draws share a key.
+    KeyList makeKeys(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        KeyList retval;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t const program = rng() % 40;
+            retval.push_back({ RenderQueue::makeKey(rng() % 3, program, program % 4, rng() % 300, rng() % 8), i });
+        }
+        return retval;
+    }
+
+    void fill(RenderQueue& queue, KeyList const& keys)
+    {
+        queue.beginFrame(1);
+        for (auto const& key : keys)
+        {
+            queue.add(key.first, makeDraw(key.second));
+        }
+    }
+
+    KeyList readBack(RenderQueue const& queue)
+    {
+        KeyList retval;
+        for (size_t i = 0; i < queue.getDrawCount(); ++i)
+        {
+            retval.push_back({ queue.getKey(i), queue.getDraw(i).user_data });
+        }
+        return retval;
+    }
+
+    KeyList stableSorted(KeyList keys)
+    {
+        std::stable_sort(keys.begin(), keys.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+        return keys;
+    }
+
+    template <typename Exception, typename Function>
+    bool throws(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testKeys()
+    {
+        // fields are ordered pass, program, layout, geometry, depth from the most significant bits down
+        RenderQueue::SortKey const max_below = RenderQueue::makeKey(0, 0x3FFF, 0x3FF, 0xFFFFF, 0xFFF);
+        DXOWL_CHECK(max_below == (RenderQueue::SortKey(1) << RenderQueue::pass_shift) - 1);
+        DXOWL_CHECK(RenderQueue::makeKey(1, 0, 0, 0, 0) > max_below);
+        DXOWL_CHECK(RenderQueue::makeKey(0, 1, 0, 0, 0) > RenderQueue::makeKey(0, 0, 0x3FF, 0xFFFFF, 0xFFF));
+        DXOWL_CHECK(RenderQueue::makeKey(0, 0, 0, 1, 0) > RenderQueue::makeKey(0, 0, 0, 0, 0xFFF));
+        DXOWL_CHECK(RenderQueue::getPass(RenderQueue::makeKey(0xFF, 5, 6, 7, 8)) == 0xFF);
+
+        DXOWL_CHECK(throws<std::out_of_range>([]() { RenderQueue::makeKey(0x100, 0, 0, 0, 0); }));
+        DXOWL_CHECK(throws<std::out_of_range>([]() { RenderQueue::makeKey(0, 0x4000, 0, 0, 0); }));
+        DXOWL_CHECK(throws<std::out_of_range>([]() { RenderQueue::makeKey(0, 0, 0x400, 0, 0); }));
+        DXOWL_CHECK(throws<std::out_of_range>([]() { RenderQueue::makeKey(0, 0, 0, 0x100000, 0); }));
+        DXOWL_CHECK(throws<std::out_of_range>([]() { RenderQueue::makeKey(0, 0, 0, 0, 0x1000); }));
+
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(1.0f, 1.0f, 101.0f) == 0);
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(101.0f, 1.0f, 101.0f) == 0xFFF);
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(500.0f, 1.0f, 101.0f) == 0xFFF);
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(101.0f, 1.0f, 101.0f, true) == 0);
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(20.0f, 1.0f, 101.0f) < RenderQueue::computeDepthBucket(30.0f, 1.0f, 101.0f));
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(20.0f, 1.0f, 101.0f, true) > RenderQueue::computeDepthBucket(30.0f, 1.0f, 101.0f, true));
+        DXOWL_CHECK(RenderQueue::computeDepthBucket(20.0f, 5.0f, 5.0f) == 0);
+    }
+
+    void testAdd()
+    {
+        RenderQueue queue;
+        queue.beginFrame(7);
+
+        RenderQueue::Draw draw = makeDraw(0);
+        draw.program = nullptr;
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { queue.add(0, draw); }));
+        draw = makeDraw(0);
+        draw.mesh = nullptr;
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { queue.add(0, draw); }));
+        draw.arena = reinterpret_cast<GeometryArena*>(placeholders[1]);
+        draw.mesh = reinterpret_cast<Mesh*>(placeholders[1]);
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { queue.add(0, draw); }));
+        DXOWL_CHECK(queue.getDrawCount() == 0);
+
+        queue.add(5, makeDraw(0));
+        queue.add(2, makeDraw(1));
+        DXOWL_CHECK(queue.getDrawCount() == 2 && queue.getKey(0) == 5 && queue.getDraw(1).user_data == 1);
+        DXOWL_CHECK(throws<std::out_of_range>([&]() { queue.getKey(2); }));
+        DXOWL_CHECK(throws<std::out_of_range>([&]() { queue.getDraw(2); }));
+
+        queue.sort();
+        DXOWL_CHECK(queue.getKey(0) == 2 && queue.getDraw(0).user_data == 1);
+        queue.endFrame();
+        DXOWL_CHECK(queue.getLastFrameStatistics().frame == 7 && queue.getLastFrameStatistics().draw_count == 2);
+
+        // beginFrame clears the draws
+        queue.beginFrame(8);
+        DXOWL_CHECK(queue.getDrawCount() == 0);
+    }
+
+    void testSort()
+    {
+        KeyList const keys = makeKeys(5000, 1);
+        RenderQueue queue;
+        fill(queue, keys);
+        queue.sort();
+
+        // equal keys keep the order they were added in
+        DXOWL_CHECK(readBack(queue) == stableSorted(keys));
+
+        // the small ids leave bytes 3 and 6 zero in every key, those passes are skipped
+        DXOWL_CHECK(queue.getCurrentFrameStatistics().radix_passes == 6);
+
+        // draws added in key order are not sorted again
+        fill(queue, stableSorted(keys));
+        queue.sort();
+        DXOWL_CHECK(queue.getCurrentFrameStatistics().radix_passes == 0);
+        DXOWL_CHECK(readBack(queue) == stableSorted(keys));
+    }
+
+    void testParallelSort()
+    {
+        // above the parallel threshold, the chunked sort must give the same order as the serial one
+        KeyList const keys = makeKeys(100000, 2);
+        ThreadPool thread_pool(4);
+
+        RenderQueue serial;
+        fill(serial, keys);
+        serial.sort();
+
+        RenderQueue parallel;
+        fill(parallel, keys);
+        parallel.sort(&thread_pool);
+
+        KeyList const reference = stableSorted(keys);
+        DXOWL_CHECK(readBack(serial) == reference);
+        DXOWL_CHECK(readBack(parallel) == reference);
+        DXOWL_CHECK(parallel.getCurrentFrameStatistics().radix_passes == serial.getCurrentFrameStatistics().radix_passes);
+    }
+} // namespace
+
+int main()
+{
+    testKeys();
+    testAdd();
+    testSort();
+    testParallelSort();
+
+    return dxowl_test::result();
+}
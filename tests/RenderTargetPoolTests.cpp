@@ -0,0 +1,178 @@
+/// <copyright file="RenderTargetPoolTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <stdexcept>
+
+#include <dxowl/RenderTargetPool.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+// With the default settings, a request is allocated with 1/8 slack and rounded up to multiples of 64.
+namespace
+{
+    DXGI_FORMAT const color_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+    template <typename Exception, typename Function>
+    bool throws(Function const& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+        }
+        return false;
+    }
+
+    void testReuse()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        RenderTargetPool pool(device.Get());
+
+        pool.beginFrame(1);
+        RenderTargetPool::Lease const lease = pool.acquireRenderTarget(color_format, 1000, 600);
+        DXOWL_CHECK(lease.render_target != nullptr && lease.depth_stencil == nullptr);
+        DXOWL_CHECK(lease.width == 1000 && lease.height == 600);
+        DXOWL_CHECK(lease.render_target->getTextureDesc().Width == 1152);
+        DXOWL_CHECK(lease.render_target->getTextureDesc().Height == 704);
+        DXOWL_CHECK(lease.viewport.Width == 1000.0f && lease.viewport.Height == 600.0f);
+        DXOWL_CHECK(lease.uv_scale[0] == 1000.0f / 1152.0f && lease.uv_scale[1] == 600.0f / 704.0f);
+        pool.release(lease);
+        pool.endFrame();
+
+        RenderTargetPool::FrameStatistics stats = pool.getLastFrameStatistics();
+        DXOWL_CHECK(stats.acquire_count == 1 && stats.allocation_count == 1 && stats.hit_count == 0);
+        DXOWL_CHECK(stats.pooled_count == 1 && stats.pooled_bytes == size_t(1152) * 704 * 4);
+
+        // a window resized within the slack keeps its texture
+        size_t const texture_cnt = device->texture_cnt;
+        for (UINT frame = 2; frame < 6; ++frame)
+        {
+            pool.beginFrame(frame);
+            RenderTargetPool::Lease const resized = pool.acquireRenderTarget(color_format, 1000 + frame * 25, 600 + frame * 15);
+            DXOWL_CHECK(resized.render_target == lease.render_target);
+            DXOWL_CHECK(resized.uv_scale[0] == (1000.0f + frame * 25) / 1152.0f);
+            pool.endFrame();
+            DXOWL_CHECK(pool.getLastFrameStatistics().hit_count == 1);
+        }
+        DXOWL_CHECK(device->texture_cnt == texture_cnt);
+
+        // textures more than max_area_ratio larger than the request are replaced, not reused
+        pool.beginFrame(6);
+        RenderTargetPool::Lease const small = pool.acquireRenderTarget(color_format, 400, 300);
+        DXOWL_CHECK(small.render_target->getTextureDesc().Width == 512);
+        DXOWL_CHECK(small.render_target->getTextureDesc().Height == 384);
+        pool.endFrame();
+        stats = pool.getLastFrameStatistics();
+        DXOWL_CHECK(stats.allocation_count == 1 && stats.hit_count == 0);
+        DXOWL_CHECK(stats.pooled_count == 1 && stats.pooled_bytes == size_t(512) * 384 * 4);
+
+        // other formats and depth stencils are pooled separately, depth formats are allocated typeless
+        pool.beginFrame(7);
+        RenderTargetPool::Lease const hdr = pool.acquireRenderTarget(DXGI_FORMAT_R16G16B16A16_FLOAT, 400, 300);
+        RenderTargetPool::Lease const depth = pool.acquireDepthStencil(DXGI_FORMAT_D24_UNORM_S8_UINT, 400, 300);
+        DXOWL_CHECK(hdr.render_target != small.render_target);
+        DXOWL_CHECK(depth.depth_stencil != nullptr && depth.render_target == nullptr);
+        DXOWL_CHECK(depth.depth_stencil->getTextureDesc().Format == DXGI_FORMAT_R24G8_TYPELESS);
+        DXOWL_CHECK(depth.depth_stencil->getDepthStencilView() != nullptr);
+        DXOWL_CHECK(depth.depth_stencil->getShaderResourceView() != nullptr);
+        pool.endFrame();
+        DXOWL_CHECK(pool.getLastFrameStatistics().pooled_count == 3);
+
+        // unused textures are trimmed after trim_after_frames
+        pool.beginFrame(7 + RenderTargetPool::Settings().trim_after_frames + 1);
+        pool.endFrame();
+        DXOWL_CHECK(pool.getLastFrameStatistics().trim_count == 3);
+        DXOWL_CHECK(pool.getLastFrameStatistics().pooled_count == 0);
+
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { pool.acquireRenderTarget(color_format, 0, 600); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { pool.acquireDepthStencil(DXGI_FORMAT_R32_FLOAT, 64, 64); }));
+    }
+
+    void testAliasing()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        RenderTargetPool pool(device.Get());
+
+        // leases held at the same time never share a texture
+        pool.beginFrame(1);
+        RenderTargetPool::Lease const first = pool.acquireRenderTarget(color_format, 512, 512);
+        RenderTargetPool::Lease const second = pool.acquireRenderTarget(color_format, 512, 512);
+        DXOWL_CHECK(first.render_target != second.render_target);
+
+        // a released texture is handed out again in the same frame
+        pool.release(first);
+        RenderTargetPool::Lease const third = pool.acquireRenderTarget(color_format, 500, 500);
+        DXOWL_CHECK(third.render_target == first.render_target);
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().leased_peak == 2);
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().hit_count == 1);
+
+        pool.release(third);
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { pool.release(third); }));
+
+        // endFrame releases the leases still held
+        pool.endFrame();
+        pool.beginFrame(2);
+        RenderTargetPool::Lease const fourth = pool.acquireRenderTarget(color_format, 512, 512);
+        RenderTargetPool::Lease const fifth = pool.acquireRenderTarget(color_format, 512, 512);
+        DXOWL_CHECK(fourth.render_target != fifth.render_target);
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().hit_count == 2);
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().allocation_count == 0);
+
+        // trim() keeps leased textures
+        pool.release(fourth);
+        pool.trim();
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().trim_count == 1);
+        DXOWL_CHECK(pool.getCurrentFrameStatistics().pooled_count == 1);
+        pool.release(fifth);
+        pool.endFrame();
+    }
+
+    void testFailedCreation()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        RenderTargetPool pool(device.Get());
+
+        // a failed first allocation leaves no entry behind
+        pool.beginFrame(1);
+        device->failing_create_cnt = 1;
+        DXOWL_CHECK(throws<winrt::hresult_error>([&]() { pool.acquireRenderTarget(color_format, 512, 512); }));
+        pool.endFrame();
+        DXOWL_CHECK(pool.getLastFrameStatistics().pooled_count == 0);
+
+        pool.beginFrame(2);
+        RenderTargetPool::Lease const lease = pool.acquireRenderTarget(color_format, 512, 512);
+        pool.endFrame();
+
+        // a failed replacement keeps the free texture it would have replaced
+        pool.beginFrame(3);
+        device->failing_create_cnt = 1;
+        DXOWL_CHECK(throws<winrt::hresult_error>([&]() { pool.acquireRenderTarget(color_format, 2048, 2048); }));
+        RenderTargetPool::Lease const reused = pool.acquireRenderTarget(color_format, 512, 512);
+        DXOWL_CHECK(reused.render_target == lease.render_target);
+        DXOWL_CHECK(reused.render_target->getRenderTargetView() != nullptr);
+        pool.endFrame();
+        DXOWL_CHECK(pool.getLastFrameStatistics().pooled_count == 1);
+        DXOWL_CHECK(pool.getLastFrameStatistics().allocation_count == 0);
+    }
+} // namespace
+
+int main()
+{
+    testReuse();
+    testAliasing();
+    testFailedCreation();
+
+    return dxowl_test::result();
+}
@@ -0,0 +1,221 @@
+/// <copyright file="ResidencyManagerTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/ResidencyManager.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    // 64x64 RGBA8 without mips, the meshes below are sized to match
+    size_t const resource_byte_size = 64 * 64 * 4;
+
+    template <typename Exception, typename Function>
+    bool throws(Function const& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+        }
+        return false;
+    }
+
+    size_t trackedBytes()
+    {
+        return MemoryTracker::get().getStatistics().total_bytes;
+    }
+
+    /// Texture factory that counts its calls, recreation after eviction calls it again.
+    ResidencyManager::TextureFactory makeTextureFactory(int& create_cnt)
+    {
+        return [&create_cnt](ID3D11Device4* d3d11_device) {
+            D3D11_TEXTURE2D_DESC desc;
+            ZeroMemory(&desc, sizeof(desc));
+            desc.Width = 64;
+            desc.Height = 64;
+            desc.MipLevels = 1;
+            desc.ArraySize = 1;
+            desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            desc.SampleDesc.Count = 1;
+            desc.Usage = D3D11_USAGE_DEFAULT;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC view_desc;
+            ZeroMemory(&view_desc, sizeof(view_desc));
+            view_desc.Format = desc.Format;
+            view_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            view_desc.Texture2D.MipLevels = 1;
+
+            ++create_cnt;
+            return std::make_unique<Texture2D>(d3d11_device, std::vector<void const*>(), desc, view_desc);
+        };
+    }
+
+    /// Mesh factory with empty buffers of resource_byte_size bytes in total.
+    ResidencyManager::MeshFactory makeMeshFactory(int& create_cnt)
+    {
+        return [&create_cnt](ID3D11Device4* d3d11_device) {
+            std::vector<VertexDescriptor> const layout = {
+                { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } }
+            };
+            size_t const index_byte_size = 1024;
+
+            ++create_cnt;
+            return std::make_unique<Mesh>(
+                d3d11_device,
+                std::vector<void const*>{ nullptr },
+                std::vector<size_t>{ resource_byte_size - index_byte_size },
+                static_cast<void const*>(nullptr),
+                index_byte_size,
+                layout,
+                DXGI_FORMAT_R16_UINT);
+        };
+    }
+
+    void testEvictionOrder(dxowl_test::TestDevice const& test_device)
+    {
+        DXOWL_CHECK(trackedBytes() == 0);
+
+        ResidencyManager manager(test_device.device.Get(), 3 * resource_byte_size);
+        int create_cnt[4] = { 0, 0, 0, 0 };
+        ResidencyManager::Handle const handles[4] = {
+            manager.addTexture(makeTextureFactory(create_cnt[0])),
+            manager.addMesh(makeMeshFactory(create_cnt[1])),
+            manager.addTexture(makeTextureFactory(create_cnt[2])),
+            manager.addTexture(makeTextureFactory(create_cnt[3])),
+        };
+        DXOWL_CHECK(!manager.isResident(handles[0]) && create_cnt[0] == 0);
+
+        // frames 1 to 3 create one resource each, all fit into the budget
+        manager.beginFrame(1);
+        DXOWL_CHECK(manager.getTexture(handles[0]) != nullptr);
+        manager.endFrame();
+        manager.beginFrame(2);
+        DXOWL_CHECK(manager.getMesh(handles[1]) != nullptr);
+        DXOWL_CHECK(manager.getMesh(handles[1])->getMemoryByteSize() == resource_byte_size);
+        manager.endFrame();
+        manager.beginFrame(3);
+        manager.getTexture(handles[2]);
+        manager.endFrame();
+        DXOWL_CHECK(trackedBytes() == 3 * resource_byte_size);
+        DXOWL_CHECK(manager.getLastFrameStatistics().resident_count == 3);
+        DXOWL_CHECK(manager.getLastFrameStatistics().evicted_count == 0);
+
+        // using resource 0 again makes the mesh the least recently used
+        manager.beginFrame(4);
+        manager.getTexture(handles[0]);
+        manager.endFrame();
+        DXOWL_CHECK(manager.getLastFrameStatistics().recreated_count == 0);
+
+        manager.beginFrame(5);
+        manager.getTexture(handles[3]);
+        DXOWL_CHECK(!manager.isResident(handles[1]));
+        DXOWL_CHECK(manager.isResident(handles[0]) && manager.isResident(handles[2]) && manager.isResident(handles[3]));
+        manager.endFrame();
+        ResidencyManager::FrameStatistics stats = manager.getLastFrameStatistics();
+        DXOWL_CHECK(stats.frame == 5);
+        DXOWL_CHECK(stats.recreated_count == 1 && stats.recreated_bytes == resource_byte_size);
+        DXOWL_CHECK(stats.evicted_count == 1 && stats.evicted_bytes == resource_byte_size);
+        DXOWL_CHECK(stats.resident_count == 3 && stats.resident_bytes == 3 * resource_byte_size);
+        DXOWL_CHECK(!stats.over_budget);
+
+        // the evicted mesh is recreated on request and pushes out resource 2, last used in frame 3
+        manager.beginFrame(6);
+        DXOWL_CHECK(manager.getMesh(handles[1]) != nullptr);
+        manager.endFrame();
+        DXOWL_CHECK(create_cnt[1] == 2);
+        DXOWL_CHECK(!manager.isResident(handles[2]));
+        DXOWL_CHECK(manager.isResident(handles[0]) && manager.isResident(handles[3]));
+        DXOWL_CHECK(trackedBytes() == 3 * resource_byte_size);
+
+        // resources used in the current frame stay resident, even over budget
+        manager.setBudget(resource_byte_size);
+        manager.beginFrame(7);
+        manager.getTexture(handles[0]);
+        manager.getTexture(handles[3]);
+        manager.endFrame();
+        stats = manager.getLastFrameStatistics();
+        DXOWL_CHECK(!manager.isResident(handles[1]));
+        DXOWL_CHECK(manager.isResident(handles[0]) && manager.isResident(handles[3]));
+        DXOWL_CHECK(stats.evicted_count == 1 && stats.resident_count == 2);
+        DXOWL_CHECK(stats.over_budget);
+
+        // in the next frame neither is in use, evicting one of them meets the budget
+        manager.beginFrame(8);
+        manager.endFrame();
+        DXOWL_CHECK(manager.getLastFrameStatistics().evicted_count == 1);
+        DXOWL_CHECK(!manager.getLastFrameStatistics().over_budget);
+        DXOWL_CHECK(manager.isResident(handles[0]) != manager.isResident(handles[3]));
+        DXOWL_CHECK(trackedBytes() == resource_byte_size);
+
+        DXOWL_CHECK(create_cnt[0] == 1 && create_cnt[2] == 1 && create_cnt[3] == 1);
+    }
+
+    void testUnevictable(dxowl_test::TestDevice const& test_device)
+    {
+        DXOWL_CHECK(trackedBytes() == 0);
+
+        ResidencyManager manager(test_device.device.Get(), 2 * resource_byte_size);
+        int create_cnt[3] = { 0, 0, 0 };
+        ResidencyManager::Handle const pinned = manager.addTexture(makeTextureFactory(create_cnt[0]), false);
+        ResidencyManager::Handle const first = manager.addTexture(makeTextureFactory(create_cnt[1]));
+        ResidencyManager::Handle const second = manager.addMesh(makeMeshFactory(create_cnt[2]));
+
+        manager.beginFrame(1);
+        manager.getTexture(pinned);
+        manager.getTexture(first);
+        manager.endFrame();
+
+        // both textures were last used in frame 1, only the evictable one is a candidate
+        manager.beginFrame(2);
+        manager.getMesh(second);
+        manager.endFrame();
+        DXOWL_CHECK(manager.isResident(pinned) && manager.isResident(second));
+        DXOWL_CHECK(!manager.isResident(first));
+
+        // unmanaged memory counts against the budget, the mesh has to make room for it
+        MemoryTracker::Allocation render_target(MemoryTracker::Category::RenderTarget, resource_byte_size);
+        manager.beginFrame(3);
+        manager.endFrame();
+        DXOWL_CHECK(manager.isResident(pinned) && !manager.isResident(second));
+        DXOWL_CHECK(manager.getLastFrameStatistics().resident_count == 1);
+        DXOWL_CHECK(trackedBytes() == 2 * resource_byte_size);
+
+        // removed handles are invalid, handles of the wrong kind are rejected
+        manager.remove(first);
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { manager.getTexture(first); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { manager.getMesh(pinned); }));
+        DXOWL_CHECK(throws<std::invalid_argument>([&]() { manager.getTexture(second); }));
+
+        ResidencyManager::Handle const failing = manager.addTexture([](ID3D11Device4*) { return std::unique_ptr<Texture2D>(); });
+        DXOWL_CHECK(throws<std::runtime_error>([&]() { manager.getTexture(failing); }));
+        DXOWL_CHECK(!manager.isResident(failing));
+    }
+} // namespace
+
+int main()
+{
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+
+    testEvictionOrder(test_device);
+    testUnevictable(test_device);
+
+    return dxowl_test::result();
+}
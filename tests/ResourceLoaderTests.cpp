@@ -0,0 +1,173 @@
+/// <copyright file="ResourceLoaderTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dxowl/ResourceLoader.hpp>
+#include <dxowl/Texture2D.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    struct Named
+    {
+        Named(ID3D11Device4* d3d11_device, std::string name, int value) : name(std::move(name)), value(value) {}
+
+        std::string name;
+        int value;
+    };
+
+    bool endsWith(std::string const& str, std::string const& suffix)
+    {
+        return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // the factories do not touch the device, so no device is needed
+    void testCompletions()
+    {
+        ResourceLoader loader(nullptr, 4);
+        std::thread::id const main_thread = std::this_thread::get_id();
+
+        int completions = 0;
+        bool on_main_thread = true;
+        std::vector<ResourceLoader::Handle<int>> handles;
+        for (int i = 0; i < 64; ++i)
+        {
+            handles.push_back(loader.load<int>(
+                [i](ID3D11Device4*) { return std::make_shared<int>(i); },
+                [&](ResourceLoader::Handle<int> const& handle) {
+                    ++completions;
+                    on_main_thread = on_main_thread && std::this_thread::get_id() == main_thread && handle.isReady();
+                }));
+        }
+
+        bool values_ok = true;
+        for (int i = 0; i < 64; ++i)
+        {
+            handles[i].wait();
+            values_ok = values_ok && !handles[i].hasError() && *handles[i].getResource() == i;
+        }
+        DXOWL_CHECK(values_ok);
+
+        // callbacks only run in dispatchCompletions
+        DXOWL_CHECK(completions == 0);
+        DXOWL_CHECK(loader.dispatchCompletions() == 64);
+        DXOWL_CHECK(completions == 64 && on_main_thread);
+        DXOWL_CHECK(loader.dispatchCompletions() == 0);
+    }
+
+    void testCreate()
+    {
+        ResourceLoader loader(nullptr, 1);
+        ResourceLoader::Handle<Named> handle;
+        {
+            std::string name = "copied";
+            handle = loader.create<Named>(nullptr, name, 7);
+        }
+        handle.wait();
+        DXOWL_CHECK(handle.getResource() != nullptr);
+        DXOWL_CHECK(handle.getResource()->name == "copied" && handle.getResource()->value == 7);
+    }
+
+    void testErrors()
+    {
+        ResourceLoader loader(nullptr, 2);
+
+        auto hresult_failure = loader.load<int>([](ID3D11Device4*) -> std::shared_ptr<int> { throw winrt::hresult_error(E_INVALIDARG); });
+        auto std_failure = loader.load<int>([](ID3D11Device4*) -> std::shared_ptr<int> { throw std::runtime_error("file not found"); });
+        hresult_failure.wait();
+        std_failure.wait();
+
+        DXOWL_CHECK(hresult_failure.hasError() && hresult_failure.getResource() == nullptr);
+        DXOWL_CHECK(hresult_failure.getErrorCode() == E_INVALIDARG);
+        // the system message text depends on the locale, the code is appended to it
+        DXOWL_CHECK(endsWith(hresult_failure.getErrorMessage(), " (HRESULT 0x80070057)"));
+        DXOWL_CHECK(hresult_failure.getErrorMessage().size() > std::string(" (HRESULT 0x80070057)").size());
+
+        DXOWL_CHECK(std_failure.hasError() && std_failure.getErrorCode() == E_FAIL);
+        DXOWL_CHECK(std_failure.getErrorMessage() == "file not found");
+
+        bool rethrown = false;
+        try
+        {
+            std::rethrow_exception(std_failure.getError());
+        }
+        catch (std::runtime_error const&)
+        {
+            rethrown = true;
+        }
+        DXOWL_CHECK(rethrown);
+
+        // a default constructed handle belongs to no job
+        ResourceLoader::Handle<int> invalid;
+        DXOWL_CHECK(!invalid.isValid() && !invalid.isReady() && invalid.getResource() == nullptr);
+        bool wait_threw = false;
+        try
+        {
+            invalid.wait();
+        }
+        catch (std::logic_error const&)
+        {
+            wait_threw = true;
+        }
+        DXOWL_CHECK(wait_threw);
+    }
+
+    void testTextureErrors(dxowl_test::TestDevice const& test_device)
+    {
+        ResourceLoader loader(test_device.device.Get(), 2);
+        D3D11_TEXTURE2D_DESC desc = {};
+        desc.Width = 16;
+        desc.Height = 16;
+        desc.MipLevels = 1;
+        desc.ArraySize = 1;
+        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC view_desc = {};
+        view_desc.Format = desc.Format;
+        view_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        view_desc.Texture2D.MipLevels = 1;
+        auto const factory = [](D3D11_TEXTURE2D_DESC desc, D3D11_SHADER_RESOURCE_VIEW_DESC view_desc) {
+            return [desc, view_desc](ID3D11Device4* d3d11_device) {
+                return std::make_shared<Texture2D>(d3d11_device, std::vector<void*>(), desc, view_desc);
+            };
+        };
+
+        auto texture = loader.load<Texture2D>(factory(desc, view_desc));
+        desc.Width = 0;
+        auto empty_texture = loader.load<Texture2D>(factory(desc, view_desc));
+        texture.wait();
+        empty_texture.wait();
+
+        // the device refuses a texture without texels, the HRESULT reaches the handle
+        DXOWL_CHECK(!texture.hasError() && texture.getResource() != nullptr);
+        DXOWL_CHECK(empty_texture.hasError() && empty_texture.getResource() == nullptr);
+        DXOWL_CHECK(empty_texture.getErrorCode() == E_INVALIDARG);
+        DXOWL_CHECK(endsWith(empty_texture.getErrorMessage(), " (HRESULT 0x80070057)"));
+    }
+} // namespace
+
+int main()
+{
+    testCompletions();
+    testCreate();
+    testErrors();
+
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+    testTextureErrors(test_device);
+    return dxowl_test::result();
+}
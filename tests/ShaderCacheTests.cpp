@@ -0,0 +1,298 @@
+/// <copyright file="ShaderCacheTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dxowl/Lz4.hpp>
+#include <dxowl/ShaderCache.hpp>
+#include <dxowl/ShaderProgram.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    std::string tempPath(std::string const& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("dxowl_" + name)).string();
+    }
+
+    std::vector<uint8_t> readBytes(std::string const& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(std::string const& path, std::vector<uint8_t> const& bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    /// Stand-in for shader bytecode: repeated instruction words with some noise, compresses like DXBC.
+    std::vector<uint8_t> makeBlob(size_t byte_size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> retval(byte_size);
+        for (size_t i = 0; i < byte_size; ++i)
+        {
+            retval[i] = (i % 16 < 12) ? static_cast<uint8_t>(i % 16) : static_cast<uint8_t>(rng());
+        }
+        return retval;
+    }
+
+    bool matches(ShaderCache::Bytecode bytecode, std::vector<uint8_t> const& expected)
+    {
+        return bytecode.data != nullptr
+            && bytecode.byte_size == expected.size()
+            && std::memcmp(bytecode.data, expected.data(), expected.size()) == 0;
+    }
+
+    template <typename Exception, typename Function>
+    bool throws(Function&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (Exception const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testLz4()
+    {
+        for (size_t byte_size : { 0, 1, 12, 13, 100, 70000 })
+        {
+            std::vector<uint8_t> const input = makeBlob(byte_size, 1);
+            std::vector<uint8_t> const compressed = lz4::compress(input.data(), input.size());
+            std::vector<uint8_t> output(byte_size);
+            DXOWL_CHECK(lz4::decompress(compressed.data(), compressed.size(), output.data(), output.size()));
+            DXOWL_CHECK(output == input);
+        }
+
+        // an empty input decodes into a null destination
+        std::vector<uint8_t> const empty = lz4::compress(nullptr, 0);
+        DXOWL_CHECK(empty.size() == 1 && lz4::decompress(empty.data(), empty.size(), nullptr, 0));
+
+        std::vector<uint8_t> const input = makeBlob(4096, 2);
+        std::vector<uint8_t> compressed = lz4::compress(input.data(), input.size());
+        DXOWL_CHECK(compressed.size() < input.size() / 2);
+        std::vector<uint8_t> output(input.size());
+        DXOWL_CHECK(!lz4::decompress(compressed.data(), compressed.size(), output.data(), output.size() - 1));
+        DXOWL_CHECK(!lz4::decompress(compressed.data(), compressed.size() - 1, output.data(), output.size()));
+
+        // a match that reaches back before the start of the output
+        std::vector<uint8_t> const bad_offset = { 0x10, 'a', 0x05, 0x00, 0x00 };
+        DXOWL_CHECK(!lz4::decompress(bad_offset.data(), bad_offset.size(), output.data(), 5));
+    }
+
+    void testRoundTrip()
+    {
+        std::vector<std::vector<uint8_t>> blobs;
+        for (uint32_t i = 0; i < 20; ++i)
+        {
+            blobs.push_back(makeBlob(64 + i * 300, i));
+        }
+
+        ShaderCacheWriter writer;
+        std::vector<ShaderCache::Handle> handles;
+        for (auto const& blob : blobs)
+        {
+            handles.push_back(writer.add(blob));
+        }
+
+        // identical bytecode is stored once and keeps its handle
+        DXOWL_CHECK(writer.add(blobs[3]) == handles[3] && writer.add(blobs[7].data(), blobs[7].size()) == handles[7]);
+        DXOWL_CHECK(writer.getBlobCount() == 20 && writer.getDuplicateCount() == 2);
+        DXOWL_CHECK(ShaderCache::computeHandle(blobs[3].data(), blobs[3].size()) == handles[3]);
+
+        for (bool compress : { false, true })
+        {
+            std::string const path = tempPath(compress ? "compressed.dxsp" : "raw.dxsp");
+            writer.write(path, compress);
+            {
+                ShaderCache cache(path);
+                DXOWL_CHECK(cache.getBlobCount() == 20);
+                for (size_t i = 0; i < blobs.size(); ++i)
+                {
+                    DXOWL_CHECK(cache.contains(handles[i]));
+                    DXOWL_CHECK(matches(cache.getBytecode(handles[i]), blobs[i]));
+                }
+
+                // uncompressed bytecode points into the mapping, decompressed bytecode is kept after the first access
+                ShaderCache::Bytecode const first = cache.getBytecode(handles[5]);
+                DXOWL_CHECK(cache.getBytecode(handles[5]).data == first.data);
+
+                DXOWL_CHECK(!cache.contains(ShaderCache::InvalidHandle) && cache.getBytecode(ShaderCache::InvalidHandle).data == nullptr);
+                std::vector<uint8_t> const unknown = makeBlob(100, 99);
+                DXOWL_CHECK(!cache.contains(ShaderCache::computeHandle(unknown.data(), unknown.size())));
+            }
+            std::filesystem::remove(path);
+        }
+
+        writer.write(tempPath("raw.dxsp"));
+        writer.write(tempPath("compressed.dxsp"), true);
+        DXOWL_CHECK(std::filesystem::file_size(tempPath("compressed.dxsp")) < std::filesystem::file_size(tempPath("raw.dxsp")) / 2);
+        std::filesystem::remove(tempPath("raw.dxsp"));
+        std::filesystem::remove(tempPath("compressed.dxsp"));
+
+        // blobs that do not shrink are stored raw
+        ShaderCacheWriter noise_writer;
+        std::vector<uint8_t> noise(256);
+        std::mt19937 rng(5);
+        for (auto& byte : noise)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        ShaderCache::Handle const noise_handle = noise_writer.add(noise);
+        noise_writer.write(tempPath("noise.dxsp"), true);
+        {
+            std::vector<uint8_t> const bytes = readBytes(tempPath("noise.dxsp"));
+            detail::ShaderPackHeader header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            detail::ShaderPackEntry entry;
+            std::memcpy(&entry, bytes.data() + header.index_offset, sizeof(entry));
+            DXOWL_CHECK(entry.flags == 0 && entry.stored_byte_size == 256);
+            DXOWL_CHECK(matches(ShaderCache(tempPath("noise.dxsp")).getBytecode(noise_handle), noise));
+        }
+        std::filesystem::remove(tempPath("noise.dxsp"));
+    }
+
+    void testCorruptFiles()
+    {
+        std::vector<uint8_t> const blob = makeBlob(2000, 3);
+        ShaderCacheWriter writer;
+        ShaderCache::Handle const handle = writer.add(blob);
+        std::string const path = tempPath("corrupt.dxsp");
+        writer.write(path, true);
+        std::vector<uint8_t> const original = readBytes(path);
+
+        detail::ShaderPackHeader header;
+        std::memcpy(&header, original.data(), sizeof(header));
+        size_t const entry_offset = static_cast<size_t>(header.index_offset);
+
+        auto opens = [&](std::vector<uint8_t> const& bytes) {
+            writeBytes(path, bytes);
+            return !throws<std::runtime_error>([&]() { ShaderCache cache(path); });
+        };
+
+        DXOWL_CHECK(opens(original));
+        DXOWL_CHECK(!opens(std::vector<uint8_t>(original.begin(), original.begin() + 16)));
+
+        std::vector<uint8_t> bytes = original;
+        bytes[0] = 'X';
+        DXOWL_CHECK(!opens(bytes));
+
+        // an index offset close to the top of the range must not wrap past the size check
+        bytes = original;
+        uint64_t const huge_offset = ~uint64_t(0) - 7;
+        std::memcpy(bytes.data() + offsetof(detail::ShaderPackHeader, index_offset), &huge_offset, 8);
+        DXOWL_CHECK(!opens(bytes));
+
+        bytes = original;
+        uint32_t const entry_count = 2;
+        std::memcpy(bytes.data() + offsetof(detail::ShaderPackHeader, entry_count), &entry_count, 4);
+        DXOWL_CHECK(!opens(bytes));
+
+        // entries pointing outside the data are not found, a wrapping offset included
+        for (uint64_t offset : { uint64_t(header.index_offset), ~uint64_t(0) - 15 })
+        {
+            bytes = original;
+            std::memcpy(bytes.data() + entry_offset + offsetof(detail::ShaderPackEntry, offset), &offset, 8);
+            DXOWL_CHECK(opens(bytes));
+            ShaderCache cache(path);
+            DXOWL_CHECK(cache.contains(handle) && cache.getBytecode(handle).data == nullptr);
+        }
+
+        // compressed data that does not decode
+        bytes = original;
+        detail::ShaderPackEntry entry;
+        std::memcpy(&entry, original.data() + entry_offset, sizeof(entry));
+        DXOWL_CHECK(entry.flags == detail::shader_pack_entry_lz4);
+        bytes[static_cast<size_t>(entry.offset)] = 0xff;
+        bytes[static_cast<size_t>(entry.offset) + 1] = 0xff;
+        DXOWL_CHECK(opens(bytes));
+        {
+            ShaderCache cache(path);
+            DXOWL_CHECK(cache.getBytecode(handle).data == nullptr);
+        }
+
+        std::filesystem::remove(path);
+        DXOWL_CHECK(throws<std::runtime_error>([&]() { ShaderCache cache(path); }));
+    }
+
+    void testProgramHandles(dxowl_test::TestDevice const& test_device)
+    {
+        std::vector<uint8_t> const vertex_shader = makeBlob(300, 10);
+        std::vector<uint8_t> const pixel_shader = makeBlob(300, 11);
+        std::vector<uint8_t> const missing_shader = makeBlob(300, 12);
+        ShaderCacheWriter writer;
+        ShaderCache::Handle const vs = writer.add(vertex_shader);
+        ShaderCache::Handle const ps = writer.add(pixel_shader);
+        ShaderCache::Handle const missing = ShaderCache::computeHandle(missing_shader.data(), missing_shader.size());
+        std::string const path = tempPath("program.dxsp");
+        writer.write(path);
+
+        {
+            ShaderCache cache(path);
+            ID3D11Device4* device = test_device.device.Get();
+            std::vector<VertexDescriptor> const layout = { { 12, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } } };
+
+            // only the geometry shader is optional, a handle that is given must resolve
+            DXOWL_CHECK(throws<std::invalid_argument>([&]() { ShaderProgram(device, layout, cache, ShaderCache::InvalidHandle, ShaderCache::InvalidHandle, ps); }));
+            DXOWL_CHECK(throws<std::invalid_argument>([&]() { ShaderProgram(device, layout, cache, vs, ShaderCache::InvalidHandle, ShaderCache::InvalidHandle); }));
+            DXOWL_CHECK(throws<std::runtime_error>([&]() { ShaderProgram(device, layout, cache, vs, missing, ps); }));
+
+            std::string message;
+            try
+            {
+                ShaderProgram(device, layout, cache, missing, ShaderCache::InvalidHandle, ps);
+            }
+            catch (std::runtime_error const& e)
+            {
+                message = e.what();
+            }
+            char missing_str[24];
+            std::snprintf(missing_str, sizeof(missing_str), "0x%016llX", static_cast<unsigned long long>(missing));
+            DXOWL_CHECK(message.find("vertex shader") != std::string::npos && message.find(missing_str) != std::string::npos);
+
+#ifndef _WIN32
+            // the recording device accepts any bytecode, a WARP device would reject the stand-ins
+            ShaderProgram program(device, layout, cache, vs, ShaderCache::InvalidHandle, ps);
+            auto* recording_device = static_cast<dxowl_test::RecordingDevice*>(device);
+            DXOWL_CHECK(recording_device->shader_cnt == 2 && recording_device->input_layout_cnt == 1);
+#endif
+        }
+        std::filesystem::remove(path);
+    }
+} // namespace
+
+int main()
+{
+    testLz4();
+    testRoundTrip();
+    testCorruptFiles();
+
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+    testProgramHandles(test_device);
+
+    return dxowl_test::result();
+}
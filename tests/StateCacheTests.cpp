@@ -0,0 +1,120 @@
+/// <copyright file="StateCacheTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <vector>
+
+#include <dxowl/StateCache.hpp>
+
+#include "RecordingDevice.hpp"
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    typedef Microsoft::WRL::ComPtr<ID3D11Buffer> BufferPtr;
+
+    BufferPtr createVertexBuffer(ID3D11Device4* device)
+    {
+        CD3D11_BUFFER_DESC const desc(256, D3D11_BIND_VERTEX_BUFFER);
+        BufferPtr retval;
+        device->CreateBuffer(&desc, nullptr, retval.GetAddressOf());
+        return retval;
+    }
+
+    uint64_t address(void const* ptr)
+    {
+        return reinterpret_cast<uintptr_t>(ptr);
+    }
+
+    void testRedundantState()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        StateCache cache(ctx);
+
+        uint8_t const bytecode[4] = {};
+        Microsoft::WRL::ComPtr<ID3D11VertexShader> vs;
+        Microsoft::WRL::ComPtr<ID3D11PixelShader> ps;
+        device->CreateVertexShader(bytecode, sizeof(bytecode), nullptr, vs.GetAddressOf());
+        device->CreatePixelShader(bytecode, sizeof(bytecode), nullptr, ps.GetAddressOf());
+        BufferPtr const index_buffer = createVertexBuffer(device.Get());
+
+        cache.beginFrame(1);
+        for (int i = 0; i < 3; ++i)
+        {
+            cache.setVertexShader(vs.Get());
+            cache.setPixelShader(ps.Get());
+            cache.setGeometryShader(nullptr);
+            cache.setPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            cache.setIndexBuffer(index_buffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+            cache.drawIndexed(3, 0, 0);
+        }
+        cache.endFrame();
+
+        // the first round reaches the context, the repetitions are filtered
+        DXOWL_CHECK(ctx->countCalls("VSSetShader") == 1 && ctx->countCalls("PSSetShader") == 1 && ctx->countCalls("GSSetShader") == 1);
+        DXOWL_CHECK(ctx->countCalls("IASetPrimitiveTopology") == 1 && ctx->countCalls("IASetIndexBuffer") == 1);
+        DXOWL_CHECK(ctx->countCalls("DrawIndexed") == 3);
+        DXOWL_CHECK(cache.getLastFrameStatistics().calls_issued == 5 && cache.getLastFrameStatistics().calls_skipped == 10);
+
+        // a changed index buffer offset is a change
+        cache.setIndexBuffer(index_buffer.Get(), DXGI_FORMAT_R16_UINT, 64);
+        DXOWL_CHECK(ctx->findCalls("IASetIndexBuffer").back().args[2] == 64);
+
+        // after invalidate() nothing is assumed about the context
+        ctx->calls.clear();
+        cache.invalidate();
+        cache.setVertexShader(vs.Get());
+        cache.setIndexBuffer(index_buffer.Get(), DXGI_FORMAT_R16_UINT, 64);
+        DXOWL_CHECK(ctx->countCalls("VSSetShader") == 1 && ctx->countCalls("IASetIndexBuffer") == 1);
+    }
+
+    void testVertexBufferRanges()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext* ctx = device->immediate_context.Get();
+        StateCache cache(ctx);
+
+        BufferPtr const buffers[3] = { createVertexBuffer(device.Get()), createVertexBuffer(device.Get()), createVertexBuffer(device.Get()) };
+        UINT const strides[3] = { 12, 8, 4 };
+        UINT const offsets[3] = { 0, 0, 0 };
+        ID3D11Buffer* const raw_buffers[3] = { buffers[0].Get(), buffers[1].Get(), buffers[2].Get() };
+
+        // separate slot changes become one ranged call at the draw
+        cache.setVertexBuffers(0, 1, &raw_buffers[0], &strides[0], &offsets[0]);
+        cache.setVertexBuffers(2, 1, &raw_buffers[2], &strides[2], &offsets[2]);
+        DXOWL_CHECK(ctx->countCalls("IASetVertexBuffers") == 0);
+        cache.draw(3, 0);
+        std::vector<dxowl_test::RecordedCall> calls = ctx->findCalls("IASetVertexBuffers");
+        DXOWL_CHECK(calls.size() == 1 && calls[0].args[0] == 0 && calls[0].args[1] == 3);
+        DXOWL_CHECK(calls[0].args[2] == address(raw_buffers[0]) && calls[0].args[3] == 12);
+        DXOWL_CHECK(calls[0].args[5] == 0 && calls[0].args[8] == address(raw_buffers[2]));
+
+        // rebinding what is bound issues nothing, a single changed slot is issued alone
+        cache.setVertexBuffers(0, 3, raw_buffers, strides, offsets);
+        cache.draw(3, 0);
+        DXOWL_CHECK(ctx->countCalls("IASetVertexBuffers") == 2);
+        UINT const moved_offsets[3] = { 0, 32, 0 };
+        cache.setVertexBuffers(0, 3, raw_buffers, strides, moved_offsets);
+        cache.draw(3, 0);
+        calls = ctx->findCalls("IASetVertexBuffers");
+        DXOWL_CHECK(calls.size() == 3 && calls[2].args[0] == 1 && calls[2].args[1] == 1 && calls[2].args[4] == 32);
+
+        // an explicit flush without pending changes is free
+        cache.flush();
+        DXOWL_CHECK(ctx->countCalls("IASetVertexBuffers") == 3 && ctx->countCalls("Draw") == 3);
+    }
+} // namespace
+
+int main()
+{
+    testRedundantState();
+    testVertexBufferRanges();
+
+    return dxowl_test::result();
+}
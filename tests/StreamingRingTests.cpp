@@ -0,0 +1,132 @@
+/// <copyright file="StreamingRingTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/StreamingRing.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    void testAllocationAndWrap(dxowl_test::TestDevice const& test_device)
+    {
+        StreamingRing ring(test_device.device.Get(), 256);
+        ID3D11DeviceContext4* ctx = test_device.context.Get();
+        std::vector<uint8_t> data(100, 0x5a);
+
+        ring.beginFrame(1);
+        StreamingRing::Allocation a = ring.upload(ctx, data);
+        StreamingRing::Allocation b = ring.upload(ctx, data);
+        DXOWL_CHECK(a.buffer == ring.getBuffer() && a.byte_offset == 0 && a.byte_size == 100 && a.frame == 1);
+        DXOWL_CHECK(b.byte_offset == 112);
+        DXOWL_CHECK(ring.isCurrent(a) && ring.isCurrent(b));
+
+        // does not fit behind b, wraps with a discard that invalidates a and b
+        StreamingRing::Allocation c = ring.upload(ctx, data);
+        DXOWL_CHECK(c.byte_offset == 0);
+        DXOWL_CHECK(!ring.isCurrent(a) && !ring.isCurrent(b) && ring.isCurrent(c));
+
+        ring.endFrame();
+        StreamingRing::FrameStatistics stats = ring.getLastFrameStatistics();
+        DXOWL_CHECK(stats.frame == 1 && stats.allocation_count == 3 && stats.bytes_allocated == 300);
+        DXOWL_CHECK(stats.discard_count == 2 && stats.no_overwrite_count == 1);
+        DXOWL_CHECK(stats.bytes_padding == 12 + 44); // alignment of b and the skipped tail behind b
+
+        // appending in the next frame keeps c valid
+        ring.beginFrame(2);
+        StreamingRing::Allocation d = ring.upload(ctx, data.data(), 50, 64);
+        DXOWL_CHECK(d.byte_offset == 128 && d.frame == 2);
+        DXOWL_CHECK(ring.isCurrent(c) && ring.isCurrent(d));
+        DXOWL_CHECK(ring.getCurrentFrameStatistics().discard_count == 0);
+        ring.endFrame();
+    }
+
+    void testErrors(dxowl_test::TestDevice const& test_device)
+    {
+        StreamingRing ring(test_device.device.Get(), 64);
+        StreamingRing other(test_device.device.Get(), 64);
+        ring.beginFrame(1);
+
+        bool threw = false;
+        try
+        {
+            ring.upload(test_device.context.Get(), static_cast<void const*>(nullptr), 65);
+        }
+        catch (std::length_error const&)
+        {
+            threw = true;
+        }
+        DXOWL_CHECK(threw);
+
+        std::vector<float> data(4, 1.0f);
+        StreamingRing::Allocation a = other.upload(test_device.context.Get(), data);
+        DXOWL_CHECK(other.isCurrent(a) && !ring.isCurrent(a));
+    }
+
+#ifndef _WIN32
+    std::vector<uint64_t> recordedMapTypes(dxowl_test::RecordingContext const& ctx)
+    {
+        std::vector<uint64_t> retval;
+        for (dxowl_test::RecordedCall const& call : ctx.findCalls("Map"))
+        {
+            retval.push_back(call.args[2]);
+        }
+        return retval;
+    }
+
+    /// The recording context shows which map type reached the driver, and where the data landed.
+    void testMapTypes()
+    {
+        auto device = dxowl_test::createRecordingDevice();
+        dxowl_test::RecordingContext& ctx = *device->immediate_context.Get();
+        StreamingRing ring(device.Get(), 256);
+        std::vector<uint8_t> data(100, 0x5a);
+
+        ring.beginFrame(1);
+        ring.upload(&ctx, data);
+        ring.upload(&ctx, data);
+        ring.upload(&ctx, data);
+        ring.endFrame();
+        ring.beginFrame(2);
+        ring.upload(&ctx, data);
+        ring.upload(&ctx, data);
+        ring.endFrame();
+
+        // the first upload and every wrap discard, appending never does
+        std::vector<uint64_t> const expected = {
+            D3D11_MAP_WRITE_DISCARD, D3D11_MAP_WRITE_NO_OVERWRITE, D3D11_MAP_WRITE_DISCARD,
+            D3D11_MAP_WRITE_NO_OVERWRITE, D3D11_MAP_WRITE_DISCARD };
+        DXOWL_CHECK(recordedMapTypes(ctx) == expected);
+        DXOWL_CHECK(ctx.countCalls("Unmap") == expected.size());
+        for (dxowl_test::RecordedCall const& call : ctx.findCalls("Map"))
+        {
+            DXOWL_CHECK(call.args[0] == reinterpret_cast<uintptr_t>(ring.getBuffer()) && call.args[1] == 0 && call.args[3] == 0);
+        }
+
+        // the last allocation was written at offset zero after the final discard
+        std::vector<uint8_t> const& contents = static_cast<dxowl_test::RecordingBuffer*>(ring.getBuffer())->data;
+        DXOWL_CHECK(std::equal(data.begin(), data.end(), contents.begin()));
+    }
+#endif
+} // namespace
+
+int main()
+{
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+    testAllocationAndWrap(test_device);
+    testErrors(test_device);
+#ifndef _WIN32
+    testMapTypes();
+#endif
+    return dxowl_test::result();
+}
@@ -0,0 +1,36 @@
+/// <copyright file="TestCheck.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef TestCheck_hpp
+#define TestCheck_hpp
+
+#include <cstdio>
+
+namespace dxowl_test
+{
+    inline int failure_count = 0;
+
+    inline void reportFailure(char const* expr, char const* file, int line)
+    {
+        std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expr);
+        ++failure_count;
+    }
+
+    /// Exit code of a test executable, non-zero if any check failed.
+    inline int result()
+    {
+        if (failure_count > 0)
+        {
+            std::fprintf(stderr, "%d check(s) failed\n", failure_count);
+        }
+        return failure_count > 0 ? 1 : 0;
+    }
+} // namespace dxowl_test
+
+/// Records a failure and continues, so one run reports every failing check.
+#define DXOWL_CHECK(expr) ((expr) ? (void)0 : dxowl_test::reportFailure(#expr, __FILE__, __LINE__))
+
+#endif // !TestCheck_hpp
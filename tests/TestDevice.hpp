@@ -0,0 +1,63 @@
+/// <copyright file="TestDevice.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef TestDevice_hpp
+#define TestDevice_hpp
+
+#include <d3d11_4.h>
+#include <wrl/client.h> // Microsoft::WRL::ComPtr
+#include <winrt/base.h> // winrt::check_hresult
+
+#ifndef _WIN32
+#include "RecordingDevice.hpp"
+#endif
+
+namespace dxowl_test
+{
+    struct TestDevice
+    {
+        Microsoft::WRL::ComPtr<ID3D11Device4> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext4> context;
+    };
+
+#ifdef _WIN32
+    /// WARP software device, so tests that create resources run on hosts without a GPU.
+    inline TestDevice createTestDevice()
+    {
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+        D3D_FEATURE_LEVEL const feature_level = D3D_FEATURE_LEVEL_11_1;
+        winrt::check_hresult(D3D11CreateDevice(
+            nullptr,
+            D3D_DRIVER_TYPE_WARP,
+            nullptr,
+            0,
+            &feature_level,
+            1,
+            D3D11_SDK_VERSION,
+            device.GetAddressOf(),
+            nullptr,
+            context.GetAddressOf()));
+
+        TestDevice retval;
+        winrt::check_hresult(device.As(&retval.device));
+        winrt::check_hresult(context.As(&retval.context));
+        return retval;
+    }
+#else
+    /// Recording device of host/, which keeps resources in system memory.
+    inline TestDevice createTestDevice()
+    {
+        Microsoft::WRL::ComPtr<RecordingDevice> device = createRecordingDevice();
+        TestDevice retval;
+        retval.device = device;
+        retval.context = device->immediate_context;
+        return retval;
+    }
+#endif
+} // namespace dxowl_test
+
+#endif // !TestDevice_hpp
@@ -0,0 +1,40 @@
+/// <copyright file="TestImage.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef TestImage_hpp
+#define TestImage_hpp
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace dxowl_test
+{
+    /// Synthetic RGBA8 image with smooth gradients, a sine pattern and a noisy checker board, shared by
+    /// the BlockCompressor tests and benchmark. Alpha is a cosine band unless opaque is set.
+    inline std::vector<uint8_t> makeTestImage(uint32_t width, uint32_t height, bool opaque = false)
+    {
+        std::vector<uint8_t> retval(size_t(width) * height * 4);
+        std::mt19937 rng(1);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                float const fx = x / float(width);
+                float const fy = y / float(height);
+                uint8_t* texel = &retval[(size_t(y) * width + x) * 4];
+                texel[0] = uint8_t(255.0f * (0.5f + 0.5f * std::sin(fx * 20.0f + fy * 3.0f)));
+                texel[1] = uint8_t(255.0f * fy);
+                texel[2] = uint8_t(((x / 32 + y / 32) % 2 ? 200 : 40) + rng() % 16);
+                texel[3] = opaque ? 255 : uint8_t(255.0f * (0.5f + 0.5f * std::cos(fy * 13.0f)));
+            }
+        }
+        return retval;
+    }
+} // namespace dxowl_test
+
+#endif // !TestImage_hpp
@@ -0,0 +1,65 @@
+/// <copyright file="TestMesh.hpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#ifndef TestMesh_hpp
+#define TestMesh_hpp
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace dxowl_test
+{
+    /// UV sphere with segments x segments quads and triangles in random order, shared by the MeshOptimizer
+    /// tests and benchmark. ids holds a per-vertex value that identifies the original vertex after reordering.
+    struct TestMesh
+    {
+        size_t vertex_count = 0;
+        std::vector<float> positions; // xyz per vertex
+        std::vector<uint32_t> ids;
+        std::vector<uint32_t> indices;
+    };
+
+    inline TestMesh makeTestSphere(uint32_t segments, uint32_t seed = 1)
+    {
+        TestMesh retval;
+        for (uint32_t y = 0; y <= segments; ++y)
+        {
+            for (uint32_t x = 0; x <= segments; ++x)
+            {
+                float const u = x * 6.2831853f / segments;
+                float const v = y * 3.1415927f / segments;
+                retval.positions.insert(retval.positions.end(), { std::cos(u) * std::sin(v), std::cos(v), std::sin(u) * std::sin(v) });
+                retval.ids.push_back(static_cast<uint32_t>(retval.vertex_count++));
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (uint32_t y = 0; y < segments; ++y)
+        {
+            for (uint32_t x = 0; x < segments; ++x)
+            {
+                uint32_t const a = y * (segments + 1) + x;
+                uint32_t const c = a + segments + 1;
+                triangles.push_back({ a, c, a + 1 });
+                triangles.push_back({ a + 1, c, c + 1 });
+            }
+        }
+
+        std::mt19937 rng(seed);
+        std::shuffle(triangles.begin(), triangles.end(), rng);
+        for (auto const& triangle : triangles)
+        {
+            retval.indices.insert(retval.indices.end(), triangle.begin(), triangle.end());
+        }
+        return retval;
+    }
+} // namespace dxowl_test
+
+#endif // !TestMesh_hpp
@@ -0,0 +1,100 @@
+/// <copyright file="Texture3DTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <dxowl/Texture3D.hpp>
+
+#include "TestCheck.hpp"
+#include "TestDevice.hpp"
+
+using namespace dxowl;
+
+// The texel data is compared on the recording device only, the WARP device just has to accept it.
+namespace
+{
+    D3D11_TEXTURE3D_DESC makeDesc(DXGI_FORMAT format, UINT mip_levels)
+    {
+        D3D11_TEXTURE3D_DESC desc;
+        ZeroMemory(&desc, sizeof(desc));
+        desc.Width = 4;
+        desc.Height = 4;
+        desc.Depth = 2;
+        desc.MipLevels = mip_levels;
+        desc.Format = format;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        return desc;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC makeViewDesc(D3D11_TEXTURE3D_DESC const& desc)
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC view_desc;
+        ZeroMemory(&view_desc, sizeof(view_desc));
+        view_desc.Format = desc.Format;
+        view_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE3D;
+        view_desc.Texture3D.MipLevels = desc.MipLevels;
+        return view_desc;
+    }
+
+    bool hasData(Texture3D const& texture, UINT subresource, void const* expected, size_t byte_size)
+    {
+#ifndef _WIN32
+        auto recorded = static_cast<dxowl_test::RecordingTexture3D*>(texture.getTexture().Get());
+        return recorded->subresources[subresource].data.size() == byte_size
+            && std::memcmp(recorded->subresources[subresource].data.data(), expected, byte_size) == 0;
+#else
+        return texture.getTexture() != nullptr;
+#endif
+    }
+
+    void testContiguousData(dxowl_test::TestDevice const& test_device)
+    {
+        // a vector of texels is one buffer holding all depth slices of level 0
+        std::vector<uint8_t> texels(4 * 4 * 2 * 4);
+        for (size_t i = 0; i < texels.size(); ++i)
+        {
+            texels[i] = static_cast<uint8_t>(i);
+        }
+        D3D11_TEXTURE3D_DESC const desc = makeDesc(DXGI_FORMAT_R8G8B8A8_UNORM, 1);
+        Texture3D const texture(test_device.device.Get(), texels, desc, makeViewDesc(desc));
+        DXOWL_CHECK(hasData(texture, 0, texels.data(), texels.size()));
+        DXOWL_CHECK(texture.getMemoryByteSize() == texels.size());
+
+        std::vector<float> const values(4 * 4 * 2, 0.25f);
+        D3D11_TEXTURE3D_DESC const float_desc = makeDesc(DXGI_FORMAT_R32_FLOAT, 1);
+        Texture3D const float_texture(test_device.device.Get(), values, float_desc, makeViewDesc(float_desc));
+        DXOWL_CHECK(hasData(float_texture, 0, values.data(), values.size() * sizeof(float)));
+    }
+
+    void testPerLevelData(dxowl_test::TestDevice const& test_device)
+    {
+        // a vector of pointers holds one pointer per mip level
+        std::vector<uint8_t> const level0(4 * 4 * 2, 1);
+        std::vector<uint8_t> const level1(2 * 2 * 1, 2);
+        std::vector<uint8_t const*> const levels = { level0.data(), level1.data() };
+        D3D11_TEXTURE3D_DESC const desc = makeDesc(DXGI_FORMAT_R8_UNORM, 2);
+        Texture3D const texture(test_device.device.Get(), levels, desc, makeViewDesc(desc));
+        DXOWL_CHECK(hasData(texture, 0, level0.data(), level0.size()));
+        DXOWL_CHECK(hasData(texture, 1, level1.data(), level1.size()));
+
+        // no pointers create the texture without initial data
+        Texture3D const empty(test_device.device.Get(), std::vector<void const*>(), desc, makeViewDesc(desc));
+        DXOWL_CHECK(empty.getTexture() != nullptr && empty.getShaderResourceView() != nullptr);
+    }
+} // namespace
+
+int main()
+{
+    dxowl_test::TestDevice test_device = dxowl_test::createTestDevice();
+
+    testContiguousData(test_device);
+    testPerLevelData(test_device);
+
+    return dxowl_test::result();
+}
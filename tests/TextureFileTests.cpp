@@ -0,0 +1,353 @@
+/// <copyright file="TextureFileTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dxowl/TextureFile.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    class Bytes
+    {
+    public:
+        void put32(uint32_t value) { put(&value, sizeof(value)); }
+        void put64(uint64_t value) { put(&value, sizeof(value)); }
+        void put(void const* data, size_t byte_size)
+        {
+            auto bytes = static_cast<uint8_t const*>(data);
+            m_data.insert(m_data.end(), bytes, bytes + byte_size);
+        }
+        void set32(size_t offset, uint32_t value) { std::memcpy(&m_data[offset], &value, sizeof(value)); }
+
+        std::vector<uint8_t>& data() { return m_data; }
+
+    private:
+        std::vector<uint8_t> m_data;
+    };
+
+    /// Payload byte i is i % 251, so every subresource starts with a distinct byte.
+    std::vector<uint8_t> makePayload(size_t byte_size)
+    {
+        std::vector<uint8_t> retval(byte_size);
+        for (size_t i = 0; i < byte_size; ++i)
+        {
+            retval[i] = uint8_t(i % 251);
+        }
+        return retval;
+    }
+
+    std::string writeFile(std::string const& name, std::vector<uint8_t> const& data)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / ("dxowl_" + name)).string();
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+        return path;
+    }
+
+    /// DDS header with an empty pixel format, four_cc is "DX10" for files with the extended header.
+    Bytes makeDDSHeader(uint32_t width, uint32_t height, uint32_t mip_levels, uint32_t pf_flags, char const* four_cc, uint32_t caps2)
+    {
+        Bytes bytes;
+        bytes.put("DDS ", 4);
+        bytes.put32(124);
+        bytes.put32(0x1007 | 0x20000); // caps, height, width, pixel format, mip map count
+        bytes.put32(height);
+        bytes.put32(width);
+        bytes.put32(0); // pitch or linear size
+        bytes.put32(0); // depth
+        bytes.put32(mip_levels);
+        for (int i = 0; i < 11; ++i)
+        {
+            bytes.put32(0);
+        }
+        bytes.put32(32);
+        bytes.put32(pf_flags);
+        bytes.put(four_cc, 4);
+        for (int i = 0; i < 5; ++i)
+        {
+            bytes.put32(0);
+        }
+        bytes.put32(0x1000); // caps
+        bytes.put32(caps2);
+        bytes.put32(0);
+        bytes.put32(0);
+        bytes.put32(0);
+        return bytes;
+    }
+
+    Bytes makeKTX2Header(uint32_t vk_format, uint32_t width, uint32_t height, uint32_t layer_cnt, uint32_t level_cnt, uint32_t scheme)
+    {
+        static uint8_t const identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+        Bytes bytes;
+        bytes.put(identifier, sizeof(identifier));
+        bytes.put32(vk_format);
+        bytes.put32(1); // type size
+        bytes.put32(width);
+        bytes.put32(height);
+        bytes.put32(0); // depth
+        bytes.put32(layer_cnt);
+        bytes.put32(1); // faces
+        bytes.put32(level_cnt);
+        bytes.put32(scheme);
+        for (int i = 0; i < 4; ++i)
+        {
+            bytes.put32(0); // data format descriptor and key/value data
+        }
+        bytes.put64(0); // supercompression global data
+        bytes.put64(0);
+        return bytes;
+    }
+
+    bool throwsRuntimeError(std::string const& path)
+    {
+        try
+        {
+            TextureFile file(path);
+        }
+        catch (std::runtime_error const&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testDDSArray()
+    {
+        // 8x4 RGBA8, 2 mips, 2 slices: 128 + 32 bytes per slice
+        Bytes bytes = makeDDSHeader(8, 4, 2, 0x4, "DX10", 0);
+        bytes.put32(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+        bytes.put32(3); // 2D
+        bytes.put32(0);
+        bytes.put32(2);
+        bytes.put32(0);
+        std::vector<uint8_t> const payload = makePayload(2 * (128 + 32));
+        bytes.put(payload.data(), payload.size());
+        std::string const path = writeFile("array.dds", bytes.data());
+
+        TextureFile::Info probed;
+        DXOWL_CHECK(TextureFile::probe(path, probed));
+        DXOWL_CHECK(probed.width == 8 && probed.height == 4 && probed.mip_levels == 2 && probed.array_size == 2);
+
+        {
+            TextureFile file(path);
+            TextureFile::Info const& info = file.getInfo();
+            DXOWL_CHECK(info.container == TextureFile::Container::DDS);
+            DXOWL_CHECK(info.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+            DXOWL_CHECK(info.depth == 1 && !info.is_cube && !info.is_volume);
+            DXOWL_CHECK(file.isZeroCopy());
+
+            // all mips of slice 0 first, each pointing at its bytes in the file
+            std::vector<void const*> const data = file.getSubresourceData();
+            size_t const offsets[4] = { 0, 128, 160, 288 };
+            DXOWL_CHECK(data.size() == 4);
+            for (size_t i = 0; i < data.size() && i < 4; ++i)
+            {
+                DXOWL_CHECK(std::memcmp(data[i], payload.data() + offsets[i], i % 2 == 0 ? 128 : 32) == 0);
+            }
+            DXOWL_CHECK(static_cast<uint8_t const*>(data[1]) - static_cast<uint8_t const*>(data[0]) == 128);
+
+            std::vector<D3D11_SUBRESOURCE_DATA> const& initial_data = file.getInitialData();
+            DXOWL_CHECK(initial_data[0].SysMemPitch == 32 && initial_data[0].SysMemSlicePitch == 128);
+            DXOWL_CHECK(initial_data[1].SysMemPitch == 16 && initial_data[1].SysMemSlicePitch == 32);
+
+            D3D11_TEXTURE2D_DESC const desc = file.getTexture2DDesc();
+            DXOWL_CHECK(desc.Width == 8 && desc.Height == 4 && desc.MipLevels == 2 && desc.ArraySize == 2);
+            DXOWL_CHECK(desc.Usage == D3D11_USAGE_IMMUTABLE && desc.MiscFlags == 0);
+            DXOWL_CHECK(file.getShaderResourceViewDesc().ViewDimension == D3D11_SRV_DIMENSION_TEXTURE2DARRAY);
+
+            bool threw = false;
+            try
+            {
+                file.getTexture3DDesc();
+            }
+            catch (std::invalid_argument const&)
+            {
+                threw = true;
+            }
+            DXOWL_CHECK(threw);
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    void testDDSCube()
+    {
+        // legacy DXT1 cube map, 8x8 with one mip, four blocks per face
+        Bytes bytes = makeDDSHeader(8, 8, 1, 0x4, "DXT1", 0x200 | 0xFC00);
+        std::vector<uint8_t> const payload = makePayload(6 * 32);
+        bytes.put(payload.data(), payload.size());
+        std::string const path = writeFile("cube.dds", bytes.data());
+
+        {
+            TextureFile file(path);
+            DXOWL_CHECK(file.getInfo().format == DXGI_FORMAT_BC1_UNORM);
+            DXOWL_CHECK(file.getInfo().is_cube && file.getInfo().array_size == 6);
+            DXOWL_CHECK(file.getTexture2DDesc().MiscFlags == D3D11_RESOURCE_MISC_TEXTURECUBE);
+            DXOWL_CHECK(file.getShaderResourceViewDesc().ViewDimension == D3D11_SRV_DIMENSION_TEXTURECUBE);
+            DXOWL_CHECK(file.getInitialData()[5].SysMemPitch == 16);
+            DXOWL_CHECK(std::memcmp(file.getSubresourceData()[5], payload.data() + 5 * 32, 32) == 0);
+        }
+
+        // only five faces
+        bytes.set32(4 + 108, 0x200 | 0x7C00);
+        std::string const partial_path = writeFile("partial_cube.dds", bytes.data());
+        DXOWL_CHECK(throwsRuntimeError(partial_path));
+
+        std::filesystem::remove(path);
+        std::filesystem::remove(partial_path);
+    }
+
+    void testKTX2()
+    {
+        // 4x4 RGBA8, 3 mips, 2 layers; levels are stored smallest first
+        uint64_t const level_sizes[3] = { 2 * 64, 2 * 16, 2 * 4 };
+        Bytes bytes = makeKTX2Header(37, 4, 4, 2, 3, 0);
+        uint64_t const data_offset = bytes.data().size() + 3 * 24;
+        uint64_t const level_offsets[3] = { data_offset + 8 + 32, data_offset + 8, data_offset };
+        for (int level = 0; level < 3; ++level)
+        {
+            bytes.put64(level_offsets[level]);
+            bytes.put64(level_sizes[level]);
+            bytes.put64(level_sizes[level]);
+        }
+        std::vector<uint8_t> const payload = makePayload(8 + 32 + 128);
+        bytes.put(payload.data(), payload.size());
+        std::string const path = writeFile("array.ktx2", bytes.data());
+
+        {
+            TextureFile file(path);
+            TextureFile::Info const& info = file.getInfo();
+            DXOWL_CHECK(info.container == TextureFile::Container::KTX2);
+            DXOWL_CHECK(info.format == DXGI_FORMAT_R8G8B8A8_UNORM);
+            DXOWL_CHECK(info.width == 4 && info.height == 4 && info.mip_levels == 3 && info.array_size == 2);
+            DXOWL_CHECK(file.isZeroCopy());
+
+            // subresource 4 is mip 1 of layer 1, the second half of level 1
+            std::vector<void const*> const data = file.getSubresourceData();
+            DXOWL_CHECK(data.size() == 6);
+            DXOWL_CHECK(std::memcmp(data[0], payload.data() + 40, 64) == 0);
+            DXOWL_CHECK(std::memcmp(data[3], payload.data() + 104, 64) == 0);
+            DXOWL_CHECK(std::memcmp(data[4], payload.data() + 8 + 16, 16) == 0);
+            DXOWL_CHECK(std::memcmp(data[5], payload.data() + 4, 4) == 0);
+        }
+
+        // level sizes must match the format
+        bytes.data()[80 + 8] = 100;
+        std::string const bad_path = writeFile("bad_level.ktx2", bytes.data());
+        DXOWL_CHECK(throwsRuntimeError(bad_path));
+
+        std::filesystem::remove(path);
+        std::filesystem::remove(bad_path);
+    }
+
+    void testKTX2Supercompressed()
+    {
+        // single 4x2 RGBA8 level, "compressed" by inverting every byte
+        std::vector<uint8_t> const texels = makePayload(32);
+        std::vector<uint8_t> compressed = texels;
+        for (auto& value : compressed)
+        {
+            value = uint8_t(~value);
+        }
+
+        Bytes bytes = makeKTX2Header(37, 4, 2, 0, 1, 2);
+        bytes.put64(bytes.data().size() + 24);
+        bytes.put64(compressed.size());
+        bytes.put64(texels.size());
+        bytes.put(compressed.data(), compressed.size());
+        std::string const path = writeFile("zstd.ktx2", bytes.data());
+
+        uint32_t seen_scheme = 0;
+        auto decompressor = [&seen_scheme](uint32_t scheme, void const* src, size_t src_size, void* dst, size_t dst_size) {
+            seen_scheme = scheme;
+            if (src_size != dst_size)
+            {
+                throw std::runtime_error("size mismatch");
+            }
+            for (size_t i = 0; i < src_size; ++i)
+            {
+                static_cast<uint8_t*>(dst)[i] = uint8_t(~static_cast<uint8_t const*>(src)[i]);
+            }
+        };
+
+        {
+            TextureFile file(path, decompressor);
+            DXOWL_CHECK(seen_scheme == 2);
+            DXOWL_CHECK(!file.isZeroCopy());
+            DXOWL_CHECK(std::memcmp(file.getSubresourceData()[0], texels.data(), texels.size()) == 0);
+            DXOWL_CHECK(file.getInitialData()[0].SysMemPitch == 16);
+        }
+
+        // without a decompressor the file cannot be used
+        DXOWL_CHECK(throwsRuntimeError(path));
+
+        std::filesystem::remove(path);
+    }
+
+    void testErrors()
+    {
+        TextureFile::Info info;
+        DXOWL_CHECK(!TextureFile::probe((std::filesystem::temp_directory_path() / "dxowl_missing.dds").string(), info));
+
+        Bytes unknown;
+        unknown.put("PNG ", 4);
+        for (int i = 0; i < 40; ++i)
+        {
+            unknown.put32(0);
+        }
+        std::string const unknown_path = writeFile("unknown.dds", unknown.data());
+        DXOWL_CHECK(!TextureFile::probe(unknown_path, info));
+        DXOWL_CHECK(throwsRuntimeError(unknown_path));
+
+        // header claims more texels than the file holds, readInfo only needs the header bytes
+        Bytes truncated = makeDDSHeader(16, 16, 1, 0x4, "DXT5", 0);
+        truncated.put32(0);
+        std::string const truncated_path = writeFile("truncated.dds", truncated.data());
+        DXOWL_CHECK(!TextureFile::probe(truncated_path, info));
+        DXOWL_CHECK(throwsRuntimeError(truncated_path));
+
+        bool threw = false;
+        try
+        {
+            TextureFile::readInfo(truncated.data().data(), truncated.data().size(), truncated.data().size() + 256);
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        DXOWL_CHECK(!threw);
+
+        // BasisLZ needs transcoding and is rejected
+        Bytes basis = makeKTX2Header(0, 4, 4, 0, 1, 1);
+        std::string const basis_path = writeFile("basis.ktx2", basis.data());
+        DXOWL_CHECK(!TextureFile::probe(basis_path, info));
+
+        std::filesystem::remove(unknown_path);
+        std::filesystem::remove(truncated_path);
+        std::filesystem::remove(basis_path);
+    }
+} // namespace
+
+int main()
+{
+    testDDSArray();
+    testDDSCube();
+    testKTX2();
+    testKTX2Supercompressed();
+    testErrors();
+
+    return dxowl_test::result();
+}
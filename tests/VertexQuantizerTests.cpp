@@ -0,0 +1,244 @@
+/// <copyright file="VertexQuantizerTests.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <dxowl/VertexQuantizer.hpp>
+
+#include "TestCheck.hpp"
+
+using namespace dxowl;
+
+namespace
+{
+    struct Vertex
+    {
+        float position[3];
+        float normal[3];
+        float tangent[4];
+        float tex_coord[2];
+        float color[4];
+        uint8_t bone_indices[4];
+    };
+
+    VertexDescriptor makeVertexLayout()
+    {
+        return { sizeof(Vertex),
+            {
+                { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            } };
+    }
+
+    VertexDescriptor makeInstanceLayout()
+    {
+        return { 12, { { "POSITION", 1, DXGI_FORMAT_R32G32B32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 } } };
+    }
+
+    /// Shader side decode of the octahedral encoding documented in VertexQuantizer.hpp.
+    void decodeOctahedral(int16_t x, int16_t y, float (&n)[3])
+    {
+        n[0] = (std::max)(x / 32767.0f, -1.0f);
+        n[1] = (std::max)(y / 32767.0f, -1.0f);
+        n[2] = 1.0f - std::fabs(n[0]) - std::fabs(n[1]);
+        if (n[2] < 0.0f)
+        {
+            float const fx = (1.0f - std::fabs(n[1])) * (n[0] >= 0.0f ? 1.0f : -1.0f);
+            float const fy = (1.0f - std::fabs(n[0])) * (n[1] >= 0.0f ? 1.0f : -1.0f);
+            n[0] = fx;
+            n[1] = fy;
+        }
+        float const length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (float& value : n)
+        {
+            value /= length;
+        }
+    }
+
+    template <typename T>
+    T load(std::vector<uint8_t> const& stream, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, stream.data() + offset, sizeof(T));
+        return value;
+    }
+
+    void testLayout()
+    {
+        std::vector<Vertex> vertices(3, Vertex{});
+        float const instances[3][3] = { { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, { 7.0f, 8.0f, 9.0f } };
+
+        auto const mesh = VertexQuantizer::quantize({ makeVertexLayout(), makeInstanceLayout() }, { vertices.data(), instances }, vertices.size());
+        std::vector<VertexDescriptor> const& layout = mesh.getVertexLayout();
+
+        // position 8, normal 4, tangent 8, texcoord 4, color 4, blend indices 4 bytes
+        DXOWL_CHECK(layout.size() == 2 && layout[0].stride == 32);
+        DXGI_FORMAT const formats[6] = {
+            DXGI_FORMAT_R16G16B16A16_SNORM, DXGI_FORMAT_R16G16_SNORM, DXGI_FORMAT_R16G16B16A16_SNORM,
+            DXGI_FORMAT_R16G16_FLOAT, DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_UINT
+        };
+        UINT const offsets[6] = { 0, 8, 12, 20, 24, 28 };
+        for (size_t i = 0; i < 6 && i < layout[0].attributes.size(); ++i)
+        {
+            DXOWL_CHECK(layout[0].attributes[i].Format == formats[i]);
+            DXOWL_CHECK(layout[0].attributes[i].AlignedByteOffset == offsets[i]);
+        }
+        DXOWL_CHECK(layout[0].attributes[1].SemanticName == makeVertexLayout().attributes[1].SemanticName);
+
+        // per-instance streams are copied as they are
+        DXOWL_CHECK(layout[1] == makeInstanceLayout());
+        DXOWL_CHECK(mesh.getVertexDataByteSizes()[1] == sizeof(instances));
+        DXOWL_CHECK(std::memcmp(mesh.getVertexData()[1], instances, sizeof(instances)) == 0);
+
+        DXOWL_CHECK(mesh.getReport().bytes_per_vertex_before == sizeof(Vertex));
+        DXOWL_CHECK(mesh.getReport().bytes_per_vertex_after == 32);
+        DXOWL_CHECK(mesh.getVertexCount() == 3 && mesh.getVertexDataByteSizes()[0] == 3 * 32);
+
+        bool threw = false;
+        try
+        {
+            VertexQuantizer::quantize({ makeVertexLayout() }, {}, 0);
+        }
+        catch (std::invalid_argument const&)
+        {
+            threw = true;
+        }
+        DXOWL_CHECK(threw);
+    }
+
+    void testRounding()
+    {
+        // x spans [-32767, 32767], which makes the position scale exactly 1 per unit
+        std::vector<float> const x = { -32767.0f, 32767.0f, 0.5f, 1.5f, 2.5f, -0.5f, -1.5f };
+        int16_t const expected_x[] = { -32767, 32767, 0, 2, 2, 0, -2 };
+
+        // six normals so that both the four-wide and the remainder path of the octahedral encoder see -0
+        float const normals[6][3] = {
+            { -0.0f, 0.0f, -1.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, -0.0f, -1.0f },
+            { 0.0f, 0.0f, 1.0f }, { -0.0f, 0.0f, -1.0f }, { 0.0f, -0.0f, -1.0f }
+        };
+        int16_t const expected_normals[6][2] = {
+            { -32767, 32767 }, { 32767, 32767 }, { 32767, -32767 }, { 0, 0 }, { -32767, 32767 }, { 32767, -32767 }
+        };
+
+        std::vector<Vertex> vertices(x.size(), Vertex{});
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            vertices[v].position[0] = x[v];
+            std::memcpy(vertices[v].normal, normals[v % 6], sizeof(vertices[v].normal));
+            vertices[v].tangent[0] = 1.0f;
+            vertices[v].tangent[3] = v % 2 == 0 ? 1.0f : -1.0f;
+            vertices[v].color[3] = 1.0f;
+        }
+        vertices[0].color[0] = 0.5f; // 127.5 rounds to even
+        vertices[0].color[1] = -0.25f;
+        vertices[0].color[2] = 1.25f;
+        vertices[1].tex_coord[0] = 1.0f + 1.0f / 2048.0f; // halfway between two halves, rounds to even
+        vertices[1].tex_coord[1] = 1.0f + 3.0f / 2048.0f;
+
+        auto const mesh = VertexQuantizer::quantize({ makeVertexLayout() }, { vertices.data() }, vertices.size());
+        auto stream = static_cast<uint8_t const*>(mesh.getVertexData()[0]);
+        std::vector<uint8_t> const data(stream, stream + mesh.getVertexDataByteSizes()[0]);
+
+        DXOWL_CHECK(mesh.getDequantizationConstants().position_scale[0] == 32767.0f);
+        DXOWL_CHECK(mesh.getDequantizationConstants().position_offset[0] == 0.0f);
+        DXOWL_CHECK(mesh.getDequantizationConstants().position_scale[3] == 0.0f && mesh.getDequantizationConstants().position_offset[3] == 1.0f);
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            DXOWL_CHECK(load<int16_t>(data, v * 32) == expected_x[v]);
+            DXOWL_CHECK(load<int16_t>(data, v * 32 + 8) == expected_normals[v % 6][0]);
+            DXOWL_CHECK(load<int16_t>(data, v * 32 + 10) == expected_normals[v % 6][1]);
+            DXOWL_CHECK(load<int16_t>(data, v * 32 + 16) == (v % 2 == 0 ? 32767 : -32767));
+        }
+
+        DXOWL_CHECK(load<uint32_t>(data, 24) == (128u | (0u << 8) | (255u << 16) | (255u << 24)));
+        DXOWL_CHECK(load<uint16_t>(data, 32 + 20) == 0x3C00);
+        DXOWL_CHECK(load<uint16_t>(data, 32 + 22) == 0x3C02);
+
+        // every folded corner decodes to the pole, so the reported normal error stays tiny
+        DXOWL_CHECK(mesh.getReport().max_normal_error_degrees < 0.01f);
+    }
+
+    void testErrorBounds()
+    {
+        // more vertices than one encoding task, with and without a thread pool
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<Vertex> vertices(10001);
+        for (Vertex& vertex : vertices)
+        {
+            float length = 0.0f;
+            for (int k = 0; k < 3; ++k)
+            {
+                vertex.position[k] = 10.0f * unit(rng) + 3.0f;
+                vertex.normal[k] = unit(rng);
+                vertex.tangent[k] = unit(rng);
+                length += vertex.normal[k] * vertex.normal[k];
+            }
+            for (float& value : vertex.normal)
+            {
+                value /= std::sqrt(length);
+            }
+            vertex.tangent[3] = unit(rng) < 0.0f ? -1.0f : 1.0f;
+            vertex.tex_coord[0] = 0.5f * unit(rng) + 0.5f;
+            vertex.tex_coord[1] = 0.5f * unit(rng) + 0.5f;
+            for (float& value : vertex.color)
+            {
+                value = 0.5f * unit(rng) + 0.5f;
+            }
+        }
+
+        ThreadPool thread_pool(3);
+        auto const serial = VertexQuantizer::quantize({ makeVertexLayout() }, { vertices.data() }, vertices.size());
+        auto const parallel = VertexQuantizer::quantize({ makeVertexLayout() }, { vertices.data() }, vertices.size(), &thread_pool);
+        DXOWL_CHECK(serial.getVertexDataByteSizes() == parallel.getVertexDataByteSizes());
+        DXOWL_CHECK(std::memcmp(serial.getVertexData()[0], parallel.getVertexData()[0], serial.getVertexDataByteSizes()[0]) == 0);
+
+        VertexQuantizer::Report const& report = serial.getReport();
+        DXOWL_CHECK(report.max_position_error > 0.0f && report.max_position_error <= 10.0f / 32767.0f);
+        DXOWL_CHECK(report.max_normal_error_degrees > 0.0f && report.max_normal_error_degrees < 0.05f);
+        DXOWL_CHECK(report.max_texcoord_error <= 1.0f / 4096.0f);
+        DXOWL_CHECK(report.max_color_error <= 0.5f / 255.0f + 1e-6f);
+
+        // the report is an upper bound of what a shader decodes
+        auto stream = static_cast<uint8_t const*>(serial.getVertexData()[0]);
+        std::vector<uint8_t> const data(stream, stream + serial.getVertexDataByteSizes()[0]);
+        VertexQuantizer::DequantizationConstants const& constants = serial.getDequantizationConstants();
+        float position_error = 0.0f;
+        float normal_cos = 1.0f;
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                float const decoded = (std::max)(load<int16_t>(data, v * 32 + 2 * k) / 32767.0f, -1.0f) * constants.position_scale[k] + constants.position_offset[k];
+                position_error = (std::max)(position_error, std::fabs(decoded - vertices[v].position[k]));
+            }
+            float n[3];
+            decodeOctahedral(load<int16_t>(data, v * 32 + 8), load<int16_t>(data, v * 32 + 10), n);
+            normal_cos = (std::min)(normal_cos, n[0] * vertices[v].normal[0] + n[1] * vertices[v].normal[1] + n[2] * vertices[v].normal[2]);
+        }
+        DXOWL_CHECK(position_error <= report.max_position_error);
+        DXOWL_CHECK(std::acos((std::min)(normal_cos, 1.0f)) * (180.0f / 3.14159265f) <= report.max_normal_error_degrees + 1e-3f);
+    }
+} // namespace
+
+int main()
+{
+    testLayout();
+    testRounding();
+    testErrorBounds();
+
+    return dxowl_test::result();
+}
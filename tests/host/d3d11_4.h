@@ -0,0 +1,675 @@
+/// <copyright file="d3d11_4.h">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+// Stand-in for the Windows SDK header on hosts without it. Declares the subset of D3D11 that dxowl uses, with
+// the SDK's names and values, so that dxowl builds against the recording device of RecordingDevice.hpp.
+// Interfaces only carry the methods dxowl calls, in no particular vtable order.
+
+#ifndef d3d11_4_h
+#define d3d11_4_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <dxgiformat.h>
+
+typedef int BOOL;
+typedef unsigned char UINT8;
+typedef unsigned int UINT;
+typedef int INT;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef uint64_t UINT64;
+typedef float FLOAT;
+typedef size_t SIZE_T;
+typedef char const* LPCSTR;
+typedef int32_t HRESULT;
+
+#define TRUE 1
+#define FALSE 0
+
+#define S_OK ((HRESULT)0L)
+#define S_FALSE ((HRESULT)1L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define E_NOINTERFACE ((HRESULT)0x80004002L)
+#define DXGI_ERROR_INVALID_CALL ((HRESULT)0x887A0001L)
+#define DXGI_ERROR_WAS_STILL_DRAWING ((HRESULT)0x887A000AL)
+
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+#define ZeroMemory(destination, length) std::memset((destination), 0, (length))
+
+// Interface ids are the addresses of one static per interface type, which is all QueryInterface needs here.
+struct GUID
+{
+    void const* id;
+};
+typedef GUID IID;
+#define REFIID IID const&
+
+template <typename Interface>
+inline IID const& dxowlHostUuidOf()
+{
+    static char const tag = 0;
+    static IID const iid = { &tag };
+    return iid;
+}
+#define __uuidof(Interface) dxowlHostUuidOf<Interface>()
+
+inline bool operator==(IID const& lhs, IID const& rhs)
+{
+    return lhs.id == rhs.id;
+}
+
+#define D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT 32
+#define D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT 14
+#define D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT 128
+#define D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT 8
+#define D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT 4096
+#define D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION 16384
+#define D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION 2048
+#define D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION 2048
+#define D3D11_REQ_MIP_LEVELS 15
+#define D3D11_APPEND_ALIGNED_ELEMENT 0xffffffff
+#define D3D11_DEFAULT_SAMPLE_MASK 0xffffffff
+
+enum D3D11_USAGE
+{
+    D3D11_USAGE_DEFAULT = 0,
+    D3D11_USAGE_IMMUTABLE = 1,
+    D3D11_USAGE_DYNAMIC = 2,
+    D3D11_USAGE_STAGING = 3
+};
+
+enum D3D11_BIND_FLAG
+{
+    D3D11_BIND_VERTEX_BUFFER = 0x1,
+    D3D11_BIND_INDEX_BUFFER = 0x2,
+    D3D11_BIND_CONSTANT_BUFFER = 0x4,
+    D3D11_BIND_SHADER_RESOURCE = 0x8,
+    D3D11_BIND_STREAM_OUTPUT = 0x10,
+    D3D11_BIND_RENDER_TARGET = 0x20,
+    D3D11_BIND_DEPTH_STENCIL = 0x40,
+    D3D11_BIND_UNORDERED_ACCESS = 0x80
+};
+
+enum D3D11_CPU_ACCESS_FLAG
+{
+    D3D11_CPU_ACCESS_WRITE = 0x10000,
+    D3D11_CPU_ACCESS_READ = 0x20000
+};
+
+enum D3D11_RESOURCE_MISC_FLAG
+{
+    D3D11_RESOURCE_MISC_GENERATE_MIPS = 0x1,
+    D3D11_RESOURCE_MISC_TEXTURECUBE = 0x4,
+    D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS = 0x10,
+    D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS = 0x20,
+    D3D11_RESOURCE_MISC_BUFFER_STRUCTURED = 0x40
+};
+
+enum D3D11_MAP
+{
+    D3D11_MAP_READ = 1,
+    D3D11_MAP_WRITE = 2,
+    D3D11_MAP_READ_WRITE = 3,
+    D3D11_MAP_WRITE_DISCARD = 4,
+    D3D11_MAP_WRITE_NO_OVERWRITE = 5
+};
+
+enum D3D11_MAP_FLAG
+{
+    D3D11_MAP_FLAG_DO_NOT_WAIT = 0x100000
+};
+
+enum D3D11_INPUT_CLASSIFICATION
+{
+    D3D11_INPUT_PER_VERTEX_DATA = 0,
+    D3D11_INPUT_PER_INSTANCE_DATA = 1
+};
+
+enum D3D_PRIMITIVE_TOPOLOGY
+{
+    D3D_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+    D3D_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+    D3D_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+    D3D_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+    D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+    D3D11_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5
+};
+typedef D3D_PRIMITIVE_TOPOLOGY D3D11_PRIMITIVE_TOPOLOGY;
+
+enum D3D11_SRV_DIMENSION
+{
+    D3D11_SRV_DIMENSION_UNKNOWN = 0,
+    D3D11_SRV_DIMENSION_BUFFER = 1,
+    D3D11_SRV_DIMENSION_TEXTURE2D = 4,
+    D3D11_SRV_DIMENSION_TEXTURE2DARRAY = 5,
+    D3D11_SRV_DIMENSION_TEXTURE2DMS = 6,
+    D3D11_SRV_DIMENSION_TEXTURE3D = 8,
+    D3D11_SRV_DIMENSION_TEXTURECUBE = 9,
+    D3D11_SRV_DIMENSION_TEXTURECUBEARRAY = 10,
+    D3D11_SRV_DIMENSION_BUFFEREX = 11
+};
+
+enum D3D11_UAV_DIMENSION
+{
+    D3D11_UAV_DIMENSION_UNKNOWN = 0,
+    D3D11_UAV_DIMENSION_BUFFER = 1
+};
+
+enum D3D11_BUFFER_UAV_FLAG
+{
+    D3D11_BUFFER_UAV_FLAG_RAW = 0x1,
+    D3D11_BUFFER_UAV_FLAG_APPEND = 0x2,
+    D3D11_BUFFER_UAV_FLAG_COUNTER = 0x4
+};
+
+enum D3D11_RTV_DIMENSION
+{
+    D3D11_RTV_DIMENSION_UNKNOWN = 0,
+    D3D11_RTV_DIMENSION_TEXTURE2D = 4,
+    D3D11_RTV_DIMENSION_TEXTURE2DMS = 6
+};
+
+enum D3D11_DSV_DIMENSION
+{
+    D3D11_DSV_DIMENSION_UNKNOWN = 0,
+    D3D11_DSV_DIMENSION_TEXTURE2D = 3,
+    D3D11_DSV_DIMENSION_TEXTURE2DMS = 5
+};
+
+enum D3D11_CLEAR_FLAG
+{
+    D3D11_CLEAR_DEPTH = 0x1,
+    D3D11_CLEAR_STENCIL = 0x2
+};
+
+enum D3D11_DEVICE_CONTEXT_TYPE
+{
+    D3D11_DEVICE_CONTEXT_IMMEDIATE = 0,
+    D3D11_DEVICE_CONTEXT_DEFERRED = 1
+};
+
+enum D3D11_FEATURE
+{
+    D3D11_FEATURE_THREADING = 0,
+    D3D11_FEATURE_D3D11_OPTIONS = 7
+};
+
+struct D3D11_FEATURE_DATA_THREADING
+{
+    BOOL DriverConcurrentCreates;
+    BOOL DriverCommandLists;
+};
+
+struct D3D11_FEATURE_DATA_D3D11_OPTIONS
+{
+    BOOL OutputMergerLogicOp;
+    BOOL UAVOnlyRenderingForcedSampleCount;
+    BOOL DiscardAPIsSeenByDriver;
+    BOOL FlagsForUpdateAndCopySeenByDriver;
+    BOOL ClearView;
+    BOOL CopyWithOverlap;
+    BOOL ConstantBufferPartialUpdate;
+    BOOL ConstantBufferOffsetting;
+    BOOL MapNoOverwriteOnDynamicConstantBuffer;
+    BOOL MapNoOverwriteOnDynamicBufferSRV;
+    BOOL MultisampleRTVWithForcedSampleCountOne;
+    BOOL SAD4ShaderInstructions;
+    BOOL ExtendedDoublesShaderInstructions;
+    BOOL ExtendedResourceSharing;
+};
+
+struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+};
+
+struct D3D11_BUFFER_DESC
+{
+    UINT ByteWidth;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+    UINT StructureByteStride;
+};
+
+struct CD3D11_BUFFER_DESC : D3D11_BUFFER_DESC
+{
+    CD3D11_BUFFER_DESC() = default;
+    explicit CD3D11_BUFFER_DESC(
+        UINT byte_width,
+        UINT bind_flags,
+        D3D11_USAGE usage = D3D11_USAGE_DEFAULT,
+        UINT cpu_access_flags = 0,
+        UINT misc_flags = 0,
+        UINT structure_byte_stride = 0)
+    {
+        ByteWidth = byte_width;
+        Usage = usage;
+        BindFlags = bind_flags;
+        CPUAccessFlags = cpu_access_flags;
+        MiscFlags = misc_flags;
+        StructureByteStride = structure_byte_stride;
+    }
+};
+
+struct D3D11_TEXTURE2D_DESC
+{
+    UINT Width;
+    UINT Height;
+    UINT MipLevels;
+    UINT ArraySize;
+    DXGI_FORMAT Format;
+    DXGI_SAMPLE_DESC SampleDesc;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+};
+
+struct D3D11_TEXTURE3D_DESC
+{
+    UINT Width;
+    UINT Height;
+    UINT Depth;
+    UINT MipLevels;
+    DXGI_FORMAT Format;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+};
+
+struct D3D11_SUBRESOURCE_DATA
+{
+    void const* pSysMem;
+    UINT SysMemPitch;
+    UINT SysMemSlicePitch;
+};
+
+struct D3D11_MAPPED_SUBRESOURCE
+{
+    void* pData;
+    UINT RowPitch;
+    UINT DepthPitch;
+};
+
+struct D3D11_BOX
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+};
+
+struct D3D11_INPUT_ELEMENT_DESC
+{
+    LPCSTR SemanticName;
+    UINT SemanticIndex;
+    DXGI_FORMAT Format;
+    UINT InputSlot;
+    UINT AlignedByteOffset;
+    D3D11_INPUT_CLASSIFICATION InputSlotClass;
+    UINT InstanceDataStepRate;
+};
+
+struct D3D11_BUFFER_SRV
+{
+    union
+    {
+        UINT FirstElement;
+        UINT ElementOffset;
+    };
+    union
+    {
+        UINT NumElements;
+        UINT ElementWidth;
+    };
+};
+
+struct D3D11_BUFFEREX_SRV
+{
+    UINT FirstElement;
+    UINT NumElements;
+    UINT Flags;
+};
+
+struct D3D11_TEX2D_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_TEX2D_ARRAY_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+    UINT FirstArraySlice;
+    UINT ArraySize;
+};
+
+struct D3D11_TEX3D_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_TEXCUBE_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_TEXCUBE_ARRAY_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+    UINT First2DArrayFace;
+    UINT NumCubes;
+};
+
+struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_SRV Buffer;
+        D3D11_BUFFEREX_SRV BufferEx;
+        D3D11_TEX2D_SRV Texture2D;
+        D3D11_TEX2D_ARRAY_SRV Texture2DArray;
+        D3D11_TEX3D_SRV Texture3D;
+        D3D11_TEXCUBE_SRV TextureCube;
+        D3D11_TEXCUBE_ARRAY_SRV TextureCubeArray;
+    };
+};
+
+struct D3D11_BUFFER_UAV
+{
+    UINT FirstElement;
+    UINT NumElements;
+    UINT Flags;
+};
+
+struct D3D11_UNORDERED_ACCESS_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_UAV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_UAV Buffer;
+    };
+};
+
+struct D3D11_TEX2D_RTV
+{
+    UINT MipSlice;
+};
+
+struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_RTV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_TEX2D_RTV Texture2D;
+    };
+};
+
+struct D3D11_TEX2D_DSV
+{
+    UINT MipSlice;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT Flags;
+    union
+    {
+        D3D11_TEX2D_DSV Texture2D;
+    };
+};
+
+struct D3D11_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+};
+
+struct D3D11_RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+struct D3D11_DRAW_INDEXED_INSTANCED_INDIRECT_ARGS
+{
+    UINT IndexCountPerInstance;
+    UINT InstanceCount;
+    UINT StartIndexLocation;
+    INT BaseVertexLocation;
+    UINT StartInstanceLocation;
+};
+
+struct D3D11_DRAW_INSTANCED_INDIRECT_ARGS
+{
+    UINT VertexCountPerInstance;
+    UINT InstanceCount;
+    UINT StartVertexLocation;
+    UINT StartInstanceLocation;
+};
+
+struct IUnknown
+{
+    virtual HRESULT QueryInterface(REFIID riid, void** object) = 0;
+    virtual ULONG AddRef() = 0;
+    virtual ULONG Release() = 0;
+
+protected:
+    virtual ~IUnknown() = default;
+};
+
+struct ID3D11DeviceChild : IUnknown
+{
+};
+
+struct ID3D11Resource : ID3D11DeviceChild
+{
+};
+
+struct ID3D11Buffer : ID3D11Resource
+{
+    virtual void GetDesc(D3D11_BUFFER_DESC* desc) = 0;
+};
+
+struct ID3D11Texture2D : ID3D11Resource
+{
+    virtual void GetDesc(D3D11_TEXTURE2D_DESC* desc) = 0;
+};
+
+struct ID3D11Texture3D : ID3D11Resource
+{
+    virtual void GetDesc(D3D11_TEXTURE3D_DESC* desc) = 0;
+};
+
+struct ID3D11View : ID3D11DeviceChild
+{
+};
+
+struct ID3D11ShaderResourceView : ID3D11View
+{
+};
+
+struct ID3D11UnorderedAccessView : ID3D11View
+{
+};
+
+struct ID3D11RenderTargetView : ID3D11View
+{
+};
+
+struct ID3D11DepthStencilView : ID3D11View
+{
+};
+
+struct ID3D11InputLayout : ID3D11DeviceChild
+{
+};
+
+struct ID3D11VertexShader : ID3D11DeviceChild
+{
+};
+
+struct ID3D11GeometryShader : ID3D11DeviceChild
+{
+};
+
+struct ID3D11PixelShader : ID3D11DeviceChild
+{
+};
+
+struct ID3D11ClassInstance : ID3D11DeviceChild
+{
+};
+
+struct ID3D11ClassLinkage : ID3D11DeviceChild
+{
+};
+
+struct ID3D11CommandList : ID3D11DeviceChild
+{
+};
+
+struct ID3D11DeviceContext : ID3D11DeviceChild
+{
+    virtual void IASetInputLayout(ID3D11InputLayout* input_layout) = 0;
+    virtual void IASetVertexBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* strides, UINT const* offsets) = 0;
+    virtual void IASetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset) = 0;
+    virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+
+    virtual void VSSetShader(ID3D11VertexShader* shader, ID3D11ClassInstance* const* class_instances, UINT class_instance_cnt) = 0;
+    virtual void GSSetShader(ID3D11GeometryShader* shader, ID3D11ClassInstance* const* class_instances, UINT class_instance_cnt) = 0;
+    virtual void PSSetShader(ID3D11PixelShader* shader, ID3D11ClassInstance* const* class_instances, UINT class_instance_cnt) = 0;
+
+    virtual void VSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) = 0;
+    virtual void GSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) = 0;
+    virtual void PSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) = 0;
+    virtual void CSSetConstantBuffers(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers) = 0;
+
+    virtual void VSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void HSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void DSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void GSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void PSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void CSSetShaderResources(UINT start_slot, UINT view_cnt, ID3D11ShaderResourceView* const* views) = 0;
+
+    virtual void OMSetRenderTargets(UINT view_cnt, ID3D11RenderTargetView* const* render_target_views, ID3D11DepthStencilView* depth_stencil_view) = 0;
+    virtual void RSSetViewports(UINT viewport_cnt, D3D11_VIEWPORT const* viewports) = 0;
+    virtual void ClearRenderTargetView(ID3D11RenderTargetView* render_target_view, FLOAT const color[4]) = 0;
+    virtual void ClearDepthStencilView(ID3D11DepthStencilView* depth_stencil_view, UINT clear_flags, FLOAT depth, UINT8 stencil) = 0;
+
+    virtual void Draw(UINT vertex_cnt, UINT start_vertex) = 0;
+    virtual void DrawIndexed(UINT index_cnt, UINT start_index, INT base_vertex) = 0;
+    virtual void DrawInstanced(UINT vertex_cnt, UINT instance_cnt, UINT start_vertex, UINT start_instance) = 0;
+    virtual void DrawIndexedInstanced(UINT index_cnt, UINT instance_cnt, UINT start_index, INT base_vertex, UINT start_instance) = 0;
+    virtual void DrawIndexedInstancedIndirect(ID3D11Buffer* args, UINT args_offset) = 0;
+    virtual void DrawInstancedIndirect(ID3D11Buffer* args, UINT args_offset) = 0;
+
+    virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP map_type, UINT map_flags, D3D11_MAPPED_SUBRESOURCE* mapped) = 0;
+    virtual void Unmap(ID3D11Resource* resource, UINT subresource) = 0;
+    virtual void UpdateSubresource(ID3D11Resource* resource, UINT subresource, D3D11_BOX const* box, void const* data, UINT row_pitch, UINT depth_pitch) = 0;
+    virtual void CopyResource(ID3D11Resource* destination, ID3D11Resource* source) = 0;
+    virtual void CopySubresourceRegion(ID3D11Resource* destination, UINT destination_subresource, UINT x, UINT y, UINT z, ID3D11Resource* source, UINT source_subresource, D3D11_BOX const* box) = 0;
+    virtual void GenerateMips(ID3D11ShaderResourceView* view) = 0;
+
+    virtual void ExecuteCommandList(ID3D11CommandList* command_list, BOOL restore_context_state) = 0;
+    virtual HRESULT FinishCommandList(BOOL restore_deferred_context_state, ID3D11CommandList** command_list) = 0;
+    virtual void ClearState() = 0;
+    virtual void Flush() = 0;
+    virtual D3D11_DEVICE_CONTEXT_TYPE GetType() = 0;
+};
+
+struct ID3D11DeviceContext1 : ID3D11DeviceContext
+{
+    virtual void VSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) = 0;
+    virtual void GSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) = 0;
+    virtual void PSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) = 0;
+    virtual void CSSetConstantBuffers1(UINT start_slot, UINT buffer_cnt, ID3D11Buffer* const* buffers, UINT const* first_constants, UINT const* constant_cnts) = 0;
+};
+
+struct ID3D11DeviceContext2 : ID3D11DeviceContext1
+{
+};
+
+struct ID3D11DeviceContext3 : ID3D11DeviceContext2
+{
+};
+
+struct ID3D11DeviceContext4 : ID3D11DeviceContext3
+{
+};
+
+struct ID3D11Device : IUnknown
+{
+    virtual HRESULT CreateBuffer(D3D11_BUFFER_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Buffer** buffer) = 0;
+    virtual HRESULT CreateTexture2D(D3D11_TEXTURE2D_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Texture2D** texture) = 0;
+    virtual HRESULT CreateTexture3D(D3D11_TEXTURE3D_DESC const* desc, D3D11_SUBRESOURCE_DATA const* initial_data, ID3D11Texture3D** texture) = 0;
+    virtual HRESULT CreateShaderResourceView(ID3D11Resource* resource, D3D11_SHADER_RESOURCE_VIEW_DESC const* desc, ID3D11ShaderResourceView** view) = 0;
+    virtual HRESULT CreateUnorderedAccessView(ID3D11Resource* resource, D3D11_UNORDERED_ACCESS_VIEW_DESC const* desc, ID3D11UnorderedAccessView** view) = 0;
+    virtual HRESULT CreateRenderTargetView(ID3D11Resource* resource, D3D11_RENDER_TARGET_VIEW_DESC const* desc, ID3D11RenderTargetView** view) = 0;
+    virtual HRESULT CreateDepthStencilView(ID3D11Resource* resource, D3D11_DEPTH_STENCIL_VIEW_DESC const* desc, ID3D11DepthStencilView** view) = 0;
+    virtual HRESULT CreateInputLayout(D3D11_INPUT_ELEMENT_DESC const* elements, UINT element_cnt, void const* shader_bytecode, SIZE_T bytecode_length, ID3D11InputLayout** input_layout) = 0;
+    virtual HRESULT CreateVertexShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage* class_linkage, ID3D11VertexShader** shader) = 0;
+    virtual HRESULT CreateGeometryShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage* class_linkage, ID3D11GeometryShader** shader) = 0;
+    virtual HRESULT CreatePixelShader(void const* shader_bytecode, SIZE_T bytecode_length, ID3D11ClassLinkage* class_linkage, ID3D11PixelShader** shader) = 0;
+    virtual HRESULT CreateDeferredContext(UINT context_flags, ID3D11DeviceContext** context) = 0;
+    virtual HRESULT CheckFeatureSupport(D3D11_FEATURE feature, void* feature_support_data, UINT feature_support_data_size) = 0;
+    virtual void GetImmediateContext(ID3D11DeviceContext** context) = 0;
+};
+
+struct ID3D11Device1 : ID3D11Device
+{
+};
+
+struct ID3D11Device2 : ID3D11Device1
+{
+};
+
+struct ID3D11Device3 : ID3D11Device2
+{
+    virtual HRESULT CreateDeferredContext3(UINT context_flags, ID3D11DeviceContext3** context) = 0;
+    virtual void GetImmediateContext3(ID3D11DeviceContext3** context) = 0;
+};
+
+struct ID3D11Device4 : ID3D11Device3
+{
+};
+
+#endif // !d3d11_4_h
@@ -0,0 +1,74 @@
+/// <copyright file="base.h">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+// Stand-in for the C++/WinRT header on hosts without it. Only the HRESULT error handling that dxowl uses.
+
+#ifndef winrt_base_h
+#define winrt_base_h
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <d3d11_4.h>
+
+namespace winrt
+{
+    struct hresult
+    {
+        int32_t value = 0;
+
+        hresult() = default;
+        hresult(int32_t hr) : value(hr) {}
+        operator int32_t() const noexcept { return value; }
+    };
+
+    typedef std::wstring hstring;
+
+    inline std::string to_string(std::wstring_view value)
+    {
+        std::string retval;
+        for (wchar_t c : value)
+        {
+            retval.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+        }
+        return retval;
+    }
+
+    class hresult_error
+    {
+    public:
+        explicit hresult_error(hresult code) : m_code(code) {}
+
+        hresult code() const noexcept { return m_code; }
+
+        hstring message() const
+        {
+            switch (static_cast<int32_t>(m_code))
+            {
+            case E_INVALIDARG:
+                return L"The parameter is incorrect.";
+            case E_OUTOFMEMORY:
+                return L"Not enough memory resources are available to complete this operation.";
+            default:
+                return L"Unspecified error";
+            }
+        }
+
+    private:
+        hresult m_code;
+    };
+
+    inline void check_hresult(hresult hr)
+    {
+        if (hr < 0)
+        {
+            throw hresult_error(hr);
+        }
+    }
+} // namespace winrt
+
+#endif // !winrt_base_h
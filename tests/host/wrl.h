@@ -0,0 +1,14 @@
+/// <copyright file="wrl.h">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+// Stand-in for the Windows SDK header on hosts without it.
+
+#ifndef wrl_h
+#define wrl_h
+
+#include <wrl/client.h>
+
+#endif // !wrl_h
@@ -0,0 +1,201 @@
+/// <copyright file="client.h">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+// Stand-in for the Windows SDK header on hosts without it. Microsoft::WRL::ComPtr with the reference counting
+// semantics of the original, limited to the members dxowl uses.
+
+#ifndef wrl_client_h
+#define wrl_client_h
+
+#include <cstddef>
+
+#include <d3d11_4.h>
+
+namespace Microsoft
+{
+    namespace WRL
+    {
+        template <typename T>
+        class ComPtr;
+
+        namespace Details
+        {
+            /// Result of ComPtr::operator&, converts to the ComPtr itself or to the address of its released pointer.
+            template <typename T>
+            class ComPtrRef
+            {
+            public:
+                explicit ComPtrRef(ComPtr<T>* ptr) : m_ptr(ptr) {}
+
+                operator ComPtr<T>*() const { return m_ptr; }
+                operator T**() const { return m_ptr->ReleaseAndGetAddressOf(); }
+                operator void**() const { return reinterpret_cast<void**>(m_ptr->ReleaseAndGetAddressOf()); }
+
+            private:
+                ComPtr<T>* m_ptr;
+            };
+        } // namespace Details
+
+        template <typename T>
+        class ComPtr
+        {
+        public:
+            ComPtr() : m_ptr(nullptr) {}
+            ComPtr(std::nullptr_t) : m_ptr(nullptr) {}
+
+            template <typename U>
+            ComPtr(U* ptr) : m_ptr(ptr)
+            {
+                addRef();
+            }
+
+            ComPtr(ComPtr const& other) : m_ptr(other.m_ptr)
+            {
+                addRef();
+            }
+
+            template <typename U>
+            ComPtr(ComPtr<U> const& other) : m_ptr(other.Get())
+            {
+                addRef();
+            }
+
+            ComPtr(ComPtr&& other) noexcept : m_ptr(other.m_ptr)
+            {
+                other.m_ptr = nullptr;
+            }
+
+            ~ComPtr()
+            {
+                Reset();
+            }
+
+            ComPtr& operator=(ComPtr const& rhs)
+            {
+                ComPtr(rhs).Swap(*this);
+                return *this;
+            }
+
+            ComPtr& operator=(ComPtr&& rhs) noexcept
+            {
+                ComPtr(static_cast<ComPtr&&>(rhs)).Swap(*this);
+                return *this;
+            }
+
+            template <typename U>
+            ComPtr& operator=(U* rhs)
+            {
+                ComPtr(rhs).Swap(*this);
+                return *this;
+            }
+
+            ComPtr& operator=(std::nullptr_t)
+            {
+                Reset();
+                return *this;
+            }
+
+            T* Get() const { return m_ptr; }
+            T* operator->() const { return m_ptr; }
+            explicit operator bool() const { return m_ptr != nullptr; }
+
+            T* const* GetAddressOf() const { return &m_ptr; }
+            T** GetAddressOf() { return &m_ptr; }
+
+            T** ReleaseAndGetAddressOf()
+            {
+                Reset();
+                return &m_ptr;
+            }
+
+            /// Like the original, taking the address releases the current object once it is used as T**.
+            Details::ComPtrRef<T> operator&()
+            {
+                return Details::ComPtrRef<T>(this);
+            }
+
+            ULONG Reset()
+            {
+                ULONG retval = 0;
+                if (m_ptr != nullptr)
+                {
+                    retval = m_ptr->Release();
+                    m_ptr = nullptr;
+                }
+                return retval;
+            }
+
+            void Attach(T* ptr)
+            {
+                Reset();
+                m_ptr = ptr;
+            }
+
+            T* Detach()
+            {
+                T* retval = m_ptr;
+                m_ptr = nullptr;
+                return retval;
+            }
+
+            void Swap(ComPtr& other)
+            {
+                T* ptr = m_ptr;
+                m_ptr = other.m_ptr;
+                other.m_ptr = ptr;
+            }
+
+            template <typename U>
+            HRESULT As(ComPtr<U>* other) const
+            {
+                return m_ptr->QueryInterface(__uuidof(U), reinterpret_cast<void**>(other->ReleaseAndGetAddressOf()));
+            }
+
+            template <typename U>
+            HRESULT As(Details::ComPtrRef<U> other) const
+            {
+                return As(static_cast<ComPtr<U>*>(other));
+            }
+
+        private:
+            void addRef()
+            {
+                if (m_ptr != nullptr)
+                {
+                    m_ptr->AddRef();
+                }
+            }
+
+            T* m_ptr;
+        };
+
+        template <typename T, typename U>
+        bool operator==(ComPtr<T> const& lhs, ComPtr<U> const& rhs)
+        {
+            return lhs.Get() == rhs.Get();
+        }
+
+        template <typename T, typename U>
+        bool operator!=(ComPtr<T> const& lhs, ComPtr<U> const& rhs)
+        {
+            return lhs.Get() != rhs.Get();
+        }
+
+        template <typename T>
+        bool operator==(ComPtr<T> const& lhs, std::nullptr_t)
+        {
+            return lhs.Get() == nullptr;
+        }
+
+        template <typename T>
+        bool operator!=(ComPtr<T> const& lhs, std::nullptr_t)
+        {
+            return lhs.Get() != nullptr;
+        }
+    } // namespace WRL
+} // namespace Microsoft
+
+#endif // !wrl_client_h
@@ -0,0 +1,266 @@
+/// <copyright file="MeshConverter.cpp">
+/// MIT License.
+/// Copyright (c) 2026 Michael Becher.
+/// </copyright>
+/// <author>Michael Becher</author>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dxowl/MeshFile.hpp>
+#include <dxowl/MeshOptimizer.hpp>
+
+using namespace dxowl;
+
+namespace
+{
+    /// Triangulated OBJ mesh with one index per unique position/texcoord/normal combination.
+    struct ObjMesh
+    {
+        std::vector<std::array<float, 3>> positions;
+        std::vector<std::array<float, 3>> normals;
+        std::vector<std::array<float, 2>> tex_coords;
+        std::vector<uint32_t> indices;
+    };
+
+    /// Resolves a 1-based or negative (relative to the end) OBJ index, 0 means the element is missing.
+    size_t resolveIndex(long index, size_t count, size_t line_number)
+    {
+        long const resolved = index < 0 ? static_cast<long>(count) + index : index - 1;
+        if (resolved < 0 || static_cast<size_t>(resolved) >= count)
+        {
+            throw std::runtime_error("MeshConverter: index out of range in line " + std::to_string(line_number));
+        }
+        return static_cast<size_t>(resolved);
+    }
+
+    /// Reads v, vt, vn and f statements, other statements are skipped. Polygons are triangulated as fans.
+    /// OBJ texture coordinates have their origin at the bottom left, they are flipped to the D3D convention.
+    ObjMesh readObj(std::string const& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("MeshConverter: cannot open " + path);
+        }
+
+        std::vector<std::array<float, 3>> positions;
+        std::vector<std::array<float, 3>> normals;
+        std::vector<std::array<float, 2>> tex_coords;
+        std::vector<std::array<size_t, 3>> corners; // position, tex coord + 1, normal + 1
+        std::map<std::array<size_t, 3>, uint32_t> corner_indices;
+
+        ObjMesh retval;
+        std::string line;
+        size_t line_number = 0;
+        while (std::getline(file, line))
+        {
+            ++line_number;
+            std::istringstream stream(line);
+            std::string statement;
+            stream >> statement;
+
+            if (statement == "v")
+            {
+                std::array<float, 3> position = {};
+                stream >> position[0] >> position[1] >> position[2];
+                positions.push_back(position);
+            }
+            else if (statement == "vt")
+            {
+                std::array<float, 2> tex_coord = {};
+                stream >> tex_coord[0] >> tex_coord[1];
+                tex_coord[1] = 1.0f - tex_coord[1];
+                tex_coords.push_back(tex_coord);
+            }
+            else if (statement == "vn")
+            {
+                std::array<float, 3> normal = {};
+                stream >> normal[0] >> normal[1] >> normal[2];
+                normals.push_back(normal);
+            }
+            else if (statement == "f")
+            {
+                std::vector<uint32_t> polygon;
+                std::string vertex;
+                while (stream >> vertex)
+                {
+                    // v, v/vt, v//vn or v/vt/vn
+                    long references[3] = { 0, 0, 0 };
+                    size_t begin = 0;
+                    for (int i = 0; i < 3 && begin <= vertex.size(); ++i)
+                    {
+                        size_t const end = (std::min)(vertex.find('/', begin), vertex.size());
+                        if (end > begin)
+                        {
+                            references[i] = std::strtol(vertex.c_str() + begin, nullptr, 10);
+                        }
+                        begin = end + 1;
+                    }
+
+                    std::array<size_t, 3> corner = { resolveIndex(references[0], positions.size(), line_number), 0, 0 };
+                    if (references[1] != 0)
+                    {
+                        corner[1] = resolveIndex(references[1], tex_coords.size(), line_number) + 1;
+                    }
+                    if (references[2] != 0)
+                    {
+                        corner[2] = resolveIndex(references[2], normals.size(), line_number) + 1;
+                    }
+
+                    auto inserted = corner_indices.insert({ corner, static_cast<uint32_t>(corners.size()) });
+                    if (inserted.second)
+                    {
+                        corners.push_back(corner);
+                    }
+                    polygon.push_back(inserted.first->second);
+                }
+
+                if (polygon.size() < 3)
+                {
+                    throw std::runtime_error("MeshConverter: face with less than 3 vertices in line " + std::to_string(line_number));
+                }
+                for (size_t i = 2; i < polygon.size(); ++i)
+                {
+                    retval.indices.insert(retval.indices.end(), { polygon[0], polygon[i - 1], polygon[i] });
+                }
+            }
+        }
+
+        if (retval.indices.empty())
+        {
+            throw std::runtime_error("MeshConverter: no faces in " + path);
+        }
+
+        // corners without a tex coord or normal get zeros if other corners have one
+        for (auto const& corner : corners)
+        {
+            retval.positions.push_back(positions[corner[0]]);
+            if (!tex_coords.empty())
+            {
+                retval.tex_coords.push_back(corner[1] > 0 ? tex_coords[corner[1] - 1] : std::array<float, 2>{});
+            }
+            if (!normals.empty())
+            {
+                retval.normals.push_back(corner[2] > 0 ? normals[corner[2] - 1] : std::array<float, 3>{});
+            }
+        }
+
+        return retval;
+    }
+
+    void printUsage()
+    {
+        std::printf("usage: MeshConverter [--compress] [--optimize] input.obj output.dxmf\n");
+        std::printf("  --compress  byte shuffle and LZ4 compress the streams where that saves space\n");
+        std::printf("  --optimize  reorder triangles and vertices for the vertex cache with MeshOptimizer\n");
+    }
+} // namespace
+
+// Converts a Wavefront OBJ file to the binary mesh format of MeshFile. Positions, normals and texture
+// coordinates are written to separate vertex streams in that order, one input slot each, streams the file
+// does not have are left out. Indices are 16 bit if the vertex count allows it.
+int main(int argc, char** argv)
+{
+    bool compress = false;
+    bool optimize = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        if (arg == "--compress")
+        {
+            compress = true;
+        }
+        else if (arg == "--optimize")
+        {
+            optimize = true;
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            paths.push_back(arg);
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (paths.size() != 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        ObjMesh mesh = readObj(paths[0]);
+        size_t const vertex_cnt = mesh.positions.size();
+
+        std::vector<VertexDescriptor> vertex_layout;
+        std::vector<void*> vertex_data;
+        vertex_layout.push_back({ sizeof(float) * 3, { { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } });
+        vertex_data.push_back(mesh.positions.data());
+        if (!mesh.normals.empty())
+        {
+            vertex_layout.push_back({ sizeof(float) * 3, { { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, UINT(vertex_layout.size()), 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } });
+            vertex_data.push_back(mesh.normals.data());
+        }
+        if (!mesh.tex_coords.empty())
+        {
+            vertex_layout.push_back({ sizeof(float) * 2, { { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, UINT(vertex_layout.size()), 0, D3D11_INPUT_PER_VERTEX_DATA, 0 } } });
+            vertex_data.push_back(mesh.tex_coords.data());
+        }
+
+        if (optimize)
+        {
+            MeshOptimizer::Report const report = MeshOptimizer::optimize(
+                vertex_data,
+                vertex_cnt,
+                vertex_layout,
+                mesh.indices.data(),
+                mesh.indices.size(),
+                DXGI_FORMAT_R32_UINT);
+            std::printf("ACMR %.3f -> %.3f\n", report.before.acmr, report.after.acmr);
+        }
+
+        DXGI_FORMAT const index_format = vertex_cnt <= 0xFFFF ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+        MeshFileWriter writer(vertex_layout, index_format);
+        for (size_t i = 0; i < vertex_layout.size(); ++i)
+        {
+            writer.setVertexData(i, vertex_data[i], vertex_cnt * vertex_layout[i].stride);
+        }
+        if (index_format == DXGI_FORMAT_R16_UINT)
+        {
+            writer.setIndexData(std::vector<uint16_t>(mesh.indices.begin(), mesh.indices.end()));
+        }
+        else
+        {
+            writer.setIndexData(mesh.indices);
+        }
+        writer.write(paths[1], compress);
+
+        std::printf("%zu vertices, %zu triangles, %zu streams, %s indices\n",
+            vertex_cnt,
+            mesh.indices.size() / 3,
+            vertex_layout.size(),
+            index_format == DXGI_FORMAT_R16_UINT ? "16 bit" : "32 bit");
+    }
+    catch (std::exception const& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}